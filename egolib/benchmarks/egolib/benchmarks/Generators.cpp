@@ -0,0 +1,205 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Generators.cpp
+/// @brief Synthetic inputs for the benchmarks.
+
+#include "egolib/benchmarks/Generators.hpp"
+#include <random>
+#include <sstream>
+
+namespace Ego { namespace Benchmarks {
+
+const std::string INPUT_MOUNT_POINT = "mp_benchmarks";
+
+/// @brief Rolling hills with a height between 0 and 512.
+static float getHeight(float x, float y)
+{
+    return 256.0f + 128.0f * std::sin(x / 700.0f) + 128.0f * std::cos(y / 500.0f);
+}
+
+std::shared_ptr<ego_mesh_t> makeMesh(size_t tileCountX, size_t tileCountY, float wallProbability, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::bernoulli_distribution isWall(wallProbability);
+    auto mesh = std::make_shared<ego_mesh_t>(MeshInfo(tileCountX, tileCountY));
+    const float size = Info<float>::Grid::Size();
+    for (size_t iy = 0; iy < tileCountY; ++iy)
+    {
+        for (size_t ix = 0; ix < tileCountX; ++ix)
+        {
+            Index1D i = ix + iy * tileCountX;
+            ego_tile_info_t& tile = mesh->_tmem.get(i);
+            tile._type = 0;
+            tile._img = 0;
+            tile._vrtstart = i.i() * MAP_FAN_VERTICES_MAX;
+            bool border = 0 == ix || 0 == iy || tileCountX - 1 == ix || tileCountY - 1 == iy;
+            tile._base_fx = (border || isWall(generator)) ? (MAPFX_WALL | MAPFX_IMPASS) : 0;
+            tile.setFX(tile._base_fx);
+            // The corners in the order expected by ego_mesh_t::getElevation.
+            const float corners[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+            for (size_t j = 0; j < 4; ++j)
+            {
+                GLXvector3f& position = mesh->_tmem._plst[tile._vrtstart + j];
+                position[XX] = (ix + corners[j][0]) * size;
+                position[YY] = (iy + corners[j][1]) * size;
+                position[ZZ] = getHeight(position[XX], position[YY]);
+            }
+        }
+    }
+    return mesh;
+}
+
+std::vector<oct_bb_t> makeBoundingBoxes(size_t count, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> position(0.0f, 4096.0f);
+    std::uniform_real_distribution<float> extent(8.0f, 128.0f);
+    std::vector<oct_bb_t> boxes;
+    boxes.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Vector3f min(position(generator), position(generator), position(generator) / 16.0f);
+        Vector3f max = min + Vector3f(extent(generator), extent(generator), extent(generator));
+        oct_bb_t box(oct_vec_v2_t{min});
+        box.join(oct_vec_v2_t{max});
+        boxes.push_back(box);
+    }
+    return boxes;
+}
+
+std::vector<MD2_Vertex> makeFrame(size_t vertexCount, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> coordinate(-64.0f, 64.0f);
+    std::uniform_int_distribution<size_t> normal(0, MD2Model::normalCount - 1);
+    std::vector<MD2_Vertex> frame(vertexCount);
+    for (auto& vertex : frame)
+    {
+        vertex.pos = Vector3f(coordinate(generator), coordinate(generator), coordinate(generator));
+        vertex.nrm = normalize(Vector3f(coordinate(generator), coordinate(generator), coordinate(generator))).get_vector();
+        vertex.normal = normal(generator);
+    }
+    return frame;
+}
+
+std::vector<lighting_cache_t> makeLightingCaches(size_t count, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> light(0.0f, 255.0f);
+    std::vector<lighting_cache_t> caches(count);
+    for (auto& cache : caches)
+    {
+        for (size_t i = 0; i < LIGHTING_VEC_SIZE; ++i)
+        {
+            cache.low._lighting[i] = light(generator);
+            cache.hgh._lighting[i] = light(generator);
+        }
+        cache.max_light();
+    }
+    return caches;
+}
+
+std::string makeConfigFile(size_t entryCount, uint32_t seed)
+{
+    static const char *const sections[] = { "graphic", "sound", "camera", "game", "network", "debug" };
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<size_t> section(0, sizeof(sections) / sizeof(sections[0]) - 1);
+    std::uniform_int_distribution<int> value(0, 4096);
+    std::ostringstream os;
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+        if (0 == i % 8)
+        {
+            os << "// group " << i / 8 << "\n";
+        }
+        os << sections[section(generator)] << ".option" << i << ".value : \"" << value(generator) << "\"\n";
+    }
+    return os.str();
+}
+
+std::string makeDataFile(size_t groupCount, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> integer(0, 1000);
+    std::uniform_int_distribution<int> letter('A', 'Z');
+    std::ostringstream os;
+    for (size_t i = 0; i < groupCount; ++i)
+    {
+        const int low = integer(generator);
+        os << "Integer value              : " << integer(generator) << "\n";
+        os << "Real value                 : " << integer(generator) / 8.0f << "\n";
+        os << "Range                      : " << low << "-" << low + integer(generator) << "\n";
+        os << "IDSZ                       : [" << char(letter(generator)) << char(letter(generator))
+           << char(letter(generator)) << char(letter(generator)) << "]\n";
+        os << "Name                       : Name_" << i << "\n";
+    }
+    return os.str();
+}
+
+std::string makeScript(size_t blockCount, uint32_t seed)
+{
+    static const char *const conditions[] = { "IfSpawned", "IfTimeOut", "IfAtWaypoint" };
+    static const char *const actions[] = { "SetTargetToSelf", "ClearWaypoints", "AddWaypoint", "SetTime" };
+    static const char *const variables[] = { "tmpx", "tmpy", "tmpdist", "tmpturn", "tmpargument" };
+    static const char *const operands[] = { "selfx", "selfy", "targetx", "targety", "rand" };
+    static const char *const operators[] = { "+", "-", "*", "/", "&", "%" };
+    std::mt19937 generator(seed);
+    auto pick = [&generator](size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(generator); };
+    std::ostringstream os;
+    for (size_t i = 0; i < blockCount; ++i)
+    {
+        os << conditions[pick(3)] << "\n";
+        os << "  " << variables[pick(5)] << " = " << operands[pick(5)] << " " << operators[pick(6)] << " " << 1 + pick(255) << "\n";
+        os << "  " << actions[pick(4)] << "\n";
+        os << "  " << conditions[pick(3)] << "\n";
+        os << "    " << variables[pick(5)] << " = " << operands[pick(5)] << " " << operators[pick(6)] << " " << operands[pick(5)]
+           << " " << operators[pick(6)] << " " << 1 + pick(255) << " // comment\n";
+        os << "    " << actions[pick(4)] << "\n";
+    }
+    os << "End\n";
+    return os.str();
+}
+
+/// @brief Write a file to the write directory.
+static void writeFile(const std::string& pathname, const std::string& contents)
+{
+    vfs_FILE *file = vfs_openWrite(pathname);
+    if (!file)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to open file `" + pathname + "` for writing");
+    }
+    size_t written = vfs_write(contents.data(), 1, contents.size(), file);
+    vfs_close(file);
+    if (written != contents.size())
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to write file `" + pathname + "`");
+    }
+}
+
+void createInputFiles()
+{
+    vfs_mkdir("/benchmarks");
+    writeFile("/benchmarks/setup.txt", makeConfigFile(1024, 1));
+    writeFile("/benchmarks/data.txt", makeDataFile(DATA_FILE_GROUP_COUNT, 2));
+    writeFile("/benchmarks/script.txt", makeScript(256, 3));
+    vfs_add_mount_point(fs_getUserDirectory(), FsPath("benchmarks"), VfsPath(INPUT_MOUNT_POINT), 1);
+}
+
+} } // namespace Ego::Benchmarks
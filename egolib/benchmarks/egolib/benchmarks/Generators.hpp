@@ -0,0 +1,69 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Generators.hpp
+/// @brief Synthetic inputs for the benchmarks.
+/// @remark All generators are deterministic for a given seed, so results of different runs are comparable.
+
+#pragma once
+
+#include "egolib/egolib.h"
+#include "egolib/game/mesh.h"
+#include "egolib/game/lighting.h"
+#include "egolib/Graphics/MD2Model.hpp"
+
+namespace Ego { namespace Benchmarks {
+
+/// The mount point of the directory the synthetic input files are written to.
+extern const std::string INPUT_MOUNT_POINT;
+
+/// The number of groups in the data file written by createInputFiles.
+static constexpr size_t DATA_FILE_GROUP_COUNT = 256;
+
+/// @brief Create a mesh with rolling hills.
+/// @param tileCountX, tileCountY the size of the mesh in tiles
+/// @param wallProbability the probability of a tile being a wall
+/// @remark The border tiles are always walls.
+///         Only the corner vertices and the fx bits are set, the mesh is not finalized.
+std::shared_ptr<ego_mesh_t> makeMesh(size_t tileCountX, size_t tileCountY, float wallProbability, uint32_t seed);
+
+/// @brief Create octagonal bounding boxes of random sizes scattered over an area of 4096 x 4096.
+std::vector<oct_bb_t> makeBoundingBoxes(size_t count, uint32_t seed);
+
+/// @brief Create a frame of a model with random vertex positions and normals.
+std::vector<MD2_Vertex> makeFrame(size_t vertexCount, uint32_t seed);
+
+/// @brief Create lighting caches with random directed and ambient light.
+std::vector<lighting_cache_t> makeLightingCaches(size_t count, uint32_t seed);
+
+/// @brief Create the contents of a configuration file like "setup.txt".
+std::string makeConfigFile(size_t entryCount, uint32_t seed);
+
+/// @brief Create the contents of a data file like "data.txt" of an object profile.
+/// @remark The file consists of @a groupCount repetitions of an integer, a real, a range, an IDSZ and a name entry.
+std::string makeDataFile(size_t groupCount, uint32_t seed);
+
+/// @brief Create the contents of an AI script with @a blockCount nested conditional blocks.
+std::string makeScript(size_t blockCount, uint32_t seed);
+
+/// @brief Write the synthetic input files and mount their directory at INPUT_MOUNT_POINT.
+/// @throw idlib::runtime_error if a file can not be written
+void createInputFiles();
+
+} } // namespace Ego::Benchmarks
@@ -0,0 +1,98 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Graphics.cpp
+/// @brief Benchmarks of model vertex interpolation and lighting cache evaluation.
+
+#include "egolib/benchmarks/Generators.hpp"
+#include "egolib/game/Graphics/ObjectGraphics.hpp"
+#include <benchmark/benchmark.h>
+
+namespace Ego { namespace Benchmarks { namespace Graphics {
+
+static void md2_interpolate_vertices(::benchmark::State& state)
+{
+    const size_t vertexCount = state.range(0);
+    auto lastFrame = makeFrame(vertexCount, 19);
+    auto nextFrame = makeFrame(vertexCount, 20);
+    std::vector<GLvertex> vertices(vertexCount);
+    for (auto _ : state)
+    {
+        Ego::Graphics::ObjectGraphics::interpolateVerticesRaw(vertices, lastFrame, nextFrame, 0, vertexCount - 1, 0.5f);
+        ::benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * vertexCount);
+}
+BENCHMARK(md2_interpolate_vertices)->Arg(256)->Arg(1024)->Arg(4096);
+
+static void md2_interpolate_packed_vertices(::benchmark::State& state)
+{
+    const size_t vertexCount = state.range(0);
+    MD2_Frame lastFrame, nextFrame;
+    lastFrame.vertexList = makeFrame(vertexCount, 19);
+    nextFrame.vertexList = makeFrame(vertexCount, 20);
+    lastFrame.pack();
+    nextFrame.pack();
+    std::vector<GLvertex> vertices(vertexCount);
+    for (auto _ : state)
+    {
+        Ego::Graphics::ObjectGraphics::interpolateVerticesRaw(vertices, lastFrame, nextFrame, 0, vertexCount - 1, 0.5f);
+        ::benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * vertexCount);
+}
+BENCHMARK(md2_interpolate_packed_vertices)->Arg(256)->Arg(1024)->Arg(4096);
+
+static void lighting_cache_evaluate(::benchmark::State& state)
+{
+    auto caches = makeLightingCaches(1024, 21);
+    auto normals = makeFrame(caches.size(), 22);
+    const AxisAlignedBox3f bbox(Point3f(-64.0f, -64.0f, 0.0f), Point3f(64.0f, 64.0f, 128.0f));
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+        for (size_t i = 0; i < caches.size(); ++i)
+        {
+            float ambient, directed;
+            sum += lighting_cache_t::lighting_evaluate_cache(caches[i], normals[i].nrm, normals[i].pos.z(), bbox, &ambient, &directed);
+        }
+        ::benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * caches.size());
+}
+BENCHMARK(lighting_cache_evaluate);
+
+static void lighting_cache_interpolate(::benchmark::State& state)
+{
+    auto caches = makeLightingCaches(1024, 23);
+    for (auto _ : state)
+    {
+        lighting_cache_t result;
+        for (size_t i = 3; i < caches.size(); ++i)
+        {
+            const std::array<const lighting_cache_t *, 4> corners = { &caches[i - 3], &caches[i - 2], &caches[i - 1], &caches[i] };
+            lighting_cache_t::lighting_cache_interpolate(result, corners, 0.25f, 0.75f);
+        }
+        ::benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * (caches.size() - 3));
+}
+BENCHMARK(lighting_cache_interpolate);
+
+} } } // namespace Ego::Benchmarks::Graphics
@@ -0,0 +1,57 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Main.cpp
+/// @brief Entry point of the benchmarks.
+/// @details Run with <tt>--benchmark_out=results.json --benchmark_out_format=json</tt> to record the results.
+
+#include "egolib/benchmarks/Generators.hpp"
+#include "egolib/game/script_compile.h"
+#include <benchmark/benchmark.h>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return EXIT_FAILURE;
+    }
+    if (0 != vfs_init(argv[0], nullptr))
+    {
+        std::cerr << "unable to initialize the virtual file system" << std::endl;
+        return EXIT_FAILURE;
+    }
+    Log::initialize("/debug/benchmarks-log.txt", Log::Level::Warning);
+    try
+    {
+        Ego::Benchmarks::createInputFiles();
+        parser_state_t::initialize();
+    }
+    catch (const idlib::exception& ex)
+    {
+        std::cerr << ex.to_string() << std::endl;
+        Log::uninitialize();
+        return EXIT_FAILURE;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    parser_state_t::uninitialize();
+    Log::uninitialize();
+    return EXIT_SUCCESS;
+}
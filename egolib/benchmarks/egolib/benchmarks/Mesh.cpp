@@ -0,0 +1,126 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Mesh.cpp
+/// @brief Benchmarks of mesh queries, path finding and line of sight tests.
+
+#include "egolib/benchmarks/Generators.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace Ego { namespace Benchmarks { namespace Mesh {
+
+/// @brief Random points on a mesh of the specified size (in tiles).
+static std::vector<Vector2f> makePoints(size_t count, size_t tileCountX, size_t tileCountY, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> x(0.0f, tileCountX * Info<float>::Grid::Size());
+    std::uniform_real_distribution<float> y(0.0f, tileCountY * Info<float>::Grid::Size());
+    std::vector<Vector2f> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        points.emplace_back(x(generator), y(generator));
+    }
+    return points;
+}
+
+static void mesh_get_elevation(::benchmark::State& state)
+{
+    auto mesh = makeMesh(128, 128, 0.1f, 10);
+    auto points = makePoints(4096, 128, 128, 11);
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+        for (const auto& point : points)
+        {
+            sum += mesh->getElevation(point);
+        }
+        ::benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(mesh_get_elevation);
+
+static void mesh_test_wall(::benchmark::State& state)
+{
+    auto mesh = makeMesh(128, 128, 0.1f, 12);
+    auto points = makePoints(4096, 128, 128, 13);
+    const float radius = state.range(0);
+    for (auto _ : state)
+    {
+        BIT_FIELD bits = EMPTY_BIT_FIELD;
+        for (const auto& point : points)
+        {
+            bits |= mesh->test_wall(Vector3f(point.x(), point.y(), 0.0f), radius, MAPFX_WALL | MAPFX_IMPASS);
+        }
+        ::benchmark::DoNotOptimize(bits);
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(mesh_test_wall)->Arg(16)->Arg(64)->Arg(256);
+
+static void astar_find_path(::benchmark::State& state)
+{
+    const size_t size = state.range(0);
+    std::shared_ptr<const ego_mesh_t> mesh = makeMesh(size, size, 0.2f, 14);
+    std::mt19937 generator(15);
+    std::uniform_int_distribution<int> coordinate(1, size - 2);
+    std::vector<std::array<int, 4>> queries(64);
+    for (auto& query : queries)
+    {
+        query = { coordinate(generator), coordinate(generator), coordinate(generator), coordinate(generator) };
+    }
+    AStar astar;
+    for (auto _ : state)
+    {
+        size_t found = 0;
+        for (const auto& query : queries)
+        {
+            found += astar.find_path(mesh, MAPFX_WALL | MAPFX_IMPASS, query[0], query[1], query[2], query[3]) ? 1 : 0;
+        }
+        ::benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(astar_find_path)->Arg(32)->Arg(128);
+
+static void line_of_sight_blocked(::benchmark::State& state)
+{
+    std::shared_ptr<const ego_mesh_t> mesh = makeMesh(128, 128, 0.02f, 16);
+    auto starts = makePoints(1024, 128, 128, 17);
+    auto ends = makePoints(1024, 128, 128, 18);
+    for (auto _ : state)
+    {
+        size_t blocked = 0;
+        for (size_t i = 0; i < starts.size(); ++i)
+        {
+            line_of_sight_info_t los;
+            los.x0 = starts[i].x(); los.y0 = starts[i].y(); los.z0 = 0.0f;
+            los.x1 = ends[i].x(); los.y1 = ends[i].y(); los.z1 = 0.0f;
+            los.stopped_by = MAPFX_WALL | MAPFX_IMPASS;
+            blocked += line_of_sight_info_t::blocked(los, mesh) ? 1 : 0;
+        }
+        ::benchmark::DoNotOptimize(blocked);
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+}
+BENCHMARK(line_of_sight_blocked);
+
+} } } // namespace Ego::Benchmarks::Mesh
@@ -0,0 +1,75 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Parsers.cpp
+/// @brief Benchmarks of the configuration file parser and of reading data files.
+
+#include "egolib/benchmarks/Generators.hpp"
+#include "egolib/FileFormats/ConfigFile/configfile.h"
+#include <benchmark/benchmark.h>
+
+namespace Ego { namespace Benchmarks { namespace Parsers {
+
+static size_t getFileSize(const std::string& pathname)
+{
+    size_t bytes = 0;
+    vfs_readEntireFile(pathname, [&bytes](size_t numberOfBytes, const char *) { bytes += numberOfBytes; });
+    return bytes;
+}
+
+static void config_file_parse(::benchmark::State& state)
+{
+    const std::string pathname = INPUT_MOUNT_POINT + "/setup.txt";
+    for (auto _ : state)
+    {
+        ConfigFileParser parser(pathname);
+        auto file = parser.parse();
+        if (!file)
+        {
+            state.SkipWithError("unable to parse the configuration file");
+            break;
+        }
+        ::benchmark::DoNotOptimize(file.get());
+    }
+    state.SetBytesProcessed(state.iterations() * getFileSize(pathname));
+}
+BENCHMARK(config_file_parse);
+
+static void read_context_data_file(::benchmark::State& state)
+{
+    const std::string pathname = INPUT_MOUNT_POINT + "/data.txt";
+    for (auto _ : state)
+    {
+        ReadContext ctxt(pathname);
+        float sum = 0.0f;
+        for (size_t i = 0; i < DATA_FILE_GROUP_COUNT; ++i)
+        {
+            sum += vfs_get_next_int(ctxt);
+            sum += vfs_get_next_float(ctxt);
+            sum += vfs_get_next_range(ctxt).upper();
+            ::benchmark::DoNotOptimize(vfs_get_next_idsz(ctxt));
+            ::benchmark::DoNotOptimize(vfs_get_next_name(ctxt));
+        }
+        ::benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * getFileSize(pathname));
+}
+BENCHMARK(read_context_data_file);
+
+} } } // namespace Ego::Benchmarks::Parsers
@@ -0,0 +1,51 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Script.cpp
+/// @brief Benchmarks of the EgoScript compiler.
+/// @remark Running compiled scripts requires the objects of a loaded module and is not covered here.
+
+#include "egolib/benchmarks/Generators.hpp"
+#include "egolib/game/script_compile.h"
+#include <benchmark/benchmark.h>
+
+namespace Ego { namespace Benchmarks { namespace Script {
+
+static void script_compile(::benchmark::State& state)
+{
+    const std::string pathname = INPUT_MOUNT_POINT + "/script.txt";
+    size_t bytes = 0;
+    vfs_readEntireFile(pathname, [&bytes](size_t numberOfBytes, const char *) { bytes += numberOfBytes; });
+    size_t instructions = 0;
+    for (auto _ : state)
+    {
+        script_info_t script;
+        if (rv_success != load_ai_script_vfs(parser_state_t::get(), pathname, nullptr, script))
+        {
+            state.SkipWithError("unable to compile the script");
+            break;
+        }
+        instructions = script._instructions.getNumberOfInstructions();
+    }
+    state.counters["instructions"] = instructions;
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(script_compile);
+
+} } } // namespace Ego::Benchmarks::Script
@@ -0,0 +1,80 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Sorting.cpp
+/// @brief Benchmarks of the radix sort of entity lists against a comparison sort.
+
+#include "egolib/Core/RadixSort.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+
+namespace Ego { namespace Benchmarks { namespace Sorting {
+
+/// Like an entity list entry: a reference and a key packed from a distance and a material.
+struct Entry
+{
+    uint16_t ref;
+    uint64_t key;
+};
+
+/// Objects and particles at random distances with a few different materials.
+static std::vector<Entry> makeMixedEntries(size_t count, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distance(0.1f, 4096.0f);
+    std::uniform_int_distribution<uint32_t> profile(0, 63);
+    std::vector<Entry> entries(count);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const uint32_t material = (i % 3 == 0) ? profile(generator) : (0x80000000 | profile(generator));
+        entries[i] = Entry{ uint16_t(i), (uint64_t(radix_key(distance(generator))) << 32) | material };
+    }
+    return entries;
+}
+
+static void std_sort_mixed_entries(::benchmark::State& state)
+{
+    const auto entries = makeMixedEntries(state.range(0), 10);
+    std::vector<Entry> work;
+    for (auto _ : state)
+    {
+        work = entries;
+        std::sort(work.begin(), work.end(), [](const Entry& x, const Entry& y) { return x.key < y.key; });
+        ::benchmark::DoNotOptimize(work.data());
+    }
+    state.SetItemsProcessed(state.iterations() * entries.size());
+}
+BENCHMARK(std_sort_mixed_entries)->Arg(1024)->Arg(4096);
+
+static void radix_sort_mixed_entries(::benchmark::State& state)
+{
+    const auto entries = makeMixedEntries(state.range(0), 10);
+    std::vector<Entry> work, scratch;
+    for (auto _ : state)
+    {
+        work = entries;
+        radix_sort(work, scratch, [](const Entry& x) { return x.key; });
+        ::benchmark::DoNotOptimize(work.data());
+    }
+    state.SetItemsProcessed(state.iterations() * entries.size());
+}
+BENCHMARK(radix_sort_mixed_entries)->Arg(1024)->Arg(4096);
+
+} } } // namespace Ego::Benchmarks::Sorting
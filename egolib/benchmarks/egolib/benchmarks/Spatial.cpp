@@ -0,0 +1,149 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/benchmarks/Spatial.cpp
+/// @brief Benchmarks of the quad tree and of octagonal bounding boxes.
+
+#include "egolib/benchmarks/Generators.hpp"
+#include <benchmark/benchmark.h>
+
+namespace Ego { namespace Benchmarks { namespace Spatial {
+
+class Element {
+public:
+    Element(const oct_bb_t& box) :
+        _bounds(Point2f(box._mins[OCT_X], box._mins[OCT_Y]), Point2f(box._maxs[OCT_X], box._maxs[OCT_Y]))
+    {}
+
+    const AxisAlignedBox2f& getAxisAlignedBox2D() const { return _bounds; }
+
+private:
+    AxisAlignedBox2f _bounds;
+};
+
+static std::vector<std::shared_ptr<Element>> makeElements(size_t count)
+{
+    std::vector<std::shared_ptr<Element>> elements;
+    for (const auto& box : makeBoundingBoxes(count, 4))
+    {
+        elements.push_back(std::make_shared<Element>(box));
+    }
+    return elements;
+}
+
+static void quad_tree_insert(::benchmark::State& state)
+{
+    auto elements = makeElements(state.range(0));
+    QuadTree<Element> tree;
+    for (auto _ : state)
+    {
+        tree.clear(0.0f, 0.0f, 4096.0f, 4096.0f);
+        for (const auto& element : elements)
+        {
+            tree.insert(element);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * elements.size());
+}
+BENCHMARK(quad_tree_insert)->Arg(256)->Arg(1024)->Arg(4096);
+
+static void quad_tree_find(::benchmark::State& state)
+{
+    auto elements = makeElements(state.range(0));
+    QuadTree<Element> tree(0.0f, 0.0f, 4096.0f, 4096.0f);
+    for (const auto& element : elements)
+    {
+        tree.insert(element);
+    }
+    auto queries = makeBoundingBoxes(256, 5);
+    std::vector<std::shared_ptr<Element>> result;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            result.clear();
+            tree.find(Element(query).getAxisAlignedBox2D(), result);
+            ::benchmark::DoNotOptimize(result.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(quad_tree_find)->Arg(256)->Arg(1024)->Arg(4096);
+
+static void oct_bb_join(::benchmark::State& state)
+{
+    auto boxes = makeBoundingBoxes(1024, 6);
+    for (auto _ : state)
+    {
+        oct_bb_t result;
+        for (const auto& box : boxes)
+        {
+            result.join(box);
+        }
+        ::benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(oct_bb_join);
+
+static void oct_bb_intersection(::benchmark::State& state)
+{
+    auto boxes = makeBoundingBoxes(1024, 7);
+    for (auto _ : state)
+    {
+        for (size_t i = 1; i < boxes.size(); ++i)
+        {
+            ::benchmark::DoNotOptimize(oct_bb_t::intersection(boxes[i - 1], boxes[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (boxes.size() - 1));
+}
+BENCHMARK(oct_bb_intersection);
+
+static void oct_bb_contains(::benchmark::State& state)
+{
+    auto boxes = makeBoundingBoxes(1024, 8);
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (size_t i = 1; i < boxes.size(); ++i)
+        {
+            count += oct_bb_t::contains(boxes[i - 1], boxes[i]) ? 1 : 0;
+        }
+        ::benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * (boxes.size() - 1));
+}
+BENCHMARK(oct_bb_contains);
+
+static void oct_bb_interpolate(::benchmark::State& state)
+{
+    auto boxes = makeBoundingBoxes(1024, 9);
+    for (auto _ : state)
+    {
+        for (size_t i = 1; i < boxes.size(); ++i)
+        {
+            ::benchmark::DoNotOptimize(oct_bb_t::interpolate(boxes[i - 1], boxes[i], 0.25f));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (boxes.size() - 1));
+}
+BENCHMARK(oct_bb_interpolate);
+
+} } } // namespace Ego::Benchmarks::Spatial
@@ -26,20 +26,35 @@
 #include "egolib/game/renderer_3d.h" // for point debugging
 #include "egolib/Script/script.h"  // for waypoint list control
 #include "egolib/game/mesh.h"
+#include "egolib/Core/FrameArena.hpp"
 
 AStar::AStar() : 
+    node_pool(),
     final_node(nullptr), 
     start_node(nullptr)
-{}
+{
+    node_pool.reserve(MAX_ASTAR_POOL);
+}
 
 void AStar::reset()
 {
     /// @author ZF
     /// @details Reset AStar memory.
+    node_pool.clear();
     final_node = nullptr;
     start_node = nullptr;
 }
 
+const AStar::Node *AStar::make_node(int x, int y, float weight, const Node *parent)
+{
+    // Never grow the pool, that would move the nodes the others point to
+    if (node_pool.size() >= node_pool.capacity()) {
+        return nullptr;
+    }
+    node_pool.emplace_back(x, y, weight, parent);
+    return &node_pool.back();
+}
+
 /// Functor to determine the distance of point (sourceX, sourceY) to point (targetX, targetY).
 struct Distance {
     float operator()(int sourceX, int sourceY, int targetX, int targetY) const {
@@ -91,22 +106,25 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
     };
 
     //Node sorting algorithm (lowest weight first)
-    auto comparator = [](const std::shared_ptr<Node> &first, const std::shared_ptr<Node> &second){
+    auto comparator = [](const Node *first, const Node *second){
         return first->weight < second->weight;
     };
 
-    //Set of closed nodes
-    std::unordered_set<int> closedNodes;
-    std::priority_queue<std::shared_ptr<Node>, 
-                        std::vector<std::shared_ptr<Node>>,
-                        decltype(comparator)> openNodes(comparator);
+    //Set of closed nodes, the containers only live for this search
+    Ego::FrameArena& arena = Ego::FrameArena::getUpdateArena();
+    Ego::FrameUnorderedSet<int> closedNodes(2 * MAX_ASTAR_NODES, Ego::FrameAllocator<int>(arena));
+    Ego::FrameVector<const Node *> openNodesContainer{Ego::FrameAllocator<const Node *>(arena)};
+    openNodesContainer.reserve(MAX_ASTAR_POOL);
+    std::priority_queue<const Node *,
+                        Ego::FrameVector<const Node *>,
+                        decltype(comparator)> openNodes(comparator, std::move(openNodesContainer));
 
     // restart the algorithm
     reset();
 
     // initialize the starting node
     weight = Distance()(src_ix, src_iy, dst_ix, dst_iy);
-    start_node = std::make_shared<AStar::Node>(src_ix, src_iy, weight, nullptr);
+    start_node = make_node(src_ix, src_iy, weight, nullptr);
     openNodes.push(start_node);
 
     // do the algorithm
@@ -121,7 +139,7 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
         }
 
         //Get the cheapest open node
-        std::shared_ptr<Node> currentNode = openNodes.top();
+        const Node *currentNode = openNodes.top();
         openNodes.pop();
 
         // find some child nodes
@@ -144,8 +162,8 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
             if (tmp_x == dst_ix && tmp_y == dst_iy)
             {
                 weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy);
-                final_node = std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode);
-                return true;
+                final_node = make_node(tmp_x, tmp_y, weight, currentNode);
+                return nullptr != final_node;
             }
 
             // is the test node on the mesh?
@@ -177,7 +195,11 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
             // OK. determine the weight (F + H)
             weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy)
                    + Distance()(tmp_x, tmp_y, dst_ix, dst_iy);
-            openNodes.push(std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode));
+            const Node *node = make_node(tmp_x, tmp_y, weight, currentNode);
+            if (nullptr == node) {
+                return false;
+            }
+            openNodes.push(node);
         }
     }
 
@@ -196,23 +218,23 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
     size_t path_length, waypoint_num;
     //bool diagonal_movement = false;
 
-    Node *current_node, *last_waypoint, *safe_waypoint;
-    Node *node_path[MAX_ASTAR_PATH];
+    const Node *current_node, *last_waypoint, *safe_waypoint;
+    const Node *node_path[MAX_ASTAR_PATH];
 
     //Fill the waypoint list as much as we can, the final waypoint will always be the destination waypoint
     waypoint_num = 0;
-    current_node = final_node.get();
-    last_waypoint = start_node.get();
+    current_node = final_node;
+    last_waypoint = start_node;
 
     //Build the local node path tree
     path_length = 0;
-    while (path_length < MAX_ASTAR_PATH && current_node != start_node.get())
+    while (path_length < MAX_ASTAR_PATH && current_node != start_node)
     {
         // add the node to the end of the path
         node_path[path_length++] = current_node;
 
         // get next node
-        current_node = current_node->parent.get();
+        current_node = current_node->parent;
     }
 
     //Begin at the end of the list, which contains the starting node
@@ -37,7 +37,7 @@ class AStar {
 
 public:
     struct Node {
-        Node(int x, int y, float setWeight, const std::shared_ptr<Node>& setParent) :
+        Node(int x, int y, float setWeight, const Node *setParent) :
             ix(x),
             iy(y),
             weight(setWeight),
@@ -48,7 +48,7 @@ public:
 
         float weight;
         int ix, iy;
-        std::shared_ptr<Node> parent;
+        const Node *parent;
     };
 
 public:
@@ -60,11 +60,18 @@ private:
     static constexpr size_t MAX_ASTAR_NODES = 512;   ///< Maximum number of nodes to explore
     static constexpr size_t MAX_ASTAR_PATH = 128;    ///< Maximum length of the final path (before pruning)
 
-    std::shared_ptr<Node> final_node;
-    std::shared_ptr<Node> start_node;
+    /// A node is only created for a tile which was closed just before and the search stops after
+    /// MAX_ASTAR_NODES closed tiles (plus up to 4 of the last step), so it never creates more
+    /// nodes than this. The pool is reused by every search and never reallocated.
+    static constexpr size_t MAX_ASTAR_POOL = MAX_ASTAR_NODES + 8;
+
+    std::vector<Node> node_pool;
+    const Node *final_node;
+    const Node *start_node;
 
 private:
     void reset();
+    const Node *make_node(int x, int y, float weight, const Node *parent);
 };
 
 extern AStar g_astar;
@@ -67,14 +67,87 @@ static const std::array<const char*, GSND_COUNT> wavenames =
     "stealth_end"
 };
 
+namespace {
+
+/// The SDL mixer implementation of the voice backend.
+class MixerVoiceBackend : public Ego::Audio::VoiceBackend
+{
+public:
+    MixerVoiceBackend(Ego::Audio::SoundCache& sounds) :
+        _sounds(sounds),
+        _channelSounds()
+    {}
+
+    int getChannelCount() const override
+    {
+        // Passing a negative number queries the number of channels.
+        return Mix_AllocateChannels(-1);
+    }
+
+    bool play(int channel, SoundID soundID, bool looped) override
+    {
+        // Decodes the sound on first use.
+        Mix_Chunk *chunk = _sounds.acquire(soundID, [this](SoundID other) { return isSoundPlaying(other); });
+        if (nullptr == chunk) {
+            return false;
+        }
+        if (Mix_PlayChannel(channel, chunk, looped ? -1 : 0) != channel) {
+            return false;
+        }
+        if (static_cast<size_t>(channel) >= _channelSounds.size()) {
+            _channelSounds.resize(channel + 1, INVALID_SOUND_ID);
+        }
+        _channelSounds[channel] = soundID;
+        //limited global sound volume
+        Mix_Volume(channel, (128 * egoboo_config_t::get().sound_effects_volume.getValue()) / 100);
+        return true;
+    }
+
+    void halt(int channel) override
+    {
+        Mix_HaltChannel(channel);
+    }
+
+    bool isPlaying(int channel) const override
+    {
+        return 0 != Mix_Playing(channel);
+    }
+
+    void setPosition(int channel, float angle, float distance) override
+    {
+        Mix_SetPosition(channel, static_cast<Sint16>(angle), static_cast<Uint8>(Ego::Math::constrain(distance, 0.0f, 255.0f)));
+    }
+
+    bool isSoundPlaying(SoundID soundID) const
+    {
+        for (size_t channel = 0; channel < _channelSounds.size(); ++channel) {
+            if (_channelSounds[channel] == soundID && 0 != Mix_Playing(static_cast<int>(channel))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    Ego::Audio::SoundCache& _sounds;
+    /// The sound last started on each channel.
+    std::vector<SoundID> _channelSounds;
+};
+
+} // namespace
+
 AudioSystem::AudioSystem() :
-    _musicLoaded(),
+    _musicFiles(),
     _musicIDToNameMap(),
-    _soundsLoaded(),
+    _music(nullptr),
+    _soundCache(),
     _globalSounds(),
     _loopingSounds(),
     _currentSongPlaying(),
-    _maxSoundDistance(DEFAULT_MAX_DISTANCE)
+    _maxSoundDistance(DEFAULT_MAX_DISTANCE),
+    _voiceBackend(std::make_unique<MixerVoiceBackend>(_soundCache)),
+    _voiceManager(std::make_unique<Ego::Audio::VoiceManager>(*_voiceBackend)),
+    _listener()
 {
     _globalSounds.fill(INVALID_SOUND_ID);
 
@@ -148,17 +221,16 @@ void AudioSystem::loadGlobalSounds()
 
 AudioSystem::~AudioSystem()
 {
-    for (auto& music : _musicLoaded) {
-        Mix_FreeMusic(music.second);
+    if (_music) {
+        Mix_FreeMusic(_music);
+        _music = nullptr;
     }
-    _musicLoaded.clear();
+    _musicFiles.clear();
     _musicIDToNameMap.clear();
 
-    for (Mix_Chunk *chunk : _soundsLoaded)
-    {
-        Mix_FreeChunk(chunk);
-    }
-    _soundsLoaded.clear();
+    // Stop all channels before the sounds are freed.
+    _voiceManager->clear();
+    _soundCache.clear();
     _loopingSounds.clear();
 
 	Mix_CloseAudio();
@@ -167,6 +239,7 @@ AudioSystem::~AudioSystem()
 void AudioSystem::download(egoboo_config_t& cfg)
 {
     // Clear all data.
+    _voiceManager->clear();
     _loopingSounds.clear();
 
     // Restore audio if needed
@@ -192,12 +265,9 @@ void AudioSystem::download(egoboo_config_t& cfg)
         loadAllMusic();
 
         // Start playing queued/paused song.
-        if(!_currentSongPlaying.empty()) {
-            const auto& result = _musicLoaded.find(_currentSongPlaying);
-            if (result != _musicLoaded.end()) {
-                Mix_HaltMusic();
-                Mix_FadeInMusic(result->second, -1, 500);
-            }            
+        if(!_currentSongPlaying.empty() && _music) {
+            Mix_HaltMusic();
+            Mix_FadeInMusic(_music, -1, 500);
         }
     }
 }
@@ -224,43 +294,8 @@ SoundID AudioSystem::loadSound(const std::string &fileName)
         return INVALID_SOUND_ID;
     }
 
-    // blank out the data
-    std::string fullFileName;
-    Mix_Chunk* loadedSound = nullptr;
-    bool fileExists = false;
-
-    // try an ogg file
-    fullFileName = fileName + ".ogg";
-    if (vfs_exists(fullFileName.c_str()))
-    {
-        fileExists = true;
-        loadedSound = Mix_LoadWAV_RW(vfs_openRWopsRead(fullFileName.c_str()), 1);
-    }
-
-    //OGG failed, try WAV instead
-    if (nullptr == loadedSound)
-    {
-        fullFileName = fileName + ".wav";
-        if (vfs_exists(fullFileName.c_str()))
-        {
-            fileExists = true;
-            loadedSound = Mix_LoadWAV_RW(vfs_openRWopsRead(fullFileName.c_str()), 1);
-        }
-    }
-
-    if (nullptr == loadedSound)
-    {
-        // there is an error only if the file exists and can't be loaded
-        if (fileExists) {
-			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", fileName, "`: ", Mix_GetError(), Log::EndOfEntry);
-        }
-
-        return INVALID_SOUND_ID;
-    }
-
-    //Sound loaded!
-    _soundsLoaded.push_back(loadedSound);
-    return _soundsLoaded.size() - 1;
+    // The sound is decoded when it is played for the first time.
+    return _soundCache.load(fileName);
 }
 
 MusicID AudioSystem::loadMusic(const std::string &fileName)
@@ -270,18 +305,16 @@ MusicID AudioSystem::loadMusic(const std::string &fileName)
         return INVALID_SOUND_ID;
     }
 
-    Mix_Music* loadedMusic = Mix_LoadMUSType_RW(vfs_openRWopsRead(fileName.c_str()), MUS_NONE, 1);
-
-    if (!loadedMusic)
+    if (!vfs_exists(fileName))
     {
-		Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load music file", "`", fileName, "`: ", Mix_GetError(), Log::EndOfEntry);
+		Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load music file", "`", fileName, "`: ", "file does not exist", Log::EndOfEntry);
         return INVALID_SOUND_ID;
     }
 
-    // Got it!
+    // Got it! The file is opened and streamed when the song is played.
     const std::string songName = fileName.substr(fileName.find_last_of('/') + 1);
-    const MusicID id = _musicLoaded.size();
-    _musicLoaded[songName] = loadedMusic;
+    const MusicID id = _musicFiles.size();
+    _musicFiles[songName] = fileName;
     _musicIDToNameMap[id] = songName;
 
     return id;
@@ -304,19 +337,33 @@ void AudioSystem::playMusic(const std::string& songName, const uint16_t fadetime
     //Set music volume
     Mix_VolumeMusic(egoboo_config_t::get().sound_music_volume.getValue());
 
-    //Get the actual music data from the name of the song
-    const auto& result = _musicLoaded.find(songName);
-    if(result == _musicLoaded.end()) {
+    //Get the music file from the name of the song
+    const auto& result = _musicFiles.find(songName);
+    if(result == _musicFiles.end()) {
         Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to play music ", "`", songName, "`", ": ",
                                          "song name ", "`", songName, "`", " does not exist", Log::EndOfEntry);        
         return;
     }
 
+    // Open the song, SDL mixer decodes it from the file while it is playing.
+    Mix_Music* music = Mix_LoadMUSType_RW(vfs_openRWopsRead(result->second.c_str()), MUS_NONE, 1);
+    if (!music) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load music file", "`", result->second, "`: ",
+                                         Mix_GetError(), Log::EndOfEntry);
+        return;
+    }
+
     // Mix_FadeOutMusic(fadetime);      // Stops the game too
-    if (Mix_FadeInMusic(result->second, -1, fadetime) == -1) {
+    if (Mix_FadeInMusic(music, -1, fadetime) == -1) {
         Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to play music ", "`", songName, "`", ": ",
                                          Mix_GetError(), Log::EndOfEntry);
     }
+
+    // The previous song was halted by Mix_FadeInMusic.
+    if (_music) {
+        Mix_FreeMusic(_music);
+    }
+    _music = music;
 }
 
 void AudioSystem::playMusic(const int musicID, const uint16_t fadetime)
@@ -330,12 +377,12 @@ void AudioSystem::playMusic(const int musicID, const uint16_t fadetime)
 
 void AudioSystem::loadAllMusic()
 {
-    if (!_musicLoaded.empty() || !egoboo_config_t::get().sound_music_enable.getValue()) return;
+    if (!_musicFiles.empty() || !egoboo_config_t::get().sound_music_enable.getValue()) return;
 
     // Open the playlist listing all music files
     ReadContext ctxt("mp_data/music/playlist.txt");
 
-    // Load all music data into memory
+    // Register all music files
     while (ctxt.skipToColon(true))
     {
         std::string songName = vfs_read_name(ctxt);
@@ -355,44 +402,20 @@ void AudioSystem::loadAllMusic()
 
 void AudioSystem::updateLoopingSound(const std::shared_ptr<LoopingSound> &sound)
 {
-    int channel = sound->getChannel();
-
     //skip dead stuff
     if (!_currentModule->getObjectHandler().exists(sound->getOwnerRef())) {
 
         //Stop loop if we just died
-        if (channel != INVALID_SOUND_CHANNEL) {
-            Mix_HaltChannel(channel);
-            sound->setChannel(INVALID_SOUND_CHANNEL);
+        if (sound->getVoiceID() != Ego::Audio::VoiceManager::INVALID_VOICE_ID) {
+            _voiceManager->removeVoice(sound->getVoiceID());
+            sound->setVoiceID(Ego::Audio::VoiceManager::INVALID_VOICE_ID);
         }
 
         return;
     }
 
-    const Ego::Vector3f soundPosition = _currentModule->getObjectHandler().get(sound->getOwnerRef())->getPosition();
-    const float distance = getSoundDistance(soundPosition);
-
-    //Sound is close enough to be heard?
-    if (distance < _maxSoundDistance)
-    {
-        //No channel allocated to this sound yet? try to allocate a free one
-        if (channel == INVALID_SOUND_CHANNEL) {
-            channel = Mix_PlayChannel(-1, _soundsLoaded[sound->getSoundID()], -1);
-        }
-
-        //Update sound effects
-        if (channel != INVALID_SOUND_CHANNEL) {
-            mixAudioPosition3D(channel, distance, soundPosition);
-            sound->setChannel(channel);
-        }
-    }
-    else if (channel != INVALID_SOUND_CHANNEL)
-    {
-        //We are too far away to hear sound, stop it and free 
-        //channel until we come closer again
-        Mix_HaltChannel(channel);
-        sound->setChannel(INVALID_SOUND_CHANNEL);
-    }
+    // The voice manager decides whether the sound is audible and important enough for a channel.
+    _voiceManager->setVoicePosition(sound->getVoiceID(), _currentModule->getObjectHandler().get(sound->getOwnerRef())->getPosition());
 }
 
 void AudioSystem::updateLoopingSounds()
@@ -401,13 +424,46 @@ void AudioSystem::updateLoopingSounds()
     {
         updateLoopingSound(sound);
     }
+    _voiceManager->update(_listener, _maxSoundDistance);
+}
+
+void AudioSystem::updateListener()
+{
+    _listener.positions.clear();
+    _listener.averagePosition = idlib::zero<Ego::Vector2f>();
+    auto averageRotation = Ego::Turns(0.0f);
+
+    const auto& cameras = CameraSystem::get().getCameraList();
+    for (const std::shared_ptr<Camera> &camera : cameras) {
+        _listener.positions.emplace_back(camera->getCenter().x(), camera->getCenter().y(), camera->getPosition().z());
+        _listener.averagePosition.x() += camera->getCenter().x();
+        _listener.averagePosition.y() += camera->getCenter().y();
+        averageRotation += camera->getTurnZ_turns();
+    }
+    if (!cameras.empty()) {
+        _listener.averagePosition *= 1.0f / cameras.size();
+        averageRotation /= cameras.size();
+    }
+    _listener.averageRotation = idlib::semantic_cast<Ego::Radians>(averageRotation);
 }
 
 void AudioSystem::update()
 {
+    // Compute listener data once per frame, it is shared by all sounds.
+    updateListener();
     updateLoopingSounds();
 }
 
+const Ego::Audio::VoiceManager::Statistics& AudioSystem::getVoiceStatistics() const
+{
+    return _voiceManager->getStatistics();
+}
+
+const Ego::Audio::SoundCache::Statistics& AudioSystem::getSoundCacheStatistics() const
+{
+    return _soundCache.getStatistics();
+}
+
 size_t AudioSystem::stopObjectLoopingSounds(ObjectRef ownerRef, const SoundID soundID) {
 	if (!_currentModule->getObjectHandler().exists(ownerRef)) {
 		return 0;
@@ -429,7 +485,7 @@ size_t AudioSystem::stopObjectLoopingSounds(ObjectRef ownerRef, const SoundID so
     // Remove all looping sounds from list.
     for (const std::shared_ptr<LoopingSound> &sound : removeLoops) {
         _loopingSounds.remove(sound);
-        Mix_HaltChannel(sound->getChannel());
+        _voiceManager->removeVoice(sound->getVoiceID());
     }
 
     return removedLoopCount;
@@ -443,7 +499,7 @@ void AudioSystem::fadeAllSounds()
 
 int AudioSystem::playSoundFull(SoundID soundID)
 {
-    if (soundID < 0 || soundID >= _soundsLoaded.size())
+    if (!_soundCache.isValid(soundID))
     {
         return INVALID_SOUND_CHANNEL;
     }
@@ -453,60 +509,8 @@ int AudioSystem::playSoundFull(SoundID soundID)
         return INVALID_SOUND_CHANNEL;
     }
 
-    // play the sound
-    int channel = Mix_PlayChannel(-1, _soundsLoaded[soundID], 0);
-
-    if (channel != INVALID_SOUND_CHANNEL) {
-        //remove any 3D positional mixing effects
-        Mix_SetPosition(channel, 0, 0);
-
-        // we are still limited by the global sound volume
-        Mix_Volume(channel, (128 * egoboo_config_t::get().sound_effects_volume.getValue()) / 100);
-    }
-
-    return channel;
-}
-
-float AudioSystem::getSoundDistance(const Ego::Vector3f& soundPosition)
-{
-    //Pick the camera that is nearest to the sound
-    float distance = std::numeric_limits<float>::max();
-    for(const std::shared_ptr<Camera> &camera : CameraSystem::get().getCameraList()) {
-        Ego::Vector3f cameraPosition = Ego::Vector3f(camera->getCenter().x(), camera->getCenter().y(), camera->getPosition().z());
-		distance = std::min(distance, idlib::euclidean_norm(cameraPosition - soundPosition));
-    }
-
-    //Calculate distance between camera and sound origin
-    return distance;
-}
-
-void AudioSystem::mixAudioPosition3D(const int channel, float distance, const Ego::Vector3f& soundPosition)
-{
-    //Calculate the average position and rotation of all cameras
-    Ego::Vector2f averageCameraPosition = idlib::zero<Ego::Vector2f>();
-    auto averageRotation = Ego::Turns(0.0f);
-    for(const std::shared_ptr<Camera>& camera : CameraSystem::get().getCameraList()) {
-        averageCameraPosition.x() += camera->getCenter().x();
-        averageCameraPosition.y() += camera->getCenter().y();
-        averageRotation += camera->getTurnZ_turns();
-    }
-    averageCameraPosition *= 1.0f / CameraSystem::get().getCameraList().size();
-    averageRotation /= CameraSystem::get().getCameraList().size();
-
-    //Scale distance (0 is very close 255 is very far away)
-    distance *= 255.0f / _maxSoundDistance;
-
-    //Calculate angle from camera to sound origin
-    auto angle = Ego::Radians(std::atan2(averageCameraPosition.y() - soundPosition.y(), averageCameraPosition.x() - soundPosition.x()));
-
-    //Adjust for camera rotation
-    angle += idlib::semantic_cast<Ego::Radians>(averageRotation);
-
-    //limited global sound volume
-    Mix_Volume(channel, (128 * egoboo_config_t::get().sound_effects_volume.getValue()) / 100);
-
-    //Do 3D sound mixing
-    Mix_SetPosition(channel, float(idlib::semantic_cast<Ego::Degrees>(angle)), distance);
+    // play the sound, non-positional sounds have the highest priority
+    return _voiceManager->playOneShot(soundID);
 }
 
 void AudioSystem::playSoundLooped(const SoundID soundID, ObjectRef ownerRef)
@@ -517,7 +521,7 @@ void AudioSystem::playSoundLooped(const SoundID soundID, ObjectRef ownerRef)
     }
 
     // Check for invalid sounds
-    if (soundID < 0 || soundID >= _soundsLoaded.size()) {
+    if (!_soundCache.isValid(soundID)) {
         return;
     }
 
@@ -531,18 +535,23 @@ void AudioSystem::playSoundLooped(const SoundID soundID, ObjectRef ownerRef)
 
     //Create new looping sound
     std::shared_ptr<LoopingSound> sound = std::make_shared<LoopingSound>(ownerRef, soundID);
+    sound->setVoiceID(_voiceManager->addLoopingVoice(soundID, _currentModule->getObjectHandler().get(ownerRef)->getPosition(),
+                                                     Ego::Audio::VoicePriority::Normal));
 
     // add the sound to the LoopedList
     _loopingSounds.push_front(sound);
 
     //First time update
-    updateLoopingSound(sound);
+    if (_listener.positions.empty()) {
+        updateListener();
+    }
+    _voiceManager->update(_listener, _maxSoundDistance);
 }
 
-int AudioSystem::playSound(const Ego::Vector3f& snd_pos, const SoundID soundID)
+int AudioSystem::playSound(const Ego::Vector3f& snd_pos, const SoundID soundID, Ego::Audio::VoicePriority priority)
 {
     // If the sound ID is not valid ...
-    if (soundID < 0 || soundID >= _soundsLoaded.size())
+    if (!_soundCache.isValid(soundID))
     {
         // ... return invalid channel.
         return INVALID_SOUND_CHANNEL;
@@ -555,31 +564,14 @@ int AudioSystem::playSound(const Ego::Vector3f& snd_pos, const SoundID soundID)
         return INVALID_SOUND_CHANNEL;
     }
 
-    // Get distance from sound to camera.
-    float distance = getSoundDistance(snd_pos);
-
-    // Outside hearing distance?
-    if (distance > _maxSoundDistance)
-    {
-        return INVALID_SOUND_CHANNEL;
-    }
-
-    // Play the sound once
-    int channel = Mix_PlayChannel(-1, _soundsLoaded[soundID], 0);
-
-    // could fail if no free channels are available.
-    if (INVALID_SOUND_CHANNEL != channel)
-    {
-        // Apply 3D positional sound effect.
-        mixAudioPosition3D(channel, distance, snd_pos);
-    }
-    else
-    {
-        /// @note ZF@> disabled this warning because this happens really often
-        //log_debug( "Unable to play sound. (%s)\n", Mix_GetError() );
+    // No update this frame yet?
+    if (_listener.positions.empty()) {
+        updateListener();
     }
 
-    return channel;
+    // Culls sounds outside of the hearing distance and could fail if no channel is available
+    // for a sound of this priority.
+    return _voiceManager->playOneShot(soundID, snd_pos, priority, _listener, _maxSoundDistance);
 }
 
 void AudioSystem::setMaxHearingDistance(const float distance)
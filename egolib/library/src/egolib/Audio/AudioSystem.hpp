@@ -24,19 +24,15 @@
 #include <SDL_mixer.h>
 #include "egolib/egoboo_setup.h"
 #include "egolib/Math/_Include.hpp"
-
-typedef int MusicID;
-typedef int SoundID;
-
-static constexpr int INVALID_SOUND_CHANNEL = -1;
-static constexpr SoundID INVALID_SOUND_ID = -1;
+#include "egolib/Audio/VoiceManager.hpp"
+#include "egolib/Audio/SoundCache.hpp"
 
 /// Data needed to store and manipulate a looped sound
 class LoopingSound
 {
 public:
     LoopingSound(ObjectRef ownerRef, SoundID soundID) :
-        _channel(INVALID_SOUND_CHANNEL),
+        _voiceID(Ego::Audio::VoiceManager::INVALID_VOICE_ID),
         _ownerRef(ownerRef),
         _soundID(soundID)
     {
@@ -46,9 +42,9 @@ public:
     LoopingSound(const LoopingSound&) = delete;
     LoopingSound& operator=(const LoopingSound&) = delete;
 
-    inline int getChannel() const
+    inline Ego::Audio::VoiceManager::VoiceID getVoiceID() const
     {
-        return _channel;
+        return _voiceID;
     }
     
     inline const ObjectRef& getOwnerRef() const
@@ -56,9 +52,9 @@ public:
         return _ownerRef; // Immutable object references can be returned by constant reference.
     }
     
-    inline void setChannel(int channel)
+    inline void setVoiceID(Ego::Audio::VoiceManager::VoiceID voiceID)
     {
-        _channel = channel;
+        _voiceID = voiceID;
     }
 
     inline SoundID getSoundID() const
@@ -68,7 +64,7 @@ public:
 
 
 private:
-    int _channel;
+    Ego::Audio::VoiceManager::VoiceID _voiceID;
     const ObjectRef _ownerRef;
     const SoundID _soundID;
 };
@@ -149,20 +145,31 @@ public:
 
     /**
     * @author ZF
-    * @details This functions plays a specified track loaded into memory
+    * @details This functions plays a specified track, streaming it from its file
     **/
     void playMusic(const MusicID musicID, const uint16_t fadetime = 0);
 
     /**
     * @author ZF
-    * @details This functions plays a specified track loaded into memory
+    * @details This functions plays a specified track, streaming it from its file
     **/
     void playMusic(const std::string& songName, const uint16_t fadetime = 0);
 
+    /**
+     * @brief
+     *  Load a sound.
+     * @param fileName
+     *  the file name of the sound without extension
+     * @return
+     *  the sound ID, INVALID_SOUND_ID if the sound does not exist
+     * @remark
+     *  The sound is shared with all other loads of the same file (or of a file with the same contents)
+     *  and decoded when it is played for the first time.
+     */
     SoundID loadSound(const std::string &fileName);
 
     /// @author ZF
-    /// @details This function loads all of the music sounds
+    /// @details This function registers all of the music tracks. The tracks are opened when played.
     void loadAllMusic();
 
     /**
@@ -173,6 +180,18 @@ public:
 
     void update();
 
+    /**
+     * @brief
+     *  Get the voice manager statistics of the last update.
+     */
+    const Ego::Audio::VoiceManager::Statistics& getVoiceStatistics() const;
+
+    /**
+     * @brief
+     *  Get the sound cache statistics.
+     */
+    const Ego::Audio::SoundCache::Statistics& getSoundCacheStatistics() const;
+
     /**
      * @brief
 	 *  Stop looping of sounds of an specified owner.
@@ -204,10 +223,13 @@ public:
 	 *  the position
 	 * @param soundID
 	 *  the sound ID
+	 * @param priority
+	 *  the priority of the sound. If all channels are busy, the sound takes the channel of a less important sound.
 	 * @return
 	 *  the channel the sound is played over
 	 */
-    int playSound(const Ego::Vector3f& position, const SoundID soundID);
+    int playSound(const Ego::Vector3f& position, const SoundID soundID,
+                  Ego::Audio::VoicePriority priority = Ego::Audio::VoicePriority::Normal);
 
     /**
      * @brief
@@ -258,30 +280,15 @@ public:
 
 private:
     /**
-    * @brief Loads one music track. Returns nullptr if it fails
+    * @brief Registers one music track. Returns INVALID_SOUND_ID if the file does not exist
     **/
     MusicID loadMusic(const std::string &fileName);
 
-    /**
-     * @brief applies 3D spatial effect to the specified sound (using volume and panning)
-     * @param channel
-     *  the channel
-     * @param distance
-     *  the distance between the sound origin and the listener
-     * @param soundPosition
-     *  the sound origin
-     */
-    void mixAudioPosition3D(const int channel, float distance, const Ego::Vector3f& soundPosition);
-
     /**
      * @brief
-     *  Calculates distance between the sound origin and the players.
-     * @param soundPosition
-     *  the sound origin
-     * @return
-     *  the distance between the sound origin and the players
+     *  Gather the listener data (camera positions and rotations) for this frame.
      */
-    float getSoundDistance(const Ego::Vector3f& soundPosition);
+    void updateListener();
 
     /**
      * @brief
@@ -292,12 +299,17 @@ private:
     void updateLoopingSound(const std::shared_ptr<LoopingSound>& sound);
 
 private:
-    std::unordered_map<std::string, Mix_Music*> _musicLoaded;    //Maps song names to music data
+    std::unordered_map<std::string, std::string> _musicFiles;     //Maps song names to music file names
     std::unordered_map<MusicID, std::string> _musicIDToNameMap;   //Maps MusicID to song names
-    std::vector<Mix_Chunk*> _soundsLoaded;
+    Mix_Music* _music;                                            //The music track currently streamed
+    Ego::Audio::SoundCache _soundCache;
     std::array<SoundID, GSND_COUNT> _globalSounds;
 
     std::forward_list<std::shared_ptr<LoopingSound>> _loopingSounds;
     std::string _currentSongPlaying;
     float _maxSoundDistance;                                            ///< How far away can we hear sound effects?
+
+    std::unique_ptr<Ego::Audio::VoiceBackend> _voiceBackend;            ///< SDL mixer channels
+    std::unique_ptr<Ego::Audio::VoiceManager> _voiceManager;            ///< Decides which sounds get a channel
+    Ego::Audio::AudioListener _listener;                                ///< The listener of the current frame
 };
@@ -0,0 +1,255 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/SoundCache.cpp
+/// @brief Content-addressed cache of sound effects which are decoded on first use.
+
+#include "egolib/Audio/SoundCache.hpp"
+
+#include "egolib/vfs.h"
+
+namespace Ego {
+namespace Audio {
+
+namespace {
+
+/// Reads the sound files from the vfs. The generation changes whenever a mount point is added or removed.
+class VfsSoundSource : public SoundSource
+{
+public:
+    uint32_t getGeneration() const override
+    {
+        return vfs_getMountGeneration();
+    }
+
+    bool exists(const std::string& pathname) const override
+    {
+        return vfs_exists(pathname);
+    }
+
+    void read(const std::string& pathname, std::function<void(size_t, const char *)> receive) const override
+    {
+        vfs_readEntireFile(pathname, receive);
+    }
+
+    SDL_RWops *open(const std::string& pathname) const override
+    {
+        return vfs_openRWopsRead(pathname);
+    }
+};
+
+} // namespace
+
+SoundCache::SoundCache(size_t budget) :
+    SoundCache(std::make_unique<VfsSoundSource>(), budget)
+{}
+
+SoundCache::SoundCache(std::unique_ptr<SoundSource> source, size_t budget) :
+    _source(std::move(source)),
+    _budget(budget),
+    _entries(),
+    _pathnameToSound(),
+    _mountGeneration(_source->getGeneration()),
+    _hashToSound(),
+    _resident(),
+    _statistics()
+{}
+
+SoundCache::~SoundCache()
+{
+    clear();
+}
+
+uint64_t SoundCache::hashFile(const std::string& pathname)
+{
+    // 64 bit FNV-1a over the contents, finished with the length.
+    uint64_t hash = 14695981039346656037ULL;
+    uint64_t length = 0;
+    _source->read(pathname, [&hash, &length](size_t size, const char *bytes) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<uint8_t>(bytes[i]);
+            hash *= 1099511628211ULL;
+        }
+        length += size;
+    });
+    hash ^= length;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+void SoundCache::checkMountGeneration()
+{
+    const uint32_t mountGeneration = _source->getGeneration();
+    if (mountGeneration != _mountGeneration) {
+        _pathnameToSound.clear();
+        _mountGeneration = mountGeneration;
+    }
+}
+
+SoundID SoundCache::load(const std::string& fileName)
+{
+    checkMountGeneration();
+
+    // Prefer an OGG file over a WAV file.
+    std::string pathname = fileName + ".ogg";
+    if (!_source->exists(pathname)) {
+        pathname = fileName + ".wav";
+        if (!_source->exists(pathname)) {
+            return INVALID_SOUND_ID;
+        }
+    }
+
+    // Same file name?
+    const auto byName = _pathnameToSound.find(pathname);
+    if (byName != _pathnameToSound.end()) {
+        _statistics.sharedLoads++;
+        return byName->second;
+    }
+
+    // Same contents?
+    uint64_t hash;
+    try {
+        hash = hashFile(pathname);
+    } catch (const idlib::runtime_error& ex) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", pathname, "`: ", ex.what(), Log::EndOfEntry);
+        return INVALID_SOUND_ID;
+    }
+    const auto byHash = _hashToSound.find(hash);
+    if (byHash != _hashToSound.end()) {
+        // The old file name of the sound might refer to another file by now, decode from this one.
+        Entry& entry = _entries[byHash->second];
+        if (entry.mountGeneration != _mountGeneration) {
+            entry.pathname = pathname;
+            entry.mountGeneration = _mountGeneration;
+            entry.failed = false;
+        }
+        _pathnameToSound[pathname] = byHash->second;
+        _statistics.sharedLoads++;
+        return byHash->second;
+    }
+
+    // A new sound.
+    const SoundID soundID = static_cast<SoundID>(_entries.size());
+    _entries.push_back(Entry{ pathname, hash, _mountGeneration, nullptr, false, _resident.end() });
+    _pathnameToSound[pathname] = soundID;
+    _hashToSound[hash] = soundID;
+    _statistics.sounds = _entries.size();
+    return soundID;
+}
+
+bool SoundCache::isValid(SoundID soundID) const
+{
+    return soundID >= 0 && static_cast<size_t>(soundID) < _entries.size();
+}
+
+Mix_Chunk *SoundCache::acquire(SoundID soundID, const std::function<bool(SoundID)>& isPlaying)
+{
+    if (!isValid(soundID)) {
+        return nullptr;
+    }
+    Entry& entry = _entries[soundID];
+
+    // Already decoded? Mark it as most recently used.
+    if (nullptr != entry.chunk) {
+        _resident.splice(_resident.begin(), _resident, entry.residentPosition);
+        return entry.chunk;
+    }
+    if (entry.failed) {
+        return nullptr;
+    }
+
+    // Does the file name still refer to the contents of the sound?
+    const uint32_t mountGeneration = _source->getGeneration();
+    if (entry.mountGeneration != mountGeneration) {
+        bool unchanged = false;
+        try {
+            unchanged = _source->exists(entry.pathname) && hashFile(entry.pathname) == entry.hash;
+        } catch (const idlib::runtime_error&) {
+        }
+        if (!unchanged) {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", entry.pathname, "`: ", "the file has been replaced by remounting", Log::EndOfEntry);
+            entry.failed = true;
+            return nullptr;
+        }
+        entry.mountGeneration = mountGeneration;
+    }
+
+    // Decode it.
+    entry.chunk = Mix_LoadWAV_RW(_source->open(entry.pathname), 1);
+    if (nullptr == entry.chunk) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load sound file ", "`", entry.pathname, "`: ", Mix_GetError(), Log::EndOfEntry);
+        entry.failed = true;
+        return nullptr;
+    }
+    _resident.push_front(soundID);
+    entry.residentPosition = _resident.begin();
+    _statistics.decodes++;
+    _statistics.residentSounds++;
+    _statistics.residentBytes += entry.chunk->alen;
+
+    evict(soundID, isPlaying);
+    return entry.chunk;
+}
+
+void SoundCache::evict(SoundID keep, const std::function<bool(SoundID)>& isPlaying)
+{
+    auto it = _resident.end();
+    while (_statistics.residentBytes > _budget && it != _resident.begin()) {
+        --it;
+        const SoundID soundID = *it;
+        if (soundID == keep || isPlaying(soundID)) {
+            continue;
+        }
+        // Continue from the successor, the element is erased.
+        it = std::next(it);
+        release(soundID);
+        _statistics.evictions++;
+    }
+}
+
+void SoundCache::release(SoundID soundID)
+{
+    Entry& entry = _entries[soundID];
+    _statistics.residentSounds--;
+    _statistics.residentBytes -= entry.chunk->alen;
+    Mix_FreeChunk(entry.chunk);
+    entry.chunk = nullptr;
+    _resident.erase(entry.residentPosition);
+    entry.residentPosition = _resident.end();
+}
+
+void SoundCache::setBudget(size_t budget)
+{
+    _budget = budget;
+}
+
+void SoundCache::clear()
+{
+    while (!_resident.empty()) {
+        release(_resident.front());
+    }
+    _entries.clear();
+    _pathnameToSound.clear();
+    _mountGeneration = _source->getGeneration();
+    _hashToSound.clear();
+    _statistics = Statistics();
+}
+
+} // namespace Audio
+} // namespace Ego
@@ -0,0 +1,201 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/SoundCache.hpp
+/// @brief Content-addressed cache of sound effects which are decoded on first use.
+
+#pragma once
+
+#include <SDL_mixer.h>
+#include "egolib/egoboo_setup.h"
+#include "egolib/Audio/VoiceManager.hpp"
+
+namespace Ego {
+namespace Audio {
+
+/**
+ * @brief
+ *  The interface to the files used by the sound cache.
+ *  The default implementation is using the vfs, tests are using fake files.
+ */
+class SoundSource
+{
+public:
+    virtual ~SoundSource() {}
+
+    /// @return a number which changes whenever a file name might start to refer to another file
+    virtual uint32_t getGeneration() const = 0;
+
+    /// @return @a true if the specified file exists
+    virtual bool exists(const std::string& pathname) const = 0;
+
+    /// @brief Read the entire contents of the specified file.
+    /// @throw idlib::runtime_error if the file can not be read
+    virtual void read(const std::string& pathname, std::function<void(size_t, const char *)> receive) const = 0;
+
+    /// @return the opened file, @a nullptr on failure
+    virtual SDL_RWops *open(const std::string& pathname) const = 0;
+};
+
+/**
+ * @brief
+ *  A cache of sound effects.
+ *  Sounds are identified by their file name and by the hash of their file contents,
+ *  such that a sound shared by many object profiles is only loaded once.
+ *  File names are only trusted until the vfs mount points change, e.g. when another module
+ *  is mounted at <c>mp_objects</c>, afterwards the contents decide.
+ *  Loading a sound only registers it, the sound is decoded when it is played for the first time.
+ *  Decoded sounds which are not playing are evicted in least recently used order
+ *  if the decoded sounds exceed the memory budget.
+ */
+class SoundCache : private idlib::non_copyable
+{
+public:
+    /// The default memory budget for decoded sounds.
+    static constexpr size_t DEFAULT_BUDGET = 32 * 1024 * 1024;
+
+    /**
+     * @brief
+     *  Statistics of the sound cache.
+     */
+    struct Statistics
+    {
+        size_t sounds;          ///< Number of distinct sounds
+        size_t sharedLoads;     ///< Number of loads which were satisfied by an existing sound
+        size_t residentSounds;  ///< Number of decoded sounds
+        size_t residentBytes;   ///< Size of the decoded sounds in Bytes
+        size_t decodes;         ///< Number of sounds decoded
+        size_t evictions;       ///< Number of decoded sounds evicted
+    };
+
+    /**
+     * @brief
+     *  Construct this sound cache.
+     * @param budget
+     *  the memory budget for decoded sounds in Bytes
+     */
+    SoundCache(size_t budget = DEFAULT_BUDGET);
+
+    /**
+     * @brief
+     *  Construct this sound cache reading its files from the specified source.
+     * @param source
+     *  the source of the sound files
+     * @param budget
+     *  the memory budget for decoded sounds in Bytes
+     */
+    SoundCache(std::unique_ptr<SoundSource> source, size_t budget = DEFAULT_BUDGET);
+
+    /**
+     * @brief
+     *  Destruct this sound cache, freeing all decoded sounds.
+     */
+    ~SoundCache();
+
+    /**
+     * @brief
+     *  Register a sound.
+     * @param fileName
+     *  the file name of the sound without extension. A ".ogg" file is preferred over a ".wav" file.
+     * @return
+     *  the ID of the sound, INVALID_SOUND_ID if no such file exists or the file can not be read
+     */
+    SoundID load(const std::string& fileName);
+
+    /**
+     * @brief
+     *  Get if a sound ID refers to a sound of this cache.
+     */
+    bool isValid(SoundID soundID) const;
+
+    /**
+     * @brief
+     *  Get the decoded sound, decoding it if necessary.
+     *  This might evict other decoded sounds.
+     * @param soundID
+     *  the ID of the sound
+     * @param isPlaying
+     *  a function which returns @a true if a sound is currently playing. Playing sounds are not evicted.
+     * @return
+     *  the decoded sound, @a nullptr if the sound ID is invalid or the sound can not be decoded
+     */
+    Mix_Chunk *acquire(SoundID soundID, const std::function<bool(SoundID)>& isPlaying);
+
+    /**
+     * @brief
+     *  Set the memory budget for decoded sounds.
+     * @param budget
+     *  the memory budget in Bytes
+     */
+    void setBudget(size_t budget);
+
+    /**
+     * @brief
+     *  Free all decoded sounds and forget all sounds.
+     * @warning
+     *  The sounds must not be playing.
+     */
+    void clear();
+
+    const Statistics& getStatistics() const { return _statistics; }
+
+private:
+    struct Entry
+    {
+        /// The file name of the sound (including the extension).
+        std::string pathname;
+        /// The hash of the file contents.
+        uint64_t hash;
+        /// The generation of the source in which the file name was known to refer to these contents.
+        uint32_t mountGeneration;
+        /// The decoded sound or @a nullptr.
+        Mix_Chunk *chunk;
+        /// Did decoding fail? If so, decoding is not tried again.
+        bool failed;
+        /// The position in the list of decoded sounds if decoded.
+        std::list<SoundID>::iterator residentPosition;
+    };
+
+    /// @brief Compute the hash of the contents of a file.
+    uint64_t hashFile(const std::string& pathname);
+
+    /// @brief Forget the file names if the generation of the source changed since the last load.
+    void checkMountGeneration();
+
+    /// @brief Evict decoded sounds until the budget is met.
+    void evict(SoundID keep, const std::function<bool(SoundID)>& isPlaying);
+
+    /// @brief Free the decoded sound of an entry.
+    void release(SoundID soundID);
+
+    std::unique_ptr<SoundSource> _source;
+    size_t _budget;
+    std::vector<Entry> _entries;
+    /// Maps file names to sounds, valid for the generation _mountGeneration of the source.
+    std::unordered_map<std::string, SoundID> _pathnameToSound;
+    uint32_t _mountGeneration;
+    /// Maps file content hashes to sounds.
+    std::unordered_map<uint64_t, SoundID> _hashToSound;
+    /// The decoded sounds, most recently used first.
+    std::list<SoundID> _resident;
+    Statistics _statistics;
+};
+
+} // namespace Audio
+} // namespace Ego
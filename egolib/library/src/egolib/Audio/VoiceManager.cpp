@@ -0,0 +1,294 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/VoiceManager.cpp
+/// @brief Virtual voices with priorities which compete for a limited number of mixer channels.
+
+#include "egolib/Audio/VoiceManager.hpp"
+
+namespace Ego {
+namespace Audio {
+
+/// Changes of the angle (in degrees) or the scaled distance below these thresholds are not audible.
+static constexpr float ANGLE_TOLERANCE = 2.0f;
+static constexpr float DISTANCE_TOLERANCE = 2.0f;
+
+AudioListener::AudioListener() :
+    positions(),
+    averagePosition(idlib::zero<Vector2f>()),
+    averageRotation(0.0f)
+{}
+
+float AudioListener::getDistance(const Vector3f& soundPosition) const
+{
+    //Pick the listener that is nearest to the sound
+    float distance = std::numeric_limits<float>::max();
+    for (const auto& position : positions) {
+        distance = std::min(distance, idlib::euclidean_norm(position - soundPosition));
+    }
+    return distance;
+}
+
+float AudioListener::getAngle(const Vector3f& soundPosition) const
+{
+    //Calculate angle from listener to sound origin and adjust for listener rotation
+    auto angle = Radians(std::atan2(averagePosition.y() - soundPosition.y(), averagePosition.x() - soundPosition.x()));
+    angle += averageRotation;
+    return float(idlib::semantic_cast<Degrees>(angle));
+}
+
+VoiceManager::VoiceManager(VoiceBackend& backend) :
+    _backend(backend),
+    _voices(),
+    _channels(),
+    _nextVoiceID(INVALID_VOICE_ID + 1),
+    _statistics()
+{}
+
+float VoiceManager::getScore(VoicePriority priority, float distance, float maxDistance)
+{
+    // The priority dominates, the proximity breaks ties within a priority.
+    const float proximity = maxDistance > 0.0f ? 1.0f - Math::constrain(distance / maxDistance, 0.0f, 1.0f) : 0.0f;
+    return static_cast<float>(priority) + proximity;
+}
+
+void VoiceManager::refreshChannels()
+{
+    const size_t channelCount = static_cast<size_t>(std::max(0, _backend.getChannelCount()));
+
+    // Channels were removed: unbind anything that played on them.
+    for (size_t channel = channelCount; channel < _channels.size(); ++channel) {
+        if (_channels[channel].voiceID != INVALID_VOICE_ID) {
+            _voices[_channels[channel].voiceID].channel = INVALID_SOUND_CHANNEL;
+        }
+    }
+    _channels.resize(channelCount, Channel{ INVALID_VOICE_ID, false, 0.0f });
+
+    // Free channels of finished one-shot sounds.
+    for (size_t channel = 0; channel < _channels.size(); ++channel) {
+        if (_channels[channel].oneShot && !_backend.isPlaying(static_cast<int>(channel))) {
+            _channels[channel].oneShot = false;
+            _channels[channel].score = 0.0f;
+        }
+    }
+}
+
+int VoiceManager::acquireChannel(float score)
+{
+    int victim = INVALID_SOUND_CHANNEL;
+    for (size_t channel = 0; channel < _channels.size(); ++channel) {
+        const Channel& slot = _channels[channel];
+        if (!slot.oneShot && slot.voiceID == INVALID_VOICE_ID) {
+            return static_cast<int>(channel);
+        }
+        // Remember the least important channel.
+        if (victim == INVALID_SOUND_CHANNEL || slot.score < _channels[victim].score) {
+            victim = static_cast<int>(channel);
+        }
+    }
+
+    // No free channel, steal the least important one if we are more important.
+    if (victim != INVALID_SOUND_CHANNEL && _channels[victim].score < score) {
+        releaseChannel(victim);
+        return victim;
+    }
+    return INVALID_SOUND_CHANNEL;
+}
+
+void VoiceManager::releaseChannel(int channel)
+{
+    Channel& slot = _channels[channel];
+    if (slot.voiceID != INVALID_VOICE_ID) {
+        // The looping voice becomes virtual again.
+        _voices[slot.voiceID].channel = INVALID_SOUND_CHANNEL;
+    }
+    _backend.halt(channel);
+    slot = Channel{ INVALID_VOICE_ID, false, 0.0f };
+}
+
+void VoiceManager::applyPosition(Voice& voice, const AudioListener& listener, float distance, float maxDistance, bool force)
+{
+    //Scale distance (0 is very close 255 is very far away)
+    const float scaledDistance = distance * 255.0f / maxDistance;
+    const float angle = listener.getAngle(voice.position);
+    if (!force && std::abs(angle - voice.lastAngle) < ANGLE_TOLERANCE && std::abs(scaledDistance - voice.lastDistance) < DISTANCE_TOLERANCE) {
+        return;
+    }
+    _backend.setPosition(voice.channel, angle, scaledDistance);
+    voice.lastAngle = angle;
+    voice.lastDistance = scaledDistance;
+    _statistics.positionUpdates++;
+}
+
+int VoiceManager::playOneShot(SoundID soundID, const Vector3f& position, VoicePriority priority,
+                              const AudioListener& listener, float maxDistance)
+{
+    // Outside hearing distance?
+    const float distance = listener.getDistance(position);
+    if (distance > maxDistance) {
+        return INVALID_SOUND_CHANNEL;
+    }
+
+    refreshChannels();
+    const float score = getScore(priority, distance, maxDistance);
+    const int channel = acquireChannel(score);
+    if (channel == INVALID_SOUND_CHANNEL || !_backend.play(channel, soundID, false)) {
+        _statistics.droppedSounds++;
+        return INVALID_SOUND_CHANNEL;
+    }
+    _channels[channel] = Channel{ INVALID_VOICE_ID, true, score };
+    _backend.setPosition(channel, listener.getAngle(position), distance * 255.0f / maxDistance);
+    return channel;
+}
+
+int VoiceManager::playOneShot(SoundID soundID)
+{
+    refreshChannels();
+    const float score = getScore(VoicePriority::Interface, 0.0f, 1.0f);
+    const int channel = acquireChannel(score);
+    if (channel == INVALID_SOUND_CHANNEL || !_backend.play(channel, soundID, false)) {
+        _statistics.droppedSounds++;
+        return INVALID_SOUND_CHANNEL;
+    }
+    _channels[channel] = Channel{ INVALID_VOICE_ID, true, score };
+    //remove any 3D positional mixing effects
+    _backend.setPosition(channel, 0.0f, 0.0f);
+    return channel;
+}
+
+VoiceManager::VoiceID VoiceManager::addLoopingVoice(SoundID soundID, const Vector3f& position, VoicePriority priority)
+{
+    const VoiceID voiceID = _nextVoiceID++;
+    if (_nextVoiceID == INVALID_VOICE_ID) {
+        _nextVoiceID++;
+    }
+    _voices[voiceID] = Voice{ soundID, position, priority, INVALID_SOUND_CHANNEL, 0.0f, 0.0f, 0.0f };
+    return voiceID;
+}
+
+void VoiceManager::setVoicePosition(VoiceID voiceID, const Vector3f& position)
+{
+    const auto it = _voices.find(voiceID);
+    if (it != _voices.end()) {
+        it->second.position = position;
+    }
+}
+
+void VoiceManager::removeVoice(VoiceID voiceID)
+{
+    const auto it = _voices.find(voiceID);
+    if (it == _voices.end()) {
+        return;
+    }
+    if (it->second.channel != INVALID_SOUND_CHANNEL) {
+        releaseChannel(it->second.channel);
+    }
+    _voices.erase(it);
+}
+
+void VoiceManager::clear()
+{
+    for (size_t channel = 0; channel < _channels.size(); ++channel) {
+        if (_channels[channel].voiceID != INVALID_VOICE_ID || _channels[channel].oneShot) {
+            _backend.halt(static_cast<int>(channel));
+        }
+    }
+    _channels.clear();
+    _voices.clear();
+}
+
+int VoiceManager::getChannel(VoiceID voiceID) const
+{
+    const auto it = _voices.find(voiceID);
+    return it != _voices.end() ? it->second.channel : INVALID_SOUND_CHANNEL;
+}
+
+void VoiceManager::update(const AudioListener& listener, float maxDistance)
+{
+    _statistics.positionUpdates = 0;
+    refreshChannels();
+
+    // Compute the importance of every looping voice and cull inaudible ones.
+    std::vector<std::pair<float, VoiceID>> audible;
+    audible.reserve(_voices.size());
+    for (auto& element : _voices) {
+        Voice& voice = element.second;
+        const float distance = listener.getDistance(voice.position);
+        if (distance >= maxDistance) {
+            //We are too far away to hear the sound, free the channel until we come closer again
+            if (voice.channel != INVALID_SOUND_CHANNEL) {
+                releaseChannel(voice.channel);
+            }
+            continue;
+        }
+        voice.score = getScore(voice.priority, distance, maxDistance);
+        audible.emplace_back(voice.score, element.first);
+    }
+
+    // Most important first, ties broken by voice ID so that the result is deterministic.
+    std::sort(audible.begin(), audible.end(), [](const std::pair<float, VoiceID>& a, const std::pair<float, VoiceID>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+
+    // Only as many voices as there are channels not occupied by one-shots can be bound.
+    size_t available = 0;
+    for (const Channel& channel : _channels) {
+        if (!channel.oneShot) available++;
+    }
+
+    // Unbind the voices which did not make the cut first, so their channels can be reused.
+    for (size_t i = available; i < audible.size(); ++i) {
+        Voice& voice = _voices[audible[i].second];
+        if (voice.channel != INVALID_SOUND_CHANNEL) {
+            releaseChannel(voice.channel);
+        }
+    }
+
+    // Bind and position the winners.
+    size_t bound = 0;
+    for (size_t i = 0; i < std::min(available, audible.size()); ++i) {
+        const VoiceID voiceID = audible[i].second;
+        Voice& voice = _voices[voiceID];
+        const float distance = listener.getDistance(voice.position);
+        bool force = false;
+        if (voice.channel == INVALID_SOUND_CHANNEL) {
+            const int channel = acquireChannel(voice.score);
+            if (channel == INVALID_SOUND_CHANNEL || !_backend.play(channel, voice.soundID, true)) {
+                continue;
+            }
+            voice.channel = channel;
+            force = true;
+        }
+        _channels[voice.channel] = Channel{ voiceID, false, voice.score };
+        applyPosition(voice, listener, distance, maxDistance, force);
+        bound++;
+    }
+
+    size_t oneShots = 0;
+    for (const Channel& channel : _channels) {
+        if (channel.oneShot) oneShots++;
+    }
+    _statistics.virtualVoices = _voices.size();
+    _statistics.boundVoices = bound;
+    _statistics.oneShotVoices = oneShots;
+    _statistics.droppedSounds = 0;
+}
+
+} // namespace Audio
+} // namespace Ego
@@ -0,0 +1,242 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Audio/VoiceManager.hpp
+/// @brief Virtual voices with priorities which compete for a limited number of mixer channels.
+
+#pragma once
+
+#include "egolib/Math/_Include.hpp"
+
+typedef int MusicID;
+typedef int SoundID;
+
+static constexpr int INVALID_SOUND_CHANNEL = -1;
+static constexpr SoundID INVALID_SOUND_ID = -1;
+
+namespace Ego {
+namespace Audio {
+
+/**
+ * @brief
+ *  How important a sound is. If all channels are in use, a more important sound
+ *  takes the channel of a less important one. Within the same priority, closer
+ *  sounds are more important than sounds far away.
+ */
+enum class VoicePriority : uint8_t
+{
+    Ambient = 0,    ///< Background noise, foot steps, ...
+    Normal = 1,     ///< Most sound effects
+    Important = 2,  ///< Combat feedback the player should not miss
+    Interface = 3,  ///< GUI and non-positional sounds, never dropped for a positional sound
+};
+
+/**
+ * @brief
+ *  Listener data of a frame. Computed once per frame from the cameras and then
+ *  used for all sounds in that frame.
+ */
+struct AudioListener
+{
+    AudioListener();
+
+    /// The positions of all listeners (one per camera).
+    std::vector<Vector3f> positions;
+    /// The average xy-position of all listeners.
+    Vector2f averagePosition;
+    /// The average rotation of all listeners.
+    Radians averageRotation;
+
+    /**
+     * @brief
+     *  Get the distance between the sound origin and the nearest listener.
+     * @return
+     *  the distance, std::numeric_limits<float>::max() if there are no listeners
+     */
+    float getDistance(const Vector3f& soundPosition) const;
+
+    /**
+     * @brief
+     *  Get the angle (in degrees, as expected by Mix_SetPosition) from the listeners to the sound origin.
+     */
+    float getAngle(const Vector3f& soundPosition) const;
+};
+
+/**
+ * @brief
+ *  The interface to the mixer used by the voice manager.
+ *  The default implementation is using SDL_mixer, tests are using a fake mixer.
+ */
+class VoiceBackend
+{
+public:
+    virtual ~VoiceBackend() {}
+
+    /// @return the number of mixer channels
+    virtual int getChannelCount() const = 0;
+
+    /// @brief Start playing a sound on the specified channel.
+    /// @return @a true on success, @a false otherwise
+    virtual bool play(int channel, SoundID soundID, bool looped) = 0;
+
+    /// @brief Stop the sound playing on the specified channel.
+    virtual void halt(int channel) = 0;
+
+    /// @return @a true if the specified channel is still playing
+    virtual bool isPlaying(int channel) const = 0;
+
+    /// @brief Set the 3D position of the specified channel.
+    /// @param angle the angle in degrees
+    /// @param distance the distance scaled to [0,255]
+    virtual void setPosition(int channel, float angle, float distance) = 0;
+};
+
+/**
+ * @brief
+ *  Manages virtual voices. All looping sounds are tracked with their position and priority,
+ *  but only the most important audible ones are bound to real mixer channels.
+ *  One-shot sounds take a free channel or steal the channel of the least important voice.
+ */
+class VoiceManager
+{
+public:
+    using VoiceID = uint32_t;
+    static constexpr VoiceID INVALID_VOICE_ID = 0;
+
+    /**
+     * @brief
+     *  Statistics of the last update.
+     */
+    struct Statistics
+    {
+        size_t virtualVoices;     ///< Number of looping voices tracked
+        size_t boundVoices;       ///< Number of looping voices bound to channels
+        size_t oneShotVoices;     ///< Number of channels playing one-shot sounds
+        size_t positionUpdates;   ///< Number of calls to VoiceBackend::setPosition
+        size_t droppedSounds;     ///< Number of one-shot sounds dropped since the last update
+    };
+
+    VoiceManager(VoiceBackend& backend);
+
+    /**
+     * @brief
+     *  Play a one-shot sound.
+     * @param soundID the sound
+     * @param position the sound origin
+     * @param priority the priority of the sound
+     * @param listener the listener of the current frame
+     * @param maxDistance the maximum hearing distance
+     * @return
+     *  the channel the sound is played over, INVALID_SOUND_CHANNEL if the sound was culled or dropped
+     */
+    int playOneShot(SoundID soundID, const Vector3f& position, VoicePriority priority,
+                    const AudioListener& listener, float maxDistance);
+
+    /**
+     * @brief
+     *  Play a non-positional one-shot sound (VoicePriority::Interface).
+     * @return
+     *  the channel the sound is played over, INVALID_SOUND_CHANNEL if the sound was dropped
+     */
+    int playOneShot(SoundID soundID);
+
+    /**
+     * @brief
+     *  Add a looping voice. The voice is bound to a channel by the next update if it is important enough.
+     * @return
+     *  the ID of the voice
+     */
+    VoiceID addLoopingVoice(SoundID soundID, const Vector3f& position, VoicePriority priority);
+
+    /**
+     * @brief
+     *  Update the position of a looping voice.
+     */
+    void setVoicePosition(VoiceID voiceID, const Vector3f& position);
+
+    /**
+     * @brief
+     *  Remove a looping voice, stopping its channel if it is bound.
+     */
+    void removeVoice(VoiceID voiceID);
+
+    /**
+     * @brief
+     *  Remove all voices and stop all channels owned by this voice manager.
+     */
+    void clear();
+
+    /**
+     * @brief
+     *  Update all voices: cull inaudible voices, bind the most important
+     *  looping voices to channels and update the 3D positions of bound voices.
+     */
+    void update(const AudioListener& listener, float maxDistance);
+
+    /**
+     * @return
+     *  the channel a looping voice is bound to, INVALID_SOUND_CHANNEL if it is virtual
+     */
+    int getChannel(VoiceID voiceID) const;
+
+    const Statistics& getStatistics() const { return _statistics; }
+
+private:
+    struct Voice
+    {
+        SoundID soundID;
+        Vector3f position;
+        VoicePriority priority;
+        int channel;
+        float score;
+        float lastAngle;
+        float lastDistance;
+    };
+
+    struct Channel
+    {
+        VoiceID voiceID;   ///< The looping voice bound to this channel or INVALID_VOICE_ID
+        bool oneShot;      ///< Is a one-shot sound playing on this channel?
+        float score;       ///< The importance of what is playing on this channel
+    };
+
+    /// @brief Compute the importance of a voice.
+    static float getScore(VoicePriority priority, float distance, float maxDistance);
+
+    /// @brief Resize the channel table to the backend channel count and free channels of finished one-shots.
+    void refreshChannels();
+
+    /// @brief Get a channel a sound with the specified score may use, stealing one if necessary.
+    int acquireChannel(float score);
+
+    /// @brief Stop a channel and unbind the voice playing on it.
+    void releaseChannel(int channel);
+
+    /// @brief Apply the 3D position, skipping the backend if nothing audible has changed.
+    void applyPosition(Voice& voice, const AudioListener& listener, float distance, float maxDistance, bool force);
+
+    VoiceBackend& _backend;
+    std::unordered_map<VoiceID, Voice> _voices;
+    std::vector<Channel> _channels;
+    VoiceID _nextVoiceID;
+    Statistics _statistics;
+};
+
+} // namespace Audio
+} // namespace Ego
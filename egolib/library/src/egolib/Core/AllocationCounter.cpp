@@ -0,0 +1,93 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/AllocationCounter.cpp
+/// @brief  Counts calls of the global operator new in debug builds
+
+#include "egolib/Core/AllocationCounter.hpp"
+
+#if defined(_DEBUG)
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> g_allocationCount(0);
+
+static void *countedAllocate(size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(size_t size)
+{
+    void *pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new[](size_t size)
+{
+    void *pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void *pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+#endif
+
+namespace Ego
+{
+
+bool AllocationCounter::isAvailable()
+{
+#if defined(_DEBUG)
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t AllocationCounter::getCount()
+{
+#if defined(_DEBUG)
+    return g_allocationCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+} // namespace Ego
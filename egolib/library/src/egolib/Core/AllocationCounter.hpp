@@ -17,8 +17,23 @@
 //*
 //********************************************************************************************
 
-/// @file EgoLib/Script/IRuntimeStatistics.cpp
-/// @brief Definition of statistics for a runtime
-/// @author Michael Heilmann
+/// @file   egolib/Core/AllocationCounter.hpp
+/// @brief  Counts calls of the global operator new in debug builds
 
-#include "egolib/Script/IRuntimeStatistics.hpp"
+#pragma once
+
+#include <idlib/idlib.hpp>
+
+namespace Ego
+{
+
+struct AllocationCounter
+{
+    /// @return @a true if allocations are counted, which is only the case in debug builds
+    static bool isAvailable();
+
+    /// @return the number of calls of the global operator new since the program started
+    static uint64_t getCount();
+};
+
+} // namespace Ego
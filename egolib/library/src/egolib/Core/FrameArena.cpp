@@ -0,0 +1,110 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/FrameArena.cpp
+/// @brief  Monotonic memory for containers which do not outlive an update or render frame
+
+#include "egolib/Core/FrameArena.hpp"
+
+namespace Ego
+{
+
+FrameArena::FrameArena(size_t chunkSize) :
+    _chunks(),
+    _chunkSize(chunkSize),
+    _offset(0),
+    _used(0),
+    _capacity(0),
+    _highWaterMark(0),
+    _generation(0),
+    _enabled(true),
+    _requestedEnabled(true)
+{}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    _used += size;
+    if (!_enabled)
+    {
+        return ::operator new(size);
+    }
+
+    while (true)
+    {
+        if (!_chunks.empty())
+        {
+            const uintptr_t begin = reinterpret_cast<uintptr_t>(_chunks.back().get());
+            const uintptr_t aligned = (begin + _offset + alignment - 1) & ~uintptr_t(alignment - 1);
+            if (aligned + size <= begin + _chunkSize)
+            {
+                _offset = aligned + size - begin;
+                return reinterpret_cast<void *>(aligned);
+            }
+        }
+        // The current chunk is full, continue in a larger one.
+        const size_t next = _chunks.empty() ? _chunkSize : 2 * _chunkSize;
+        addChunk(std::max(next, size + alignment));
+    }
+}
+
+void FrameArena::deallocate(void *pointer)
+{
+    if (!_enabled)
+    {
+        ::operator delete(pointer);
+    }
+}
+
+void FrameArena::reset()
+{
+    _highWaterMark = std::max(_highWaterMark, _used);
+    if (_chunks.size() > 1)
+    {
+        const size_t size = _capacity;
+        _chunks.clear();
+        _capacity = 0;
+        addChunk(size);
+    }
+    _offset = 0;
+    _used = 0;
+    _generation++;
+    _enabled = _requestedEnabled;
+}
+
+void FrameArena::addChunk(size_t size)
+{
+    _chunks.emplace_back(new char[size]);
+    _chunkSize = size;
+    _offset = 0;
+    _capacity += size;
+}
+
+FrameArena& FrameArena::getUpdateArena()
+{
+    thread_local FrameArena arena;
+    return arena;
+}
+
+FrameArena& FrameArena::getRenderArena()
+{
+    thread_local FrameArena arena;
+    return arena;
+}
+
+} // namespace Ego
@@ -0,0 +1,152 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/FrameArena.hpp
+/// @brief  Monotonic memory for containers which do not outlive an update or render frame
+
+#pragma once
+
+#include <idlib/idlib.hpp>
+#include <vector>
+#include <unordered_set>
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  A monotonic arena: allocating bumps a pointer, freeing does nothing and all memory is
+ *  released at once by reset() at the end of the frame. The memory itself is kept, so a
+ *  frame which does not need more than the previous ones does not allocate at all.
+ * @remark
+ *  An arena is not thread-safe. Every thread has its own update and render arena, only the
+ *  ones of the main thread are reset by the GameEngine. The arenas of other threads, e.g. the
+ *  module loading thread, are released when their thread ends.
+ */
+class FrameArena : private idlib::non_copyable
+{
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit FrameArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /// @brief Allocate memory which stays valid until the next reset().
+    /// @throw std::bad_alloc if the memory could not be allocated
+    void* allocate(size_t size, size_t alignment);
+
+    /// @brief Free memory from allocate(). Only a disabled arena actually frees memory.
+    void deallocate(void *pointer);
+
+    /**
+     * @brief
+     *  Release everything allocated since the last reset. If the frame did not fit into a
+     *  single chunk, the chunks are merged so that the next frame fits.
+     * @remark
+     *  No container using this arena may be alive.
+     */
+    void reset();
+
+    /// @brief Pass allocations through to the global operator new instead. Takes effect at the next reset().
+    void setEnabled(bool enabled) { _requestedEnabled = enabled; }
+
+    bool isEnabled() const { return _enabled; }
+
+    /// @return the number of bytes allocated since the last reset
+    size_t getUsed() const { return _used; }
+
+    /// @return the number of bytes reserved for allocations
+    size_t getCapacity() const { return _capacity; }
+
+    /// @return the largest number of bytes used by a single frame
+    size_t getHighWaterMark() const { return std::max(_highWaterMark, _used); }
+
+    /// @return the number of resets, memory of an older generation is gone
+    uint64_t getGeneration() const { return _generation; }
+
+    /// @return the arena of transient containers of GameEngine::updateOneFrame()
+    static FrameArena& getUpdateArena();
+
+    /// @return the arena of transient containers of GameEngine::renderOneFrame()
+    static FrameArena& getRenderArena();
+
+private:
+    void addChunk(size_t size);
+
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    size_t _chunkSize;   ///< The size of the current (last) chunk
+    size_t _offset;      ///< The first free byte in the current chunk
+    size_t _used;
+    size_t _capacity;
+    size_t _highWaterMark;
+    uint64_t _generation;
+    bool _enabled;
+    bool _requestedEnabled;
+};
+
+/// @brief An STL allocator taking its memory from a FrameArena.
+template <typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(FrameArena& arena) noexcept : _arena(&arena) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : _arena(other.getArena()) {}
+
+    T* allocate(size_t n)
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *pointer, size_t) noexcept
+    {
+        _arena->deallocate(pointer);
+    }
+
+    FrameArena *getArena() const noexcept { return _arena; }
+
+private:
+    FrameArena *_arena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) noexcept
+{
+    return a.getArena() == b.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) noexcept
+{
+    return a.getArena() != b.getArena();
+}
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template <typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+using FrameUnorderedSet = std::unordered_set<T, Hash, Equal, FrameAllocator<T>>;
+
+} // namespace Ego
@@ -0,0 +1,115 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/FrameTimeHistogram.hpp
+/// @brief  Histogram of frame times with power of two buckets
+
+#pragma once
+
+#include <idlib/idlib.hpp>
+#include <array>
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  Counts frame times in buckets of increasing size: bucket 0 holds times below 2 microseconds,
+ *  bucket i > 0 holds times from 2^i up to 2^(i+1) microseconds. Periodic spikes which are hidden
+ *  in averages show up as a second peak in the upper buckets.
+ */
+class FrameTimeHistogram
+{
+public:
+    static constexpr size_t BUCKET_COUNT = 24;
+
+    FrameTimeHistogram()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        _buckets.fill(0);
+        _count = 0;
+        _max = 0;
+    }
+
+    /// @brief Add a frame time in microseconds.
+    void add(uint64_t microseconds)
+    {
+        _buckets[getBucket(microseconds)]++;
+        _count++;
+        _max = std::max(_max, microseconds);
+    }
+
+    /// @return the bucket of a frame time in microseconds
+    static size_t getBucket(uint64_t microseconds)
+    {
+        size_t bucket = 0;
+        while (microseconds > 1 && bucket + 1 < BUCKET_COUNT)
+        {
+            microseconds >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    /// @return the exclusive upper limit of a bucket in microseconds
+    static uint64_t getBucketLimit(size_t bucket)
+    {
+        return uint64_t(2) << bucket;
+    }
+
+    /// @return the number of frame times in a bucket
+    size_t getBucketCount(size_t bucket) const { return _buckets[bucket]; }
+
+    /// @return the number of frame times
+    size_t getCount() const { return _count; }
+
+    /// @return the longest frame time in microseconds
+    uint64_t getMax() const { return _max; }
+
+    /**
+     * @return
+     *  the upper limit in microseconds of the bucket containing the given fraction of all frame times,
+     *  e.g. 0.99 for the 99th percentile
+     */
+    uint64_t getPercentile(double fraction) const
+    {
+        const size_t rank = size_t(fraction * _count);
+        size_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+        {
+            seen += _buckets[bucket];
+            if (seen > rank)
+            {
+                return std::min(getBucketLimit(bucket), _max);
+            }
+        }
+        return _max;
+    }
+
+private:
+    std::array<size_t, BUCKET_COUNT> _buckets;
+    size_t _count;
+    uint64_t _max;
+};
+
+} // namespace Ego
@@ -25,6 +25,8 @@
 
 #include "egolib/Math/_Include.hpp"
 #include "egolib/Math/Standard.hpp"
+#include <queue>
+#include <unordered_set>
 
 namespace Ego
 {
@@ -93,6 +95,83 @@ public:
         return true;
     }
 
+    /**
+    * @brief
+    *   Removes an element from this QuadTree
+    * @param element
+    *   The element to remove
+    * @param bounds
+    *   The bounding box the element had when it was inserted. Only subtrees intersecting it are visited
+    * @return
+    *   true if the element was found and removed
+    **/
+    bool remove(const T *element, const AxisAlignedBox2f &bounds)
+    {
+        if(!idlib::is_intersecting(_bounds, bounds)) {
+            return false;
+        }
+
+        //Remove from this node, the last element takes its place
+        bool removed = false;
+        for(size_t i = 0; i < _size; ++i) {
+            std::shared_ptr<T> candidate = _nodes[i].lock();
+            if(candidate.get() == element) {
+                _nodes[i] = _nodes[--_size];
+                _nodes[_size].reset();
+                removed = true;
+                break;
+            }
+        }
+
+        //An element spanning several quadrants is contained in each of them
+        if(_quadrants[0] != nullptr) {
+            for(size_t i = 0; i < _quadrants.size(); ++i) {
+                removed |= _quadrants[i]->remove(element, bounds);
+            }
+        }
+        return removed;
+    }
+
+    /**
+    * @return
+    *   true if this QuadTree contains the element in a subtree intersecting the bounding box
+    **/
+    bool contains(const T *element, const AxisAlignedBox2f &bounds) const
+    {
+        if(!idlib::is_intersecting(_bounds, bounds)) {
+            return false;
+        }
+        for(size_t i = 0; i < _size; ++i) {
+            if(_nodes[i].lock().get() == element) {
+                return true;
+            }
+        }
+        if(_quadrants[0] != nullptr) {
+            for(size_t i = 0; i < _quadrants.size(); ++i) {
+                if(_quadrants[i]->contains(element, bounds)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+    * @brief
+    *   Collect all elements contained in this QuadTree, including expired ones as nullptr
+    **/
+    void collect(std::unordered_set<const T*> &result) const
+    {
+        for(size_t i = 0; i < _size; ++i) {
+            result.insert(_nodes[i].lock().get());
+        }
+        if(_quadrants[0] != nullptr) {
+            for(size_t i = 0; i < _quadrants.size(); ++i) {
+                _quadrants[i]->collect(result);
+            }
+        }
+    }
+
     /**
     * @brief
     *   Find all elements that are within range of a specified point in this QuadTree's
@@ -102,7 +181,8 @@ public:
     * @param result
     *   Vector of all elements that fit within the search area
     **/
-    void find(const AxisAlignedBox2f &searchArea, std::vector<std::shared_ptr<T>> &result) const
+    template <typename Allocator>
+    void find(const AxisAlignedBox2f &searchArea, std::vector<std::shared_ptr<T>, Allocator> &result) const
     {
         //Search grid is not part of our bounds
         if(!idlib::is_intersecting(_bounds, searchArea)) {
@@ -136,6 +216,104 @@ public:
         }
     }
 
+    /**
+    * @brief
+    *   Find the elements nearest to a point, closest first. Subtrees and elements are visited
+    *   in order of increasing distance, so the search stops as soon as enough elements were
+    *   accepted instead of scanning everything within range.
+    * @param trees
+    *   The QuadTrees to search. Elements contained in more than one tree are only visited once
+    * @param point
+    *   The point to search from
+    * @param maxDistance
+    *   Elements further away than this are not considered
+    * @param count
+    *   The maximum number of elements to find
+    * @param squaredDistance
+    *   Functor returning the squared distance of an element from the point. It must not be smaller
+    *   than the squared distance between the point and the bounding box of the element
+    * @param filter
+    *   Predicate returning true if an element is accepted, called closest element first
+    * @param result
+    *   Vector to which the accepted elements are appended, closest first
+    **/
+    template <typename SquaredDistance, typename Filter>
+    static void findNearest(std::initializer_list<const QuadTree<T>*> trees, const Point2f& point, const float maxDistance, const size_t count,
+                            SquaredDistance squaredDistance, Filter filter, std::vector<std::shared_ptr<T>> &result)
+    {
+        //A subtree (if tree is not null) or an element to visit
+        struct Candidate {
+            float squaredDistance;
+            const QuadTree<T> *tree;
+            std::shared_ptr<T> element;
+        };
+        struct Further {
+            bool operator()(const Candidate& a, const Candidate& b) const { return a.squaredDistance > b.squaredDistance; }
+        };
+        std::priority_queue<Candidate, std::vector<Candidate>, Further> queue;
+        std::unordered_set<const T*> visited;
+        const float maxSquaredDistance = maxDistance * maxDistance;
+
+        for(const QuadTree<T> *tree : trees) {
+            const float distance = tree->getSquaredDistance(point);
+            if(distance <= maxSquaredDistance) {
+                queue.push(Candidate{distance, tree, nullptr});
+            }
+        }
+
+        size_t found = 0;
+        while(!queue.empty() && found < count) {
+            Candidate candidate = queue.top();
+            queue.pop();
+
+            //Nothing closer is left, check the element
+            if(candidate.tree == nullptr) {
+                if(filter(candidate.element)) {
+                    result.push_back(candidate.element);
+                    found++;
+                }
+                continue;
+            }
+
+            //Enqueue the elements of this QuadTree
+            const QuadTree<T> &tree = *candidate.tree;
+            for(size_t i = 0; i < tree._size; ++i) {
+                std::shared_ptr<T> element = tree._nodes[i].lock();
+
+                //Make sure element still exists and was not visited through another tree
+                if(element == nullptr || !visited.insert(element.get()).second) {
+                    continue;
+                }
+                const float distance = squaredDistance(*element);
+                if(distance <= maxSquaredDistance) {
+                    queue.push(Candidate{distance, nullptr, element});
+                }
+            }
+
+            //Enqueue subtrees (if any)
+            if(tree._quadrants[0] != nullptr) {
+                for(size_t i = 0; i < tree._quadrants.size(); ++i) {
+                    const float distance = tree._quadrants[i]->getSquaredDistance(point);
+                    if(distance <= maxSquaredDistance) {
+                        queue.push(Candidate{distance, tree._quadrants[i].get(), nullptr});
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+    * @brief
+    *   Find the elements of this QuadTree nearest to a point, closest first.
+    * @see findNearest(std::initializer_list<const QuadTree<T>*>, const Point2f&, const float, const size_t, SquaredDistance, Filter, std::vector<std::shared_ptr<T>>&)
+    **/
+    template <typename SquaredDistance, typename Filter>
+    void findNearest(const Point2f& point, const float maxDistance, const size_t count,
+                     SquaredDistance squaredDistance, Filter filter, std::vector<std::shared_ptr<T>> &result) const
+    {
+        findNearest({this}, point, maxDistance, count, squaredDistance, filter, result);
+    }
+
     /**
     * @brief
     *   Clears all elements from this QuadTree and all its children
@@ -153,6 +331,19 @@ public:
     }
 
 private:
+    /**
+    * @brief
+    *   Get the squared distance between a point and the bounds of this QuadTree
+    * @return
+    *   0 if the point is inside the bounds
+    **/
+    float getSquaredDistance(const Point2f& point) const
+    {
+        const float dx = std::max({_bounds.get_min()[kX] - point[kX], 0.0f, point[kX] - _bounds.get_max()[kX]});
+        const float dy = std::max({_bounds.get_min()[kY] - point[kY], 0.0f, point[kY] - _bounds.get_max()[kY]});
+        return dx * dx + dy * dy;
+    }
+
     /**
     * @brief
     *   Helper function to subdivide this QuadTree into four more QuadTrees
@@ -0,0 +1,107 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/RadixSort.hpp
+/// @brief  LSD radix sort of elements by 64 bit keys
+
+#pragma once
+
+#include <idlib/idlib.hpp>
+#include <cstring>
+#include <vector>
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  Convert a float into an unsigned integer which compares like the float.
+ * @remark
+ *  Negative numbers have their bits flipped, positive numbers have their sign bit set.
+ */
+inline uint32_t radix_key(float x)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/**
+ * @brief
+ *  Sort elements in ascending order of their keys.
+ *  The sort is stable, elements with equal keys keep their order.
+ * @param elements the elements
+ * @param scratch a buffer for the sort, resized as needed. Keep it around to avoid allocations.
+ * @param key a function returning the uint64_t key of an element
+ * @remark
+ *  Eight passes over 8 bit digits, from the least to the most significant digit.
+ *  Passes in which all elements have the same digit are skipped, so keys using
+ *  only a few of their bits are sorted in fewer passes.
+ */
+template <typename T, typename KeyFunction>
+void radix_sort(std::vector<T>& elements, std::vector<T>& scratch, KeyFunction key)
+{
+    const size_t n = elements.size();
+    if (n < 2)
+    {
+        return;
+    }
+    scratch.resize(n);
+
+    // Build the histograms of all digits in one pass.
+    size_t histograms[8][256] = {};
+    for (const T& element : elements)
+    {
+        uint64_t k = key(element);
+        for (size_t digit = 0; digit < 8; ++digit)
+        {
+            histograms[digit][(k >> (digit * 8)) & 0xff]++;
+        }
+    }
+
+    std::vector<T> *source = &elements, *target = &scratch;
+    for (size_t digit = 0; digit < 8; ++digit)
+    {
+        size_t *histogram = histograms[digit];
+        // All elements have the same digit, this pass would not change the order.
+        if (histogram[(key((*source)[0]) >> (digit * 8)) & 0xff] == n)
+        {
+            continue;
+        }
+        // Turn the counts into offsets.
+        size_t offset = 0;
+        for (size_t i = 0; i < 256; ++i)
+        {
+            size_t count = histogram[i];
+            histogram[i] = offset;
+            offset += count;
+        }
+        for (const T& element : *source)
+        {
+            (*target)[histogram[(key(element) >> (digit * 8)) & 0xff]++] = element;
+        }
+        std::swap(source, target);
+    }
+    if (source != &elements)
+    {
+        elements.swap(scratch);
+    }
+}
+
+} // namespace Ego
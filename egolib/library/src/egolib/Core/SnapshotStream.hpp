@@ -0,0 +1,127 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SnapshotStream.hpp
+/// @brief  Allocation-light binary serialization of plain data into a reusable buffer
+
+#pragma once
+
+#include <idlib/idlib.hpp>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  Appends plain data to a byte buffer. The values are stored in native byte order:
+ *  snapshots are only exchanged between runs of the same build.
+ * @remark
+ *  The buffer is not cleared, so a buffer reused for every snapshot stops allocating
+ *  once it has grown to the size of a snapshot.
+ */
+class SnapshotWriter
+{
+public:
+    SnapshotWriter(std::vector<char>& buffer) :
+        _buffer(buffer)
+    {}
+
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        const char *bytes = reinterpret_cast<const char *>(&value);
+        _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void writeString(const std::string& value)
+    {
+        write(uint32_t(value.size()));
+        _buffer.insert(_buffer.end(), value.begin(), value.end());
+    }
+
+    size_t getSize() const
+    {
+        return _buffer.size();
+    }
+
+private:
+    std::vector<char>& _buffer;
+};
+
+/**
+ * @brief
+ *  Reads plain data written by a SnapshotWriter.
+ */
+class SnapshotReader
+{
+public:
+    SnapshotReader(const char *bytes, size_t size) :
+        _bytes(bytes), _size(size), _position(0)
+    {}
+
+    SnapshotReader(const std::vector<char>& buffer) :
+        SnapshotReader(buffer.data(), buffer.size())
+    {}
+
+    /// @throw idlib::runtime_error if the snapshot is truncated
+    template <typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    /// @throw idlib::runtime_error if the snapshot is truncated
+    std::string readString()
+    {
+        const uint32_t size = read<uint32_t>();
+        const char *bytes = take(size);
+        return std::string(bytes, bytes + size);
+    }
+
+    bool isAtEnd() const
+    {
+        return _position == _size;
+    }
+
+private:
+    const char *take(size_t size)
+    {
+        if (size > _size - _position)
+        {
+            throw idlib::runtime_error(__FILE__, __LINE__, "truncated snapshot");
+        }
+        const char *bytes = _bytes + _position;
+        _position += size;
+        return bytes;
+    }
+
+    const char *_bytes;
+    size_t _size;
+    size_t _position;
+};
+
+} // namespace Ego
@@ -105,6 +105,11 @@ public:
         _semaphore.wait(lock, [this]{ return _activeThreads == 0 && _tasks.empty(); });
     }
 
+    size_t getThreadCount() const
+    {
+        return _threads.size();
+    }
+
 /*
 protected:
 
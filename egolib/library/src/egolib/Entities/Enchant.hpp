@@ -156,6 +156,8 @@ private:
     float _ownerLifeSustain;
     float _targetManaDrain;
     float _targetLifeDrain;
+
+    friend class WorldSnapshot;
 };
 
 } //Ego
\ No newline at end of file
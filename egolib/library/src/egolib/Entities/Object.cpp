@@ -53,6 +53,15 @@ constexpr float Object::DROPZVEL;
 /// @todo Remove this if GCC & Clang are fixed.
 constexpr float Object::DISMOUNTZVEL;
 
+Object::ColdData::ColdData(uint32_t levelUpSeed) :
+    name("*NONE*"),
+    inventory(),
+    levelUpSeed(levelUpSeed),
+    hasBeenKilled(false)
+{
+    //ctor
+}
+
 Object::Object(ObjectProfileRef proRef, ObjectRef objRef) : 
     ai(),
     gender(Gender::Male),
@@ -62,7 +71,7 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     ammo(0),
     holdingwhich(),
     equipment(),
-    team(Team::TEAM_NULL),
+    _team(Team::TEAM_NULL),
     team_base(Team::TEAM_NULL),
     fat_stt(0.0f),
     fat(0.0f),
@@ -138,17 +147,17 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     _profile(ProfileSystem::get().getProfile(_profileID)),
     _showStatus(false),
     _isAlive(true),
-    _name("*NONE*"),
 
     _currentLife(0.0f),
     _currentMana(0.0f),
     _baseAttribute(),
     _tempAttribute(),
 
-    _inventory(),
     _money(0),
     _perks(),
-    _levelUpSeed(Random::next(std::numeric_limits<uint32_t>::max())),
+
+    //Input commands
+    _inputLatchesPressed(),
 
     //Graphics
     inst(*this),
@@ -156,19 +165,20 @@ Object::Object(ObjectProfileRef proRef, ObjectRef objRef) :
     //Physics
     _objectPhysics(*this),
 
-    //Input commands
-    _inputLatchesPressed(),
-
     //Non-persistent variables
-    _hasBeenKilled(false),
     _reallyDuration(0),
     _stealth(false),
     _stealthTimer(0),
     _observationTimer((objRef.get() % ONESECOND) + update_wld), //spread observations so all characters don't happen at the same time
+    _dormant(false),
+    _idleUpdates(0),
+    _wakeTime(0),
 
     //Enchants
     _activeEnchants(),
-    _lastEnchantSpawned()
+    _lastEnchantSpawned(),
+
+    _cold(std::make_unique<ColdData>(Random::next(std::numeric_limits<uint32_t>::max())))
 {
     // Grip info
     holdingwhich.fill(ObjectRef::Invalid);
@@ -203,7 +213,7 @@ Object::~Object()
         removeFromGame(this);
 
         // free the character's inventory
-        for(const std::shared_ptr<Object> pitem : _inventory.iterate())
+        for(const std::shared_ptr<Object> pitem : _cold->inventory.iterate())
         {
             pitem->requestTerminate();
         }
@@ -214,9 +224,9 @@ Object::~Object()
             _currentModule->getTeamList()[team_base].decreaseMorale();
         }
 
-        if ( _currentModule->getTeamList()[team].getLeader().get() == this )
+        if ( _currentModule->getTeamList()[_team].getLeader().get() == this )
         {
-            _currentModule->getTeamList()[team].setLeader(INVALID_OBJECT);
+            _currentModule->getTeamList()[_team].setLeader(INVALID_OBJECT);
         }
 
         // remove any attached particles
@@ -884,13 +894,13 @@ void Object::update()
 
             //Danger Sense reveals enemies on the minimap
             if(hasPerk(Ego::Perks::DANGER_SENSE)) {
-                local_stats.sense_enemies_team = this->team;
+                local_stats.sense_enemies_team = _team;
                 local_stats.sense_enemies_idsz = IDSZ2::None;     //Reveal all
             }
 
             //Danger Sense reveals enemies on the minimap
             else if(hasPerk(Ego::Perks::SENSE_UNDEAD)) {
-                local_stats.sense_enemies_team = this->team;
+                local_stats.sense_enemies_team = _team;
                 local_stats.sense_enemies_idsz = IDSZ2('U','N','D','E');     //Reveal only undead
             }
         }        
@@ -1049,7 +1059,7 @@ std::string Object::getName(bool prefixArticle, bool prefixDefinite, bool capita
 
     if (isNameKnown())
     {
-        result = _name;
+        result = _cold->name;
 
         // capitalize the name ?
         if (capitalLetter)
@@ -1215,11 +1225,11 @@ bool Object::detatchFromHolder(const bool ignoreKurse, const bool doShop)
     // Reset the team if it is a mount
     if ( pholder->isMount() )
     {
-        pholder->team = pholder->team_base;
+        pholder->assignTeam(pholder->team_base);
         SET_BIT( pholder->ai.alert, ALERTIF_DROPPED );
     }
 
-    team = team_base;
+    assignTeam(team_base);
     SET_BIT( ai.alert, ALERTIF_DROPPED );
 
     // Reset transparency
@@ -1472,7 +1482,7 @@ void Object::kill(const std::shared_ptr<Object> &originalKiller, bool ignoreInvi
             else actualKiller->giveExperience(experience, XP_KILLENEMY, false);
 
             //Mercenary Perk gives +1 Zenny per kill (if this is the first time we died)
-            if(actualKiller->hasPerk(Ego::Perks::MERCENARY) && !_hasBeenKilled) {
+            if(actualKiller->hasPerk(Ego::Perks::MERCENARY) && !_cold->hasBeenKilled) {
                 actualKiller->giveMoney(1);
                 AudioSystem::get().playSound(getPosition(), AudioSystem::get().getGlobalSound(GSND_COINGET));
             }
@@ -1522,7 +1532,7 @@ void Object::kill(const std::shared_ptr<Object> &originalKiller, bool ignoreInvi
     }
 
     // Let it's AI script run one last time
-    _hasBeenKilled = true;
+    _cold->hasBeenKilled = true;
     ai.timer = update_wld + 1;            // Prevent IfTimeOut in scr_run_chr_script()
     scr_run_chr_script(this);
 }
@@ -1671,13 +1681,13 @@ void Object::removeFromGame(Object *obj)
 	obj->sparkle = NOSPARKLE;
 
 	// Remove it from the team
-	obj->team = obj->team_base;
-	_currentModule->getTeamList()[obj->team].decreaseMorale();
+	obj->assignTeam(obj->team_base);
+	_currentModule->getTeamList()[obj->getTeamID()].decreaseMorale();
 
-	if (_currentModule->getTeamList()[obj->team].getLeader().get() == obj)
+	if (_currentModule->getTeamList()[obj->getTeamID()].getLeader().get() == obj)
 	{
 		// The team now has no leader if the character is the leader
-		_currentModule->getTeamList()[obj->team].setLeader(Object::INVALID_OBJECT);
+		_currentModule->getTeamList()[obj->getTeamID()].setLeader(Object::INVALID_OBJECT);
 	}
 
 	// Clear all shop passages that it owned..
@@ -1863,7 +1873,7 @@ void Object::respawn()
     _currentMana = getAttribute(Ego::Attribute::MAX_MANA);
     setPosition(getSpawnPosition());
     setVelocity(idlib::zero<Ego::Vector3f>());
-    team = team_base;
+    assignTeam(team_base);
     canbecrushed = false;
     ori.map_twist_facing_y = orientation_t::MAP_TURN_OFFSET;  // These two mean on level surface
     ori.map_twist_facing_x = orientation_t::MAP_TURN_OFFSET;
@@ -1902,7 +1912,7 @@ void Object::respawn()
     daze_timer = 0;
 
     // Let worn items come back
-    for(const std::shared_ptr<Object> pitem : _inventory.iterate())
+    for(const std::shared_ptr<Object> pitem : _cold->inventory.iterate())
     {
         if ( pitem->isequipped )
         {
@@ -2111,7 +2121,7 @@ void Object::increaseBaseAttribute(const Ego::Attribute::AttributeType type, flo
 
 Inventory& Object::getInventory()
 {
-    return _inventory;
+    return _cold->inventory;
 }
 
 bool Object::hasPerk(Ego::Perks::PerkID perk) const
@@ -2258,7 +2268,7 @@ void Object::setLife(const float value)
 
 void Object::setName(const std::string &name)
 {
-    _name = name;
+    _cold->name = name;
 }
 
 const std::shared_ptr<ObjectProfile>& Object::getProfile() const 
@@ -2279,8 +2289,10 @@ void Object::polymorphObject(ObjectProfileRef profileID, const SKIN_T newSkin)
         return;
     }
 
+    const std::shared_ptr<ObjectProfile> oldProfile = _profile;
     _profileID = profileID;
     _profile = ProfileSystem::get().getProfile(_profileID);
+    _currentModule->getObjectHandler().onProfileChanged(getObjRef(), oldProfile);
 
     //Exit stealth if we change form
     deactivateStealth();
@@ -2659,6 +2671,16 @@ const std::shared_ptr<Object>& Object::getHolder() const
     return _currentModule->getObjectHandler()[attachedto];
 }
 
+void Object::assignTeam(TEAM_REF team_new)
+{
+    if (_team == team_new) {
+        return;
+    }
+    const TEAM_REF team_old = _team;
+    _team = team_new;
+    _currentModule->getObjectHandler().onTeamChanged(getObjRef(), team_old, team_new);
+}
+
 void Object::setTeam(TEAM_REF team_new, bool permanent)
 {
     //No change?
@@ -2670,7 +2692,7 @@ void Object::setTeam(TEAM_REF team_new, bool permanent)
     const bool canHaveTeam = !isItem() && isAlive() && !isInvincible();
 
     // take the character off of its old team
-    if ( VALID_TEAM_RANGE(this->team) )
+    if ( VALID_TEAM_RANGE(_team) )
     {
         // remove the character from the old team
         if ( canHaveTeam )
@@ -2691,11 +2713,11 @@ void Object::setTeam(TEAM_REF team_new, bool permanent)
     }
 
     // place the character onto its new team
-    this->team = team_new;
+    assignTeam(team_new);
 
     // switch the base team only if required
     if (permanent) {
-        team_base = this->team;
+        team_base = _team;
     }
 
     // add the character to the new team
@@ -2867,7 +2889,7 @@ void Object::dropKeys()
         pkey->hitready               = true;
         pkey->isequipped             = false;
         pkey->ori.facing_z           = idlib::canonicalize(direction + ATK_BEHIND);
-        pkey->team                   = pkey->team_base;
+        pkey->assignTeam(pkey->team_base);
 
         // fix the current velocity
         pkey->setVelocity(pkey->getVelocity() + 
@@ -2923,7 +2945,7 @@ void Object::dropAllItems()
         // fix some flags
         pitem->hitready               = true;
         pitem->ori.facing_z           = idlib::canonicalize(direction + ATK_BEHIND);
-        pitem->team                   = pitem->team_base;
+        pitem->assignTeam(pitem->team_base);
 
         // fix the current velocity
         pitem->setVelocity(pitem->getVelocity() +
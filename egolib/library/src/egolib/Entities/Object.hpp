@@ -42,7 +42,7 @@
 #include "egolib/game/Graphics/ObjectGraphics.hpp"
 
 //Forward declarations
-namespace Ego { class Enchantment; }
+namespace Ego { class Enchantment; class WorldSnapshot; class DormancySystem; }
 
 /// The possible methods for characters to determine what direction they are facing
 enum turn_mode_t : uint8_t
@@ -138,7 +138,12 @@ public:
     /**
     * @return the current team this object is on. This can change in-game (mounts or pets for example)
     **/
-    Team& getTeam() const { return _currentModule->getTeamList()[team]; }
+    Team& getTeam() const { return _currentModule->getTeamList()[_team]; }
+
+    /**
+    * @return the ID of the team this object is currently on
+    **/
+    TEAM_REF getTeamID() const { return _team; }
 
     /**
     * @brief
@@ -325,6 +330,13 @@ public:
     **/
     bool isAlive() const {return _isAlive;}
 
+    /**
+    * @return
+    *   true if this Object is asleep. Dormant objects are skipped by the A.I., update and
+    *   movement loops until Ego::DormancySystem wakes them.
+    **/
+    bool isDormant() const {return _dormant;}
+
     /**
     * @return
     *   true if the Object is currently in hidden state. In hidden state the object cannot be
@@ -616,14 +628,14 @@ public:
     *   Get the random seed used for determining which perks will be available when leveling and
     *   how much attributes get improved
     **/
-    uint32_t getLevelUpSeed() const { return _levelUpSeed; }
+    uint32_t getLevelUpSeed() const { return _cold->levelUpSeed; }
 
     /**
     * @brief
     *   Generates a new random level up seed. Should be called every time a level up is complete
     *   or first time generating a character from scratch (not a save game)
     **/
-    void randomizeLevelUpSeed() { _levelUpSeed = Random::next(Random::next<uint32_t>(std::numeric_limits<uint32_t>::max())); }
+    void randomizeLevelUpSeed() { _cold->levelUpSeed = Random::next(Random::next<uint32_t>(std::numeric_limits<uint32_t>::max())); }
 
     /**
     * @brief
@@ -730,6 +742,14 @@ public:
     **/
     void setTeam(TEAM_REF team, bool permanent = true);
 
+    /**
+    * @brief
+    *   Moves this Object onto another team without touching team morale or leadership.
+    *   The only way to change Object::_team, so that the team
+    *   index of the ObjectHandler stays up to date.
+    **/
+    void assignTeam(TEAM_REF team);
+
     /**
     * @brief
     *   checks if the object has a matching skill IDSZ. This function also maps between the old skill IDSZ
@@ -841,7 +861,9 @@ public:
     std::array<ObjectRef, INVEN_COUNT> equipment;   ///< != ObjectRef::Invalid if character has equipped something
 
     // team stuff
-    TEAM_REF       team;            ///< Character's team
+private:
+    TEAM_REF       _team;           ///< Character's team, only changed by assignTeam()
+public:
     TEAM_REF       team_base;        ///< Character's starting team
 
     float          fat_stt;                       ///< Character's initial size
@@ -956,7 +978,6 @@ private:
     std::shared_ptr<ObjectProfile> _profile;         ///< Our Profile
     bool _showStatus;                                ///< Display stats?
     bool _isAlive;                                   ///< Is this Object alive or dead?
-    std::string _name;                               ///< Name of the Object
 
     //Attributes
     float _currentLife;
@@ -964,10 +985,8 @@ private:
     std::array<float, Ego::Attribute::NR_OF_ATTRIBUTES> _baseAttribute; ///< Character attributes
     std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>> _tempAttribute; ///< Character attributes with enchants
 
-    Inventory _inventory;
     uint16_t  _money;                                    ///< Money
     std::bitset<Ego::Perks::NR_OF_PERKS> _perks;         ///< Perks known (super-efficient bool array)
-    uint32_t _levelUpSeed;
 
     //Input commands
     std::bitset<LATCHBUTTON_COUNT> _inputLatchesPressed;
@@ -981,15 +1000,38 @@ private:
     Ego::Physics::ObjectPhysics _objectPhysics;
 
     //Non persistent variables. Once game ends these are not saved
-    bool _hasBeenKilled;                              ///< If this Object has been killed at least once this module (many can respawn)
     uint32_t _reallyDuration;                         ///< Game Logic Update frame duration for rally bonus gained from the Perk
     bool _stealth;                                    ///< Is this Object actively trying to hide from others?
     uint16_t _stealthTimer;                           ///< Time before we can enter stealth again
     uint32_t _observationTimer;                       ///< Next update frame we are going to scan for hidden objects
+    bool _dormant;                                    ///< Asleep, see Ego::DormancySystem
+    uint16_t _idleUpdates;                            ///< Number of consecutive updates this Object could have slept
+    uint32_t _wakeTime;                               ///< Update frame at which a dormant Object wakes for its A.I. timer
 
     //Enchantment stuff
     std::forward_list<std::shared_ptr<Ego::Enchantment>> _activeEnchants;    ///< List of all active enchants on this Object
     std::weak_ptr<Ego::Enchantment> _lastEnchantSpawned;    //< Last enchantment that his Object has spawned
 
+    /**
+    * @brief
+    *   State of an Object which is not read by the per-tick update (name, inventory, level-up seed, ...).
+    *   It is a separate heap allocation so that loops over all objects do not drag it through the cache.
+    *   Attributes, perks and the rally bonus are read every tick and stay in the Object.
+    **/
+    struct ColdData
+    {
+        ColdData(uint32_t levelUpSeed);
+
+        std::string name;                                                           ///< Name of the Object
+        Inventory inventory;
+        uint32_t levelUpSeed;
+
+        //Non persistent variables. Once game ends these are not saved
+        bool hasBeenKilled;                            ///< If this Object has been killed at least once this module (many can respawn)
+    };
+    std::unique_ptr<ColdData> _cold;
+
     friend class ObjectHandler;
+    friend class Ego::WorldSnapshot;
+    friend class Ego::DormancySystem;
 };
@@ -43,7 +43,10 @@ ObjectHandler::ObjectHandler() :
     _totalCharactersSpawned(0),
     _dynamicObjects(),
     _staticObjects(),
-    _updateStaticTreeClock(0)
+    _staticObjectsBounds(),
+    _staticObjectBounds(),
+    _teamMembers(),
+    _idszMembers(IDSZ_COUNT)
 {
     _iteratorList.reserve(OBJECTS_MAX);
 }
@@ -58,7 +61,13 @@ bool ObjectHandler::remove(ObjectRef ref) {
 #endif
 
 	//Remove us from any holder first
-	_internalCharacterList[ref]->detatchFromHolder(true, false);
+	const std::shared_ptr<Object> &object = _internalCharacterList[ref];
+	object->detatchFromHolder(true, false);
+
+	// Remove us from the secondary indices.
+	_teamMembers[object->getTeamID()].erase(ref);
+	unindexIDSZ(ref, *object->getProfile());
+	updateStaticObject(object, false);
 
 	// If we are inside a list loop, do not actually change the length of the
 	// list. Else this can cause some problems later.
@@ -126,6 +135,10 @@ std::shared_ptr<Object> ObjectHandler::insert(ObjectProfileRef profileRef, Objec
 		// Allocate the new one (we can safely modify the internal map, it isn't iterable from outside).
 		_internalCharacterList[objRef] = objPtr;
 
+		// Add it to the secondary indices.
+		_teamMembers[objPtr->getTeamID()].insert(objRef);
+		indexIDSZ(objRef, *objPtr->getProfile());
+
 		// Wait to adding it to the iterable list.
 		_allocateList.push_back(objPtr);
 		return objPtr;
@@ -168,6 +181,15 @@ void ObjectHandler::clear()
 	_internalCharacterList.clear();
 	_iteratorList.clear();
     _dynamicObjects.clear(0, 0, 0, 0);
+    _staticObjects.clear(0, 0, 0, 0);
+    _staticObjectsBounds = Ego::AxisAlignedBox2f();
+    _staticObjectBounds.clear();
+    for (auto &members : _teamMembers) {
+        members.clear();
+    }
+    for (auto &slot : _idszMembers) {
+        slot.clear();
+    }
     _deletedCharacters = 0;
     _totalCharactersSpawned = 0;
 }
@@ -298,37 +320,90 @@ size_t ObjectHandler::getObjectCount() const
     return _iteratorList.size() + _allocateList.size() - _deletedCharacters;
 }
 
+static bool isSameBox(const Ego::AxisAlignedBox2f& a, const Ego::AxisAlignedBox2f& b)
+{
+    return a.get_min()[kX] == b.get_min()[kX] && a.get_min()[kY] == b.get_min()[kY]
+        && a.get_max()[kX] == b.get_max()[kX] && a.get_max()[kY] == b.get_max()[kY];
+}
+
 void ObjectHandler::updateQuadTree(float minX, float minY, float maxX, float maxY)
 {
     //Reset quad-tree
     _dynamicObjects.clear(minX, minY, maxX, maxY);
 
-    //Rebuild the static quad tree only once per second
-    bool updateStaticQuadTree = false;
-    if(_updateStaticTreeClock <= 0) {
-        _updateStaticTreeClock = ONESECOND;
-        updateStaticQuadTree = true;
+    //The static quad-tree is only reset if the level changed
+    const Ego::AxisAlignedBox2f bounds(Ego::Point2f(minX, minY), Ego::Point2f(maxX, maxY));
+    if(!isSameBox(bounds, _staticObjectsBounds)) {
+        _staticObjectsBounds = bounds;
         _staticObjects.clear(minX, minY, maxX, maxY);
-    }
-    else {
-        _updateStaticTreeClock--;
+        _staticObjectBounds.clear();
     }
 
     //Rebuild quad-tree
     for(const std::shared_ptr<Object> &object : _iteratorList) {
         //Do not add objects that cannot interact with the rest of the world
-        if(object->isTerminated() || object->isHidden()) continue;
+        const bool interacts = !object->isTerminated() && !object->isHidden();
+        const bool isScenery = interacts && object->isScenery();
+
+        if(interacts && !isScenery) {
+            _dynamicObjects.insert(object);
+        }
+        updateStaticObject(object, isScenery);
+    }
+
+#if defined(_DEBUG)
+    IDLIB_DEBUG_ASSERT(checkStaticObjects());
+#endif
+}
+
+void ObjectHandler::updateStaticObject(const std::shared_ptr<Object> &object, bool isStatic)
+{
+    const auto it = _staticObjectBounds.find(object.get());
+    if(it != _staticObjectBounds.end()) {
+        //Unchanged?
+        if(isStatic && isSameBox(it->second, object->getAxisAlignedBox2D())) {
+            return;
+        }
+        _staticObjects.remove(object.get(), it->second);
+        _staticObjectBounds.erase(it);
+    }
+    if(isStatic && _staticObjects.insert(object)) {
+        _staticObjectBounds.emplace(object.get(), object->getAxisAlignedBox2D());
+    }
+}
 
-        if(object->isScenery()) {
-            if(updateStaticQuadTree) {
-                _staticObjects.insert(object);
+#if defined(_DEBUG)
+bool ObjectHandler::checkStaticObjects() const
+{
+    size_t expected = 0;
+    for(const std::shared_ptr<Object> &object : _iteratorList) {
+        const bool isStatic = !object->isTerminated() && !object->isHidden() && object->isScenery();
+        const auto it = _staticObjectBounds.find(object.get());
+        if(it == _staticObjectBounds.end()) {
+            //Objects outside of the level are not in the quad-tree
+            if(isStatic && idlib::is_intersecting(_staticObjectsBounds, object->getAxisAlignedBox2D())) {
+                Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "scenery object ", object->getObjRef().get(), " is missing in the static quad tree", Log::EndOfEntry);
+                return false;
             }
+            continue;
         }
-        else {
-            _dynamicObjects.insert(object);
+        if(!isStatic || !isSameBox(it->second, object->getAxisAlignedBox2D()) || !_staticObjects.contains(object.get(), it->second)) {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "object ", object->getObjRef().get(), " is out of date in the static quad tree", Log::EndOfEntry);
+            return false;
         }
+        expected++;
+    }
+
+    //No objects which are not tracked (e.g. removed objects)
+    std::unordered_set<const Object*> contained;
+    _staticObjects.collect(contained);
+    if(contained.size() != expected || expected != _staticObjectBounds.size()) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "static quad tree contains ", contained.size(), " objects, expected ", expected, Log::EndOfEntry);
+        return false;
     }
+    return true;
 }
+#endif
 
 std::vector<std::shared_ptr<Object>> ObjectHandler::findObjects(const float x, const float y, const float distance, bool includeSceneryObjects) const { 
     std::vector<std::shared_ptr<Object>> result;
@@ -345,3 +420,116 @@ void ObjectHandler::findObjects(const Ego::AxisAlignedBox2f &searchArea, std::ve
     }
     return _dynamicObjects.find(searchArea, result);
 }
+
+void ObjectHandler::findObjects(const Ego::AxisAlignedBox2f &searchArea, Ego::FrameVector<std::shared_ptr<Object>> &result, bool includeSceneryObjects) const
+{
+    if(includeSceneryObjects) {
+        _staticObjects.find(searchArea, result);
+    }
+    _dynamicObjects.find(searchArea, result);
+}
+
+std::vector<std::shared_ptr<Object>> ObjectHandler::findNearestObjects(const Ego::Vector3f& position, float maxDistance, size_t count, const ObjectFilter& filter, bool includeSceneryObjects) const
+{
+    std::vector<std::shared_ptr<Object>> result;
+    const Ego::Point2f point(position[kX], position[kY]);
+    const auto squaredDistance = [&position](const Object& object) {
+        return idlib::squared_euclidean_norm(object.getPosition() - position);
+    };
+    if(includeSceneryObjects) {
+        Ego::QuadTree<Object>::findNearest({&_dynamicObjects, &_staticObjects}, point, maxDistance, count, squaredDistance, filter, result);
+    }
+    else {
+        _dynamicObjects.findNearest(point, maxDistance, count, squaredDistance, filter, result);
+    }
+    return result;
+}
+
+std::shared_ptr<Object> ObjectHandler::findNearestObject(const Ego::Vector3f& position, float maxDistance, const ObjectFilter& filter, bool includeSceneryObjects) const
+{
+    std::vector<std::shared_ptr<Object>> result = findNearestObjects(position, maxDistance, 1, filter, includeSceneryObjects);
+    return result.empty() ? nullptr : result.front();
+}
+
+std::vector<std::shared_ptr<Object>> ObjectHandler::findObjectsInRadius(const Ego::Vector3f& position, float radius, const ObjectFilter& filter, bool includeSceneryObjects) const
+{
+    return findNearestObjects(position, radius, std::numeric_limits<size_t>::max(), filter, includeSceneryObjects);
+}
+
+std::shared_ptr<Object> ObjectHandler::findNearestObjectInCone(const Ego::Vector3f& position, Facing facing, FACING_T halfAngle, float maxDistance, const ObjectFilter& filter, bool includeSceneryObjects) const
+{
+    facing = idlib::canonicalize(facing);
+    return findNearestObject(position, maxDistance, [&](const std::shared_ptr<Object>& object) {
+        Facing angle = Facing(FACING_T(-facing + vec_to_facing(object->getPosX() - position[kX], object->getPosY() - position[kY])));
+        if(angle >= Facing(halfAngle) && angle <= Facing(0xFFFF - halfAngle)) {
+            return false;
+        }
+        return filter(object);
+    }, includeSceneryObjects);
+}
+
+const std::set<ObjectRef>& ObjectHandler::getTeamMembers(TEAM_REF team) const
+{
+    static const std::set<ObjectRef> EMPTY;
+    if (!VALID_TEAM_RANGE(team)) {
+        return EMPTY;
+    }
+    return _teamMembers[team];
+}
+
+const std::set<ObjectRef>& ObjectHandler::getObjectsWithIDSZ(size_t idszSlot, const IDSZ2& idsz) const
+{
+    static const std::set<ObjectRef> EMPTY;
+    if (idszSlot >= _idszMembers.size()) {
+        return EMPTY;
+    }
+    const auto it = _idszMembers[idszSlot].find(idsz);
+    if (it == _idszMembers[idszSlot].end()) {
+        return EMPTY;
+    }
+    return it->second;
+}
+
+void ObjectHandler::onTeamChanged(ObjectRef ref, TEAM_REF oldTeam, TEAM_REF newTeam)
+{
+    // Objects that have already been removed are not indexed anymore.
+    if (!exists(ref)) {
+        return;
+    }
+    if (VALID_TEAM_RANGE(oldTeam)) {
+        _teamMembers[oldTeam].erase(ref);
+    }
+    if (VALID_TEAM_RANGE(newTeam)) {
+        _teamMembers[newTeam].insert(ref);
+    }
+}
+
+void ObjectHandler::onProfileChanged(ObjectRef ref, const std::shared_ptr<ObjectProfile> &oldProfile)
+{
+    if (!exists(ref)) {
+        return;
+    }
+    if (oldProfile) {
+        unindexIDSZ(ref, *oldProfile);
+    }
+    indexIDSZ(ref, *get(ref)->getProfile());
+}
+
+void ObjectHandler::indexIDSZ(ObjectRef ref, const ObjectProfile &profile)
+{
+    for (size_t slot = 0; slot < _idszMembers.size(); ++slot) {
+        _idszMembers[slot][profile.getIDSZ(slot)].insert(ref);
+    }
+}
+
+void ObjectHandler::unindexIDSZ(ObjectRef ref, const ObjectProfile &profile)
+{
+    for (size_t slot = 0; slot < _idszMembers.size(); ++slot) {
+        auto it = _idszMembers[slot].find(profile.getIDSZ(slot));
+        if (it == _idszMembers[slot].end()) continue;
+        it->second.erase(ref);
+        if (it->second.empty()) {
+            _idszMembers[slot].erase(it);
+        }
+    }
+}
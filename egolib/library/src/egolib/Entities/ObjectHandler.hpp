@@ -28,9 +28,13 @@
 
 #include "egolib/game/egoboo.h"
 #include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/FrameArena.hpp"
+#include "egolib/Logic/Team.hpp"
+#include <set>
 
 //Forward declarations
 class Object;
+class ObjectProfile;
 
 //ZF> Some macros from C Egoboo (TODO: remove these macros)
 ObjectRef GET_INDEX_PCHR(const Object *pobj);
@@ -182,19 +186,132 @@ public:
 
 	/**
 	* @brief
-	* 	Clear and rebuild the quad tree for this update frame
+	*	Find all elements that collide with a 2D bounding box area, for callers which
+	*	keep the result only for the current frame
+	**/
+	void findObjects(const Ego::AxisAlignedBox2f &searchArea, Ego::FrameVector<std::shared_ptr<Object>> &result, bool includeSceneryObjects = true) const;
+
+	/**
+	* @brief
+	*	Predicate deciding if an object found by a spatial query is accepted.
+	**/
+	using ObjectFilter = std::function<bool(const std::shared_ptr<Object>&)>;
+
+	/**
+	* @brief
+	*	Find the objects nearest to a position, closest first. Objects are tested against
+	*	the filter in order of increasing distance and the search stops once enough objects
+	*	were accepted, so the cost depends on how close the accepted objects are and not on
+	*	the number of objects in range.
+	* @param position
+	*	the position to search from
+	* @param maxDistance
+	*	the maximum distance (in 3D) of an object from the position
+	* @param count
+	*	the maximum number of objects to find
+	* @param filter
+	*	the predicate objects must fulfil
+	* @param includeSceneryObjects
+	*	if true, it will also include Scenery objects in the search as defined by Object::isScenery()
+	* @return
+	*	the accepted objects, closest first
+	**/
+	std::vector<std::shared_ptr<Object>> findNearestObjects(const Ego::Vector3f& position, float maxDistance, size_t count, const ObjectFilter& filter, bool includeSceneryObjects = true) const;
+
+	/**
+	* @brief
+	*	Find the nearest object accepted by the filter.
+	* @return
+	*	the object or nullptr if no object within the maximum distance was accepted
+	* @see findNearestObjects
+	**/
+	std::shared_ptr<Object> findNearestObject(const Ego::Vector3f& position, float maxDistance, const ObjectFilter& filter, bool includeSceneryObjects = true) const;
+
+	/**
+	* @brief
+	*	Find all objects accepted by the filter within a radius (in 3D) of a position.
+	* @return
+	*	the accepted objects, closest first
+	**/
+	std::vector<std::shared_ptr<Object>> findObjectsInRadius(const Ego::Vector3f& position, float radius, const ObjectFilter& filter, bool includeSceneryObjects = true) const;
+
+	/**
+	* @brief
+	*	Find the nearest object accepted by the filter within a cone in front of a position.
+	* @param facing
+	*	the direction the cone is facing
+	* @param halfAngle
+	*	objects are within the cone if their direction differs from the facing by less than this
+	* @return
+	*	the object or nullptr if no object within the cone and the maximum distance was accepted
+	* @see findNearestObjects
+	**/
+	std::shared_ptr<Object> findNearestObjectInCone(const Ego::Vector3f& position, Facing facing, FACING_T halfAngle, float maxDistance, const ObjectFilter& filter, bool includeSceneryObjects = true) const;
+
+	/**
+	* @brief
+	* 	Clear and rebuild the quad tree of dynamic objects for this update frame.
+	*	Scenery objects are kept in a separate quad tree which is updated incrementally:
+	*	only objects which appeared, disappeared, moved or became (non-)scenery are touched.
 	*	This function is NOT thread-safe
 	* @param minX, minY, maxX, maxY
 	*	Sets the bounds of this quad tree (size of the entire current level)
 	**/
 	void updateQuadTree(float minX, float minY, float maxX, float maxY);
 
+#if defined(_DEBUG)
+	/**
+	* @brief
+	*	Check that the quad tree of scenery objects contains exactly the scenery objects
+	*	which are neither terminated nor hidden, at their current bounds.
+	* @return
+	*	true if the quad tree of scenery objects is consistent
+	**/
+	bool checkStaticObjects() const;
+#endif
+
 	/**
 	* @return
 	*	All objects contained in this ObjectHandler
 	**/
 	const std::vector<std::shared_ptr<Object>>& getAllObjects() const {return _iteratorList; }
 
+	/**
+	* @brief
+	*	Get the references of all objects currently on the specified team.
+	*	This index is maintained incrementally (spawn, team change, removal) so
+	*	the cost of using it scales with the size of the team, not with the world.
+	* @param team
+	*	the team
+	* @return
+	*	the references of all objects on that team, sorted by object reference
+	**/
+	const std::set<ObjectRef>& getTeamMembers(TEAM_REF team) const;
+
+	/**
+	* @brief
+	*	Get the references of all objects whose profile has the specified IDSZ
+	*	in the specified IDSZ slot (e.g. IDSZ_PARENT, IDSZ_TYPE or IDSZ_SPECIAL).
+	*	This index is maintained incrementally (spawn, polymorph, removal).
+	* @return
+	*	the references of all matching objects, sorted by object reference
+	**/
+	const std::set<ObjectRef>& getObjectsWithIDSZ(size_t idszSlot, const IDSZ2& idsz) const;
+
+	/**
+	* @brief
+	*	Notify this ObjectHandler that an object has changed its team.
+	*	Called by Object::assignTeam, do not call directly.
+	**/
+	void onTeamChanged(ObjectRef ref, TEAM_REF oldTeam, TEAM_REF newTeam);
+
+	/**
+	* @brief
+	*	Notify this ObjectHandler that an object has changed its profile (polymorph).
+	*	Called by Object::polymorphObject, do not call directly.
+	**/
+	void onProfileChanged(ObjectRef ref, const std::shared_ptr<ObjectProfile> &oldProfile);
+
 private:
 
 	/**
@@ -214,6 +331,21 @@ private:
 	 */
 	void maybeRunDeferred();
 
+	/**
+	 * @brief
+	 *	Add, move or remove an object in the quad tree of scenery objects.
+	 * @param isStatic
+	 *	true if the object should be contained in the quad tree of scenery objects
+	 */
+	void updateStaticObject(const std::shared_ptr<Object> &object, bool isStatic);
+
+	/**
+	 * @brief
+	 *	Add or remove an object to or from the IDSZ index using the IDSZs of the specified profile.
+	 */
+	void indexIDSZ(ObjectRef ref, const ObjectProfile &profile);
+	void unindexIDSZ(ObjectRef ref, const ObjectProfile &profile);
+
 #if defined(_DEBUG)
 	/**
 	 * @brief
@@ -225,7 +357,8 @@ private:
 private:
 	Ego::QuadTree<Object> _dynamicObjects;			//Objects that can move (Creatures, moving platforms, etc.)
 	Ego::QuadTree<Object> _staticObjects;			//Objects that rarely move - if ever (Trees, pillars, chairs)
-	int _updateStaticTreeClock;
+	Ego::AxisAlignedBox2f _staticObjectsBounds;		//Bounds of the static quad tree, it is only reset if they change
+	std::unordered_map<const Object*, Ego::AxisAlignedBox2f> _staticObjectBounds; //Objects in the static quad tree and the bounds they were inserted with
 
 	std::unordered_map<ObjectRef, std::shared_ptr<Object>> _internalCharacterList; ///< Maps object references to shared pointers to objects
 	std::vector<std::shared_ptr<Object>> _iteratorList;					///< For iterating, contains only valid objects (unsorted)
@@ -237,5 +370,8 @@ private:
 
 	size_t _totalCharactersSpawned;										///< Total count of characters spawned (includes removed)
 
+	std::array<std::set<ObjectRef>, Team::TEAM_MAX> _teamMembers;		///< Secondary index: team -> members
+	std::vector<std::unordered_map<IDSZ2, std::set<ObjectRef>>> _idszMembers; ///< Secondary index: IDSZ slot -> IDSZ -> objects
+
 	friend class ObjectIterator;
 };
@@ -30,6 +30,7 @@
 #include "egolib/game/game.h"
 #include "egolib/game/Physics/PhysicalConstants.hpp"
 #include "egolib/game/CharacterMatrix.h"
+#include "egolib/Logic/Team.hpp"
 
 namespace Ego
 {
@@ -568,8 +569,12 @@ size_t Particle::updateContinuousSpawning()
 
     //Optimization: Only spawn cosmetic sub-particles if we ourselves were rendered
     //This prevents a lot of cosmetic particles from spawning outside visible range
-    const std::shared_ptr<ParticleProfile>& childProfile = ProfileSystem::get().ParticleProfileSystem.get_ptr(getProfile()->contspawn._lpip.get());
-    if(!childProfile->force && !inst.indolist) {
+    const PIP_REF childProfileRef = ParticleHandler::get().getParticleProfile(_spawnerProfile, getProfile()->contspawn._lpip);
+    const std::shared_ptr<ParticleProfile>& childProfile = ProfileSystem::get().ParticleProfileSystem.get_ptr(childProfileRef);
+    if (!childProfile) {
+        return spawn_count;
+    }
+    if(!childProfile->getSpawnTemplate().force && !inst.indolist) {
 
         //Is is something that spawns often? (often = at least once every 2 seconds)
         if(contspawn_timer < GameEngine::GAME_TARGET_UPS * 2) {
@@ -583,28 +588,25 @@ size_t Particle::updateContinuousSpawning()
     // reset the spawn timer
     contspawn_timer = getProfile()->contspawn._delay;
 
-    Facing facingAdd = this->facing;
-    for (size_t tnc = 0; tnc < getProfile()->contspawn._amount; tnc++)
-    {
-        std::shared_ptr<Ego::Particle> prt_child;
-        if(_spawnerProfile == ObjectProfileRef::Invalid) {
-            prt_child = ParticleHandler::get().spawnGlobalParticle(getPosition(), facingAdd, getProfile()->contspawn._lpip, tnc);
-        }
-        else {
-            prt_child = ParticleHandler::get().spawnLocalParticle(getPosition(), facingAdd, ObjectProfileRef(_spawnerProfile), getProfile()->contspawn._lpip,
-                                                                  ObjectRef::Invalid, GRIP_LAST, team, owner_ref, _particleID, tnc, _target);
-        }
+    //Keep count of how many were actually spawned
+    spawn_count = spawnChildParticles(getProfile()->contspawn, getPosition());
 
-        if (prt_child)
-        {
-            //Keep count of how many were actually spawned
-            spawn_count++;
-        }
+    return spawn_count;
+}
 
-        facingAdd += Facing(getProfile()->contspawn._facingAdd);
+size_t Particle::spawnChildParticles(const SpawnDescriptor& descriptor, const Vector3f& position)
+{
+    const PIP_REF childProfile = ParticleHandler::get().getParticleProfile(_spawnerProfile, descriptor._lpip);
+    if(_spawnerProfile == ObjectProfileRef::Invalid) {
+        //Global particle
+        return ParticleHandler::get().spawnParticles(childProfile, descriptor._amount, position, facing, Facing(descriptor._facingAdd),
+                                                     ObjectProfileRef::Invalid, ObjectRef::Invalid, GRIP_LAST, Team::TEAM_NULL, ObjectRef::Invalid);
+    }
+    else {
+        //Local particle
+        return ParticleHandler::get().spawnParticles(childProfile, descriptor._amount, position, facing, Facing(descriptor._facingAdd),
+                                                     _spawnerProfile, ObjectRef::Invalid, GRIP_LAST, team, owner_ref, _particleID, _target);
     }
-
-    return spawn_count;
 }
 
 void Particle::updateAttachedDamage()
@@ -726,23 +728,7 @@ void Particle::destroy()
     // Spawn new particles if time for old one is up
     if (getProfile()->endspawn._amount > 0 && LocalParticleProfileRef::Invalid != getProfile()->endspawn._lpip)
     {
-        Facing facingAdd = this->facing;
-        for (size_t tnc = 0; tnc < getProfile()->endspawn._amount; tnc++)
-        {
-            if(_spawnerProfile == ObjectProfileRef::Invalid)
-            {
-                //Global particle
-                ParticleHandler::get().spawnGlobalParticle(getOldPosition(), facingAdd, getProfile()->endspawn._lpip, tnc);
-            }
-            else
-            {
-                //Local particle
-                ParticleHandler::get().spawnLocalParticle(getOldPosition(), facingAdd, ObjectProfileRef(_spawnerProfile), getProfile()->endspawn._lpip,
-                                                          ObjectRef::Invalid, GRIP_LAST, team, owner_ref, _particleID, tnc, _target);
-            }
-
-            facingAdd += Facing(getProfile()->endspawn._facingAdd);
-        }
+        spawnChildParticles(getProfile()->endspawn, getOldPosition());
     }
 
     //Spawn an Object on particle end? (happens through a special script function)
@@ -782,7 +768,7 @@ void Particle::playSound(int8_t sound)
 }
 
 bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos, const Facing& spawnFacing, ObjectProfileRef spawnProfile,
-                          const PIP_REF particleProfile, const ObjectRef spawnAttach, uint16_t vrt_offset, const TEAM_REF spawnTeam,
+                          const PIP_REF particleProfile, const std::shared_ptr<ParticleProfile>& profile, const ObjectRef spawnAttach, uint16_t vrt_offset, const TEAM_REF spawnTeam,
                           const ObjectRef spawnOrigin, const ParticleRef spawnParticleOrigin, const int multispawn, const ObjectRef spawnTarget,
                           const bool onlyOverWater)
 {
@@ -801,9 +787,9 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     //Load particle profile
     _spawnerProfile = spawnProfile.get();
     _particleProfileID = particleProfile;
-    assert(ProfileSystem::get().ParticleProfileSystem.isLoaded(_particleProfileID));
-    _particleProfile = ProfileSystem::get().ParticleProfileSystem.get_ptr(_particleProfileID);
+    _particleProfile = profile;
     assert(_particleProfile != nullptr); //"Tried to spawn particle with invalid PIP_REF"
+    const ParticleSpawnTemplate& spawnTemplate = getProfile()->getSpawnTemplate();
 
     team = spawnTeam;
     parent_ref = ParticleRef(spawnParticleOrigin);
@@ -823,22 +809,22 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     // try to get an idea of who our owner is even if we are
     // given bogus info
     ObjectRef loc_chr_origin = spawnOrigin;
-    if (!_currentModule->getObjectHandler().exists(spawnOrigin) && ParticleHandler::get()[spawnParticleOrigin])
+    if (!_currentModule->getObjectHandler().exists(spawnOrigin))
     {
-        loc_chr_origin = ParticleHandler::get()[spawnParticleOrigin]->getOwner();
+        const std::shared_ptr<Particle>& parent = ParticleHandler::get()[spawnParticleOrigin];
+        if (parent)
+        {
+            loc_chr_origin = parent->getOwner();
+        }
     }
     owner_ref = loc_chr_origin;
+    const std::shared_ptr<Object>& owner = _currentModule->getObjectHandler()[owner_ref];
 
     // Lighting and sound
-    dynalight = getProfile()->dynalight;
-    dynalight.on = false;
-    if (0 == multispawn)
+    dynalight = spawnTemplate.dynalight;
+    if (0 != multispawn)
     {
-        dynalight.on = getProfile()->dynalight.mode;
-        if (DYNA_MODE_LOCAL == getProfile()->dynalight.mode)
-        {
-            dynalight.on = DYNA_MODE_OFF;
-        }
+        dynalight.on = false;
     }
 
     // Set character attachments ( ObjectRef::Invalid means none )
@@ -851,13 +837,13 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     // Targeting...
     vel.z() = 0;
 
-    offset.z() = generate_irand_pair(getProfile()->getSpawnPositionOffsetZ()) - (getProfile()->getSpawnPositionOffsetZ().rand / 2);
+    offset.z() = generate_irand_pair(getProfile()->getSpawnPositionOffsetZ()) - spawnTemplate.positionOffsetZBias;
     tmp_pos.z() += offset.z();
     const int velocity = generate_irand_pair(getProfile()->getSpawnVelocityOffsetXY());
 
     //Set target
     _target = spawnTarget;
-    if (getProfile()->newtargetonspawn)
+    if (spawnTemplate.newTarget)
     {
         if (getProfile()->targetcaster)
         {
@@ -867,10 +853,10 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
         else
         {
             const float PERFECT_AIM = 45.0f;   // 45 dex is perfect aim
-            float attackerAgility = _currentModule->getObjectHandler().get(owner_ref)->getAttribute(Ego::Attribute::AGILITY);
+            float attackerAgility = owner->getAttribute(Ego::Attribute::AGILITY);
 
             //Sharpshooter Perk improves aim by 25%
-            if(_currentModule->getObjectHandler().get(owner_ref)->hasPerk(Ego::Perks::SHARPSHOOTER)) {
+            if(owner->hasPerk(Ego::Perks::SHARPSHOOTER)) {
                 attackerAgility = std::min(PERFECT_AIM, attackerAgility*1.25f);
             }
 
@@ -879,7 +865,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
             _target = prt_find_target(spawnPos, idlib::canonicalize(loc_facing), _particleProfileID, spawnTeam, owner_ref, spawnTarget, &targetAngle);
             const std::shared_ptr<Object> &target = _currentModule->getObjectHandler()[_target];
 
-            if (target && !getProfile()->homing)
+            if (target && !spawnTemplate.homing)
             {
                 //Correct angle to new target
                 loc_facing -= Facing(targetAngle);
@@ -901,7 +887,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
                     aimError -= (0.5f/PERFECT_AIM) * attackerAgility;
                 }
 
-                offsetfacing = Random::next(getProfile()->getSpawnFacing().rand) - (getProfile()->getSpawnFacing().rand / 2);
+                offsetfacing = Random::next(getProfile()->getSpawnFacing().rand) - spawnTemplate.aimErrorBias;
                 offsetfacing *= aimError;
             }
 
@@ -950,7 +936,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     else
     {
         // Correct loc_facing for randomness
-        offsetfacing = generate_irand_pair(getProfile()->getSpawnFacing()) - (getProfile()->getSpawnFacing().base + getProfile()->getSpawnFacing().rand / 2);
+        offsetfacing = generate_irand_pair(getProfile()->getSpawnFacing()) - spawnTemplate.facingBias;
     }
     loc_facing += Facing(offsetfacing);
     facing = Facing(loc_facing);
@@ -965,8 +951,9 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     tmp_pos[kY] += offset[kY];
 
     //Particles can only spawn inside the map bounds
-    tmp_pos[kX] = Ego::Math::constrain(tmp_pos[kX], 0.0f, _currentModule->getMeshPointer()->_tmem._edge_x - 2.0f);
-    tmp_pos[kY] = Ego::Math::constrain(tmp_pos[kY], 0.0f, _currentModule->getMeshPointer()->_tmem._edge_y - 2.0f);
+    const auto& tileMemory = _currentModule->getMeshPointer()->_tmem;
+    tmp_pos[kX] = Ego::Math::constrain(tmp_pos[kX], 0.0f, tileMemory._edge_x - 2.0f);
+    tmp_pos[kY] = Ego::Math::constrain(tmp_pos[kY], 0.0f, tileMemory._edge_y - 2.0f);
 
     setPosition(tmp_pos);
     setSpawnPosition(tmp_pos);
@@ -979,7 +966,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     // Velocity data
     vel.x() = -std::cos(loc_facing) * velocity;
     vel.y() = -std::sin(loc_facing) * velocity;
-    vel.z() += generate_irand_pair(getProfile()->getSpawnVelocityOffsetZ()) - (getProfile()->getSpawnVelocityOffsetZ().rand / 2);
+    vel.z() += generate_irand_pair(getProfile()->getSpawnVelocityOffsetZ()) - spawnTemplate.velocityOffsetZBias;
     this->setVelocity(vel);
     this->setOldVelocity(vel);
     this->vel_stt = vel;
@@ -995,16 +982,16 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     size_stt = getProfile()->size_base;
     size_add = getProfile()->size_add;
 
-    _image._start = (getProfile()->image_stt)*EGO_ANIMATION_MULTIPLIER;
+    _image._start = spawnTemplate.imageStart;
     _image._add = generate_irand_pair(getProfile()->image_add);
-    _image._count = (getProfile()->image_max)*EGO_ANIMATION_MULTIPLIER;
+    _image._count = spawnTemplate.imageCount;
 
     // a particle can EITHER end_lastframe or end_time.
     // if it ends after the last frame, end_time tells you the number of cycles through
     // the animation
     int prt_anim_frames_updates = 0;
     bool prt_anim_infinite = false;
-    if (getProfile()->end_lastframe)
+    if (spawnTemplate.endOnLastFrame)
     {
         if (0 == _image._add)
         {
@@ -1013,13 +1000,8 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
         }
         else
         {
-            prt_anim_frames_updates = _image.getUpdateCount();
-
-            if (getProfile()->end_time > 0)
-            {
-                // Part time is used to give number of cycles
-                prt_anim_frames_updates *= getProfile()->end_time;
-            }
+            // Part time is used to give number of cycles
+            prt_anim_frames_updates = _image.getUpdateCount() * spawnTemplate.animationCycles;
         }
     }
     else
@@ -1033,13 +1015,13 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     // estimate the number of frames
     int prt_life_frames_updates = 0;
     bool prt_life_infinite = false;
-    if (getProfile()->end_lastframe)
+    if (spawnTemplate.endOnLastFrame)
     {
         // for end last frame, the lifetime is given by the number of animation frames
         prt_life_frames_updates = prt_anim_frames_updates;
         prt_life_infinite = prt_anim_infinite;
     }
-    else if (getProfile()->end_time <= 0)
+    else if (0 == spawnTemplate.lifetime)
     {
         // zero or negative lifetime == infinite lifetime
         prt_life_frames_updates = INFINITE_UPDATES;
@@ -1047,7 +1029,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     }
     else
     {
-        prt_life_frames_updates = getProfile()->end_time;
+        prt_life_frames_updates = spawnTemplate.lifetime;
     }
     prt_life_frames_updates = std::max(1, prt_life_frames_updates);
 
@@ -1078,17 +1060,16 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     frames_remaining = frames_total;
 
     // Damage stuff
-    damage = range_to_pair(getProfile()->damage);
+    damage = spawnTemplate.damage;
 
     //If it is a FIRE particle spawned by a Pyromaniac, increase damage by 25%
-    const std::shared_ptr<Object> &owner = _currentModule->getObjectHandler()[owner_ref];
     if(owner != nullptr && owner->hasPerk(Ego::Perks::PYROMANIAC)) {
         damage.base *= 1.25f;
         damage.rand *= 1.25f;
     }
 
     // Spawning data
-    if (0 != getProfile()->contspawn._delay)
+    if (spawnTemplate.continuousSpawn)
     {
         contspawn_timer = 1;
 
@@ -1115,7 +1096,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     }
 
     // get an initial value for the _isHoming variable
-    _isHoming = getProfile()->homing && !isAttached();
+    _isHoming = spawnTemplate.homing && !isAttached();
 
     //enable or disable gravity
     no_gravity = getProfile()->ignore_gravity;
@@ -283,11 +283,13 @@ public:
     /**
     * @brief
     *   initialize a Particle so that it is ready to be used
+    * @param profile
+    *   the loaded profile referenced by @a particleProfile
     * @note
     *   Should only ever be used by the ParticleHandler! *Do not use*
     **/
     bool initialize(const ParticleRef particleID, const Vector3f& spawnPos, const Facing& spawnFacing, ObjectProfileRef spawnProfile,
-                    const PIP_REF particleProfile, const ObjectRef spawnAttach, uint16_t vrt_offset, const TEAM_REF spawnTeam,
+                    const PIP_REF particleProfile, const std::shared_ptr<ParticleProfile>& profile, const ObjectRef spawnAttach, uint16_t vrt_offset, const TEAM_REF spawnTeam,
                     const ObjectRef spawnOrigin, const ParticleRef spawnParticleOrigin, const int multispawn, const ObjectRef spawnTarget,
                     const bool onlyOverWater);
 
@@ -324,6 +326,15 @@ private:
     **/
     size_t updateContinuousSpawning();
 
+    /**
+    * @brief
+    *   Spawn the particles described by a spawn descriptor of our profile in one pass.
+    *   They belong to our spawner profile, or are global particles if there is none.
+    * @return
+    *   the number of particles that were spawned
+    **/
+    size_t spawnChildParticles(const SpawnDescriptor& descriptor, const Vector3f& position);
+
     /**
     * @brief
     *   This makes the particle deal damage to whomever it is attached to
@@ -46,7 +46,7 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnLocalParticle
     }
 
     //Local character pip
-    PIP_REF ipip = ProfileSystem::get().getProfile(iprofile)->getParticleProfile(pip_index); 
+    PIP_REF ipip = getParticleProfile(iprofile, pip_index);
 
     return spawnParticle(pos, facing, iprofile, ipip, chr_attach, vrt_offset, team, chr_origin, prt_origin, multispawn, oldtarget);
 }
@@ -75,7 +75,7 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnGlobalParticle(const Ego::V
                                                                     const LocalParticleProfileRef& pip_index, int multispawn, const bool onlyOverWater)
 {
     //Get global particle profile
-    PIP_REF globalProfile = ((pip_index.get() < 0) || (pip_index.get() > MAX_PIP)) ? MAX_PIP : static_cast<PIP_REF>(pip_index.get());
+    PIP_REF globalProfile = getParticleProfile(ObjectProfileRef::Invalid, pip_index);
 
     return spawnParticle(spawnPos, spawnFacing, ObjectProfileRef::Invalid, globalProfile, ObjectRef::Invalid, GRIP_LAST, Team::TEAM_NULL,
                          ObjectRef::Invalid, ParticleRef::Invalid, multispawn, ObjectRef::Invalid, onlyOverWater);
@@ -105,7 +105,7 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Ego::Vector3
     std::shared_ptr<Ego::Particle> particle = getFreeParticle(ppip->force);
     if(particle) {
         //Initialize particle and add it into the game
-        if(particle->initialize(ParticleRef(_totalParticlesSpawned++), spawnPos, spawnFacing, spawnProfile, particleProfile, spawnAttach, vrt_offset, 
+        if(particle->initialize(ParticleRef(_totalParticlesSpawned++), spawnPos, spawnFacing, spawnProfile, particleProfile, ppip, spawnAttach, vrt_offset, 
                                 spawnTeam, spawnOrigin, ParticleRef(spawnParticleOrigin), multispawn, spawnTarget, onlyOverWater)) 
         {
             _pendingParticles.push_back(particle);
@@ -131,6 +131,77 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Ego::Vector3
     return particle;
 }
 
+size_t ParticleHandler::spawnParticles(const PIP_REF particleProfile, size_t count, const Ego::Vector3f& spawnPos, const Facing& spawnFacing,
+                                       const Facing& facingAdd, const ObjectProfileRef spawnProfile, const ObjectRef spawnAttach, uint16_t vrt_offset,
+                                       const TEAM_REF spawnTeam, const ObjectRef spawnOrigin, const ParticleRef spawnParticleOrigin, const ObjectRef spawnTarget)
+{
+    if (0 == count)
+    {
+        return 0;
+    }
+
+    const std::shared_ptr<ParticleProfile> &ppip = ProfileSystem::get().ParticleProfileSystem.get_ptr(particleProfile);
+    if (!ppip)
+    {
+        Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "unable to spawn particles with invalid particle profile ", REF_TO_INT(particleProfile),
+                                         ", spawn origin == ", spawnOrigin.get(), ", spawn profile == ", spawnProfile, Log::EndOfEntry);
+        return 0;
+    }
+    const bool force = ppip->getSpawnTemplate().force;
+
+    // count all the requests for this particle type
+    ppip->_spawnRequestCount += count;
+
+    _pendingParticles.reserve(_pendingParticles.size() + count);
+    _particleMap.reserve(_particleMap.size() + count);
+
+    size_t spawned = 0, failed = 0;
+    Facing facing = spawnFacing;
+    for (size_t i = 0; i < count; ++i, facing += facingAdd)
+    {
+        std::shared_ptr<Ego::Particle> particle = getFreeParticle(force);
+        if (!particle) {
+            failed++;
+            continue;
+        }
+        if (particle->initialize(ParticleRef(_totalParticlesSpawned++), spawnPos, facing, spawnProfile, particleProfile, ppip, spawnAttach, vrt_offset,
+                                 spawnTeam, spawnOrigin, spawnParticleOrigin, static_cast<int>(i), spawnTarget, false))
+        {
+            _pendingParticles.push_back(particle);
+            _particleMap[particle->getParticleID()] = particle;
+            spawned++;
+        }
+        else {
+            //If we failed to spawn somehow, put it back to the unused pool
+            _unusedPool.push_back(particle);
+        }
+    }
+
+    if (failed > 0) {
+        Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "unable to allocate ", failed, " of ", count, " particles. ",
+                                         "owner == ", spawnOrigin, ", spawn profile == ", spawnProfile, ", ",
+                                         "particle profile == ", REF_TO_INT(particleProfile), " (`", ppip->_name, "`)",
+                                         Log::EndOfEntry);
+    }
+
+    return spawned;
+}
+
+PIP_REF ParticleHandler::getParticleProfile(const ObjectProfileRef spawnProfile, const LocalParticleProfileRef& pip_index) const
+{
+    if (ObjectProfileRef::Invalid == spawnProfile)
+    {
+        //Global particle profile
+        return ((pip_index.get() < 0) || (pip_index.get() > MAX_PIP)) ? MAX_PIP : static_cast<PIP_REF>(pip_index.get());
+    }
+    if (!ProfileSystem::get().isLoaded(spawnProfile))
+    {
+        return INVALID_PIP_REF;
+    }
+    //Local character pip
+    return ProfileSystem::get().getProfile(spawnProfile)->getParticleProfile(pip_index);
+}
+
 std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
 {
     std::shared_ptr<Ego::Particle> particle = Ego::Particle::INVALID_PARTICLE;
@@ -290,14 +361,9 @@ std::shared_ptr<const Ego::Texture> ParticleHandler::getTransparentParticleTextu
 
 void ParticleHandler::spawnPoof(const std::shared_ptr<Object> &object)
 {
-    Facing facing_z = object->ori.facing_z;
-    for (int cnt = 0; cnt < object->getProfile()->getParticlePoofAmount(); cnt++)
-    {
-        ParticleHandler::get().spawnParticle(object->getOldPosition(), facing_z, object->getProfile()->getSlotNumber(), object->getProfile()->getParticlePoofProfile(),
-                                             ObjectRef::Invalid, GRIP_LAST, object->team, object->ai.owner, ParticleRef::Invalid, cnt);
-
-        facing_z += Facing(object->getProfile()->getParticlePoofFacingAdd());
-    }
+    const std::shared_ptr<ObjectProfile> &profile = object->getProfile();
+    spawnParticles(profile->getParticlePoofProfile(), profile->getParticlePoofAmount(), object->getOldPosition(), object->ori.facing_z,
+                   Facing(profile->getParticlePoofFacingAdd()), profile->getSlotNumber(), ObjectRef::Invalid, GRIP_LAST, object->getTeamID(), object->ai.owner);
 }
 
 void ParticleHandler::spawnDefencePing(const std::shared_ptr<Object> &object, const std::shared_ptr<Object> &attacker)
@@ -199,6 +199,30 @@ public:
                                                  const ObjectRef spawnOrigin, const ParticleRef spawnParticleOrigin = ParticleRef::Invalid, const int multispawn = 0,
                                                  const ObjectRef spawnTarget = ObjectRef::Invalid, const bool onlyOverWater = false);
 
+    /**
+     * @brief
+     *  Spawn @a count particles of the same profile in one pass, as if spawnParticle() was called for each
+     *  with @a multispawn set to its index. The profile is looked up once.
+     * @param facingAdd
+     *  added to the facing of each particle to obtain the facing of the next one
+     * @return
+     *  the number of particles that were spawned
+     */
+    size_t spawnParticles(const PIP_REF particleProfile, size_t count, const Ego::Vector3f& spawnPos, const Facing& spawnFacing, const Facing& facingAdd,
+                          const ObjectProfileRef spawnProfile, const ObjectRef spawnAttach, uint16_t vrt_offset, const TEAM_REF spawnTeam,
+                          const ObjectRef spawnOrigin, const ParticleRef spawnParticleOrigin = ParticleRef::Invalid,
+                          const ObjectRef spawnTarget = ObjectRef::Invalid);
+
+    /**
+     * @brief
+     *  Get the particle profile a local particle profile reference refers to.
+     * @param spawnProfile
+     *  the object profile of the local particle profile or ObjectProfileRef::Invalid for a global particle profile
+     * @return
+     *  the particle profile or INVALID_PIP_REF if the object profile is not loaded
+     */
+    PIP_REF getParticleProfile(const ObjectProfileRef spawnProfile, const LocalParticleProfileRef& pip_index) const;
+
     /**
     * @brief
     *   Spawns a global particle
@@ -31,6 +31,95 @@ static const float MD2_NORMALS[MD2Model::normalCount][3] =
     , {0, 0, 0}                     ///< the "equal light" normal
 };
 
+MD2_PackedVertex MD2_Frame::encode(const Ego::Vector3f& pos, const Ego::Vector3f& nrm, size_t normal,
+                                    const Ego::Vector3f& scale, const Ego::Vector3f& offset)
+{
+    MD2_PackedVertex vertex;
+
+    // quantise the position relative to the bounds of the frame
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const float q = scale[i] > 0.0f ? (pos[i] - offset[i]) / scale[i] : 0.0f;
+        vertex.pos[i] = static_cast<uint16_t>(Ego::Math::constrain(std::round(q), 0.0f, 65535.0f));
+    }
+
+    // project the normal onto the octahedron and fold the lower hemisphere over the upper one
+    const float l1 = std::abs(nrm[kX]) + std::abs(nrm[kY]) + std::abs(nrm[kZ]);
+    if (l1 > 0.0f)
+    {
+        float x = nrm[kX] / l1,
+              y = nrm[kY] / l1;
+        if (nrm[kZ] < 0.0f)
+        {
+            const float t = x;
+            x = std::copysign(1.0f - std::abs(y), t);
+            y = std::copysign(1.0f - std::abs(t), y);
+        }
+        vertex.nrm[0] = static_cast<int16_t>(std::round(Ego::Math::constrain(x, -1.0f, 1.0f) * 32767.0f));
+        vertex.nrm[1] = static_cast<int16_t>(std::round(Ego::Math::constrain(y, -1.0f, 1.0f) * 32767.0f));
+    }
+    else
+    {
+        vertex.nrm[0] = vertex.nrm[1] = MD2_PackedVertex::zeroNormal;
+    }
+
+    vertex.normal = static_cast<uint8_t>(std::min(normal, static_cast<size_t>(MD2_MAX_NORMALS)));
+    return vertex;
+}
+
+void MD2_Frame::pack()
+{
+    if (vertexList.empty())
+    {
+        return;
+    }
+
+    // the bounds of the frame are quantised with 16 bit
+    Ego::Vector3f mins = vertexList.front().pos,
+                  maxs = vertexList.front().pos;
+    for (const MD2_Vertex& vertex : vertexList)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            mins[i] = std::min(mins[i], vertex.pos[i]);
+            maxs[i] = std::max(maxs[i], vertex.pos[i]);
+        }
+    }
+    packedOffset = mins;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        packedScale[i] = (maxs[i] - mins[i]) / 65535.0f;
+    }
+
+    packedVertexList.resize(vertexList.size());
+    for (size_t i = 0; i < vertexList.size(); ++i)
+    {
+        packedVertexList[i] = encode(vertexList[i].pos, vertexList[i].nrm, vertexList[i].normal, packedScale, packedOffset);
+    }
+    std::vector<MD2_Vertex>().swap(vertexList);
+}
+
+void MD2_Frame::unpack()
+{
+    if (packedVertexList.empty())
+    {
+        return;
+    }
+    vertexList.resize(packedVertexList.size());
+    for (size_t i = 0; i < packedVertexList.size(); ++i)
+    {
+        vertexList[i].pos = decodePosition(packedVertexList[i]);
+        vertexList[i].nrm = decodeNormal(packedVertexList[i]);
+        vertexList[i].normal = packedVertexList[i].normal;
+    }
+    std::vector<MD2_PackedVertex>().swap(packedVertexList);
+}
+
+size_t MD2_Frame::getVertexMemory() const
+{
+    return vertexList.capacity() * sizeof(MD2_Vertex) + packedVertexList.capacity() * sizeof(MD2_PackedVertex);
+}
+
 MD2Model::MD2Model() :
 	_vertices(0),
 	_skins(),
@@ -47,10 +136,39 @@ float MD2Model::getMD2Normal(size_t normal, size_t index)
 	return MD2_NORMALS[normal][index];
 }
 
+void MD2Model::setPacked(bool packed)
+{
+    for (MD2_Frame &frame : _frames)
+    {
+        if (packed)
+        {
+            frame.pack();
+        }
+        else
+        {
+            frame.unpack();
+        }
+    }
+}
+
+size_t MD2Model::getVertexMemory() const
+{
+    size_t bytes = 0;
+    for (const MD2_Frame &frame : _frames)
+    {
+        bytes += frame.getVertexMemory();
+    }
+    return bytes;
+}
+
 void MD2Model::scaleModel(const float scaleX, const float scaleY, const float scaleZ)
 {
     for(MD2_Frame &frame : _frames)
     {
+        // scale the float representation and pack it again if necessary
+        const bool packed = frame.isPacked();
+        frame.unpack();
+
         bool boundingBoxFound = false;
 
         for(MD2_Vertex& vertex : frame.vertexList)
@@ -80,6 +198,11 @@ void MD2Model::scaleModel(const float scaleX, const float scaleY, const float sc
                 frame.bb.join(opos);
             }
         }
+
+        if (packed)
+        {
+            frame.pack();
+        }
 #if 0
         // we don't really want objects that have extent in more than one
         // dimension to be called empty
@@ -108,6 +231,10 @@ void MD2Model::makeEquallyLit()
 	    {
 	        vertex.normal = MD2Model::normalCount -1;
 	    }
+	    for(MD2_PackedVertex &vertex : frame.packedVertexList)
+	    {
+	        vertex.normal = MD2Model::normalCount -1;
+	    }
 	}
 }
 
@@ -43,6 +43,28 @@ public:
     size_t   normal;  ///< index to id-normal array
 };
 
+/// @brief A vertex of a packed frame.
+/// The position is quantised to 16 bit relative to the bounds of its frame, the normal is
+/// octahedral-encoded with 16 bit per component. 12 bytes instead of the 32 bytes of a MD2_Vertex.
+class MD2_PackedVertex
+{
+public:
+	MD2_PackedVertex() :
+		pos{0, 0, 0},
+		nrm{0, 0},
+		normal(0)
+	{
+		//ctor
+	}
+
+	/// Both components of @a nrm are set to this value for a zero normal.
+	static constexpr int16_t zeroNormal = std::numeric_limits<int16_t>::min();
+
+	uint16_t pos[3];
+	int16_t  nrm[2];
+	uint8_t  normal;  ///< index to id-normal array
+};
+
 class MD2_TexCoord
 {
 public:
@@ -79,6 +101,9 @@ public:
 		name(),
 #endif
 		vertexList(),
+		packedVertexList(),
+		packedScale(0.0f, 0.0f, 0.0f),
+		packedOffset(0.0f, 0.0f, 0.0f),
 		bb(),
 		framelip(0),
 		framefx(EMPTY_BIT_FIELD)
@@ -90,6 +115,50 @@ public:
 
     std::vector<MD2_Vertex> vertexList;
 
+    /// The vertices if this frame is packed. Either this or vertexList is empty.
+    std::vector<MD2_PackedVertex> packedVertexList;
+    Ego::Vector3f packedScale;   ///< a quantised position is multiplied by this ...
+    Ego::Vector3f packedOffset;  ///< ... and this is added to obtain the position
+
+    inline bool isPacked() const { return !packedVertexList.empty(); }
+
+    /// @brief Replace vertexList by packedVertexList.
+    void pack();
+
+    /// @brief Replace packedVertexList by vertexList.
+    void unpack();
+
+    inline Ego::Vector3f decodePosition(const MD2_PackedVertex& vertex) const
+    {
+        return Ego::Vector3f(vertex.pos[0] * packedScale[kX] + packedOffset[kX],
+                             vertex.pos[1] * packedScale[kY] + packedOffset[kY],
+                             vertex.pos[2] * packedScale[kZ] + packedOffset[kZ]);
+    }
+
+    static inline Ego::Vector3f decodeNormal(const MD2_PackedVertex& vertex)
+    {
+        if (MD2_PackedVertex::zeroNormal == vertex.nrm[0]) {
+            return Ego::Vector3f(0.0f, 0.0f, 0.0f);
+        }
+        float x = vertex.nrm[0] * (1.0f / 32767.0f),
+              y = vertex.nrm[1] * (1.0f / 32767.0f),
+              z = 1.0f - std::abs(x) - std::abs(y);
+        // Unfold the lower hemisphere.
+        if (z < 0.0f) {
+            const float t = x;
+            x = std::copysign(1.0f - std::abs(y), t);
+            y = std::copysign(1.0f - std::abs(t), y);
+        }
+        const float invLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+        return Ego::Vector3f(x * invLength, y * invLength, z * invLength);
+    }
+
+    static MD2_PackedVertex encode(const Ego::Vector3f& pos, const Ego::Vector3f& nrm, size_t normal,
+                                   const Ego::Vector3f& scale, const Ego::Vector3f& offset);
+
+    /// @return the number of bytes occupied by the vertices of this frame
+    size_t getVertexMemory() const;
+
     oct_bb_t bb;        ///< axis-aligned octagonal bounding box limits
     int framelip;       ///< the position in the current animation
     BIT_FIELD framefx;  ///< the special effects associated with this frame
@@ -118,6 +187,17 @@ public:
 	**/
 	void makeEquallyLit();
 
+	/**
+	* @brief Pack or unpack all frames.
+	* @see MD2_Frame::pack
+	**/
+	void setPacked(bool packed);
+
+	/**
+	* @return number of bytes occupied by the vertices of all frames
+	**/
+	size_t getVertexMemory() const;
+
 	/**
 	* @return number of optimized OpenGL commands stored for rendering this model
 	**/
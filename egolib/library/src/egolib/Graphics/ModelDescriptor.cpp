@@ -4,6 +4,7 @@
 #include "egolib/Core/StringUtilities.hpp"
 #include "egolib/fileutil.h"
 #include "egolib/Logic/ObjectSlot.hpp"
+#include "egolib/egoboo_setup.h"
 
 namespace Ego
 {
@@ -137,6 +138,11 @@ ModelDescriptor::ModelDescriptor(const std::string &folderPath) :
     ///      solution is to scale the model!
     _md2Model->scaleModel(-3.5f, 3.5f, 3.5f);
 
+    // Keep the frames quantised unless the float representation was requested.
+    _md2Model->setPacked(egoboo_config_t::get().graphic_md2_packedFrames_enable.getValue());
+    Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "model ", "`", folderPath, "`", " frame vertices occupy ",
+                                     _md2Model->getVertexMemory(), " bytes", Log::EndOfEntry);
+
     // Create the actions table for this imad
     ripActions();
     healActions(folderPath + "/copy.txt");
@@ -0,0 +1,182 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/TextureCache.cpp
+/// @brief An on-disk cache of preprocessed textures.
+
+#include "egolib/Graphics/TextureCache.hpp"
+#include "egolib/vfs.h"
+
+namespace Ego {
+
+namespace {
+
+const char MAGIC[8] = { 'E', 'G', 'O', 'T', 'E', 'X', '\0', '\0' };
+
+void putUint32(std::vector<char>& buffer, uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+bool getUint32(const std::vector<char>& buffer, size_t& position, uint32_t& value)
+{
+    if (buffer.size() - position < 4)
+    {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        value |= uint32_t(static_cast<uint8_t>(buffer[position++])) << (i * 8);
+    }
+    return true;
+}
+
+} // namespace
+
+TextureCache::TextureCache(const std::string& directory) :
+    _directory(directory),
+    _directoryCreated(false)
+{}
+
+uint64_t TextureCache::getKey(const char *bytes, size_t size)
+{
+    // 64 bit FNV-1a over the version and the contents, finished with the length.
+    uint64_t hash = 14695981039346656037ULL;
+    hash ^= VERSION;
+    hash *= 1099511628211ULL;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8_t>(bytes[i]);
+        hash *= 1099511628211ULL;
+    }
+    hash ^= size;
+    hash *= 1099511628211ULL;
+    return hash;
+}
+
+std::string TextureCache::getPathname(uint64_t key) const
+{
+    std::ostringstream stream;
+    stream << _directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".tex";
+    return stream.str();
+}
+
+std::shared_ptr<TexturePayload> TextureCache::load(uint64_t key) const
+{
+    const auto pathname = getPathname(key);
+    if (!vfs_exists(pathname))
+    {
+        return nullptr;
+    }
+    std::vector<char> buffer;
+    try
+    {
+        vfs_readEntireFile(pathname, [&buffer](size_t size, const char *bytes) { buffer.insert(buffer.end(), bytes, bytes + size); });
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+
+    // Header.
+    if (buffer.size() < sizeof(MAGIC) || 0 != std::memcmp(buffer.data(), MAGIC, sizeof(MAGIC)))
+    {
+        return nullptr;
+    }
+    size_t position = sizeof(MAGIC);
+    uint32_t version, hasAlpha, sourceWidth, sourceHeight, levelCount;
+    if (!getUint32(buffer, position, version) || VERSION != version ||
+        !getUint32(buffer, position, hasAlpha) ||
+        !getUint32(buffer, position, sourceWidth) ||
+        !getUint32(buffer, position, sourceHeight) ||
+        !getUint32(buffer, position, levelCount) || 0 == levelCount)
+    {
+        return nullptr;
+    }
+    auto payload = std::make_shared<TexturePayload>();
+    payload->hasAlpha = 0 != hasAlpha;
+    payload->sourceWidth = sourceWidth;
+    payload->sourceHeight = sourceHeight;
+
+    // Levels, the rows are not padded in the file.
+    const auto& pfd = payload->getPixelDescriptor();
+    const size_t bytesPerPixel = pfd.get_color_depth().depth() / 8;
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        uint32_t width, height;
+        if (!getUint32(buffer, position, width) || !getUint32(buffer, position, height) ||
+            0 == width || 0 == height || width > 0x10000 || height > 0x10000 ||
+            buffer.size() - position < size_t(width) * height * bytesPerPixel)
+        {
+            return nullptr;
+        }
+        auto level = std::shared_ptr<SDL_Surface>(SDL_CreateRGBSurface(SDL_SWSURFACE, width, height, pfd.get_color_depth().depth(),
+                                                                       pfd.get_red().get_mask(), pfd.get_green().get_mask(),
+                                                                       pfd.get_blue().get_mask(), pfd.get_alpha().get_mask()),
+                                                  [](SDL_Surface *pSurface) { SDL_FreeSurface(pSurface); });
+        if (!level)
+        {
+            return nullptr;
+        }
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            std::memcpy(static_cast<char *>(level->pixels) + y * level->pitch, buffer.data() + position, width * bytesPerPixel);
+            position += width * bytesPerPixel;
+        }
+        payload->levels.push_back(level);
+    }
+    return payload;
+}
+
+bool TextureCache::store(uint64_t key, const TexturePayload& payload)
+{
+    if (!_directoryCreated)
+    {
+        if (!vfs_isDirectory(_directory) && !vfs_mkdir(_directory))
+        {
+            return false;
+        }
+        _directoryCreated = true;
+    }
+
+    std::vector<char> buffer(MAGIC, MAGIC + sizeof(MAGIC));
+    putUint32(buffer, VERSION);
+    putUint32(buffer, payload.hasAlpha ? 1 : 0);
+    putUint32(buffer, payload.sourceWidth);
+    putUint32(buffer, payload.sourceHeight);
+    putUint32(buffer, payload.levels.size());
+    for (const auto& level : payload.levels)
+    {
+        putUint32(buffer, level->w);
+        putUint32(buffer, level->h);
+        const size_t rowSize = level->w * level->format->BytesPerPixel;
+        for (int y = 0; y < level->h; ++y)
+        {
+            const char *row = static_cast<const char *>(level->pixels) + y * level->pitch;
+            buffer.insert(buffer.end(), row, row + rowSize);
+        }
+    }
+    return vfs_writeEntireFile(getPathname(key), buffer.data(), buffer.size());
+}
+
+} // namespace Ego
@@ -0,0 +1,86 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Graphics/TextureCache.hpp
+/// @brief An on-disk cache of preprocessed textures.
+
+#pragma once
+
+#include "egolib/Renderer/TexturePayload.hpp"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  An on-disk cache of texture payloads keyed by a hash of the contents of the image files.
+ *  If an image file was loaded before, its payload (converted, padded, all mipmap levels)
+ *  is read from the cache and the decoding, the conversion and the mipmap generation are skipped.
+ * @remark
+ *  The cache files are written to the user directory. Entries are never evicted,
+ *  the cache directory can be deleted at any time.
+ */
+class TextureCache
+{
+public:
+    /**
+     * @brief
+     *  Construct this texture cache.
+     * @param directory the directory of the cache files, relative to the user directory
+     */
+    TextureCache(const std::string& directory);
+
+    /**
+     * @brief
+     *  Get the key of an image file.
+     * @param bytes, size the contents of the image file
+     * @return the key
+     */
+    static uint64_t getKey(const char *bytes, size_t size);
+
+    /**
+     * @brief
+     *  Load a payload from the cache.
+     * @param key the key
+     * @return the payload, a null pointer if there is no (valid) cache file for the key
+     */
+    std::shared_ptr<TexturePayload> load(uint64_t key) const;
+
+    /**
+     * @brief
+     *  Store a payload in the cache.
+     * @param key the key
+     * @param payload the payload
+     * @return @a true on success, @a false otherwise
+     */
+    bool store(uint64_t key, const TexturePayload& payload);
+
+private:
+    /// @brief The version of the cache file format and of the preprocessing.
+    /// Increment if either changes, such that old cache files are ignored.
+    static constexpr uint32_t VERSION = 1;
+
+    std::string getPathname(uint64_t key) const;
+
+    std::string _directory;
+
+    /// @brief If the cache directory was created.
+    bool _directoryCreated;
+};
+
+} // namespace Ego
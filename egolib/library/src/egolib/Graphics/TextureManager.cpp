@@ -33,8 +33,8 @@
  *  the texture to load the image in
  * @param filename
  *  the filename of the image <em>without</em> extension.
- * @param key
- *  ?
+ * @param cache
+ *  the cache of preprocessed textures
  * @post
  *  the texture is released and - if loading succeeds - the loaded with a new image.
  *  The filenames this function considers are all combinations of the specified
@@ -42,9 +42,9 @@
  *  succeeds (i.e. the image was successfully loaded into the texture) or all
  *  combinations failed.
  */
-static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename);
+static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename, Ego::TextureCache& cache);
 
-static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename) {
+static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const char *filename, Ego::TextureCache& cache) {
     // Get rid of any old data.
     texture->release();
 
@@ -57,25 +57,38 @@ static bool ego_texture_load_vfs(std::shared_ptr<Ego::Texture> texture, const ch
             texture->release();
             // Build the full file name.
             std::string fullFilename = filename + extension;
-            // Open the file.
-            vfs_FILE *file = vfs_openRead(fullFilename);
-            if (!file) {
+            if (!vfs_exists(fullFilename)) {
                 continue;
             }
-            // Stream the surface.
-            std::shared_ptr<SDL_Surface> surface = nullptr;
+            // Was this image preprocessed before?
+            std::vector<char> bytes;
             try {
-                surface = loader.load(file);
+                vfs_readEntireFile(fullFilename, [&bytes](size_t size, const char *data) { bytes.insert(bytes.end(), data, data + size); });
             } catch (...) {
-                vfs_close(file);
                 continue;
             }
-            vfs_close(file);
-            if (!surface) {
-                continue;
+            const uint64_t key = Ego::TextureCache::getKey(bytes.data(), bytes.size());
+            std::shared_ptr<Ego::TexturePayload> payload = cache.load(key);
+            if (!payload) {
+                // Decode the surface from the bytes already read for the key.
+                std::shared_ptr<SDL_Surface> surface = nullptr;
+                try {
+                    surface = loader.load(SDL_RWFromConstMem(bytes.data(), static_cast<int>(bytes.size())));
+                } catch (...) {
+                    continue;
+                }
+                if (!surface) {
+                    continue;
+                }
+                // Preprocess the surface. 1D textures have no mipmaps.
+                const bool is1D = (1 == surface->h) && (surface->w > 1);
+                payload = Ego::TexturePayload::create(surface, !is1D);
+                if (!cache.store(key, *payload)) {
+                    Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "unable to cache texture file ", "`", fullFilename, "`", Log::EndOfEntry);
+                }
             }
-            // Create the texture from the surface.
-            retval = texture->load(fullFilename, surface);
+            // Create the texture from the payload.
+            retval = texture->load(fullFilename, payload);
             if (retval) {
                 goto End;
             }
@@ -97,7 +110,8 @@ namespace Ego {
 TextureManager::TextureManager() :
     _deferredLoadingMutex(),
     _requestedLoadDeferredTextures(),
-    _notifyDeferredLoadingComplete()
+    _notifyDeferredLoadingComplete(),
+    _payloadCache("/cache/textures")
 {}
 
 TextureManager::~TextureManager() {
@@ -132,7 +146,7 @@ void TextureManager::updateDeferredLoading() {
         std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
         for (const std::string &filePath : _requestedLoadDeferredTextures) {
             auto loadTexture = Ego::Renderer::get().createTexture();
-            ego_texture_load_vfs(loadTexture, filePath.c_str());
+            ego_texture_load_vfs(loadTexture, filePath.c_str(), _payloadCache);
             _textureCache[filePath] = loadTexture;
         }
         _requestedLoadDeferredTextures.clear();
@@ -150,7 +164,7 @@ const std::shared_ptr<Texture>& TextureManager::getTexture(const std::string &fi
         if (SDL_GL_GetCurrentContext() != nullptr) {
             //We are the main OpenGL context thread so we can load textures
             auto loadTexture = Ego::Renderer::get().createTexture();
-            ego_texture_load_vfs(loadTexture, filePath.c_str());
+            ego_texture_load_vfs(loadTexture, filePath.c_str(), _payloadCache);
             _textureCache[filePath] = loadTexture;
         } else {
             //We cannot load textures, wait blocking for main thread to load it for us
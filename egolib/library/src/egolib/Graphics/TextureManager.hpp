@@ -24,6 +24,7 @@
 
 #include "egolib/typedef.h"
 #include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Graphics/TextureCache.hpp"
 
 namespace Ego {
 
@@ -87,6 +88,8 @@ private:
     std::mutex _deferredLoadingMutex;
     std::forward_list<std::string> _requestedLoadDeferredTextures;
     std::condition_variable _notifyDeferredLoadingComplete;
+    /// The preprocessed textures of previous loads.
+    TextureCache _payloadCache;
 };
 
 } // namespace Ego
@@ -36,4 +36,9 @@ std::unordered_set<std::string> ImageLoader::getExtensions() const
     return extensions;
 }
 
+std::shared_ptr<SDL_Surface> ImageLoader::load(vfs_FILE *file) const
+{
+    return load(vfs_openRWops(file, false));
+}
+
 } // namespace Ego
@@ -52,7 +52,13 @@ public:
     /// @param file a file opened for reading
     /// @return an SDL surface on success, @a nullptr on failure
     /// @remark The file is not closed by this function.
-    virtual std::shared_ptr<SDL_Surface> load(vfs_FILE *file) const = 0;
+    std::shared_ptr<SDL_Surface> load(vfs_FILE *file) const;
+
+    /// @brief Load an image using this image loader.
+    /// @param source a source opened for reading e.g. a file already read into memory, may be @a nullptr
+    /// @return an SDL surface on success, @a nullptr on failure
+    /// @remark The source is closed by this function.
+    virtual std::shared_ptr<SDL_Surface> load(SDL_RWops *source) const = 0;
 
 };
 
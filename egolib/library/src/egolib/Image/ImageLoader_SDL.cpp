@@ -25,9 +25,9 @@ ImageLoader_SDL::ImageLoader_SDL(const std::unordered_set<std::string>& extensio
     : ImageLoader(extensions)
 {}
 
-std::shared_ptr<SDL_Surface> ImageLoader_SDL::load(vfs_FILE *file) const
+std::shared_ptr<SDL_Surface> ImageLoader_SDL::load(SDL_RWops *source) const
 {
-    SDL_Surface *surface = SDL_LoadBMP_RW(vfs_openRWops(file, false), 1);
+    SDL_Surface *surface = SDL_LoadBMP_RW(source, 1);
     if (!surface) {
         return nullptr;
     }
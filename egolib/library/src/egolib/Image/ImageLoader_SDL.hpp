@@ -27,7 +27,8 @@ struct ImageLoader_SDL : public ImageLoader
 {
 public:
     ImageLoader_SDL(const std::unordered_set<std::string>& extensions);
-    virtual std::shared_ptr<SDL_Surface> load(vfs_FILE *file) const override;
+    using ImageLoader::load;
+    virtual std::shared_ptr<SDL_Surface> load(SDL_RWops *source) const override;
 };
 
 } } // namespace Ego::Internal
@@ -24,8 +24,8 @@ namespace Ego { namespace Internal {
 ImageLoader_SDL_image::ImageLoader_SDL_image(const std::unordered_set<std::string>& extensions) :
     ImageLoader(extensions) {}
 
-std::shared_ptr<SDL_Surface> ImageLoader_SDL_image::load(vfs_FILE *file) const {
-    SDL_Surface *surface = IMG_Load_RW(vfs_openRWops(file, false), 1);
+std::shared_ptr<SDL_Surface> ImageLoader_SDL_image::load(SDL_RWops *source) const {
+    SDL_Surface *surface = IMG_Load_RW(source, 1);
     if (!surface) {
         return nullptr;
     }
@@ -23,6 +23,9 @@
 
 #include "egolib/Image/SDL_Image_Extensions.h"
 #include "egolib/Image/ImageManager.hpp"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
 
 namespace Ego { namespace SDL {
 
@@ -411,12 +414,149 @@ std::shared_ptr<SDL_Surface> pad_functor<SDL_Surface>::operator()(const std::sha
     // Fill the copy with transparent black.
     SDL_FillRect(newSurface.get(), nullptr, SDL_MapRGBA(newSurface->format, 0, 0, 0, 0));
     // Copy the old surface into the new surface.
-    for (size_t y = 0; y < oldHeight; ++y)
+    if (!oldSurface->format->palette)
+    {
+        // Both surfaces have the same pixel format, copy row by row.
+        const size_t bytesPerPixel = oldSurface->format->BytesPerPixel;
+        for (size_t y = 0; y < oldHeight; ++y)
+        {
+            const uint8_t *source = static_cast<const uint8_t *>(oldSurface->pixels) + y * oldSurface->pitch;
+            uint8_t *target = static_cast<uint8_t *>(newSurface->pixels) + (padding.top + y) * newSurface->pitch + padding.left * bytesPerPixel;
+            std::memcpy(target, source, oldWidth * bytesPerPixel);
+        }
+    }
+    else
+    {
+        for (size_t y = 0; y < oldHeight; ++y)
+        {
+            for (size_t x = 0; x < oldWidth; ++x)
+            {
+                auto p = get_pixel(oldSurface.get(), { x, y });
+                set_pixel(newSurface.get(), p, { padding.left + x, padding.top + y });
+            }
+        }
+    }
+    return newSurface;
+}
+
+namespace {
+
+/// @brief Average 2x2 blocks of a row pair of 3 Byte pixels without alpha.
+void downsampleRow_rgb(const uint8_t *row0, const uint8_t *row1, size_t dx, uint8_t *target, size_t width)
+{
+    for (size_t x = 0; x < width; ++x)
     {
-        for (size_t x = 0; x < oldWidth; ++x)
+        const uint8_t *p = row0 + x * 6, *q = row1 + x * 6;
+        for (size_t c = 0; c < 3; ++c)
+        {
+            target[x * 3 + c] = (p[c] + p[dx + c] + q[c] + q[dx + c] + 2) >> 2;
+        }
+    }
+}
+
+/// @brief Average 2x2 blocks of a row pair of 4 Byte pixels with alpha.
+/// Each colour is weighted by 256 * alpha + 1: transparent pixels do not contribute to the colour
+/// unless all four pixels are transparent, in which case the colours are averaged as is.
+void downsampleRow_rgba(const uint8_t *row0, const uint8_t *row1, size_t dx, size_t alphaIndex, uint8_t *target, size_t width)
+{
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    // One output pixel per iteration with its four channels in the four lanes.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 half = _mm_set1_ps(0.5f);
+    // 1 in the colour lanes, 0 in the alpha lane, and vice versa.
+    float colourLanes[4] = { 1.0f, 1.0f, 1.0f, 1.0f }, alphaLanes[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    colourLanes[alphaIndex] = 0.0f;
+    alphaLanes[alphaIndex] = 1.0f;
+    const __m128 colourMask = _mm_loadu_ps(colourLanes), alphaMask = _mm_loadu_ps(alphaLanes);
+    for (size_t x = 0; x < width; ++x)
+    {
+        const uint8_t *texels[4] = { row0 + x * 8, row0 + x * 8 + dx, row1 + x * 8, row1 + x * 8 + dx };
+        __m128 numerator = _mm_setzero_ps(), denominator = _mm_setzero_ps();
+        for (const uint8_t *texel : texels)
+        {
+            int32_t bits;
+            std::memcpy(&bits, texel, sizeof(bits));
+            __m128i t = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), zero), zero);
+            // The weight in the colour lanes, 1 in the alpha lane.
+            __m128 weight = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(float(256 * texel[alphaIndex] + 1)), colourMask), alphaMask);
+            numerator = _mm_add_ps(numerator, _mm_mul_ps(_mm_cvtepi32_ps(t), weight));
+            denominator = _mm_add_ps(denominator, weight);
+        }
+        __m128i result = _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(numerator, denominator), half));
+        result = _mm_packus_epi16(_mm_packs_epi32(result, zero), zero);
+        int32_t bits = _mm_cvtsi128_si32(result);
+        std::memcpy(target + x * 4, &bits, sizeof(bits));
+    }
+#else
+    for (size_t x = 0; x < width; ++x)
+    {
+        const uint8_t *texels[4] = { row0 + x * 8, row0 + x * 8 + dx, row1 + x * 8, row1 + x * 8 + dx };
+        float numerator[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, denominator = 0.0f;
+        for (const uint8_t *texel : texels)
+        {
+            float weight = float(256 * texel[alphaIndex] + 1);
+            for (size_t c = 0; c < 4; ++c)
+            {
+                numerator[c] += texel[c] * (c == alphaIndex ? 1.0f : weight);
+            }
+            denominator += weight;
+        }
+        for (size_t c = 0; c < 4; ++c)
+        {
+            float value = c == alphaIndex ? numerator[c] / 4.0f : numerator[c] / denominator;
+            target[x * 4 + c] = uint8_t(value + 0.5f);
+        }
+    }
+#endif
+}
+
+} // namespace
+
+std::shared_ptr<SDL_Surface> downsample_functor<SDL_Surface>::operator()(const std::shared_ptr<SDL_Surface>& pixels) const
+{
+    if (!pixels)
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "pixels");
+    }
+    const SDL_PixelFormat *format = pixels->format;
+    const bool hasAlpha = 4 == format->BytesPerPixel && 0 != format->Amask;
+    if (format->palette || (3 != format->BytesPerPixel && !hasAlpha) ||
+        (3 == format->BytesPerPixel && format->Amask))
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "pixel format not supported");
+    }
+
+    const int oldWidth = pixels->w, oldHeight = pixels->h;
+    const int newWidth = std::max(1, oldWidth / 2), newHeight = std::max(1, oldHeight / 2);
+    auto newSurface = std::shared_ptr<SDL_Surface>(SDL_CreateRGBSurface(SDL_SWSURFACE, newWidth, newHeight, format->BitsPerPixel,
+                                                                        format->Rmask, format->Gmask, format->Bmask, format->Amask),
+                                                   [](SDL_Surface *pSurface) { SDL_FreeSurface(pSurface); });
+    if (!newSurface)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "SDL_CreateRGBSurface failed");
+    }
+
+    // The offsets to the right and to the lower neighbour of a pixel. 0 if the dimension is 1.
+    const size_t dx = oldWidth > 1 ? format->BytesPerPixel : 0,
+                 dy = oldHeight > 1 ? pixels->pitch : 0;
+    // The index of the alpha Byte within a pixel.
+#if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
+    const size_t alphaIndex = 3 - format->Ashift / 8;
+#else
+    const size_t alphaIndex = format->Ashift / 8;
+#endif
+    for (int y = 0; y < newHeight; ++y)
+    {
+        const uint8_t *row0 = static_cast<const uint8_t *>(pixels->pixels) + (oldHeight > 1 ? 2 * y : y) * pixels->pitch;
+        const uint8_t *row1 = row0 + dy;
+        uint8_t *target = static_cast<uint8_t *>(newSurface->pixels) + y * newSurface->pitch;
+        if (hasAlpha)
+        {
+            downsampleRow_rgba(row0, row1, dx, alphaIndex, target, newWidth);
+        }
+        else
         {
-            auto p = get_pixel(oldSurface.get(), { x, y });
-            set_pixel(newSurface.get(), p, { padding.left + x, padding.top + y });
+            downsampleRow_rgb(row0, row1, dx, target, newWidth);
         }
     }
     return newSurface;
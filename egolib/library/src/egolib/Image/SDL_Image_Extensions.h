@@ -27,6 +27,7 @@
 #include "egolib/Math/_Include.hpp"
 #include "egolib/Image/blit.hpp"
 #include "egolib/Image/convert.hpp"
+#include "egolib/Image/downsample.hpp"
 #include "egolib/Image/fill.hpp"
 #include "egolib/Image/get_pixel.hpp"
 #include "egolib/Image/pad.hpp"
@@ -129,6 +130,15 @@ struct pad_functor<SDL_Surface>
     std::shared_ptr<SDL_Surface> operator()(const std::shared_ptr<SDL_Surface>& pixels, const padding& padding) const;
 };
 
+template <>
+struct downsample_functor<SDL_Surface>
+{
+    /// @brief Downsample an SDL surface.
+    /// @param pixels the SDL surface. Must have 8 bit red, green, blue and optionally alpha channels in 3 or 4 Bytes per pixel.
+    /// @throw idlib::invalid_argument_error if the pixel format is not supported
+    std::shared_ptr<SDL_Surface> operator()(const std::shared_ptr<SDL_Surface>& pixels) const;
+};
+
 template <>
 struct blit_functor<SDL_Surface>
 {
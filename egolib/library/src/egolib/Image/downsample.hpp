@@ -0,0 +1,16 @@
+#pragma once
+
+namespace Ego {
+
+/// @brief Halve the width and the height of a pixel buffer with a 2x2 box filter.
+/// A width (height) of 1 is kept. If the width (height) is odd, the last column (row) is dropped.
+/// @remark The colours are weighted by their alpha values such that the colours of transparent pixels do not bleed into visible pixels.
+/// @remark Does not modify the pixel buffer and uses no global state, hence it can be called concurrently.
+template <typename T>
+struct downsample_functor;
+
+template <typename T>
+auto downsample(const std::shared_ptr<T>& pixels) -> decltype(downsample_functor<T>()(pixels))
+{ return downsample_functor<T>()(pixels); }
+
+} // namespace Ego
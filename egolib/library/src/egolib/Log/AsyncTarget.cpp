@@ -0,0 +1,118 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+
+/// @file  egolib/Log/AsyncTarget.cpp
+/// @brief Log target writing on a background thread
+
+#include "egolib/Log/AsyncTarget.hpp"
+
+namespace Log {
+
+static_assert((AsyncTarget::CAPACITY & (AsyncTarget::CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+AsyncTarget::AsyncTarget(const std::string& filename, Level level)
+    : Target(level), _target(std::make_unique<DefaultTarget>(filename, level)),
+      _cells(new Cell[CAPACITY]), _enqueuePosition(0), _dequeuePosition(0), _dropped(0),
+      _writeMutex(), _wakeMutex(), _wakeCondition(), _terminateRequested(false), _thread() {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _thread = std::thread([this]() { run(); });
+}
+
+AsyncTarget::~AsyncTarget() {
+    _terminateRequested = true;
+    _wakeCondition.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    flush();
+}
+
+void AsyncTarget::writev(Level level, const char *format, va_list args) {
+    // Claim a cell.
+    size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+        cell = &_cells[position & (CAPACITY - 1)];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The buffer is full.
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Format the message into the cell and publish it.
+    cell->level = level;
+    vsnprintf(cell->message, MAX_MESSAGE - 1, format, args);
+    cell->message[MAX_MESSAGE - 1] = '\0';
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    if (level == Level::Error) {
+        flush();
+    } else {
+        _wakeCondition.notify_one();
+    }
+}
+
+void AsyncTarget::drain() {
+    while (true) {
+        Cell& cell = _cells[_dequeuePosition & (CAPACITY - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != _dequeuePosition + 1) {
+            // The buffer is empty or the next message is not published yet.
+            break;
+        }
+        _target->write(cell.level, cell.message);
+        cell.sequence.store(_dequeuePosition + CAPACITY, std::memory_order_release);
+        _dequeuePosition++;
+    }
+    const uint32_t dropped = _dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "%" PRIu32 " log message(s) dropped\n", dropped);
+        _target->write(Level::Warning, buffer);
+    }
+}
+
+void AsyncTarget::run() {
+    while (!_terminateRequested) {
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeCondition.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        std::lock_guard<std::mutex> lock(_writeMutex);
+        drain();
+    }
+}
+
+void AsyncTarget::flush() {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    drain();
+    _target->flush();
+}
+
+} // namespace Log
@@ -0,0 +1,118 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+
+/// @file  egolib/Log/AsyncTarget.hpp
+/// @brief Log target writing on a background thread
+
+#pragma once
+
+#include "egolib/Log/DefaultTarget.hpp"
+
+namespace Log {
+
+/**
+ * @brief
+ *  A log target which formats messages on the calling thread and hands them to a background thread
+ *  which writes them to a DefaultTarget. The calling thread never blocks on file or console output.
+ * @remark
+ *  Messages are passed through a bounded lock-free multiple-producer/single-consumer ring buffer.
+ *  If the buffer is full, messages are dropped and the number of dropped messages is reported later.
+ *  Messages of level Level::Error are written synchronously (after all pending messages) and flushed
+ *  such that they are not lost if the program terminates right after.
+ */
+struct AsyncTarget : Target {
+public:
+    /// The number of messages the ring buffer can hold. Must be a power of two.
+    static constexpr size_t CAPACITY = 1024;
+    /// The maximum length of a message.
+    static constexpr size_t MAX_MESSAGE = 1024;
+
+private:
+    struct Cell {
+        /// The sequence number of this cell.
+        std::atomic<size_t> sequence;
+        /// The log level of the message.
+        Level level;
+        /// The formatted message.
+        char message[MAX_MESSAGE];
+    };
+
+    /// The target the messages are written to.
+    std::unique_ptr<DefaultTarget> _target;
+    /// The cells of the ring buffer.
+    std::unique_ptr<Cell[]> _cells;
+    /// The position of the next message to enqueue.
+    std::atomic<size_t> _enqueuePosition;
+    /// The position of the next message to dequeue. Guarded by _writeMutex.
+    size_t _dequeuePosition;
+    /// The number of messages dropped because the ring buffer was full.
+    std::atomic<uint32_t> _dropped;
+    /// Serializes writes to the target.
+    std::mutex _writeMutex;
+    /// Used to wake up the background thread.
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    std::atomic<bool> _terminateRequested;
+    /// The background thread.
+    std::thread _thread;
+
+    /**
+     * @brief
+     *  Write all pending messages to the target.
+     * @pre
+     *  _writeMutex is locked
+     */
+    void drain();
+
+    /**
+     * @brief
+     *  The function executed by the background thread.
+     */
+    void run();
+
+protected:
+    void writev(Level level, const char *format, va_list args) override;
+
+public:
+    /**
+     * @brief
+     *  Construct this log target.
+     * @param filename
+     *  the name of the log file
+     * @param level
+     *  the log level. Default is Level::Warning.
+     * @throw std::runtime_error
+     *  if the log file can not be opened
+     */
+    AsyncTarget(const std::string& filename, Level level = Level::Warning);
+
+    /**
+     * @brief
+     *  Destruct this log target.
+     *  All pending messages are written before the log target is destroyed.
+     */
+    virtual ~AsyncTarget();
+
+    /**
+     * @brief
+     *  Write all pending messages and flush the log file.
+     */
+    void flush();
+};
+
+} // namespace Log
@@ -38,6 +38,20 @@ public:
 	DefaultTarget(const std::string& filename, Level level = Level::Warning);
 	virtual ~DefaultTarget();
 	void writev(Level level, const char *format, va_list args) override;
+	/**
+	* @brief
+	*  Write a formatted log message to the log file and the console.
+	* @param level
+	*  the log level
+	* @param message
+	*  the message
+	*/
+	void write(Level level, const char *message);
+	/**
+	* @brief
+	*  Flush the log file.
+	*/
+	void flush();
 };
 
 } // namespace Log
@@ -341,6 +341,10 @@ Entry& operator<<(Entry& entry, unsigned long long value)
 
 Target& operator<<(Target& target, const Entry& entry)
 {
+    if (target.getLevel() < entry.getLevel())
+    {
+        return target;
+    }
     std::ostringstream temporary;
     if (entry.hasAttribute("C/C++ file name"))
     {
@@ -34,4 +34,31 @@ namespace Log {
 		Debug,      ///< Verbose debug logging, useful for developers and debugging.
 	};
 
+/**
+ * @brief
+ *  The most verbose log level compiled into the program.
+ *  Log entries above this level written through the EGOLIB_LOG macros are removed at compile-time.
+ *  Debug builds keep everything, release builds drop Level::Debug.
+ *  Define before including this file to override.
+ */
+#if !defined(EGOLIB_LOG_COMPILETIME_LEVEL)
+	#if defined(_DEBUG)
+		#define EGOLIB_LOG_COMPILETIME_LEVEL Log::Level::Debug
+	#else
+		#define EGOLIB_LOG_COMPILETIME_LEVEL Log::Level::Info
+	#endif
+#endif
+
+	/**
+	 * @brief
+	 *  Get if log entries of the specified level are compiled into the program.
+	 * @param level
+	 *  the log level
+	 * @return
+	 *  @a true if log entries of the specified level are compiled in, @a false otherwise
+	 */
+	constexpr bool isCompiledIn(Level level) {
+		return static_cast<uint8_t>(level) <= static_cast<uint8_t>(EGOLIB_LOG_COMPILETIME_LEVEL);
+	}
+
 } // namespace Log
@@ -0,0 +1,50 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+
+/// @file  egolib/Log/RateLimiter.cpp
+/// @brief Limit the number of log entries written from a call site
+
+#include "egolib/Log/RateLimiter.hpp"
+
+namespace Log {
+
+static uint64_t getMilliseconds() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+RateLimiter::RateLimiter(uint32_t maximum) :
+    _maximum(maximum), _windowStart(getMilliseconds()), _count(0), _suppressed(0) {}
+
+bool RateLimiter::acquire(uint32_t& suppressed) {
+    const uint64_t now = getMilliseconds();
+    uint64_t windowStart = _windowStart.load(std::memory_order_relaxed);
+    // Start a new window if the current one is over. Only one thread wins the exchange.
+    if (now - windowStart >= 1000 && _windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+        _count.store(0, std::memory_order_relaxed);
+    }
+    if (_count.fetch_add(1, std::memory_order_relaxed) < _maximum) {
+        suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    _suppressed.fetch_add(1, std::memory_order_relaxed);
+    suppressed = 0;
+    return false;
+}
+
+} // namespace Log
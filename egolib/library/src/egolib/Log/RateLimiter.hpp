@@ -0,0 +1,64 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+
+/// @file  egolib/Log/RateLimiter.hpp
+/// @brief Limit the number of log entries written from a call site
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Log {
+
+/**
+ * @brief
+ *  Limits the number of log entries written from a single call site per second.
+ *  One static instance is created for each call site by the EGOLIB_LOG_RATE_LIMITED macro.
+ */
+struct RateLimiter {
+private:
+    /// The maximum number of entries per second.
+    const uint32_t _maximum;
+    /// The start of the current one second window, in milliseconds.
+    std::atomic<uint64_t> _windowStart;
+    /// The number of entries requested in the current window.
+    std::atomic<uint32_t> _count;
+    /// The number of entries suppressed in the previous window(s) and not reported yet.
+    std::atomic<uint32_t> _suppressed;
+
+public:
+    /**
+     * @brief
+     *  Construct this rate limiter.
+     * @param maximum
+     *  the maximum number of entries per second
+     */
+    RateLimiter(uint32_t maximum);
+
+    /**
+     * @brief
+     *  Request to write an entry.
+     * @param [out] suppressed
+     *  receives the number of entries which were suppressed before this one and not reported yet
+     * @return
+     *  @a true if the entry may be written, @a false if it must be suppressed
+     */
+    bool acquire(uint32_t& suppressed);
+};
+
+} // namespace Log
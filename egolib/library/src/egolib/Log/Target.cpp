@@ -43,7 +43,7 @@ void Target::logv(Level level, const char *format, va_list args) {
 void Target::log(Level level, const char *format, ...) {
     va_list args;
     va_start(args, format);
-    writev(level, format, args);
+    logv(level, format, args);
     va_end(args);
 }
 
@@ -22,7 +22,7 @@
 
 #include "egolib/Log/_Include.hpp"
 
-#include "egolib/Log/DefaultTarget.hpp"
+#include "egolib/Log/AsyncTarget.hpp"
 #include "egolib/Log/ConsoleColor.hpp"
 
 namespace Log {
@@ -36,7 +36,7 @@ static bool _atexit_registered = false;
 
 void initialize(const std::string& filename, Log::Level level) {
 	if (!g_target) {
-		g_target = std::make_unique<DefaultTarget>(filename, level);
+		g_target = std::make_unique<AsyncTarget>(filename, level);
 	}
 	if (!_atexit_registered) {
 		if (atexit(Log::uninitialize)) {
@@ -26,6 +26,7 @@
 #include "egolib/Log/Entry.hpp"
 #include "egolib/Log/Target.hpp"
 #include "egolib/Log/Level.hpp"
+#include "egolib/Log/RateLimiter.hpp"
 
 namespace Log {
 
@@ -62,3 +63,45 @@ namespace Log {
 	Target& get();
 
 } // namespace Log
+
+/**
+ * @brief
+ *  Write a log entry to the default target.
+ *  The entry is neither built nor written if its level is not compiled in (see EGOLIB_LOG_COMPILETIME_LEVEL)
+ *  or above the level of the default target.
+ * @param LEVEL
+ *  the log level
+ * @param ...
+ *  the values to write into the log entry
+ */
+#define EGOLIB_LOG(LEVEL, ...) \
+	do { \
+		if (Log::isCompiledIn(LEVEL) && Log::get().getLevel() >= (LEVEL)) { \
+			Log::get() << Log::Entry::create(LEVEL, __FILE__, __LINE__, __VA_ARGS__, Log::EndOfEntry); \
+		} \
+	} while (0)
+
+/**
+ * @brief
+ *  Like EGOLIB_LOG, but at most @a MAX_PER_SECOND entries per second are written from this call site.
+ *  The number of suppressed entries is reported with the next entry written.
+ * @param LEVEL
+ *  the log level
+ * @param MAX_PER_SECOND
+ *  the maximum number of entries per second
+ * @param ...
+ *  the values to write into the log entry
+ */
+#define EGOLIB_LOG_RATE_LIMITED(LEVEL, MAX_PER_SECOND, ...) \
+	do { \
+		if (Log::isCompiledIn(LEVEL) && Log::get().getLevel() >= (LEVEL)) { \
+			static Log::RateLimiter egolib_log_rateLimiter(MAX_PER_SECOND); \
+			uint32_t egolib_log_suppressed; \
+			if (egolib_log_rateLimiter.acquire(egolib_log_suppressed)) { \
+				if (egolib_log_suppressed > 0) { \
+					Log::get() << Log::Entry::create(LEVEL, __FILE__, __LINE__, egolib_log_suppressed, " similar messages suppressed", Log::EndOfEntry); \
+				} \
+				Log::get() << Log::Entry::create(LEVEL, __FILE__, __LINE__, __VA_ARGS__, Log::EndOfEntry); \
+			} \
+		} \
+	} while (0)
@@ -54,9 +54,11 @@ Team::Team(const TEAM_REF teamID) :
 
 void Team::giveTeamExperience(const int amount, const XPType xptype) const
 {
-    for(const std::shared_ptr<Object> &chr : _currentModule->getObjectHandler().iterator())
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+    for(ObjectRef memberRef : objectHandler.getTeamMembers(_teamID))
     {
-        if ( chr->getTeam()._teamID == _teamID )
+        Object *chr = objectHandler.get(memberRef);
+        if (chr && !chr->isTerminated())
         {
             chr->giveExperience(amount, xptype, false);
         }
@@ -83,11 +85,18 @@ void Team::callForHelp(const std::shared_ptr<Object> &caller)
     _sissy = caller;
 
     //Notify all other characters who are friendly that this character has called for help
-    for(const std::shared_ptr<Object> &chr : _currentModule->getObjectHandler().iterator())
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+    for(TEAM_REF team = 0; team < TEAM_MAX; ++team)
     {
-        if ( chr != caller && !chr->getTeam().hatesTeam(caller->getTeam()) )
+        if (_currentModule->getTeamList()[team].hatesTeam(caller->getTeam())) continue;
+
+        for(ObjectRef memberRef : objectHandler.getTeamMembers(team))
         {
-            SET_BIT( chr->ai.alert, ALERTIF_CALLEDFORHELP );
+            Object *chr = objectHandler.get(memberRef);
+            if ( chr && chr != caller.get() && !chr->isTerminated() )
+            {
+                SET_BIT( chr->ai.alert, ALERTIF_CALLEDFORHELP );
+            }
         }
     }
 }
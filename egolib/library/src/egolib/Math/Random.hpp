@@ -123,6 +123,22 @@ public:
      */
     static void setSeed(const long seed);
 
+    /**
+     * @brief
+     *  Get the state of the random number generator (for snapshots of the game).
+     * @return
+     *  the state
+     */
+    static const std::mt19937& getState() { return generator; }
+
+    /**
+     * @brief
+     *  Restore a state of the random number generator.
+     * @param state
+     *  the state
+     */
+    static void setState(const std::mt19937& state) { generator = state; }
+
     /**
      * @brief
      *  Returns a reference to a random element in a vector.
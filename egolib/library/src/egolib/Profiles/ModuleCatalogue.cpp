@@ -0,0 +1,276 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Profiles/ModuleCatalogue.cpp
+/// @brief A persistent index of the module profiles.
+
+#define EGOLIB_PROFILES_PRIVATE 1
+#include "egolib/Profiles/ModuleCatalogue.hpp"
+#include "egolib/Profiles/ModuleProfile.hpp"
+#include "egolib/Log/_Include.hpp"
+#include "egolib/vfs.h"
+
+namespace {
+
+const char MAGIC[8] = { 'E', 'G', 'O', 'M', 'O', 'D', '\0', '\0' };
+
+void putInteger(std::vector<char>& buffer, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+void putString(std::vector<char>& buffer, const std::string& value)
+{
+    putInteger(buffer, value.size(), 4);
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+/// @brief Reads the index file. Reading past the end sets the error flag and yields zeroes.
+struct Reader
+{
+    const std::vector<char>& buffer;
+    size_t position;
+    bool error;
+
+    Reader(const std::vector<char>& buffer) : buffer(buffer), position(0), error(false) {}
+
+    uint64_t getInteger(size_t bytes)
+    {
+        if (buffer.size() - position < bytes)
+        {
+            error = true;
+            position = buffer.size();
+            return 0;
+        }
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            value |= uint64_t(static_cast<uint8_t>(buffer[position++])) << (i * 8);
+        }
+        return value;
+    }
+
+    std::string getString()
+    {
+        size_t size = getInteger(4);
+        if (buffer.size() - position < size)
+        {
+            error = true;
+            position = buffer.size();
+            return std::string();
+        }
+        std::string value(buffer.data() + position, size);
+        position += size;
+        return value;
+    }
+};
+
+} // namespace
+
+ModuleCatalogue::ModuleCatalogue(const std::string& pathname) :
+    _pathname(pathname),
+    _entries(),
+    _changed(false),
+    _statistics()
+{}
+
+void ModuleCatalogue::load()
+{
+    _entries.clear();
+    _changed = true;
+    if (!vfs_exists(_pathname))
+    {
+        return;
+    }
+    std::vector<char> buffer;
+    try
+    {
+        vfs_readEntireFile(_pathname, [&buffer](size_t size, const char *bytes) { buffer.insert(buffer.end(), bytes, bytes + size); });
+    }
+    catch (...)
+    {
+        return;
+    }
+    if (buffer.size() < sizeof(MAGIC) || 0 != std::memcmp(buffer.data(), MAGIC, sizeof(MAGIC)))
+    {
+        return;
+    }
+    Reader reader(buffer);
+    reader.position = sizeof(MAGIC);
+    if (VERSION != reader.getInteger(4))
+    {
+        return;
+    }
+    size_t count = reader.getInteger(4);
+    for (size_t i = 0; i < count && !reader.error; ++i)
+    {
+        Entry entry;
+        std::string path = reader.getString();
+        entry.modificationTime = reader.getInteger(8);
+        entry.size = reader.getInteger(8);
+
+        auto profile = std::make_shared<ModuleProfile>();
+        profile->_name = reader.getString();
+        profile->_reference = reader.getString();
+        profile->_unlockQuest = IDSZ2(uint32_t(reader.getInteger(4)));
+        profile->_unlockQuestLevel = int32_t(reader.getInteger(4));
+        profile->_importAmount = reader.getInteger(1);
+        profile->_allowExport = 0 != reader.getInteger(1);
+        profile->_minPlayers = reader.getInteger(1);
+        profile->_maxPlayers = reader.getInteger(1);
+        profile->_respawnValid = reader.getInteger(1);
+        profile->_rank = reader.getInteger(1);
+        profile->_moduleType = static_cast<ModuleFilter>(reader.getInteger(1));
+        profile->_beaten = 0 != reader.getInteger(1);
+        size_t summaryLines = reader.getInteger(4);
+        for (size_t j = 0; j < summaryLines && !reader.error; ++j)
+        {
+            profile->_summary.push_back(reader.getString());
+        }
+        profile->_loaded = true;
+        profile->_vfsPath = path;
+        profile->_icon = Ego::DeferredTexture(path + "/gamedat/title");
+        profile->_folderName = path.substr(path.find_last_of('/', path.size() - 1) + 1);
+        entry.profile = profile;
+        if (!reader.error)
+        {
+            _entries[path] = entry;
+        }
+    }
+    if (reader.error)
+    {
+        _entries.clear();
+        return;
+    }
+    _changed = false;
+}
+
+bool ModuleCatalogue::save()
+{
+    if (!_changed)
+    {
+        return true;
+    }
+    std::vector<char> buffer(MAGIC, MAGIC + sizeof(MAGIC));
+    putInteger(buffer, VERSION, 4);
+    putInteger(buffer, _entries.size(), 4);
+    for (const auto& pair : _entries)
+    {
+        const Entry& entry = pair.second;
+        const ModuleProfile& profile = *entry.profile;
+        putString(buffer, pair.first);
+        putInteger(buffer, entry.modificationTime, 8);
+        putInteger(buffer, entry.size, 8);
+        putString(buffer, profile._name);
+        putString(buffer, profile._reference);
+        putInteger(buffer, profile._unlockQuest.toUint32(), 4);
+        putInteger(buffer, uint32_t(profile._unlockQuestLevel), 4);
+        putInteger(buffer, profile._importAmount, 1);
+        putInteger(buffer, profile._allowExport ? 1 : 0, 1);
+        putInteger(buffer, profile._minPlayers, 1);
+        putInteger(buffer, profile._maxPlayers, 1);
+        putInteger(buffer, profile._respawnValid, 1);
+        putInteger(buffer, profile._rank, 1);
+        putInteger(buffer, profile._moduleType, 1);
+        putInteger(buffer, profile._beaten ? 1 : 0, 1);
+        putInteger(buffer, profile._summary.size(), 4);
+        for (const auto& line : profile._summary)
+        {
+            putString(buffer, line);
+        }
+    }
+
+    // Make sure the directory of the index file exists.
+    const auto directory = _pathname.substr(0, _pathname.find_last_of('/'));
+    if (!directory.empty() && !vfs_isDirectory(directory) && !vfs_mkdir(directory))
+    {
+        return false;
+    }
+    if (!vfs_writeEntireFile(_pathname, buffer.data(), buffer.size()))
+    {
+        return false;
+    }
+    _changed = false;
+    return true;
+}
+
+std::vector<std::shared_ptr<ModuleProfile>> ModuleCatalogue::update(const std::string& directory)
+{
+    _statistics = Statistics();
+    std::vector<std::shared_ptr<ModuleProfile>> profiles;
+    std::unordered_map<std::string, Entry> entries;
+
+    // Search for all .mod directories and load the module info
+    SearchContext ctxt(Ego::VfsPath(directory), Ego::Extension("mod"), VFS_SEARCH_DIR);
+    while (ctxt.hasData())
+    {
+        const auto path = ctxt.getData().string();
+        ctxt.nextData();
+        _statistics.modules++;
+
+        Entry entry;
+        const bool stamped = vfs_getFileStamp(path + "/gamedat/menu.txt", entry.modificationTime, entry.size);
+
+        // Reuse the profile if the menu.txt did not change.
+        const auto it = _entries.find(path);
+        if (stamped && it != _entries.end() &&
+            it->second.modificationTime == entry.modificationTime && it->second.size == entry.size)
+        {
+            entries[path] = it->second;
+            profiles.push_back(it->second.profile);
+            _statistics.reused++;
+            continue;
+        }
+
+        //Try to load menu.txt
+        std::shared_ptr<ModuleProfile> module;
+        try
+        {
+            module = ModuleProfile::loadFromFile(path);
+        }
+        catch (...)
+        {}
+        if (!module)
+        {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load module ", "`", path, "`", Log::EndOfEntry);
+            _statistics.failed++;
+            continue;
+        }
+        _statistics.parsed++;
+        profiles.push_back(module);
+        // Only modules with a stamp can be validated later.
+        if (stamped)
+        {
+            entry.profile = module;
+            entries[path] = entry;
+        }
+        _changed = true;
+    }
+
+    // Modules which no longer exist are dropped.
+    if (entries.size() != _entries.size())
+    {
+        _changed = true;
+    }
+    _entries.swap(entries);
+    return profiles;
+}
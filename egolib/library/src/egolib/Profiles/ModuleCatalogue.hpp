@@ -0,0 +1,106 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Profiles/ModuleCatalogue.hpp
+/// @brief A persistent index of the module profiles.
+
+#pragma once
+
+#if !defined(EGOLIB_PROFILES_PRIVATE) || EGOLIB_PROFILES_PRIVATE != 1
+#error(do not include directly, include `egolib/Profiles/_Include.hpp` instead)
+#endif
+
+#include "egolib/typedef.h"
+
+class ModuleProfile;
+
+/**
+ * @brief
+ *  A persistent index of the parsed <tt>menu.txt</tt> files of all modules.
+ *  The index file stores the module profiles together with the modification time
+ *  and the size of their <tt>menu.txt</tt> files. On startup only the modules whose
+ *  <tt>menu.txt</tt> changed (or which are new) are parsed again.
+ * @remark
+ *  The title images are not part of the index, they are deferred textures loaded when drawn.
+ */
+class ModuleCatalogue
+{
+public:
+    struct Statistics
+    {
+        size_t modules;   ///< Number of modules found
+        size_t reused;    ///< Number of module profiles taken from the index
+        size_t parsed;    ///< Number of module profiles parsed from their menu.txt
+        size_t failed;    ///< Number of modules which could not be loaded
+    };
+
+    /**
+     * @brief
+     *  Construct this module catalogue.
+     * @param pathname the pathname of the index file, relative to the user directory
+     */
+    ModuleCatalogue(const std::string& pathname);
+
+    /**
+     * @brief
+     *  Read the index file. If it does not exist or is not valid, the index is empty.
+     */
+    void load();
+
+    /**
+     * @brief
+     *  Write the index file if the index has changed.
+     * @return @a true on success, @a false otherwise
+     */
+    bool save();
+
+    /**
+     * @brief
+     *  Find all modules in a directory and get their profiles, parsing only the <tt>menu.txt</tt> files that changed.
+     *  Modules which no longer exist are removed from the index.
+     * @param directory the virtual pathname of the directory (e.g. "mp_modules")
+     * @return the module profiles
+     */
+    std::vector<std::shared_ptr<ModuleProfile>> update(const std::string& directory);
+
+    const Statistics& getStatistics() const {
+        return _statistics;
+    }
+
+private:
+    /// @brief The version of the index file format. Increment if the format or the module profiles change.
+    static constexpr uint32_t VERSION = 1;
+
+    struct Entry
+    {
+        int64_t modificationTime;
+        int64_t size;
+        std::shared_ptr<ModuleProfile> profile;
+    };
+
+    std::string _pathname;
+
+    /// @brief The entries by the virtual pathnames of the modules.
+    std::unordered_map<std::string, Entry> _entries;
+
+    /// @brief If the entries have changed since the index file was read.
+    bool _changed;
+
+    Statistics _statistics;
+};
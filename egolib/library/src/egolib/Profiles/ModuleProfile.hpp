@@ -141,4 +141,5 @@ private:
     std::string _folderName;                ///< Folder name of module ("advent.mod")
 
     friend class ProfileSystem;
+    friend class ModuleCatalogue;
 };
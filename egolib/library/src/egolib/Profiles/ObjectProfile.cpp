@@ -166,6 +166,7 @@ ObjectProfile::ObjectProfile() :
     _nameIsKnown(false),
     _usageIsKnown(false),
     _canCarryToNextModule(false),
+    _canBecomeDormant(true),
 
     _damageTargetDamageType(DAMAGE_CRUSH),
     _slotsValid(),
@@ -791,6 +792,10 @@ bool ObjectProfile::loadDataFile(const std::string &filePath)
                 _causesRipples = (0 != ctxt.readIntegerLiteral());
             break;
 
+            case IDSZ2::caseLabel( 'D', 'O', 'R', 'M' ):
+                _canBecomeDormant = (0 != ctxt.readIntegerLiteral());
+            break;
+
             case IDSZ2::caseLabel( 'V', 'A', 'L', 'U' ): 
                 _isValuable = ctxt.readIntegerLiteral();
             break;
@@ -1357,6 +1362,9 @@ bool ObjectProfile::exportCharacterToFile(const std::string &filePath, const Obj
     if ( profile->_forceShadow )
         vfs_put_expansion( fileWrite, "", IDSZ2( 'S', 'H', 'A', 'D' ), 1 );
 
+    if ( !profile->_canBecomeDormant )
+        vfs_put_expansion( fileWrite, "", IDSZ2( 'D', 'O', 'R', 'M' ), 0 );
+
     if ( profile->_causesRipples == profile->_isItem )
         vfs_put_expansion( fileWrite, "", IDSZ2( 'R', 'I', 'P', 'P' ), profile->_causesRipples );
 
@@ -286,6 +286,13 @@ public:
 
     inline bool isEquipment() const {return _isEquipment;}
 
+    /**
+    * @return
+    *   true if objects of this profile may sleep while idle and far from all players.
+    *   Profiles whose scripts must run every update opt out with the [DORM] 0 expansion.
+    **/
+    inline bool canBecomeDormant() const {return _canBecomeDormant;}
+
     inline bool isStackable() const {return _isStackable;}
 
     inline PIP_REF getAttackParticleProfile() const {return getParticleProfile(_attackParticle);}
@@ -762,6 +769,7 @@ private:
     bool       _nameIsKnown;                   ///< Is the class name known?
     bool       _usageIsKnown;                  ///< Is its usage known
     bool       _canCarryToNextModule;          ///< Take it with you?
+    bool       _canBecomeDormant;              ///< May sleep while idle and far from all players?
     DamageType _damageTargetDamageType;        ///< For AI DamageTarget
     std::array<bool, SLOT_COUNT> _slotsValid;  ///< Left/Right hands valid
     bool       _riderCanAttack;                ///< Rider attack?
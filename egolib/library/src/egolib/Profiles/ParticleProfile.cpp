@@ -60,6 +60,55 @@ void dynalight_info_t::reset()
     falloff_add = 0.0f;
 }
 
+ParticleSpawnTemplate::ParticleSpawnTemplate() :
+    force(false),
+    newTarget(false),
+    homing(false),
+    continuousSpawn(false),
+    facingBias(0),
+    aimErrorBias(0),
+    positionOffsetZBias(0),
+    velocityOffsetZBias(0),
+    dynalight(),
+    imageStart(0),
+    imageCount(0),
+    endOnLastFrame(false),
+    animationCycles(1),
+    lifetime(0),
+    damage()
+{
+    //ctor
+}
+
+void ParticleSpawnTemplate::compile(const ParticleProfile& profile)
+{
+    force = profile.force;
+    newTarget = profile.newtargetonspawn;
+    homing = profile.homing;
+    continuousSpawn = 0 != profile.contspawn._delay;
+
+    facingBias = profile.getSpawnFacing().base + profile.getSpawnFacing().rand / 2;
+    aimErrorBias = profile.getSpawnFacing().rand / 2;
+    positionOffsetZBias = profile.getSpawnPositionOffsetZ().rand / 2;
+    velocityOffsetZBias = profile.getSpawnVelocityOffsetZ().rand / 2;
+
+    // local dynamic lights are turned on by the owner
+    dynalight = profile.dynalight;
+    dynalight.on = (DYNA_MODE_LOCAL == profile.dynalight.mode) ? DYNA_MODE_OFF : profile.dynalight.mode;
+
+    imageStart = profile.image_stt * EGO_ANIMATION_MULTIPLIER;
+    imageCount = profile.image_max * EGO_ANIMATION_MULTIPLIER;
+
+    // a particle can EITHER end_lastframe or end_time.
+    // if it ends after the last frame, end_time tells you the number of cycles through
+    // the animation. zero or negative lifetime == infinite lifetime
+    endOnLastFrame = profile.end_lastframe;
+    animationCycles = profile.end_time > 0 ? profile.end_time : 1;
+    lifetime = (!profile.end_lastframe && profile.end_time > 0) ? profile.end_time : 0;
+
+    damage = range_to_pair(profile.damage);
+}
+
 ParticleProfile::ParticleProfile() :
 
     // Spawning.
@@ -148,7 +197,9 @@ ParticleProfile::ParticleProfile() :
     _spawnPositionOffsetXY(),
     _spawnPositionOffsetZ(),
     _spawnVelocityOffsetXY(),
-    _spawnVelocityOffsetZ()
+    _spawnVelocityOffsetZ(),
+
+    _spawnTemplate()
 {
     _particleEffectBits[DAMFX_TURN] = true;
     dynalight.reset();
@@ -420,6 +471,8 @@ std::shared_ptr<ParticleProfile> ParticleProfile::readFromFile(const std::string
     // Limit the soundspawn index.
     profile->soundspawn = Ego::Math::constrain<int8_t>(profile->soundspawn, INVALID_SOUND_ID, MAX_WAVE);
 
+    profile->_spawnTemplate.compile(*profile);
+
     return profile;
 }
 
@@ -458,3 +511,8 @@ float ParticleProfile::getGravityPull() const
 {
     return _gravityPull;
 }
+
+const ParticleSpawnTemplate& ParticleProfile::getSpawnTemplate() const
+{
+    return _spawnTemplate;
+}
@@ -117,6 +117,38 @@ struct dynalight_info_t
     void reset();
 };
 
+class ParticleProfile;
+
+/// @brief The constants of a particle profile needed to spawn a particle.
+/// They are derived once when the profile is loaded instead of on every spawn.
+struct ParticleSpawnTemplate
+{
+    ParticleSpawnTemplate();
+
+    /// @brief Derive the template from a particle profile.
+    void compile(const ParticleProfile& profile);
+
+    bool force;                 ///< copy of ParticleProfile::force
+    bool newTarget;             ///< get a new target on spawn
+    bool homing;                ///< copy of ParticleProfile::homing
+    bool continuousSpawn;       ///< the particle spawns other particles continuously
+
+    int facingBias;             ///< subtracted from a random spawn facing if no new target is acquired
+    int aimErrorBias;           ///< subtracted from a random spawn facing if a new target is acquired
+    int positionOffsetZBias;    ///< subtracted from a random spawn altitude
+    int velocityOffsetZBias;    ///< subtracted from a random spawn up velocity
+
+    dynalight_info_t dynalight; ///< the dynamic light of the first particle of a bulk spawn, the others have none
+
+    int imageStart;             ///< the starting frame, multiplied by EGO_ANIMATION_MULTIPLIER
+    int imageCount;             ///< the number of frames, multiplied by EGO_ANIMATION_MULTIPLIER
+    bool endOnLastFrame;        ///< the lifetime is given by the animation
+    int animationCycles;        ///< the number of cycles through the animation if the particle ends on the last frame
+    int lifetime;               ///< the lifetime in updates if the particle does not end on the last frame, 0 for infinite
+
+    IPair damage;               ///< the damage in "base" + "range" form
+};
+
 /// The definition of a particle profile
 class ParticleProfile : public AbstractProfile
 {
@@ -163,6 +195,12 @@ public:
     *   if it has a gravity push
     **/
     float getGravityPull() const;
+
+    /**
+    * @brief
+    *   Get the spawn template of this particle profile.
+    **/
+    const ParticleSpawnTemplate& getSpawnTemplate() const;
     
 public:
 
@@ -273,6 +311,8 @@ private:
     IPair _spawnPositionOffsetZ;    ///< Altitude
     IPair _spawnVelocityOffsetXY;   ///< Shot velocity
     IPair _spawnVelocityOffsetZ;    ///< Up velocity
+
+    ParticleSpawnTemplate _spawnTemplate;
 };
 
 /// @todo Remove globals.
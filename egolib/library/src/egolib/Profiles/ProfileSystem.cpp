@@ -26,6 +26,7 @@
 #include "egolib/Profiles/ProfileSystem.hpp"
 #include "egolib/Profiles/ObjectProfile.hpp"
 #include "egolib/Profiles/ModuleProfile.hpp"
+#include "egolib/Profiles/ModuleCatalogue.hpp"
 #include "egolib/game/GameStates/LoadPlayerElement.hpp"
 #include "egolib/Entities/_Include.hpp"
 #include "egolib/game/game.h"
@@ -220,27 +221,19 @@ void ProfileSystem::loadModuleProfiles()
     //Clear any previously loaded first
     _moduleProfilesLoaded.clear();
 
-    // Search for all .mod directories and load the module info
-    SearchContext *ctxt = new SearchContext(Ego::VfsPath("mp_modules"), Ego::Extension("mod"), VFS_SEARCH_DIR);
-    if (!ctxt) return;
-    
-    while (ctxt->hasData())
+    // Only parse the menu.txt files which changed since the last start.
+    ModuleCatalogue catalogue("/cache/modules.idx");
+    catalogue.load();
+    _moduleProfilesLoaded = catalogue.update("mp_modules");
+    if (!catalogue.save())
     {
-        auto vfs_ModPath = ctxt->getData();
-        //Try to load menu.txt
-        std::shared_ptr<ModuleProfile> module = ModuleProfile::loadFromFile(vfs_ModPath.string());
-        if (module)
-        {
-            _moduleProfilesLoaded.push_back(module);
-        }
-        else
-        {
-			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to load module ", "`", vfs_ModPath.string(), "`", Log::EndOfEntry);
-        }
-        ctxt->nextData();
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to save module catalogue", Log::EndOfEntry);
     }
-    delete ctxt;
-    ctxt = nullptr;
+
+    const auto& statistics = catalogue.getStatistics();
+    Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "found ", statistics.modules, " modules: ",
+                                     statistics.reused, " from the catalogue, ", statistics.parsed, " parsed, ",
+                                     statistics.failed, " failed", Log::EndOfEntry);
 }
 
 
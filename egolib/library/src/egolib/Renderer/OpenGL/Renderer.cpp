@@ -84,10 +84,12 @@ Ego::StencilBuffer& Renderer::getStencilBuffer() {
 }
 
 Ego::TextureUnit& Renderer::getTextureUnit() {
+    flushPendingGeometry();
     return m_textureUnit;
 }
 
 void Renderer::setAlphaTestEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_ALPHA_TEST);
     } else {
@@ -97,6 +99,7 @@ void Renderer::setAlphaTestEnabled(bool enabled) {
 }
 
 void Renderer::setAlphaFunction(idlib::compare_function function, float value) {
+    flushPendingGeometry();
     if (value < 0.0f || value > 1.0f) {
         throw std::invalid_argument("reference alpha value out of bounds");
     }
@@ -132,6 +135,7 @@ void Renderer::setAlphaFunction(idlib::compare_function function, float value) {
 }
 
 void Renderer::setBlendingEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_BLEND);
     } else {
@@ -142,18 +146,21 @@ void Renderer::setBlendingEnabled(bool enabled) {
 
 void Renderer::setBlendFunction(idlib::color_blend_parameter sourceColour, idlib::color_blend_parameter sourceAlpha,
                                 idlib::color_blend_parameter destinationColour, idlib::color_blend_parameter destinationAlpha) {
+    flushPendingGeometry();
     glBlendFuncSeparate(toOpenGL(sourceColour), toOpenGL(destinationColour),
                         toOpenGL(sourceAlpha), toOpenGL(destinationAlpha));
     Utilities::isError();
 }
 
 void Renderer::setColour(const Colour4f& colour) {
+    flushPendingGeometry();
     glColor4f(colour.get_r(), colour.get_g(),
               colour.get_b(), colour.get_a());
     Utilities::isError();
 }
 
 void Renderer::setCullingMode(idlib::culling_mode mode) {
+    flushPendingGeometry();
     switch (mode) {
 		case idlib::culling_mode::none:
             glDisable(GL_CULL_FACE);
@@ -177,6 +184,7 @@ void Renderer::setCullingMode(idlib::culling_mode mode) {
 }
 
 void Renderer::setDepthFunction(idlib::compare_function function) {
+    flushPendingGeometry();
     switch (function) {
         case idlib::compare_function::always_fail:
             glDepthFunc(GL_NEVER);
@@ -209,6 +217,7 @@ void Renderer::setDepthFunction(idlib::compare_function function) {
 }
 
 void Renderer::setDepthTestEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_DEPTH_TEST);
     } else {
@@ -218,11 +227,13 @@ void Renderer::setDepthTestEnabled(bool enabled) {
 }
 
 void Renderer::setDepthWriteEnabled(bool enabled) {
+    flushPendingGeometry();
     glDepthMask(enabled ? GL_TRUE : GL_FALSE);
     Utilities::isError();
 }
 
 void Renderer::setScissorRectangle(float left, float bottom, float width, float height) {
+    flushPendingGeometry();
     if (width < 0) {
         throw idlib::invalid_argument_error(__FILE__, __LINE__, "width < 0");
     }
@@ -234,6 +245,7 @@ void Renderer::setScissorRectangle(float left, float bottom, float width, float
 }
 
 void Renderer::setScissorTestEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_SCISSOR_TEST);
     } else {
@@ -243,18 +255,21 @@ void Renderer::setScissorTestEnabled(bool enabled) {
 }
 
 void Renderer::setStencilMaskBack(uint32_t mask) {
+    flushPendingGeometry();
     static_assert(sizeof(GLint) >= sizeof(uint32_t), "GLint is smaller than uint32_t");
     glStencilMaskSeparate(GL_BACK, mask);
     Utilities::isError();
 }
 
 void Renderer::setStencilMaskFront(uint32_t mask) {
+    flushPendingGeometry();
     static_assert(sizeof(GLint) >= sizeof(uint32_t), "GLint is smaller than uint32_t");
     glStencilMaskSeparate(GL_FRONT, mask);
     Utilities::isError();
 }
 
 void Renderer::setStencilTestEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_STENCIL_TEST);
     } else {
@@ -264,6 +279,7 @@ void Renderer::setStencilTestEnabled(bool enabled) {
 }
 
 void Renderer::setViewportRectangle(float left, float bottom, float width, float height) {
+    flushPendingGeometry();
     if (width < 0) {
         throw std::invalid_argument("width < 0");
     }
@@ -275,6 +291,7 @@ void Renderer::setViewportRectangle(float left, float bottom, float width, float
 }
 
 void Renderer::setWindingMode(idlib::winding_mode mode) {
+    flushPendingGeometry();
     switch (mode) {
 		case idlib::winding_mode::clockwise:
             glFrontFace(GL_CW);
@@ -289,6 +306,7 @@ void Renderer::setWindingMode(idlib::winding_mode mode) {
 }
 
 void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {
+    flushPendingGeometry();
     // Convert from Matrix4f4f to an OpenGL matrix.
     GLfloat t[16];
     for (size_t i = 0; i < 4; ++i) {
@@ -301,6 +319,7 @@ void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {
 }
 
 void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
     } else {
@@ -310,6 +329,7 @@ void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {
 }
 
 void Renderer::setDitheringEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glHint(GL_GENERATE_MIPMAP_HINT, GL_NICEST);
         glEnable(GL_DITHER);
@@ -321,6 +341,7 @@ void Renderer::setDitheringEnabled(bool enabled) {
 }
 
 void Renderer::setPointSmoothEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_POINT_SMOOTH);
         glHint(GL_POINT_SMOOTH_HINT, GL_NICEST);
@@ -331,6 +352,7 @@ void Renderer::setPointSmoothEnabled(bool enabled) {
 }
 
 void Renderer::setLineSmoothEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_LINE_SMOOTH);
         glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
@@ -341,16 +363,19 @@ void Renderer::setLineSmoothEnabled(bool enabled) {
 }
 
 void Renderer::setLineWidth(float width) {
+    flushPendingGeometry();
     glLineWidth(width);
     Utilities::isError();
 }
 
 void Renderer::setPointSize(float size) {
+    flushPendingGeometry();
     glPointSize(size);
     Utilities::isError();
 }
 
 void Renderer::setPolygonSmoothEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_POLYGON_SMOOTH);
         glHint(GL_POLYGON_SMOOTH_HINT, GL_NICEST);
@@ -361,6 +386,7 @@ void Renderer::setPolygonSmoothEnabled(bool enabled) {
 }
 
 void Renderer::setMultisamplesEnabled(bool enabled) {
+    flushPendingGeometry();
     // Check if MSAA is supported *at all* (by this OpenGL context).
     int multiSampleBuffers;
     SDL_GL_GetAttribute(SDL_GL_MULTISAMPLEBUFFERS, &multiSampleBuffers);
@@ -381,6 +407,7 @@ void Renderer::setMultisamplesEnabled(bool enabled) {
 }
 
 void Renderer::setLightingEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glEnable(GL_LIGHTING);
     } else {
@@ -390,6 +417,7 @@ void Renderer::setLightingEnabled(bool enabled) {
 }
 
 void Renderer::setRasterizationMode(idlib::rasterization_mode mode) {
+    flushPendingGeometry();
     switch (mode) {
         case idlib::rasterization_mode::point:
             glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
@@ -405,6 +433,7 @@ void Renderer::setRasterizationMode(idlib::rasterization_mode mode) {
 }
 
 void Renderer::setGouraudShadingEnabled(bool enabled) {
+    flushPendingGeometry();
     if (enabled) {
         glShadeModel(GL_SMOOTH);
     } else {
@@ -414,6 +443,7 @@ void Renderer::setGouraudShadingEnabled(bool enabled) {
 }
 
 void Renderer::render(idlib::vertex_buffer& vertexBuffer, const idlib::vertex_descriptor& vertexDescriptor, idlib::primitive_type primitiveType, size_t index, size_t length) {
+    flushPendingGeometry();
     if (vertexDescriptor.get_size() != vertexBuffer.vertex_size())
     {
         throw std::invalid_argument("vertex size mismatch");
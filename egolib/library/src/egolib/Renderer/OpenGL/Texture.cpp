@@ -92,16 +92,32 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
         throw idlib::argument_null_error(__FILE__, __LINE__, "surface");
     }
 
-    std::shared_ptr<SDL_Surface> newSurface = surface;
+    // Convert, pad and compute the mipmaps if they are needed.
+    bool mipmaps = idlib::texture_type::_2D == type && idlib::texture_filter_method::none != sampler.mip_filter_method();
+    upload(name, *TexturePayload::create(surface, mipmaps), surface, type, sampler);
+}
+
+void Texture::load(const std::string& name, const TexturePayload& payload, idlib::texture_type type, const idlib::texture_sampler& sampler)
+{
+    // Bind this texture to the backing error texture.
+    release();
 
-    // Convert to RGBA if the image has non-opaque alpha values or alpha modulation and convert to RGB otherwise.
-    bool hasAlpha = SDL::testAlpha(newSurface.get());
-    const auto& pixel_format = hasAlpha ? pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>()
-                                        : pixel_descriptor::get<idlib::pixel_format::R8G8B8>();
-    newSurface = convert(newSurface, pixel_format);
+    if (payload.levels.empty())
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "payload has no levels");
+    }
+    upload(name, payload, payload.createSource(), type, sampler);
+}
 
-    // Convert to power of two.
-    newSurface = power_of_two(newSurface);
+void Texture::upload(const std::string& name, const TexturePayload& payload, const std::shared_ptr<SDL_Surface>& source, idlib::texture_type type, const idlib::texture_sampler& sampler)
+{
+    const auto& pixel_format = payload.getPixelDescriptor();
+    const auto& newSurface = payload.levels[0];
+    const bool mipmaps = idlib::texture_filter_method::none != sampler.mip_filter_method();
+    if (idlib::texture_type::_2D == type && mipmaps && payload.levels.back()->w * payload.levels.back()->h != 1)
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "payload has no mipmaps");
+    }
 
     // (1)Generate a new OpenGL texture ID.
     Utilities::clearError();
@@ -148,9 +164,9 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
     {
         case idlib::texture_type::_2D:
         {
-            if (idlib::texture_filter_method::none != sampler.mip_filter_method())
+            if (mipmaps)
             {
-                Utilities2::upload_2d_mipmap(pixel_format, newSurface->w, newSurface->h, newSurface->pixels);
+                Utilities2::upload_2d_mipmap(pixel_format, payload.levels);
             }
             else
             {
@@ -177,25 +193,37 @@ void Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>&
     m_id = id;
     m_width = newSurface->w;
     m_height = newSurface->h;
-    m_source = surface;
-    m_sourceWidth = surface->w;
-    m_sourceHeight = surface->h;
-    m_hasAlpha = hasAlpha;
+    m_source = source;
+    m_sourceWidth = payload.sourceWidth;
+    m_sourceHeight = payload.sourceHeight;
+    m_hasAlpha = payload.hasAlpha;
     m_name = name;
 }
 
-bool Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>& source)
+static idlib::texture_sampler getDesiredSampler()
 {
     auto info = Ego::Renderer::get().getInfo();
-    // Determine the texture sampler.
-    idlib::texture_sampler sampler(info->getDesiredMinimizationFilter(),
-                                   info->getDesiredMaximizationFilter(),
-                                   info->getDesiredMipMapFilter(),
-                                   idlib::texture_address_mode::repeat, idlib::texture_address_mode::repeat,
-                                   info->getDesiredAnisotropy());
-    // Determine the texture type.
-    auto type = ((1 == source->h) && (source->w > 1)) ? idlib::texture_type::_1D : idlib::texture_type::_2D;
-    load(name, source, type, sampler);
+    return idlib::texture_sampler(info->getDesiredMinimizationFilter(),
+                                  info->getDesiredMaximizationFilter(),
+                                  info->getDesiredMipMapFilter(),
+                                  idlib::texture_address_mode::repeat, idlib::texture_address_mode::repeat,
+                                  info->getDesiredAnisotropy());
+}
+
+static idlib::texture_type getDesiredType(int sourceWidth, int sourceHeight)
+{
+    return ((1 == sourceHeight) && (sourceWidth > 1)) ? idlib::texture_type::_1D : idlib::texture_type::_2D;
+}
+
+bool Texture::load(const std::string& name, const std::shared_ptr<SDL_Surface>& source)
+{
+    load(name, source, getDesiredType(source->w, source->h), getDesiredSampler());
+    return true;
+}
+
+bool Texture::load(const std::string& name, const std::shared_ptr<const TexturePayload>& payload)
+{
+    load(name, *payload, getDesiredType(payload->sourceWidth, payload->sourceHeight), getDesiredSampler());
     return true;
 }
 
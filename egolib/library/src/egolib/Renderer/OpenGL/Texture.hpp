@@ -40,11 +40,19 @@ protected:
     /// @remark At any point, a texture has a valid OpenGL texture ID assigned, <em>unless</em> resources were lost.
     GLuint m_id;
 
+    /// @brief Create the OpenGL texture from a payload.
+    /// @param source the source of the payload
+    void upload(const std::string& name, const TexturePayload& payload, const std::shared_ptr<SDL_Surface>& source, idlib::texture_type type, const idlib::texture_sampler& sampler);
+
 public:
 	void load(const std::string& name, const std::shared_ptr<SDL_Surface>& surface, idlib::texture_type type, const idlib::texture_sampler& sampler);
+	void load(const std::string& name, const TexturePayload& payload, idlib::texture_type type, const idlib::texture_sampler& sampler);
     /** @override Ego::Texture::load(const String& name, const SharedPtr<SDL_Surface>&) */
 	bool load(const std::string& name, const std::shared_ptr<SDL_Surface>& surface) override;
 
+    /** @override Ego::Texture::load(const String& name, const SharedPtr<const TexturePayload>&) */
+	bool load(const std::string& name, const std::shared_ptr<const TexturePayload>& payload) override;
+
     /** @override Ego::Texture::load(const std::shared_ptr<SDL_Surface>&) */
 	bool load(const std::shared_ptr<SDL_Surface>& surface) override;
 
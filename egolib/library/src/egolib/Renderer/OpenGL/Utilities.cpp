@@ -219,47 +219,19 @@ void Utilities2::upload_2d(const pixel_descriptor& pfd, GLsizei w, GLsizei h, co
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat_gl, w, h, 0, format_gl, type_gl, data);
 }
 
-void Utilities2::upload_2d_mipmap(const pixel_descriptor& pfd, GLsizei w, GLsizei h, const void *data)
+void Utilities2::upload_2d_mipmap(const pixel_descriptor& pfd, const std::vector<std::shared_ptr<SDL_Surface>>& levels)
 {
     GLenum internalFormat_gl, format_gl, type_gl;
     Utilities2::toOpenGL(pfd, internalFormat_gl, format_gl, type_gl);
     PushClientAttrib pca(GL_CLIENT_PIXEL_STORE_BIT);
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat_gl, w, h, 0, format_gl, type_gl, data);
-
-    if (w == 1 && h == 1) return;
-
-    uint32_t alphaMask = pfd.get_alpha().get_mask(),
-             redMask = pfd.get_red().get_mask(),
-             greenMask = pfd.get_green().get_mask(),
-             blueMask = pfd.get_blue().get_mask();
-    int bpp = pfd.get_color_depth().depth();
-
-    SDL_Surface *surf = SDL_CreateRGBSurfaceFrom((void *)data, w, h, bpp, w * bpp / 8, redMask, greenMask, blueMask, alphaMask);
-    SDL_assert(surf != nullptr);
-
-    GLsizei newW = w;
-    GLsizei newH = h;
-    GLint level = 0;
-
-    do
+    // SDL aligns the rows of surfaces to 4 Bytes.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for (size_t level = 0; level < levels.size(); ++level)
     {
-        if (newW > 1) newW /= 2;
-        if (newH > 1) newH /= 2;
-        level++;
-
-        SDL_Surface *newSurf = SDL_CreateRGBSurface(0, newW, newH, bpp, redMask, greenMask, blueMask, alphaMask);
-        SDL_assert(newSurf != nullptr);
-
-        /// @todo this is 'low-quality' and not thread-safe
-        SDL_SoftStretch(surf, nullptr, newSurf, nullptr);
-
-        glTexImage2D(GL_TEXTURE_2D, level, internalFormat_gl, newW, newH, 0, format_gl, type_gl, newSurf->pixels);
-        SDL_FreeSurface(newSurf);
-    } while (!(newW == 1 && newH == 1));
-
-    SDL_FreeSurface(surf);
+        const auto& surface = levels[level];
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat_gl, surface->w, surface->h, 0, format_gl, type_gl, surface->pixels);
+    }
 }
 
 void Utilities2::toOpenGL(idlib::texture_filter_method minFilter, idlib::texture_filter_method magFilter, idlib::texture_filter_method mipMapFilter, GLint& minFilter_gl, GLint& magFilter_gl)
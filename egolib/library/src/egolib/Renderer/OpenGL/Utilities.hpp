@@ -100,11 +100,10 @@ public:
     /// @param data a pointer to the pixels
     static void upload_2d(const pixel_descriptor& pfd, GLsizei w, GLsizei h, const void *data);
     
-    /// @brief Upload a 2D texture generating the mipmaps.
+    /// @brief Upload a 2D texture with its mipmaps.
     /// @param pdf the pixel descriptor describing the format of a pixels
-    /// @param w, h the width and height of the pixel rectangle
-    /// @param data a pointer to the pixels
-    static void upload_2d_mipmap(const pixel_descriptor& pfd, GLsizei w, GLsizei h, const void *data);
+    /// @param levels the mipmap levels, level 0 first. The rows of the surfaces are 4 Byte aligned.
+    static void upload_2d_mipmap(const pixel_descriptor& pfd, const std::vector<std::shared_ptr<SDL_Surface>>& levels);
 
     static void toOpenGL(idlib::texture_filter_method minFilter, idlib::texture_filter_method magFilter, idlib::texture_filter_method mipMapFilter, GLint& minFilter_gl, GLint& magFilter_gl);
 
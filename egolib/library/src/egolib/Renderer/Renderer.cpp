@@ -64,7 +64,8 @@ TextureUnit::~TextureUnit()
 {}
 
 Renderer::Renderer()
-    : m_projectionMatrix(idlib::perspective_projection_matrix(Degrees(45.0f), 4.0f/3.0f, +0.1f, +1.0f)),
+    : m_pendingGeometry(nullptr),
+      m_projectionMatrix(idlib::perspective_projection_matrix(Degrees(45.0f), 4.0f/3.0f, +0.1f, +1.0f)),
       m_viewMatrix(idlib::identity<Matrix4f4f>()), m_worldMatrix(idlib::identity<Matrix4f4f>())
 {
     idlib::video_buffer_manager::initialize();
@@ -85,7 +86,23 @@ void Renderer::download(egoboo_config_t& cfg)
     /* Nothing to do. */
 }
 
+void Renderer::setPendingGeometry(PendingGeometry *pendingGeometry) {
+    flushPendingGeometry();
+    m_pendingGeometry = pendingGeometry;
+}
+
+PendingGeometry *Renderer::getPendingGeometry() const {
+    return m_pendingGeometry;
+}
+
+void Renderer::flushPendingGeometry() {
+    if (m_pendingGeometry) {
+        m_pendingGeometry->flush();
+    }
+}
+
 void Renderer::setProjectionMatrix(const Matrix4f4f& projectionMatrix) {
+    flushPendingGeometry();
     m_projectionMatrix = projectionMatrix;
 }
 
@@ -94,6 +111,7 @@ Matrix4f4f Renderer::getProjectionMatrix() const {
 }
 
 void Renderer::setViewMatrix(const Matrix4f4f& viewMatrix) {
+    flushPendingGeometry();
     m_viewMatrix = viewMatrix;
 }
 
@@ -102,6 +120,7 @@ Matrix4f4f Renderer::getViewMatrix() const {
 }
 
 void Renderer::setWorldMatrix(const Matrix4f4f& worldMatrix) {
+    flushPendingGeometry();
     m_worldMatrix = worldMatrix;
 }
 
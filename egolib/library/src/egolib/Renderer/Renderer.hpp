@@ -174,6 +174,18 @@ public:
 
 };
 
+/// @brief Geometry which a client collects before it submits it to the renderer in one draw call.
+/// The renderer flushes the pending geometry before it changes state or renders anything else.
+class PendingGeometry
+{
+public:
+    virtual ~PendingGeometry() {}
+
+    /// @brief Render the pending geometry, if any.
+    /// @remark The renderer might call this function while the pending geometry is flushed.
+    virtual void flush() = 0;
+};
+
 class Renderer;
 
 /// @brief Creator functor creating the back-end.
@@ -500,6 +512,22 @@ public:
     /// @post The texture is the default texture.
     virtual std::shared_ptr<Texture> createTexture() = 0;
 
+private:
+    PendingGeometry *m_pendingGeometry;
+
+public:
+    /// @brief Set the pending geometry which is flushed before any state change or draw call.
+    /// @param pendingGeometry a pointer to the pending geometry or a null pointer
+    void setPendingGeometry(PendingGeometry *pendingGeometry);
+
+    /// @brief Get the pending geometry.
+    /// @return a pointer to the pending geometry or a null pointer
+    PendingGeometry *getPendingGeometry() const;
+
+protected:
+    /// @brief Flush the pending geometry, if any.
+    void flushPendingGeometry();
+
 private:
     Matrix4f4f m_projectionMatrix;
     Matrix4f4f m_viewMatrix;
@@ -0,0 +1,93 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/TexturePayload.cpp
+/// @brief The preprocessed pixels of a texture.
+
+#include "egolib/Renderer/TexturePayload.hpp"
+#include "egolib/Image/SDL_Image_Extensions.h"
+
+namespace Ego {
+
+const pixel_descriptor& TexturePayload::getPixelDescriptor() const
+{
+    return hasAlpha ? pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>()
+                    : pixel_descriptor::get<idlib::pixel_format::R8G8B8>();
+}
+
+std::shared_ptr<SDL_Surface> TexturePayload::createSource() const
+{
+    if (levels.empty())
+    {
+        return nullptr;
+    }
+    const auto& level = levels[0];
+    if (level->w == sourceWidth && level->h == sourceHeight)
+    {
+        return SDL::cloneSurface(level);
+    }
+    const auto *format = level->format;
+    auto source = std::shared_ptr<SDL_Surface>(SDL_CreateRGBSurface(SDL_SWSURFACE, sourceWidth, sourceHeight, format->BitsPerPixel,
+                                                                    format->Rmask, format->Gmask, format->Bmask, format->Amask),
+                                               [](SDL_Surface *pSurface) { SDL_FreeSurface(pSurface); });
+    if (!source)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "SDL_CreateRGBSurface failed");
+    }
+    // The padding is at the right and at the bottom.
+    for (int y = 0; y < sourceHeight; ++y)
+    {
+        std::memcpy(static_cast<uint8_t *>(source->pixels) + y * source->pitch,
+                    static_cast<const uint8_t *>(level->pixels) + y * level->pitch,
+                    sourceWidth * format->BytesPerPixel);
+    }
+    return source;
+}
+
+std::shared_ptr<TexturePayload> TexturePayload::create(const std::shared_ptr<SDL_Surface>& surface, bool mipmaps)
+{
+    if (!surface)
+    {
+        throw idlib::argument_null_error(__FILE__, __LINE__, "surface");
+    }
+    auto payload = std::make_shared<TexturePayload>();
+    payload->sourceWidth = surface->w;
+    payload->sourceHeight = surface->h;
+
+    // Convert to RGBA if the image has non-opaque alpha values or alpha modulation and convert to RGB otherwise.
+    payload->hasAlpha = SDL::testAlpha(surface.get());
+    auto level = convert(surface, payload->getPixelDescriptor());
+
+    // Convert to power of two.
+    level = power_of_two(level);
+    payload->levels.push_back(level);
+
+    // Compute the mipmap levels down to 1x1.
+    if (mipmaps)
+    {
+        while (level->w > 1 || level->h > 1)
+        {
+            level = downsample(level);
+            payload->levels.push_back(level);
+        }
+    }
+    return payload;
+}
+
+} // namespace Ego
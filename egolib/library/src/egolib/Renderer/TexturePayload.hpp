@@ -0,0 +1,64 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Renderer/TexturePayload.hpp
+/// @brief The preprocessed pixels of a texture.
+
+#pragma once
+
+#include "egolib/Image/Image.hpp"
+
+namespace Ego {
+
+/**
+ * @brief
+ *  The pixels of a texture ready for the upload: converted to RGB or RGBA,
+ *  padded to power of two dimensions and with all mipmap levels.
+ * @remark
+ *  Creating a payload does not touch the renderer, payloads can be created concurrently.
+ */
+struct TexturePayload
+{
+    /// @brief @a true if the pixels are RGBA, @a false if they are RGB.
+    bool hasAlpha;
+
+    /// @brief The width and height, in pixels, of the source (before padding).
+    int sourceWidth, sourceHeight;
+
+    /// @brief The mipmap levels. Level 0 is the full resolution, the last level is 1x1.
+    /// If the mipmaps were not requested, only level 0 is present.
+    std::vector<std::shared_ptr<SDL_Surface>> levels;
+
+    /// @brief Get the pixel descriptor of the levels.
+    const pixel_descriptor& getPixelDescriptor() const;
+
+    /// @brief Create a copy of the source (i.e. the level 0 without the padding).
+    std::shared_ptr<SDL_Surface> createSource() const;
+
+    /**
+     * @brief
+     *  Preprocess a surface.
+     * @param surface the surface
+     * @param mipmaps if @a true all mipmap levels are computed, otherwise only level 0
+     * @return the payload
+     */
+    static std::shared_ptr<TexturePayload> create(const std::shared_ptr<SDL_Surface>& surface, bool mipmaps);
+};
+
+} // namespace Ego
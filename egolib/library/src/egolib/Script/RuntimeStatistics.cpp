@@ -0,0 +1,227 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/RuntimeStatistics.cpp
+/// @brief Statistics of the script runtime.
+
+#include "egolib/Script/RuntimeStatistics.hpp"
+#include <algorithm>
+
+namespace Ego {
+namespace Script {
+
+namespace {
+
+/// Escape a string for a JSON string literal.
+std::string escapeJson(const std::string& string)
+{
+    std::string escaped;
+    for (char c : string)
+    {
+        if ('"' == c || '\\' == c)
+        {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+/// Sort scripts by their number of instructions, most expensive first.
+void sortScripts(std::vector<RuntimeStatistics::ScriptStatistics>& scripts)
+{
+    std::sort(scripts.begin(), scripts.end(), [](const RuntimeStatistics::ScriptStatistics& a, const RuntimeStatistics::ScriptStatistics& b) {
+        return a.instructions > b.instructions || (a.instructions == b.instructions && a.name < b.name);
+    });
+}
+
+} // namespace
+
+RuntimeStatistics::RuntimeStatistics(const std::vector<std::string>& functionNames) :
+    _functionNames(functionNames),
+    _functions(functionNames.size()),
+    _enabled(false),
+    _samplingInterval(1)
+{
+    reset();
+}
+
+void RuntimeStatistics::setSamplingInterval(uint32_t interval)
+{
+    _samplingInterval.store(std::max<uint32_t>(1, interval), std::memory_order_relaxed);
+}
+
+void RuntimeStatistics::onFunctionTimed(uint32_t functionIndex, uint64_t nanoseconds)
+{
+    if (functionIndex >= _functions.size())
+    {
+        return;
+    }
+    FunctionStatistics& function = _functions[functionIndex];
+    function.sampledCalls.fetch_add(1, std::memory_order_relaxed);
+    function.sampledNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    function.histogram[getBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = function.maxNanoseconds.load(std::memory_order_relaxed);
+    while (nanoseconds > max && !function.maxNanoseconds.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed))
+    {}
+}
+
+void RuntimeStatistics::reset()
+{
+    for (auto& function : _functions)
+    {
+        function.calls.store(0, std::memory_order_relaxed);
+        function.sampledCalls.store(0, std::memory_order_relaxed);
+        function.sampledNanoseconds.store(0, std::memory_order_relaxed);
+        function.maxNanoseconds.store(0, std::memory_order_relaxed);
+        for (auto& bucket : function.histogram)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t RuntimeStatistics::getBucket(uint64_t nanoseconds)
+{
+    uint64_t microseconds = nanoseconds / 1000;
+    size_t bucket = 0;
+    while (microseconds > 0 && bucket < NUMBER_OF_BUCKETS - 1)
+    {
+        microseconds >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+double RuntimeStatistics::getEstimatedMilliseconds(const FunctionStatistics& function) const
+{
+    const uint64_t sampledCalls = function.sampledCalls.load(std::memory_order_relaxed);
+    if (0 == sampledCalls)
+    {
+        return 0.0;
+    }
+    const double mean = double(function.sampledNanoseconds.load(std::memory_order_relaxed)) / double(sampledCalls);
+    return mean * double(function.calls.load(std::memory_order_relaxed)) / 1000000.0;
+}
+
+std::vector<size_t> RuntimeStatistics::getCalledFunctions() const
+{
+    std::vector<std::pair<double, size_t>> called;
+    for (size_t i = 0; i < _functions.size(); ++i)
+    {
+        if (_functions[i].calls.load(std::memory_order_relaxed) > 0)
+        {
+            called.emplace_back(getEstimatedMilliseconds(_functions[i]), i);
+        }
+    }
+    std::sort(called.begin(), called.end(), [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+    std::vector<size_t> indices;
+    for (const auto& element : called)
+    {
+        indices.push_back(element.second);
+    }
+    return indices;
+}
+
+void RuntimeStatistics::writeCsv(std::ostream& os, std::vector<ScriptStatistics> scripts) const
+{
+    os << "kind,name,calls,sampled calls,mean us,max us,estimated total ms,runs,instructions";
+    for (size_t i = 0; i < NUMBER_OF_BUCKETS; ++i)
+    {
+        if (0 == i) os << ",<1us";
+        else if (NUMBER_OF_BUCKETS - 1 == i) os << ",>=" << (1 << (i - 1)) << "us";
+        else os << ",<" << (1 << i) << "us";
+    }
+    os << std::endl;
+
+    for (size_t index : getCalledFunctions())
+    {
+        const FunctionStatistics& function = _functions[index];
+        const uint64_t sampledCalls = function.sampledCalls.load(std::memory_order_relaxed);
+        const double mean = 0 == sampledCalls ? 0.0 : double(function.sampledNanoseconds.load(std::memory_order_relaxed)) / double(sampledCalls) / 1000.0;
+        os << "function," << _functionNames[index] << ","
+           << function.calls.load(std::memory_order_relaxed) << "," << sampledCalls << ","
+           << mean << "," << double(function.maxNanoseconds.load(std::memory_order_relaxed)) / 1000.0 << ","
+           << getEstimatedMilliseconds(function) << ",,";
+        for (const auto& bucket : function.histogram)
+        {
+            os << "," << bucket.load(std::memory_order_relaxed);
+        }
+        os << std::endl;
+    }
+
+    sortScripts(scripts);
+    for (const auto& script : scripts)
+    {
+        os << "script,\"" << script.name << "\",,,,,," << script.runs << "," << script.instructions;
+        for (size_t i = 0; i < NUMBER_OF_BUCKETS; ++i)
+        {
+            os << ",";
+        }
+        os << std::endl;
+    }
+}
+
+void RuntimeStatistics::writeJson(std::ostream& os, std::vector<ScriptStatistics> scripts) const
+{
+    os << "{" << std::endl;
+    os << "  \"samplingInterval\": " << getSamplingInterval() << "," << std::endl;
+    os << "  \"functions\": [";
+    bool first = true;
+    for (size_t index : getCalledFunctions())
+    {
+        const FunctionStatistics& function = _functions[index];
+        const uint64_t sampledCalls = function.sampledCalls.load(std::memory_order_relaxed);
+        const double mean = 0 == sampledCalls ? 0.0 : double(function.sampledNanoseconds.load(std::memory_order_relaxed)) / double(sampledCalls) / 1000.0;
+        os << (first ? "" : ",") << std::endl;
+        os << "    { \"name\": \"" << escapeJson(_functionNames[index]) << "\""
+           << ", \"calls\": " << function.calls.load(std::memory_order_relaxed)
+           << ", \"sampledCalls\": " << sampledCalls
+           << ", \"meanMicroseconds\": " << mean
+           << ", \"maxMicroseconds\": " << double(function.maxNanoseconds.load(std::memory_order_relaxed)) / 1000.0
+           << ", \"estimatedTotalMilliseconds\": " << getEstimatedMilliseconds(function)
+           << ", \"histogram\": [";
+        for (size_t i = 0; i < NUMBER_OF_BUCKETS; ++i)
+        {
+            os << (0 == i ? "" : ", ") << function.histogram[i].load(std::memory_order_relaxed);
+        }
+        os << "] }";
+        first = false;
+    }
+    os << std::endl << "  ]," << std::endl;
+
+    sortScripts(scripts);
+    os << "  \"scripts\": [";
+    first = true;
+    for (const auto& script : scripts)
+    {
+        os << (first ? "" : ",") << std::endl;
+        os << "    { \"name\": \"" << escapeJson(script.name) << "\""
+           << ", \"runs\": " << script.runs
+           << ", \"instructions\": " << script.instructions << " }";
+        first = false;
+    }
+    os << std::endl << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
+
+} // namespace Script
+} // namespace Ego
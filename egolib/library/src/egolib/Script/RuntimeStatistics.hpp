@@ -0,0 +1,164 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/Script/RuntimeStatistics.hpp
+/// @brief Statistics of the script runtime.
+
+#pragma once
+
+#include "idlib/platform.hpp"
+#include <array>
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Ego {
+namespace Script {
+
+/**
+ * @brief
+ *  Statistics of the script runtime: the number of calls of each script function and a latency
+ *  histogram per function, plus the number of instructions executed by each script.
+ * @remark
+ *  The counters are relaxed atomics in a flat table indexed by the function value code.
+ *  Only one in getSamplingInterval() calls of a function is timed. Nothing is recorded while disabled.
+ */
+class RuntimeStatistics
+{
+public:
+    /**
+     * @brief
+     *  The number of latency buckets. Bucket 0 counts calls below 1 microsecond,
+     *  bucket i counts calls from 2^(i-1) up to 2^i microseconds, the last bucket counts all slower calls.
+     */
+    static constexpr size_t NUMBER_OF_BUCKETS = 16;
+
+    /// @brief Statistics of a single function.
+    struct FunctionStatistics
+    {
+        /// @brief The number of calls.
+        std::atomic<uint64_t> calls;
+        /// @brief The number of timed calls.
+        std::atomic<uint64_t> sampledCalls;
+        /// @brief The sum of the times (in nanoseconds) of the timed calls.
+        std::atomic<uint64_t> sampledNanoseconds;
+        /// @brief The maximum time (in nanoseconds) of a timed call.
+        std::atomic<uint64_t> maxNanoseconds;
+        /// @brief The number of timed calls per latency bucket.
+        std::array<std::atomic<uint64_t>, NUMBER_OF_BUCKETS> histogram;
+    };
+
+    /// @brief Statistics of a single script.
+    struct ScriptStatistics
+    {
+        /// @brief The name of the script.
+        std::string name;
+        /// @brief The number of times the script was run.
+        uint64_t runs;
+        /// @brief The number of instructions executed by these runs.
+        uint64_t instructions;
+    };
+
+    /**
+     * @brief
+     *  Construct these runtime statistics.
+     * @param functionNames
+     *  the names of the functions, indexed by function value code
+     */
+    RuntimeStatistics(const std::vector<std::string>& functionNames);
+
+    /// @brief Enable or disable recording.
+    void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+    /// @return @a true if recording is enabled
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    /// @brief Time one in @a interval calls of a function. Values below 1 are clamped to 1.
+    void setSamplingInterval(uint32_t interval);
+
+    /// @return the sampling interval
+    uint32_t getSamplingInterval() const { return _samplingInterval.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief
+     *  Invoked before a function is called.
+     * @param functionIndex
+     *  the function value code
+     * @return
+     *  @a true if the call should be timed and reported by onFunctionTimed()
+     */
+    bool onFunctionCalled(uint32_t functionIndex)
+    {
+        if (functionIndex >= _functions.size())
+        {
+            return false;
+        }
+        const uint64_t calls = _functions[functionIndex].calls.fetch_add(1, std::memory_order_relaxed);
+        return 0 == calls % getSamplingInterval();
+    }
+
+    /**
+     * @brief
+     *  Invoked after a timed call of a function.
+     * @param functionIndex
+     *  the function value code
+     * @param nanoseconds
+     *  the time spent on that call
+     */
+    void onFunctionTimed(uint32_t functionIndex, uint64_t nanoseconds);
+
+    /// @brief Reset all function statistics.
+    void reset();
+
+    /// @return the statistics of a function
+    const FunctionStatistics& getFunctionStatistics(uint32_t functionIndex) const { return _functions[functionIndex]; }
+
+    /// @return the latency bucket of a call which took @a nanoseconds
+    static size_t getBucket(uint64_t nanoseconds);
+
+    /**
+     * @brief
+     *  Write the function statistics and the specified script statistics as CSV, one row per function or script.
+     *  Functions are sorted by their estimated total time, scripts by their number of instructions.
+     */
+    void writeCsv(std::ostream& os, std::vector<ScriptStatistics> scripts) const;
+
+    /**
+     * @brief
+     *  Write the function statistics and the specified script statistics as JSON.
+     *  Functions are sorted by their estimated total time, scripts by their number of instructions.
+     */
+    void writeJson(std::ostream& os, std::vector<ScriptStatistics> scripts) const;
+
+private:
+    /// @return the indices of the functions called at least once, most expensive first
+    std::vector<size_t> getCalledFunctions() const;
+
+    /// @return the estimated total time (in milliseconds) spent on a function
+    double getEstimatedMilliseconds(const FunctionStatistics& function) const;
+
+    std::vector<std::string> _functionNames;
+    std::vector<FunctionStatistics> _functions;
+    std::atomic<bool> _enabled;
+    std::atomic<uint32_t> _samplingInterval;
+};
+
+} // namespace Script
+} // namespace Ego
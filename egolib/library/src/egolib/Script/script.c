@@ -24,7 +24,7 @@
 #include "egolib/Script/script.h"
 
 #include "egolib/AI/AStar.hpp"
-#include "egolib/Script/IRuntimeStatistics.hpp"
+#include "egolib/Script/RuntimeStatistics.hpp"
 
 #include "egolib/game/script_compile.h"
 #include "egolib/game/script_implementation.h"
@@ -40,27 +40,6 @@
 namespace Ego {
 namespace Script {
 
-/// @brief An implementation of runtime statistics.
-struct RuntimeStatistics : IRuntimeStatistics<uint32_t>
-{
-public:
-    void append(const std::string& pathname)
-    {
-        auto target = std::shared_ptr<vfs_FILE>(vfs_openAppend(pathname),
-                                                [](vfs_FILE *file) { if (nullptr != file) { vfs_close(file); } });
-        if (nullptr != target)
-        {
-            for (const auto& functionStatistic : _functionStatistics)
-            {
-                vfs_printf(target.get(), "function = %" PRIu32 "\t function name = \"%s\"\tnumber of calls = %ld\ttotalTime = %lf\tmaxTime = %lf\n",
-                           functionStatistic.first, _scriptFunctionNames[functionStatistic.first].c_str(), functionStatistic.second.numberOfCalls,
-                           functionStatistic.second.totalTime, functionStatistic.second.maxTime);
-
-            }
-        }
-    }
-};
-
 std::array<std::string, Ego::Script::ScriptVariables::SCRIPT_VARIABLES_COUNT> _scriptVariableNames = {
 #define Define(cName, eName) #cName,
 #define DefineAlias(cName, eName)
@@ -94,10 +73,10 @@ Runtime::Runtime() :
     #undef DefineAlias
     #undef Define
     },
-    _statistics(std::make_unique<RuntimeStatistics>()),
-    _clock(std::make_unique<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>>("runtime clock", 1))
+    _statistics(std::make_unique<RuntimeStatistics>(std::vector<std::string>(_scriptFunctionNames.begin(), _scriptFunctionNames.end())))
 {
-    /* Intentionally empty. */
+    _statistics->setEnabled(egoboo_config_t::get().debug_scriptStatistics_enable.getValue());
+    _statistics->setSamplingInterval(std::max(1, egoboo_config_t::get().debug_scriptStatistics_samplingInterval.getValue()));
 }
 
 Runtime::~Runtime()
@@ -128,11 +107,60 @@ void scripting_system_end()
 {
     if (Ego::Script::Runtime::is_initialized())
     {
-        Ego::Script::Runtime::get().getStatistics().append("/debug/script_function_timing.txt");
+        if (Ego::Script::Runtime::get().getStatistics().isEnabled())
+        {
+            scripting_system_export_statistics("/debug/script_statistics.csv", false);
+        }
         Ego::Script::Runtime::uninitialize();
     }
 }
 
+void scripting_system_reset_statistics()
+{
+    scripting_system_begin();
+    Ego::Script::Runtime::get().getStatistics().reset();
+    for (const auto& element : ProfileSystem::get().getLoadedProfiles())
+    {
+        script_info_t& script = element.second->getAIScript();
+        script._runs = 0;
+        script._instructionCount = 0;
+    }
+}
+
+bool scripting_system_export_statistics(const std::string& pathname, bool json)
+{
+    scripting_system_begin();
+
+    // Several profiles may use copies of the same script.
+    std::map<std::string, Ego::Script::RuntimeStatistics::ScriptStatistics> scriptsByName;
+    for (const auto& element : ProfileSystem::get().getLoadedProfiles())
+    {
+        const script_info_t& script = element.second->getAIScript();
+        if (0 == script._runs) continue;
+        auto& statistics = scriptsByName[script.getName()];
+        statistics.name = script.getName();
+        statistics.runs += script._runs;
+        statistics.instructions += script._instructionCount;
+    }
+    std::vector<Ego::Script::RuntimeStatistics::ScriptStatistics> scripts;
+    for (const auto& element : scriptsByName)
+    {
+        scripts.push_back(element.second);
+    }
+
+    std::ostringstream os;
+    if (json)
+    {
+        Ego::Script::Runtime::get().getStatistics().writeJson(os, scripts);
+    }
+    else
+    {
+        Ego::Script::Runtime::get().getStatistics().writeCsv(os, scripts);
+    }
+    const std::string data = os.str();
+    return vfs_writeEntireFile(pathname, data.c_str(), data.size());
+}
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 void scr_run_chr_script(Object *pchr)
@@ -241,8 +269,11 @@ void scr_run_chr_script(Object *pchr)
 
     // Run the AI Script.
     script.set_pos(0);
+    uint64_t instructionCount = 0;
     while (!aiState.terminate && script.get_pos() < script._instructions.getNumberOfInstructions())
     {
+        instructionCount++;
+
         // This is used by the Else function
         // it only keeps track of functions.
         script.indent_last = script.indent;
@@ -264,6 +295,11 @@ void scr_run_chr_script(Object *pchr)
             }
         }
     }
+    if (Ego::Script::Runtime::get().getStatistics().isEnabled())
+    {
+        script._runs++;
+        script._instructionCount += instructionCount;
+    }
 
     // Set movement latches
     if (!pchr->isPlayer())
@@ -402,17 +438,25 @@ uint8_t script_state_t::run_function(ai_state_t& aiState, script_info_t& script)
     // Assume that the function will pass, as most do
     uint8_t returnCode = true;
     auto& runtime = Ego::Script::Runtime::get();
+    const auto& result = runtime._functionValueCodeToFunctionPointer.find(functionIndex);
+    if (runtime._functionValueCodeToFunctionPointer.cend() == result)
     {
+        throw idlib::runtime_error(__FILE__, __LINE__, "function not found");
+    }
 
-        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(runtime.getClock());
-        const auto& result = runtime._functionValueCodeToFunctionPointer.find(functionIndex);
-        if (runtime._functionValueCodeToFunctionPointer.cend() == result)
-        {
-            throw idlib::runtime_error(__FILE__, __LINE__, "function not found");
-        }
+    // Time one in N calls, the other calls are only counted.
+    auto& statistics = runtime.getStatistics();
+    if (statistics.isEnabled() && statistics.onFunctionCalled(functionIndex))
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        returnCode = result->second(*this, aiState);
+        const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+        statistics.onFunctionTimed(functionIndex, static_cast<uint64_t>(nanoseconds));
+    }
+    else
+    {
         returnCode = result->second(*this, aiState);
     }
-    runtime.getStatistics().onFunctionInvoked(functionIndex, runtime.getClock().lst());
     return returnCode;
 }
 
@@ -609,7 +653,7 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
         // Load the variable. 
         auto variableIndex = constant.getAsInteger();
         varname = getVariableName(variableIndex);
-        auto pleader = _currentModule->getTeamList()[pobject->team].getLeader();
+        auto pleader = _currentModule->getTeamList()[pobject->getTeamID()].getLeader();
         iTmp = loadVariable(variableIndex, aiState, pobject, ptarget, powner, pleader.get());
     }
 
@@ -817,17 +861,17 @@ void issue_order(const ObjectRef character, uint32_t value)
     /// @details This function issues an value for help to all teammates
     int counter = 0;
 
-    const std::shared_ptr<Object> &pchr = _currentModule->getObjectHandler()[character];
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+    const std::shared_ptr<Object> &pchr = objectHandler[character];
+    if (!pchr) return;
 
-    for (const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+    for (ObjectRef memberRef : objectHandler.getTeamMembers(pchr->getTeamID()))
     {
-        if (object->isTerminated()) continue;
+        Object *member = objectHandler.get(memberRef);
+        if (!member || member->isTerminated()) continue;
 
-        if (object->getTeam() == pchr->getTeam())
-        {
-            ai_state_t::add_order(object->ai, value, counter);
-            counter++;
-        }
+        ai_state_t::add_order(member->ai, value, counter);
+        counter++;
     }
 }
 
@@ -838,15 +882,14 @@ void issue_special_order(uint32_t value, const IDSZ2& idsz)
     /// @details This function issues an order to all characters with the a matching special IDSZ
     int counter = 0;
 
-    for (const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+    ObjectHandler& objectHandler = _currentModule->getObjectHandler();
+    for (ObjectRef objectRef : objectHandler.getObjectsWithIDSZ(IDSZ_SPECIAL, idsz))
     {
-        if (object->isTerminated()) continue;
+        Object *object = objectHandler.get(objectRef);
+        if (!object || object->isTerminated()) continue;
 
-        if (idsz == object->getProfile()->getIDSZ(IDSZ_SPECIAL))
-        {
-            ai_state_t::add_order(object->ai, value, counter);
-            counter++;
-        }
+        ai_state_t::add_order(object->ai, value, counter);
+        counter++;
     }
 }
 
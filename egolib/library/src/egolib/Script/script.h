@@ -382,7 +382,9 @@ public:
         indent(0),
         indent_last(0),
         _position(0),
-        _instructions()
+        _instructions(),
+        _runs(0),
+        _instructionCount(0)
     {
         //ctor
     }
@@ -420,6 +422,12 @@ public:
 	 */
 	InstructionList _instructions;
 
+    /// @brief The number of times this script was run while the runtime statistics were enabled.
+    uint64_t _runs;
+
+    /// @brief The number of instructions executed by these runs.
+    uint64_t _instructionCount;
+
 	bool increment_pos();
 	size_t get_pos() const;
 	bool set_pos(size_t position);
@@ -538,8 +546,7 @@ namespace Ego {
 namespace Script {
 
 // Forward declaration.
-template <typename FunctionType>
-struct IRuntimeStatistics;
+class RuntimeStatistics;
 
 namespace NativeInterface {
 	/**
@@ -612,22 +619,13 @@ public:
 	std::unordered_map<uint32_t, NativeInterface::Function*> _functionValueCodeToFunctionPointer;
     std::unordered_map<uint32_t, OpcodeInfo> m_opcodeInfos;
 private:
-    /// @brief A clock to measure the time from the beginning to the end of an action performed by the runtime.
-    /// @remark Its window size is 1 as the duration spend in the invocation is added to an histogram.
-    std::unique_ptr<Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive>> _clock;
-
     /// @brief Runtime statistics (of this runtime).
-    std::unique_ptr<IRuntimeStatistics<uint32_t>> _statistics;
+    std::unique_ptr<RuntimeStatistics> _statistics;
 
 public:
-    /// @brief Get the clock.
-    /// @return the clock
-    /// @remark Used to measure the time from the beginning to the end of an action performed by the runtime.
-    Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> &getClock() { return *_clock; }
-
     /// @brief Get the statistics.
     /// @return the statistics
-    IRuntimeStatistics<uint32_t>& getStatistics() { return *_statistics; }
+    RuntimeStatistics& getStatistics() { return *_statistics; }
 };
 
 } // namespace Script
@@ -635,3 +633,11 @@ public:
 
 void scripting_system_begin();
 void scripting_system_end();
+
+/// @brief Reset the function statistics of the runtime and the instruction counts of all loaded scripts.
+void scripting_system_reset_statistics();
+
+/// @brief Write the function statistics of the runtime and the instruction counts of all loaded scripts.
+/// @param json write JSON if @a true, CSV otherwise
+/// @return @a true on success, @a false otherwise
+bool scripting_system_export_statistics(const std::string& pathname, bool json);
@@ -0,0 +1,219 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/VFS/PackArchive.cpp
+/// @brief Pack files: many small game data files in one file with a perfect hash directory.
+
+#include "egolib/VFS/PackArchive.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace Ego {
+
+namespace {
+
+uint16_t getUint16(const char *bytes)
+{
+    return uint16_t(uint8_t(bytes[0])) | uint16_t(uint8_t(bytes[1])) << 8;
+}
+
+uint32_t getUint32(const char *bytes)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        value |= uint32_t(uint8_t(bytes[i])) << (i * 8);
+    }
+    return value;
+}
+
+uint64_t getUint64(const char *bytes)
+{
+    return uint64_t(getUint32(bytes)) | uint64_t(getUint32(bytes + 4)) << 32;
+}
+
+} // namespace
+
+const char PackArchive::MAGIC[8] = { 'E', 'G', 'O', 'P', 'A', 'K', '\0', '\0' };
+
+PackArchive::PackArchive(const std::string& filename) :
+    _filename(filename),
+    _stamp(0),
+    _displacements(),
+    _entries(),
+    _names(),
+    _directories(),
+    _stream(filename, std::ios::in | std::ios::binary),
+    _streamMutex()
+{
+    if (!_stream)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to open pack file `" + filename + "`");
+    }
+
+    // Header.
+    char header[HEADER_SIZE];
+    if (!_stream.read(header, HEADER_SIZE) || 0 != std::memcmp(header, MAGIC, sizeof(MAGIC)))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "`" + filename + "` is not a pack file");
+    }
+    if (VERSION != getUint32(header + 8))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "pack file `" + filename + "` has an unsupported version");
+    }
+    const uint32_t entryCount = getUint32(header + 12);
+    const uint32_t namesSize = getUint32(header + 16);
+    _stamp = int64_t(getUint64(header + 24));
+    if (entryCount >= DIRECT)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "pack file `" + filename + "` is corrupted");
+    }
+
+    // Displacements, entries and names are read in one go.
+    std::vector<char> buffer(size_t(entryCount) * (4 + ENTRY_SIZE) + namesSize);
+    if (!buffer.empty() && !_stream.read(buffer.data(), buffer.size()))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to read the directory of pack file `" + filename + "`");
+    }
+    const char *position = buffer.data();
+    _displacements.reserve(entryCount);
+    for (uint32_t i = 0; i < entryCount; ++i, position += 4)
+    {
+        _displacements.push_back(getUint32(position));
+    }
+    _entries.reserve(entryCount);
+    for (uint32_t i = 0; i < entryCount; ++i, position += ENTRY_SIZE)
+    {
+        Entry entry;
+        entry.offset = getUint64(position);
+        entry.size = getUint64(position + 8);
+        entry.storedSize = getUint64(position + 16);
+        entry.nameOffset = getUint32(position + 24);
+        entry.nameLength = getUint16(position + 28);
+        entry.flags = getUint16(position + 30);
+        if (Stored != entry.flags || entry.size != entry.storedSize ||
+            uint64_t(entry.nameOffset) + entry.nameLength > namesSize || 0 == entry.nameLength)
+        {
+            throw idlib::runtime_error(__FILE__, __LINE__, "pack file `" + filename + "` is corrupted");
+        }
+        _entries.push_back(entry);
+    }
+    _names.assign(position, namesSize);
+
+    // Verify the directory and derive the directories from the names.
+    std::unordered_map<std::string, std::unordered_set<std::string>> directories;
+    directories[std::string()];
+    for (const auto& entry : _entries)
+    {
+        const std::string name = getName(entry);
+        if (find(name) != &entry)
+        {
+            throw idlib::runtime_error(__FILE__, __LINE__, "pack file `" + filename + "` is corrupted");
+        }
+        size_t begin = 0;
+        for (size_t end = name.find('/'); ; end = name.find('/', begin))
+        {
+            const std::string parent = 0 == begin ? std::string() : name.substr(0, begin - 1);
+            if (std::string::npos == end)
+            {
+                directories[parent].insert(name.substr(begin));
+                break;
+            }
+            directories[parent].insert(name.substr(begin, end - begin));
+            begin = end + 1;
+        }
+    }
+    for (auto& directory : directories)
+    {
+        std::vector<std::string> children(directory.second.begin(), directory.second.end());
+        std::sort(children.begin(), children.end());
+        _directories.emplace(directory.first, std::move(children));
+    }
+}
+
+uint64_t PackArchive::hash(const char *name, size_t length, uint32_t seed)
+{
+    // 64 bit FNV-1a with the seed folded into the offset basis,
+    // finished with a mixer such that the low bits can be used for the modulus.
+    uint64_t hash = 14695981039346656037ULL ^ (uint64_t(seed) * 0x9e3779b97f4a7c15ULL);
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= uint8_t(name[i]);
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+const PackArchive::Entry *PackArchive::find(const std::string& name) const
+{
+    const size_t count = _entries.size();
+    if (0 == count || name.empty())
+    {
+        return nullptr;
+    }
+    const uint32_t displacement = _displacements[hash(name.data(), name.size(), 0) % count];
+    const size_t slot = (DIRECT & displacement) ? (~DIRECT & displacement)
+                                                : hash(name.data(), name.size(), displacement) % count;
+    if (slot >= count)
+    {
+        return nullptr;
+    }
+    const Entry& entry = _entries[slot];
+    if (entry.nameLength != name.size() || 0 != _names.compare(entry.nameOffset, entry.nameLength, name))
+    {
+        return nullptr;
+    }
+    return &entry;
+}
+
+bool PackArchive::isDirectory(const std::string& name) const
+{
+    return _directories.count(name) > 0;
+}
+
+const std::vector<std::string>& PackArchive::enumerate(const std::string& name) const
+{
+    static const std::vector<std::string> empty;
+    auto it = _directories.find(name);
+    return it != _directories.end() ? it->second : empty;
+}
+
+std::vector<char> PackArchive::read(const Entry& entry) const
+{
+    std::vector<char> contents(entry.size);
+    std::lock_guard<std::mutex> lock(_streamMutex);
+    _stream.clear();
+    if (!_stream.seekg(std::streamoff(entry.offset)) ||
+        (!contents.empty() && !_stream.read(contents.data(), contents.size())))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to read `" + getName(entry) + "` from pack file `" + _filename + "`");
+    }
+    return contents;
+}
+
+std::string PackArchive::getName(const Entry& entry) const
+{
+    return _names.substr(entry.nameOffset, entry.nameLength);
+}
+
+} // namespace Ego
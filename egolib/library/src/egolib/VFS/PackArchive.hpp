@@ -0,0 +1,135 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/VFS/PackArchive.hpp
+/// @brief Pack files: many small game data files in one file with a perfect hash directory.
+
+#pragma once
+
+#include <idlib/idlib.hpp>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Ego {
+
+/**
+ * @brief
+ *  A read-only pack file.
+ * @remark
+ *  Layout of a pack file, all integers are little-endian:
+ *  - header: magic <c>EGOPAK\0\0</c>, uint32 version, uint32 entry count, uint32 size of the name table,
+ *    uint32 reserved, uint64 stamp (the time the pack was written, in seconds since the epoch)
+ *  - one uint32 displacement per bucket, there are as many buckets as entries
+ *  - the entries (see PackArchive::Entry), in the order of their slots
+ *  - the name table, the names are '/'-separated paths relative to the packed directory
+ *  - the contents of the files, each one starting at a multiple of PackArchive::ALIGNMENT
+ *
+ *  The directory is a perfect hash ("hash and displace"): a name goes into the bucket
+ *  <c>hash(name, 0) % n</c>. Its slot is <c>hash(name, d) % n</c> where @a d is the displacement of
+ *  the bucket, or <c>d & ~DIRECT</c> if the bucket has only one name and #DIRECT is set in @a d.
+ *  A lookup is two hashes and one name comparison, no probing.
+ */
+class PackArchive
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+    /// @brief File contents start at multiples of this, so they can be read (or mapped) page by page.
+    static constexpr uint64_t ALIGNMENT = 4096;
+    /// @brief A displacement with this bit set is the slot of the only name in its bucket.
+    static constexpr uint32_t DIRECT = 0x80000000;
+    static const char MAGIC[8];
+    static constexpr size_t HEADER_SIZE = 32;
+    static constexpr size_t ENTRY_SIZE = 32;
+
+    /// @brief Flags of an entry.
+    enum EntryFlags : uint16_t
+    {
+        /// @brief The contents are stored as they are. No compression method is defined yet,
+        /// archives with other flags are rejected.
+        Stored = 0,
+    };
+
+    /// @brief An entry of the directory.
+    struct Entry
+    {
+        uint64_t offset;      ///< The offset of the contents from the beginning of the pack file.
+        uint64_t size;        ///< The size of the file.
+        uint64_t storedSize;  ///< The size of the contents in the pack file.
+        uint32_t nameOffset;  ///< The offset of the name in the name table.
+        uint16_t nameLength;  ///< The length of the name.
+        uint16_t flags;       ///< See PackArchive::EntryFlags.
+    };
+
+    /**
+     * @brief Open a pack file.
+     * @param filename the pathname of the pack file in platform-specific notation
+     * @throw idlib::runtime_error the file can not be read or is not a valid pack file
+     */
+    explicit PackArchive(const std::string& filename);
+
+    /// @brief The hash function of the directory.
+    static uint64_t hash(const char *name, size_t length, uint32_t seed);
+
+    /// @return the entry of the file of the specified name, a null pointer if there is no such file
+    const Entry *find(const std::string& name) const;
+
+    /// @return @a true if the specified name is a directory i.e. a proper prefix of the name of a file, @a false otherwise
+    /// @remark The empty name is the root directory.
+    bool isDirectory(const std::string& name) const;
+
+    /// @brief Get the names (without the directory) of the files and directories in a directory.
+    /// @param name the name of the directory
+    /// @return the names, an empty vector if there is no such directory
+    const std::vector<std::string>& enumerate(const std::string& name) const;
+
+    /**
+     * @brief Read the contents of a file.
+     * @param entry the entry of the file
+     * @return the contents
+     * @throw idlib::runtime_error an error occurred while reading
+     * @remark This function is thread-safe.
+     */
+    std::vector<char> read(const Entry& entry) const;
+
+    /// @return the name of an entry
+    std::string getName(const Entry& entry) const;
+
+    const std::vector<Entry>& getEntries() const { return _entries; }
+
+    const std::string& getFilename() const { return _filename; }
+
+    /// @return the time the pack file was written, in seconds since the epoch
+    int64_t getStamp() const { return _stamp; }
+
+private:
+    std::string _filename;
+    int64_t _stamp;
+    std::vector<uint32_t> _displacements;
+    std::vector<Entry> _entries;
+    std::string _names;
+    /// @brief The contents of all directories, derived from the names when the pack is opened.
+    std::unordered_map<std::string, std::vector<std::string>> _directories;
+    mutable std::ifstream _stream;
+    mutable std::mutex _streamMutex;
+};
+
+} // namespace Ego
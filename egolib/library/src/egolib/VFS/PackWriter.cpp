@@ -0,0 +1,264 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/VFS/PackWriter.cpp
+/// @brief Writing pack files.
+
+#include "egolib/VFS/PackWriter.hpp"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace Ego {
+
+namespace {
+
+void putUint16(std::vector<char>& buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<char>(value & 0xff));
+    buffer.push_back(static_cast<char>(value >> 8));
+}
+
+void putUint32(std::vector<char>& buffer, uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+void putUint64(std::vector<char>& buffer, uint64_t value)
+{
+    putUint32(buffer, uint32_t(value));
+    putUint32(buffer, uint32_t(value >> 32));
+}
+
+} // namespace
+
+PackWriter::PackWriter() :
+    _files(),
+    _names()
+{}
+
+void PackWriter::validate(const std::string& name)
+{
+    if (name.empty() || name.size() > 0xffff || '/' == name.front() || '/' == name.back() ||
+        std::string::npos != name.find("//") || std::string::npos != name.find('\\'))
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "`" + name + "` is not a valid name for a packed file");
+    }
+    if (!_names.insert(name).second)
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "`" + name + "` was already added");
+    }
+}
+
+void PackWriter::add(const std::string& name, std::vector<char> contents)
+{
+    validate(name);
+    _files.push_back(File{ name, std::string(), std::move(contents) });
+}
+
+void PackWriter::addFile(const std::string& name, const std::string& pathname)
+{
+    validate(name);
+    _files.push_back(File{ name, pathname, std::vector<char>() });
+}
+
+void PackWriter::buildDirectory(const std::vector<std::string>& names, std::vector<uint32_t>& displacements, std::vector<uint32_t>& slots)
+{
+    const size_t count = names.size();
+    if (count >= PackArchive::DIRECT)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "too many files for a pack file");
+    }
+    displacements.assign(count, 0);
+    slots.assign(count, 0);
+
+    std::vector<std::vector<size_t>> buckets(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        buckets[PackArchive::hash(names[i].data(), names[i].size(), 0) % count].push_back(i);
+    }
+    // The largest buckets are the hardest to place, place them first while most slots are free.
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&buckets](size_t x, size_t y) { return buckets[x].size() > buckets[y].size(); });
+
+    std::vector<bool> taken(count, false);
+    std::vector<size_t> candidates;
+    size_t freeSlot = 0;
+    for (size_t bucket : order)
+    {
+        const auto& members = buckets[bucket];
+        if (members.empty())
+        {
+            break;
+        }
+        if (1 == members.size())
+        {
+            // Buckets with one name get a free slot directly.
+            while (taken[freeSlot]) freeSlot++;
+            taken[freeSlot] = true;
+            slots[members[0]] = uint32_t(freeSlot);
+            displacements[bucket] = PackArchive::DIRECT | uint32_t(freeSlot);
+            continue;
+        }
+        for (uint32_t displacement = 1; ; ++displacement)
+        {
+            if (displacement == PackArchive::DIRECT)
+            {
+                throw idlib::runtime_error(__FILE__, __LINE__, "unable to build the directory of a pack file");
+            }
+            candidates.clear();
+            for (size_t member : members)
+            {
+                const size_t slot = PackArchive::hash(names[member].data(), names[member].size(), displacement) % count;
+                if (taken[slot] || std::find(candidates.begin(), candidates.end(), slot) != candidates.end())
+                {
+                    break;
+                }
+                candidates.push_back(slot);
+            }
+            if (candidates.size() == members.size())
+            {
+                for (size_t i = 0; i < members.size(); ++i)
+                {
+                    taken[candidates[i]] = true;
+                    slots[members[i]] = uint32_t(candidates[i]);
+                }
+                displacements[bucket] = displacement;
+                break;
+            }
+        }
+    }
+}
+
+void PackWriter::write(const std::string& filename, int64_t stamp) const
+{
+    std::vector<std::string> names;
+    names.reserve(_files.size());
+    for (const auto& file : _files)
+    {
+        names.push_back(file.name);
+    }
+    std::vector<uint32_t> displacements, slots;
+    buildDirectory(names, displacements, slots);
+
+    // The name table, in the order in which the files were added.
+    std::string nameTable;
+    std::vector<uint32_t> nameOffsets;
+    for (const auto& name : names)
+    {
+        nameOffsets.push_back(uint32_t(nameTable.size()));
+        nameTable += name;
+    }
+    if (nameTable.size() > 0xffffffff)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "too many files for a pack file");
+    }
+    const uint64_t directorySize = PackArchive::HEADER_SIZE + _files.size() * (4 + PackArchive::ENTRY_SIZE) + nameTable.size();
+    const auto align = [](uint64_t offset) { return (offset + PackArchive::ALIGNMENT - 1) / PackArchive::ALIGNMENT * PackArchive::ALIGNMENT; };
+
+    std::ofstream stream(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to open pack file `" + filename + "` for writing");
+    }
+
+    static const std::vector<char> padding(PackArchive::ALIGNMENT, '\0');
+    const auto writePadding = [&stream](uint64_t size)
+    {
+        while (size > 0)
+        {
+            const uint64_t chunk = std::min(size, uint64_t(PackArchive::ALIGNMENT));
+            stream.write(padding.data(), std::streamsize(chunk));
+            size -= chunk;
+        }
+    };
+
+    // Reserve the space of the directory, it is written when the offsets are known.
+    writePadding(align(directorySize));
+
+    // The contents, in the order in which the files were added
+    // such that files of the same directory are next to each other.
+    std::vector<PackArchive::Entry> entries(_files.size());
+    uint64_t offset = align(directorySize);
+    for (size_t i = 0; i < _files.size(); ++i)
+    {
+        const File& file = _files[i];
+        std::vector<char> source;
+        const std::vector<char> *contents = &file.contents;
+        if (!file.pathname.empty())
+        {
+            std::ifstream input(file.pathname, std::ios::in | std::ios::binary);
+            if (!input)
+            {
+                throw idlib::runtime_error(__FILE__, __LINE__, "unable to open `" + file.pathname + "` for reading");
+            }
+            source.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+            if (input.bad())
+            {
+                throw idlib::runtime_error(__FILE__, __LINE__, "unable to read `" + file.pathname + "`");
+            }
+            contents = &source;
+        }
+        PackArchive::Entry& entry = entries[slots[i]];
+        entry.offset = offset;
+        entry.size = contents->size();
+        entry.storedSize = contents->size();
+        entry.nameOffset = nameOffsets[i];
+        entry.nameLength = uint16_t(file.name.size());
+        entry.flags = PackArchive::Stored;
+        stream.write(contents->data(), std::streamsize(contents->size()));
+        writePadding(align(offset + contents->size()) - (offset + contents->size()));
+        offset = align(offset + contents->size());
+    }
+
+    // The header and the directory.
+    std::vector<char> directory(PackArchive::MAGIC, PackArchive::MAGIC + sizeof(PackArchive::MAGIC));
+    putUint32(directory, PackArchive::VERSION);
+    putUint32(directory, uint32_t(_files.size()));
+    putUint32(directory, uint32_t(nameTable.size()));
+    putUint32(directory, 0);
+    putUint64(directory, uint64_t(stamp));
+    for (uint32_t displacement : displacements)
+    {
+        putUint32(directory, displacement);
+    }
+    for (const auto& entry : entries)
+    {
+        putUint64(directory, entry.offset);
+        putUint64(directory, entry.size);
+        putUint64(directory, entry.storedSize);
+        putUint32(directory, entry.nameOffset);
+        putUint16(directory, entry.nameLength);
+        putUint16(directory, entry.flags);
+    }
+    directory.insert(directory.end(), nameTable.begin(), nameTable.end());
+    stream.seekp(0);
+    stream.write(directory.data(), std::streamsize(directory.size()));
+
+    if (!stream.flush())
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to write pack file `" + filename + "`");
+    }
+}
+
+} // namespace Ego
@@ -0,0 +1,88 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/VFS/PackWriter.hpp
+/// @brief Writing pack files.
+
+#pragma once
+
+#include "egolib/VFS/PackArchive.hpp"
+#include <unordered_set>
+
+namespace Ego {
+
+/**
+ * @brief
+ *  Collects files and writes them into a pack file (see PackArchive for the layout).
+ */
+class PackWriter
+{
+public:
+    PackWriter();
+
+    /**
+     * @brief Add a file with the specified contents.
+     * @param name the '/'-separated name of the file relative to the packed directory e.g. <c>sword.obj/data.txt</c>
+     * @param contents the contents
+     * @throw idlib::invalid_argument_error @a name is not a valid name or a file of that name was already added
+     */
+    void add(const std::string& name, std::vector<char> contents);
+
+    /**
+     * @brief Add a file whose contents are read from a file when the pack file is written.
+     * @param name the '/'-separated name of the file relative to the packed directory
+     * @param pathname the pathname of the file in platform-specific notation
+     * @throw idlib::invalid_argument_error @a name is not a valid name or a file of that name was already added
+     */
+    void addFile(const std::string& name, const std::string& pathname);
+
+    /**
+     * @brief Write the pack file.
+     * @param filename the pathname of the pack file in platform-specific notation
+     * @param stamp the stamp of the pack file, usually the current time
+     * @throw idlib::runtime_error an error occurred while reading a source file or writing the pack file
+     */
+    void write(const std::string& filename, int64_t stamp) const;
+
+    /// @return the number of files added
+    size_t getSize() const { return _files.size(); }
+
+    /**
+     * @brief Assign the slots of the perfect hash.
+     * @param names the names
+     * @param [out] displacements the displacement of each bucket
+     * @param [out] slots the slot of each name
+     */
+    static void buildDirectory(const std::vector<std::string>& names, std::vector<uint32_t>& displacements, std::vector<uint32_t>& slots);
+
+private:
+    struct File
+    {
+        std::string name;
+        std::string pathname;
+        std::vector<char> contents;
+    };
+
+    void validate(const std::string& name);
+
+    std::vector<File> _files;
+    std::unordered_set<std::string> _names;
+};
+
+} // namespace Ego
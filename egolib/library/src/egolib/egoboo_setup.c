@@ -84,6 +84,7 @@ egoboo_config_t::egoboo_config_t() :
     graphic_framesPerSecond_max(30, "graphic.framesPerSecond.max", "inclusive upper bound of frames per second"),
     graphic_simultaneousParticles_max(768, "graphic.simultaneousParticles.max", "inclusive upper bound of simultaneous particles"),
     graphic_hd_textures_enable(true, "graphic.graphic_hd_textures_enable", "enable/disable HD textures"),
+    graphic_md2_packedFrames_enable(false, "graphic.md2.packedFrames.enable", "keep MD2 frames quantised instead of as floats"),
     //
     graphic_window_borderless(false, "graphic.window.bordless",
                               "if the window is borderless. A bordless window neither has a caption nor an edge frame"),
@@ -119,6 +120,8 @@ egoboo_config_t::egoboo_config_t() :
         { "Normal", Ego::GameDifficulty::Normal },
         { "Hard", Ego::GameDifficulty::Hard },
     }),
+    game_dormancy_enable(true, "game.dormancy.enable", "enable/disable letting idle objects far from all players sleep"),
+    game_dormancy_distance(16, "game.dormancy.distance", "distance in tiles from all players beyond which idle objects fall asleep"),
     // Camera configuration section.
     camera_control(CameraTurnMode::Auto, "camera.control", "type of camera control",
     {
@@ -147,7 +150,15 @@ egoboo_config_t::egoboo_config_t() :
     debug_hideMouse(true,"debug.hideMouse","show/hide mouse"),
     debug_grabMouse(true,"debug.grabMouse","grab/don't grab mouse"),
     debug_developerMode_enable(false,"debug.developerMode.enable","enable/disable developer mode"),
-    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function")
+    debug_sdlImage_enable(true,"debug.SDL_Image.enable","enable/disable advanced SDL_image function"),
+    debug_replay_record("", "debug.replay.record", "record the player input of every module played into this replay file"),
+    debug_replay_play("", "debug.replay.play", "play this replay file instead of showing the main menu"),
+    debug_replay_render(true, "debug.replay.render", "enable/disable rendering while playing a replay"),
+    debug_snapshot_ringLength(0, "debug.snapshot.ringLength", "number of seconds kept as snapshots to jump back to, 0 to take no snapshots"),
+    debug_scriptStatistics_enable(false, "debug.scriptStatistics.enable", "enable/disable recording of script function calls and instruction counts"),
+    debug_scriptStatistics_samplingInterval(16, "debug.scriptStatistics.samplingInterval", "time one in this many calls of a script function"),
+    debug_physics_parallel(true, "debug.physics.parallel", "enable/disable integrating the movement of free-standing objects in parallel"),
+    debug_frameArena_enable(true, "debug.frameArena.enable", "enable/disable allocating transient containers of a frame from a frame arena")
 {}
 
 egoboo_config_t::~egoboo_config_t()
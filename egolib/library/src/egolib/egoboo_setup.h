@@ -86,6 +86,7 @@ protected:
                 config.graphic_framesPerSecond_max,
                 config.graphic_simultaneousParticles_max,
                 config.graphic_hd_textures_enable,
+                config.graphic_md2_packedFrames_enable,
                 //
                 config.graphic_window_borderless,
                 config.graphic_window_resizable,
@@ -107,6 +108,8 @@ protected:
                 config.network_playerName,
                 //
                 config.game_difficulty,
+                config.game_dormancy_enable,
+                config.game_dormancy_distance,
                 //
                 config.camera_control,
                 //
@@ -125,7 +128,15 @@ protected:
                 config.debug_hideMouse,
                 config.debug_grabMouse,
                 config.debug_developerMode_enable,
-                config.debug_sdlImage_enable
+                config.debug_sdlImage_enable,
+                config.debug_replay_record,
+                config.debug_replay_play,
+                config.debug_replay_render,
+                config.debug_snapshot_ringLength,
+                config.debug_scriptStatistics_enable,
+                config.debug_scriptStatistics_samplingInterval,
+                config.debug_physics_parallel,
+                config.debug_frameArena_enable
             );
         return variables;
     }
@@ -283,6 +294,12 @@ public:
     /// @remark Default value is @a true.
     Ego::Configuration::Variable<bool> graphic_hd_textures_enable;
 
+    /// @brief If @a true, the frames of MD2 models are kept with quantised positions and
+    /// octahedral-encoded normals which are decoded during interpolation, otherwise they
+    /// are kept as floats.
+    /// @remark Default value is @a false.
+    Ego::Configuration::Variable<bool> graphic_md2_packedFrames_enable;
+
     /// @brief If @a true, the window is borderless, otherwise it is not.
     /// @remark A borderless window displays neither a caption nor an edge frame.
     /// @default Default is @a false.
@@ -379,6 +396,14 @@ public:
     /// @remark Default value is Ego::GameDifficulty::Normal.
     Ego::Configuration::Variable<Ego::GameDifficulty> game_difficulty;
 
+    /// @brief Let idle objects far from all players sleep until something wakes them.
+    /// @remark Default value is @a true.
+    Ego::Configuration::Variable<bool> game_dormancy_enable;
+
+    /// @brief The distance in tiles from all players beyond which idle objects fall asleep.
+    /// @remark Default value is @a 16.
+    Ego::Configuration::Variable<int> game_dormancy_distance;
+
     // HUD configuration section.
 
     /// @brief Inclusive upper bound of simultaneous messages.
@@ -448,6 +473,38 @@ public:
     /// @remark Default value is @a true.
     Ego::Configuration::Variable<bool> debug_sdlImage_enable;
 
+    /// @brief Record the player input of every module played into this replay file, empty for no recording.
+    /// @remark Default value is the empty string.
+    Ego::Configuration::Variable<std::string> debug_replay_record;
+
+    /// @brief Play this replay file instead of showing the main menu, empty for no replay.
+    /// @remark Default value is the empty string.
+    Ego::Configuration::Variable<std::string> debug_replay_play;
+
+    /// @brief Render while playing a replay? If not, the replay runs as fast as possible.
+    /// @remark Default value is @a true.
+    Ego::Configuration::Variable<bool> debug_replay_render;
+
+    /// @brief Number of seconds kept as snapshots to jump back to, 0 to take no snapshots.
+    /// @remark Default value is @a 0.
+    Ego::Configuration::Variable<int> debug_snapshot_ringLength;
+
+    /// @brief Record script function calls and instruction counts.
+    /// @remark Default value is @a false.
+    Ego::Configuration::Variable<bool> debug_scriptStatistics_enable;
+
+    /// @brief Time one in this many calls of a script function.
+    /// @remark Default value is @a 16.
+    Ego::Configuration::Variable<int> debug_scriptStatistics_samplingInterval;
+
+    /// @brief Integrate the movement of free-standing objects in parallel.
+    /// @remark Default value is @a true.
+    Ego::Configuration::Variable<bool> debug_physics_parallel;
+
+    /// @brief Allocate transient containers of an update or render frame from a frame arena.
+    /// @remark Default value is @a true.
+    Ego::Configuration::Variable<bool> debug_frameArena_enable;
+
 public:
 
     /// @brief Construct this Egoboo configuration with default settings.
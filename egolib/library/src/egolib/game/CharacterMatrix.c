@@ -26,9 +26,9 @@
 
 static int get_grip_verts( uint16_t grip_verts[], const ObjectRef imount, int vrt_offset );
 
-static egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc );
+static egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc, bool recursive );
 static bool apply_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp );
-static bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp );
+static bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp, bool recursive );
 
 static bool apply_one_character_matrix( Object * pchr, matrix_cache_t& mcache );
 static bool apply_one_weapon_matrix( Object * pweap, matrix_cache_t& mcache );
@@ -41,68 +41,75 @@ bool matrix_cache_t::isValid() const {
     return valid && matrix_valid;
 }
 
- bool matrix_cache_t::equal_to(const matrix_cache_t &rhs) const {
+namespace {
 
-    // handle problems with pointers
-    if (this == &rhs) {
-        return true;
+/// FNV-1a over the bytes of a value.
+template <typename T>
+void hashValue(uint64_t& hash, const T& value)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
     }
+}
 
-    // handle one of both if the matrix caches being invalid
-    if (!this->valid || !rhs.valid) {
-        return false;
+void hashVector(uint64_t& hash, const Ego::Vector3f& value)
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        hashValue(hash, value[i]);
     }
+}
 
-    // handle differences in the type
-    int itmp = this->type_bits - rhs.type_bits;
-    if (0 != itmp) return false;
+} // namespace
 
-    //---- check for differences in the MAT_WEAPON data
-    if (HAS_SOME_BITS(this->type_bits, MAT_WEAPON)) {
-        itmp = (signed)REF_TO_INT(this->grip_chr.get()) - (signed)REF_TO_INT(rhs.grip_chr.get());
-        if (0 != itmp) return false;
+void matrix_cache_t::updateVersion() {
+    uint64_t hash = 14695981039346656037ULL;
 
-        itmp = (signed)this->grip_slot - (signed)rhs.grip_slot;
-        if (0 != itmp) return false;
+    hashValue(hash, type_bits);
 
+    //---- the MAT_WEAPON data
+    if (HAS_SOME_BITS(type_bits, MAT_WEAPON)) {
+        hashValue(hash, grip_chr.get());
+        hashValue(hash, grip_slot);
         for (int cnt = 0; cnt < GRIP_VERTS; cnt++) {
-            itmp = (signed)this->grip_verts[cnt] - (signed)rhs.grip_verts[cnt];
-            if (0 != itmp) return false;
+            hashValue(hash, grip_verts[cnt]);
         }
+        hashVector(hash, grip_scale);
+    }
 
-        // handle differences in the scale of our mount
+    //---- the MAT_CHARACTER data
+    if (HAS_SOME_BITS(type_bits, MAT_CHARACTER)) {
         for (int cnt = 0; cnt < 3; cnt++) {
-            float ftmp = this->grip_scale[cnt] - rhs.grip_scale[cnt];
-            if (0.0f != ftmp) { return false; }
+            hashValue(hash, FACING_T(rotate[cnt]));
         }
+        hashVector(hash, pos);
     }
 
-    //---- check for differences in the MAT_CHARACTER data
-    if (HAS_SOME_BITS(this->type_bits, MAT_CHARACTER)) {
-        // handle differences in the "Euler" rotation angles in 16-bit form
-        for (int cnt = 0; cnt < 3; cnt++) {
-            Facing ftmp = this->rotate[cnt] - rhs.rotate[cnt];
-            if (Facing(0) != ftmp) { return false; }
-        }
+    //---- the shared data
+    if (HAS_SOME_BITS(type_bits, MAT_WEAPON) || HAS_SOME_BITS(type_bits, MAT_CHARACTER)) {
+        hashVector(hash, self_scale);
+    }
 
-        // handle differences in the translate vector
-        for (int cnt = 0; cnt < 3; cnt++) {
-            float ftmp = this->pos[cnt] - rhs.pos[cnt];
-            if (0.0f != ftmp) { return false; }
-        }
+    version = hash;
+}
+
+bool matrix_cache_t::equal_to(const matrix_cache_t &rhs) const {
+
+    // handle problems with pointers
+    if (this == &rhs) {
+        return true;
     }
 
-    //---- check for differences in the shared data
-    if (HAS_SOME_BITS(this->type_bits, MAT_WEAPON) || HAS_SOME_BITS(this->type_bits, MAT_CHARACTER)) {
-        // handle differences in our own scale
-        for (int cnt = 0; cnt < 3; cnt++) {
-            float ftmp = this->self_scale[cnt] - rhs.self_scale[cnt];
-            if (0.0f != ftmp) { return false; }
-        }
+    // handle one of both if the matrix caches being invalid
+    if (!this->valid || !rhs.valid) {
+        return false;
     }
 
-    // if it got here, the data is all the same
-    return true;
+    // the version covers the type and all data selected by the type
+    return this->version == rhs.version;
 }
 
 
@@ -166,7 +173,7 @@ int get_grip_verts( uint16_t grip_verts[], const ObjectRef imount, int vrt_offse
 }
 
 //--------------------------------------------------------------------------------------------
-bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
+bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp, bool recursive )
 {
     /// @author BB
     /// @details grab the matrix cache data for a given character and put it into mc_tmp.
@@ -190,7 +197,10 @@ bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
         Object * ptarget = _currentModule->getObjectHandler().get( pchr->ai.getTarget() );
 
         // make sure we have the latst info from the target
-        chr_update_matrix( ptarget, true );
+        if ( recursive )
+        {
+            chr_update_matrix( ptarget, true );
+        }
 
         // grab the matrix cache into from the character we are overlaying
         mc_tmp = ptarget->inst.matrix_cache;
@@ -212,7 +222,10 @@ bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
             Object * pmount = _currentModule->getObjectHandler().get( pchr->attachedto );
 
             // make sure we have the latst info from the target
-            chr_update_matrix( pmount, true );
+            if ( recursive )
+            {
+                chr_update_matrix( pmount, true );
+            }
 
             // just in case the mounts's matrix cannot be corrected
             // then treat it as if it is not mounted... yuck
@@ -247,6 +260,8 @@ bool chr_get_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
         }
     }
 
+    mc_tmp.updateVersion();
+
     return mc_tmp.valid;
 }
 
@@ -375,11 +390,13 @@ bool apply_one_weapon_matrix( Object * pweap, matrix_cache_t& mc_tmp )
         pweap->setPosition(Ego::Vector3f(nupoint[0][kX],nupoint[0][kY],nupoint[0][kZ]));
 
         // make sure we have the right data
-        chr_get_matrix_cache( pweap, mc_tmp );
+        // the mount was updated before the weapon, do not update it again
+        chr_get_matrix_cache( pweap, mc_tmp, false );
 
         // add in the appropriate mods
         // this is a hybrid character and weapon matrix
         SET_BIT( mc_tmp.type_bits, MAT_CHARACTER );
+        mc_tmp.updateVersion();
 
         // treat it like a normal character matrix
         apply_one_character_matrix( pweap, mc_tmp );
@@ -470,6 +487,7 @@ bool apply_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
                 mcache.rotate[kZ] = pchr->ori.facing_z;
 
                 mcache.pos = pchr->getPosition();
+                mcache.updateVersion();
 
                 applied = true;
             }
@@ -484,7 +502,7 @@ bool apply_matrix_cache( Object * pchr, matrix_cache_t& mc_tmp )
 }
 
 //--------------------------------------------------------------------------------------------
-egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc )
+egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc, bool recursive )
 {
     /// @author BB
     /// @details determine whether a matrix cache has become invalid and needs to be updated
@@ -492,18 +510,19 @@ egolib_rv matrix_cache_needs_update( Object * pchr, matrix_cache_t& pmc )
     if ( nullptr == pchr ) return rv_error;
 
     // get the matrix data that is supposed to be used to make the matrix
-    chr_get_matrix_cache( pchr, pmc );
+    chr_get_matrix_cache( pchr, pmc, recursive );
 
     // compare that data to the actual data used to make the matrix
     return !(pmc == pchr->inst.matrix_cache) ? rv_success : rv_fail;
 }
 
 //--------------------------------------------------------------------------------------------
-egolib_rv chr_update_matrix( Object * pchr, bool update_size )
+egolib_rv chr_update_matrix( Object * pchr, bool update_size, bool recursive )
 {
     /// @author BB
     /// @details Do everything necessary to set the current matrix for this character.
     ///     This might include recursively going down the list of this character's mounts, etc.
+    ///     If recursive is false, the caller has already updated the mounts (see TransformSystem).
     ///
     ///     Return true if a new matrix is applied to the character, false otherwise.
 
@@ -512,7 +531,7 @@ egolib_rv chr_update_matrix( Object * pchr, bool update_size )
     // recursively make sure that any mount matrices are updated
     const std::shared_ptr<Object> &holder = pchr->getHolder();
 
-    if (holder)
+    if (holder && recursive)
     {
         egolib_rv attached_update = chr_update_matrix(holder.get(), true);
 
@@ -533,7 +552,7 @@ egolib_rv chr_update_matrix( Object * pchr, bool update_size )
 
     // does the matrix cache need an update at all?
     matrix_cache_t mc_tmp;
-    egolib_rv retval = matrix_cache_needs_update( pchr, mc_tmp );
+    egolib_rv retval = matrix_cache_needs_update( pchr, mc_tmp, recursive );
     if ( rv_error == retval ) return rv_error;
     needs_update = ( rv_success == retval );
 
@@ -833,6 +852,7 @@ bool set_weapongrip( const ObjectRef iitem, const ObjectRef iholder, uint16_t vr
         {
             mcache.grip_verts[i] = grip_verts[i];
         }
+        mcache.updateVersion();
     }
 
     return true;
@@ -903,5 +923,6 @@ void make_one_character_matrix( const ObjectRef ichr )
         pchr->inst.matrix_cache.rotate[kZ] = pchr->ori.facing_z;
 
         pchr->inst.matrix_cache.pos = pchr->getPosition();
+        pchr->inst.matrix_cache.updateVersion();
     }
 }
@@ -51,9 +51,11 @@ struct matrix_cache_t : public idlib::equal_to_expr<matrix_cache_t>
         grip_slot(SLOT_LEFT),
         grip_verts(),
         grip_scale(),
-        self_scale()
+        self_scale(),
+        version(0)
     {
         grip_verts.fill(0xFFFF);
+        updateVersion();
     }
 
     bool valid;    // is the cache data valid?
@@ -84,6 +86,15 @@ struct matrix_cache_t : public idlib::equal_to_expr<matrix_cache_t>
     // the body fixed scaling
     Ego::Vector3f  self_scale;
 
+    // a hash of the type bits and of the data selected by them
+    uint64_t version;
+
+    /**
+     * Recompute the version of this matrix cache.
+     * @remark Must be called whenever the data of this matrix cache was modified.
+     */
+    void updateVersion();
+
     /**
      * Get if this matrix cache is valid.
      * @return @a true if this matrix cache is valid, @a false otherwise
@@ -92,12 +103,14 @@ struct matrix_cache_t : public idlib::equal_to_expr<matrix_cache_t>
     bool isValid() const;
 
 	// CRTP
+    /// @remark Two valid matrix caches are equal if their versions are equal.
     bool equal_to(const matrix_cache_t& other) const;
 };
 
 //Function prototypes
 bool    chr_matrix_valid( const Object * pchr );
-egolib_rv chr_update_matrix( Object * pchr, bool update_size );
+/// If @a recursive is @a false, the holder and the overlay target of @a pchr must already be up to date.
+egolib_rv chr_update_matrix( Object * pchr, bool update_size, bool recursive = true );
 bool set_weapongrip( const ObjectRef iitem, const ObjectRef iholder, uint16_t vrt_off );
 bool chr_getMatUp(Object *object_ptr, Ego::Vector3f& up);
 bool chr_getMatForward(Object *object_ptr, Ego::Vector3f& forward);
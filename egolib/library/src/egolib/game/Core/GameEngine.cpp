@@ -23,6 +23,13 @@
 #include "egolib/game/Graphics/CameraSystem.hpp"
 #include "egolib/game/GameStates/MainMenuState.hpp"
 #include "egolib/game/GameStates/PlayingState.hpp"
+#include "egolib/game/GameStates/LoadingState.hpp"
+#include "egolib/game/Logic/Player.hpp"
+#include "egolib/game/Logic/Replay.hpp"
+#include "egolib/Logic/Team.hpp"
+#include "egolib/game/Module/WorldSnapshot.hpp"
+#include "egolib/Script/RuntimeStatistics.hpp"
+#include "egolib/Core/AllocationCounter.hpp"
 #include "egolib/Profiles/_Include.hpp"
 #include "egolib/FileFormats/Globals.hpp"
 #include "egolib/InputControl/ControlSettingsFile.hpp"
@@ -42,6 +49,13 @@ const uint32_t GameEngine::GAME_TARGET_UPS;
 const uint64_t GameEngine::DELAY_PER_RENDER_FRAME;
 const uint64_t GameEngine::DELAY_PER_UPDATE_FRAME;
 
+/// Release the transient containers of a frame, no container using the arena may be alive.
+static void resetFrameArena(Ego::FrameArena& arena)
+{
+    arena.setEnabled(egoboo_config_t::get().debug_frameArena_enable.getValue());
+    arena.reset();
+}
+
 const uint32_t GameEngine::MAX_FRAMESKIP;
 
 const std::string GameEngine::GAME_VERSION = "2.9.0";
@@ -67,6 +81,9 @@ GameEngine::GameEngine() :
     _estimatedUPS(GAME_TARGET_UPS),
 
     _totalFramesRendered(0),
+    _updateTimes(),
+    _updateAllocations(0),
+    _renderAllocations(0),
 
     // Subscriptions
     shown(),
@@ -114,10 +131,25 @@ void GameEngine::start()
             break;
         }
 
+        // A replay without rendering is a benchmark and runs as fast as possible
+        const bool replayOnly = Ego::ReplaySystem::get().isPlaying() && !egoboo_config_t::get().debug_replay_render.getValue();
+
+        // A finished replay ends the program
+        if (Ego::ReplaySystem::get().isPlaying() && Ego::ReplaySystem::get().isFinished())
+        {
+            Ego::ReplaySystem::get().stop();
+            shutdown();
+            break;
+        }
+
         // Check if it is time to update everything
-        for(_frameSkip = 0; _frameSkip < MAX_FRAMESKIP && getMicros() > _updateTimeout; ++_frameSkip)
+        for(_frameSkip = 0; _frameSkip < MAX_FRAMESKIP && (replayOnly || getMicros() > _updateTimeout); ++_frameSkip)
         {
+            const uint64_t updateStart = getMicros();
+            const uint64_t allocations = Ego::AllocationCounter::getCount();
             updateOneFrame();
+            _updateAllocations = Ego::AllocationCounter::getCount() - allocations;
+            _updateTimes.add(getMicros() - updateStart);
             _updateTimeout += DELAY_PER_UPDATE_FRAME;
         }
 
@@ -129,10 +161,16 @@ void GameEngine::start()
         }
 
         // Check if it is time to draw everything
-        if(getMicros() >= _renderTimeout)
+        if(replayOnly)
+        {
+            // Nothing to draw, nothing to wait for
+        }
+        else if(getMicros() >= _renderTimeout)
         {
             // Draw the current frame
+            const uint64_t allocations = Ego::AllocationCounter::getCount();
             renderOneFrame();
+            _renderAllocations = Ego::AllocationCounter::getCount() - allocations;
 
             // Stabilize FPS throttle every so often in case rendering is lagging behind
             if(_totalFramesRendered % GAME_TARGET_FPS == 0)
@@ -225,6 +263,8 @@ void GameEngine::updateOneFrame()
     {
         requestScreenshot();
     }
+
+    resetFrameArena(Ego::FrameArena::getUpdateArena());
 }
 
 void GameEngine::renderOneFrame()
@@ -264,6 +304,8 @@ void GameEngine::renderOneFrame()
     {
         _screenshotReady = true;
     }
+
+    resetFrameArena(Ego::FrameArena::getRenderArena());
 }
 
 void GameEngine::renderPreloadText(const std::string &text)
@@ -283,6 +325,8 @@ void GameEngine::renderPreloadText(const std::string &text)
 
 bool GameEngine::initialize()
 {
+    const auto startTime = std::chrono::steady_clock::now();
+
     /* ********************************************************************************** */
     // >>> This must be done as the crappy old systems do not "pull" their configuration.
     //      More recent systems like video or audio system pull their configuraiton data
@@ -334,6 +378,32 @@ bool GameEngine::initialize()
 		}
 		if (command == "exit()")
 		{}
+		if (command == "quicksave()" || command == "quickload()" || 0 == command.compare(0, 7, "rewind("))
+		{
+			if (!_currentModule)
+			{
+				Ego::Core::Console::get().add_output(command + " can only be invoked when playing\n");
+				return;
+			}
+			runSnapshotCommand(command);
+		}
+		if (0 == command.compare(0, 12, "scriptstats("))
+		{
+			runScriptStatisticsCommand(command);
+		}
+		if (0 == command.compare(0, 12, "updatetimes("))
+		{
+			runUpdateTimesCommand(command);
+		}
+		if (0 == command.compare(0, 11, "spawnbench("))
+		{
+			if (!_currentModule)
+			{
+				Ego::Core::Console::get().add_output(command + " can only be invoked when playing\n");
+				return;
+			}
+			runSpawnBenchmarkCommand(command);
+		}
 	});
 
 
@@ -388,8 +458,17 @@ bool GameEngine::initialize()
     renderPreloadText("Finished!");
     vfs_empty_temp_directories();
 
-    //Start the main menu
-    pushGameState(std::make_shared<MainMenuState>());
+    // Initialize the replay system.
+    Ego::ReplaySystem::initialize();
+
+    //Start the replay or the main menu
+    if (!startReplay(egoboo_config_t::get().debug_replay_play.getValue()))
+    {
+        pushGameState(std::make_shared<MainMenuState>());
+    }
+
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+    Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "time to main menu: ", milliseconds, " ms", Log::EndOfEntry);
 
     return true;
 }
@@ -452,6 +531,9 @@ void GameEngine::uninitialize()
     // @todo This should be 'UIManager::uninitialize'.
     _uiManager.reset(nullptr);
 
+    // Uninitialize the replay system.
+    Ego::ReplaySystem::uninitialize();
+
     // Uninitialize the collision system.
     Ego::Physics::CollisionSystem::uninitialize();
 
@@ -486,6 +568,204 @@ void GameEngine::uninitialize()
 	Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "exiting Egoboo ", GAME_VERSION, ". See you next time", Log::EndOfEntry);
 }
 
+void GameEngine::runSnapshotCommand(const std::string& command)
+{
+    static const std::string QUICKSAVE_FILE = "/quicksave.egosnap";
+    auto& console = Ego::Core::Console::get();
+    try
+    {
+        if (command == "quicksave()")
+        {
+            std::vector<char> snapshot;
+            const auto startTime = std::chrono::steady_clock::now();
+            Ego::WorldSnapshot::capture(snapshot);
+            const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+            if (!Ego::WorldSnapshot::save(snapshot, QUICKSAVE_FILE))
+            {
+                console.add_output("unable to write " + QUICKSAVE_FILE + "\n");
+                return;
+            }
+            console.add_output("saved " + std::to_string(snapshot.size()) + " bytes in " + std::to_string(microseconds) + " us\n");
+        }
+        else if (command == "quickload()")
+        {
+            std::vector<char> snapshot;
+            if (!Ego::WorldSnapshot::load(snapshot, QUICKSAVE_FILE))
+            {
+                console.add_output("unable to read " + QUICKSAVE_FILE + "\n");
+                return;
+            }
+            const auto startTime = std::chrono::steady_clock::now();
+            Ego::WorldSnapshot::restore(snapshot);
+            const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+            console.add_output("loaded in " + std::to_string(microseconds) + " us\n");
+        }
+        else
+        {
+            // rewind(<seconds>)
+            Ego::SnapshotRing *ring = _currentModule->getSnapshotRing();
+            if (!ring)
+            {
+                console.add_output("no snapshots are taken, set debug.snapshot.ringLength in setup.txt\n");
+                return;
+            }
+            const int seconds = std::atoi(command.c_str() + 7);
+            if (seconds < 0 || !ring->rewind(size_t(seconds)))
+            {
+                console.add_output("only " + std::to_string(ring->size()) + " snapshots available\n");
+                return;
+            }
+            console.add_output("rewound to update " + std::to_string(update_wld) + "\n");
+        }
+    }
+    catch (const idlib::exception& ex)
+    {
+        console.add_output(command + " failed: " + ex.to_string() + "\n");
+    }
+}
+
+void GameEngine::runScriptStatisticsCommand(const std::string& command)
+{
+    auto& console = Ego::Core::Console::get();
+    scripting_system_begin();
+    auto& statistics = Ego::Script::Runtime::get().getStatistics();
+    if (command == "scriptstats(on)")
+    {
+        statistics.setEnabled(true);
+        console.add_output("recording script statistics, timing 1 in " + std::to_string(statistics.getSamplingInterval()) + " calls\n");
+    }
+    else if (command == "scriptstats(off)")
+    {
+        statistics.setEnabled(false);
+        console.add_output("stopped recording script statistics\n");
+    }
+    else if (command == "scriptstats(reset)")
+    {
+        scripting_system_reset_statistics();
+        console.add_output("script statistics reset\n");
+    }
+    else if (command == "scriptstats(csv)" || command == "scriptstats(json)")
+    {
+        const bool json = command == "scriptstats(json)";
+        const std::string pathname = json ? "/debug/script_statistics.json" : "/debug/script_statistics.csv";
+        if (!scripting_system_export_statistics(pathname, json))
+        {
+            console.add_output("unable to write " + pathname + "\n");
+            return;
+        }
+        console.add_output("script statistics written to " + pathname + "\n");
+    }
+    else
+    {
+        console.add_output("usage: scriptstats(on|off|reset|csv|json)\n");
+    }
+}
+
+void GameEngine::runUpdateTimesCommand(const std::string& command)
+{
+    auto& console = Ego::Core::Console::get();
+    if (command == "updatetimes(reset)")
+    {
+        _updateTimes.reset();
+        console.add_output("update times reset\n");
+    }
+    else if (command == "updatetimes()")
+    {
+        std::ostringstream os;
+        os << _updateTimes.getCount() << " updates, p50 " << _updateTimes.getPercentile(0.5) << " us, p99 "
+           << _updateTimes.getPercentile(0.99) << " us, max " << _updateTimes.getMax() << " us\n";
+        for (size_t bucket = 0; bucket < Ego::FrameTimeHistogram::BUCKET_COUNT; ++bucket)
+        {
+            if (_updateTimes.getBucketCount(bucket) > 0)
+            {
+                os << "  < " << Ego::FrameTimeHistogram::getBucketLimit(bucket) << " us: " << _updateTimes.getBucketCount(bucket) << "\n";
+            }
+        }
+        console.add_output(os.str());
+    }
+    else
+    {
+        console.add_output("usage: updatetimes() or updatetimes(reset)\n");
+    }
+}
+
+void GameEngine::runSpawnBenchmarkCommand(const std::string& command)
+{
+    // spawnbench(<count>)
+    auto& console = Ego::Core::Console::get();
+    const int count = std::atoi(command.c_str() + 11);
+    if (count <= 0)
+    {
+        console.add_output("usage: spawnbench(<count>)\n");
+        return;
+    }
+    std::shared_ptr<Object> object;
+    for (const auto& player : _currentModule->getPlayerList())
+    {
+        object = player->getObject();
+        if (object) break;
+    }
+    if (!object)
+    {
+        console.add_output("no player object to spawn the particles at\n");
+        return;
+    }
+
+    // Spawn harmless ripples one at a time and then in one pass.
+    auto& particleHandler = ParticleHandler::get();
+    const PIP_REF profile = particleHandler.getParticleProfile(ObjectProfileRef::Invalid, LocalParticleProfileRef(PIP_RIPPLE));
+    const Ego::Vector3f position = object->getPosition();
+
+    auto startTime = std::chrono::steady_clock::now();
+    size_t single = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (particleHandler.spawnParticle(position, Facing(0), ObjectProfileRef::Invalid, profile, ObjectRef::Invalid, GRIP_LAST, Team::TEAM_NULL,
+                                          ObjectRef::Invalid, ParticleRef::Invalid, i))
+        {
+            single++;
+        }
+    }
+    const auto singleMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+    startTime = std::chrono::steady_clock::now();
+    const size_t bulk = particleHandler.spawnParticles(profile, count, position, Facing(0), Facing(0), ObjectProfileRef::Invalid, ObjectRef::Invalid,
+                                                       GRIP_LAST, Team::TEAM_NULL, ObjectRef::Invalid);
+    const auto bulkMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+    console.add_output("spawned " + std::to_string(single) + " particles one at a time in " + std::to_string(singleMicroseconds) + " us, "
+                       + std::to_string(bulk) + " in one pass in " + std::to_string(bulkMicroseconds) + " us\n");
+}
+
+bool GameEngine::startReplay(const std::string& pathname)
+{
+    if (pathname.empty())
+    {
+        return false;
+    }
+    try
+    {
+        const Ego::ReplayHeader& header = Ego::ReplaySystem::get().startPlayback(pathname);
+        for (const auto& module : ProfileSystem::get().getModuleProfiles())
+        {
+            if (module->getPath() == header.module)
+            {
+                pushGameState(std::make_shared<LoadingState>(module, header.players));
+                return true;
+            }
+        }
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "module `", header.module, "` of replay `", pathname,
+                                         "` not found", Log::EndOfEntry);
+    }
+    catch (const idlib::exception& ex)
+    {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to play replay `", pathname, "`: ",
+                                         ex.to_string(), Log::EndOfEntry);
+    }
+    Ego::ReplaySystem::get().stop();
+    return false;
+}
+
 void GameEngine::setGameState(std::shared_ptr<GameState> gameState)
 {
     _clearGameStateStackRequested = true;
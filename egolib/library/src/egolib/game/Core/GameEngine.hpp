@@ -20,6 +20,8 @@
 #pragma once
 
 #include "egolib/egoboo_setup.h"
+#include "egolib/Core/FrameTimeHistogram.hpp"
+#include "egolib/Core/FrameArena.hpp"
 
 //Forward declarations
 class GameState;
@@ -128,6 +130,26 @@ public:
     **/
     int getFrameSkip() const;
 
+    /**
+    * @return
+    *	The histogram of the times spent in updateOneFrame(), in microseconds
+    **/
+    const Ego::FrameTimeHistogram& getUpdateTimes() const { return _updateTimes; }
+
+    /**
+    * @return
+    *	The number of heap allocations of the last updateOneFrame(), always 0 unless
+    *	Ego::AllocationCounter::isAvailable()
+    **/
+    uint64_t getUpdateAllocations() const { return _updateAllocations; }
+
+    /**
+    * @return
+    *	The number of heap allocations of the last renderOneFrame(), always 0 unless
+    *	Ego::AllocationCounter::isAvailable()
+    **/
+    uint64_t getRenderAllocations() const { return _renderAllocations; }
+
     /**
     * @return
     *   Number of microseconds since the GameEngine began running
@@ -244,6 +266,38 @@ private:
     **/
     void renderPreloadText(const std::string &text);
 
+    /**
+    * @brief
+    *	Start playing a replay: load the recorded module with the recorded players.
+    * @return
+    *	true if the replay was started, false if no replay was requested or it could not be started
+    **/
+    bool startReplay(const std::string& pathname);
+
+    /**
+    * @brief
+    *	Run one of the snapshot console commands quicksave(), quickload() and rewind(seconds).
+    **/
+    void runSnapshotCommand(const std::string& command);
+
+    /**
+    * @brief
+    *	Run the script statistics console command scriptstats(on|off|reset|csv|json).
+    **/
+    void runScriptStatisticsCommand(const std::string& command);
+
+    /**
+    * @brief
+    *	Run the update time console command updatetimes() or updatetimes(reset).
+    **/
+    void runUpdateTimesCommand(const std::string& command);
+
+    /**
+    * @brief
+    *	Run the particle spawn benchmark console command spawnbench(count).
+    **/
+    void runSpawnBenchmarkCommand(const std::string& command);
+
 private:
     std::chrono::high_resolution_clock::time_point _startupTimestamp;
     bool _terminateRequested;		///< true if the GameEngine should deinitialize and shutdown
@@ -268,6 +322,9 @@ private:
     float _estimatedUPS;
 
     uint32_t _totalFramesRendered; ///< The total number of frames drawn so far
+    Ego::FrameTimeHistogram _updateTimes; ///< The times spent in updateOneFrame()
+    uint64_t _updateAllocations;          ///< The heap allocations of the last updateOneFrame()
+    uint64_t _renderAllocations;          ///< The heap allocations of the last renderOneFrame()
 
     //GameEngine Submodules
     std::unique_ptr<Ego::GUI::UIManager> _uiManager;
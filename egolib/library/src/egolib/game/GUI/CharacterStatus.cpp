@@ -24,7 +24,6 @@
 #include "egolib/Entities/_Include.hpp"
 #include "egolib/game/Logic/Player.hpp"
 #include "egolib/game/GUI/ProgressBar.hpp"
-#include "egolib/game/GUI/Material.hpp"
 #include "egolib/game/game.h" //for update_wld
 
 namespace Ego {
@@ -126,7 +125,7 @@ float CharacterStatus::draw_one_bar(uint8_t bartype, float x_stt, float y_stt, i
     sc_rect = Rectangle2f(Point2f(x, y),
                           Point2f(x, y) + size);
 
-	_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(tx_ptr, Colour4f::white(), true));
+	_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, tx_ptr);
 
 	// make the new left-hand margin after the tab
 	x_left = x_stt + size.x();
@@ -146,7 +145,7 @@ float CharacterStatus::draw_one_bar(uint8_t bartype, float x_stt, float y_stt, i
         sc_rect = Rectangle2f(Point2f(x, y),
                               Point2f(x, y) + size);
 
-		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(tx_ptr, Colour4f::white(), true));
+		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, tx_ptr);
 
 		y += size.y();
 		ticks -= NUMTICK;
@@ -168,7 +167,7 @@ float CharacterStatus::draw_one_bar(uint8_t bartype, float x_stt, float y_stt, i
         sc_rect = Rectangle2f(Point2f(x, y),
                               Point2f(x, y) + size);
 
-		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(tx_ptr, Colour4f::white(), true));
+		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, tx_ptr);
 
 		// move to the right after drawing the full ticks
 		x += size.x();
@@ -185,7 +184,7 @@ float CharacterStatus::draw_one_bar(uint8_t bartype, float x_stt, float y_stt, i
         sc_rect = Rectangle2f(Point2f(x, y),
                               Point2f(x, y) + size);
 
-		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(tx_ptr, Colour4f::white(), true));
+		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, tx_ptr);
 
 		y += size.y();
 		total_ticks -= NUMTICK;
@@ -208,7 +207,7 @@ float CharacterStatus::draw_one_bar(uint8_t bartype, float x_stt, float y_stt, i
         sc_rect = Rectangle2f(Point2f(x, y),
                               Point2f(x, y) + size);
 
-		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(tx_ptr, Colour4f::white(), true));
+		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, tx_ptr);
 
 		y += size.y();
 		total_ticks -= NUMTICK;
@@ -231,7 +230,7 @@ float CharacterStatus::draw_one_bar(uint8_t bartype, float x_stt, float y_stt, i
         sc_rect = Rectangle2f(Point2f(x, y),
                               Point2f(x, y) + size);
 
-		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(tx_ptr, Colour4f::white(), true));
+		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, tx_ptr);
 
 		y += size.y();
 	}
@@ -263,7 +262,7 @@ float CharacterStatus::draw_one_xp_bar(float x, float y, uint8_t ticks)
 
     sc_rect = Rectangle2f(Point2f(x, y), Point2f(x, y) + size);
 
-	_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(texture, Colour4f::white(), true));
+	_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, texture);
 
 	x += size.x();
 
@@ -278,7 +277,7 @@ float CharacterStatus::draw_one_xp_bar(float x, float y, uint8_t ticks)
         sc_rect = Rectangle2f(Point2f(x + (cnt * size.x()),y),
                               Point2f(x + (cnt * size.x()) + size.x(), y + size.y()));
 
-		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(texture, Colour4f::white(), true));
+		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, texture);
 	}
 
 	//---- Draw the remaining empty ones
@@ -290,7 +289,7 @@ float CharacterStatus::draw_one_xp_bar(float x, float y, uint8_t ticks)
         sc_rect = Rectangle2f(Point2f(x + (cnt * size.x()), y),
                               Point2f(x + (cnt * size.x()) + size.x(), y + size.y()));
 
-		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(texture, Colour4f::white(), true));
+		_gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, texture);
 	}
 
 	return y + size.y();
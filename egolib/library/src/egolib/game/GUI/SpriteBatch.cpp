@@ -0,0 +1,105 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/GUI/SpriteBatch.cpp
+/// @brief Collects the 2D quads of the GUI and the HUD and renders them in as few draw calls as possible.
+
+#include "egolib/game/GUI/SpriteBatch.hpp"
+#include "egolib/Graphics/VertexFormat.hpp"
+
+namespace Ego {
+namespace GUI {
+
+SpriteBatch::SpriteBatch() :
+    _material(nullptr, Colour4f::white(), true),
+    _vertices(),
+    _lastColour(Colour4f::white()),
+    _isFlushing(false),
+    _vertexDescriptor(descriptor_factory<idlib::vertex_format::P3FC4FT2F>()()),
+    _vertexBuffer(idlib::video_buffer_manager::get().create_vertex_buffer(CAPACITY * 4, _vertexDescriptor.get_size())),
+    _currentFrame{ 0, 0 },
+    _lastFrame{ 0, 0 } {
+    _vertices.reserve(CAPACITY * 4);
+}
+
+SpriteBatch::~SpriteBatch() {
+    _vertexBuffer = nullptr;
+}
+
+void SpriteBatch::add(const Rectangle2f& target, const Rectangle2f& source, const std::shared_ptr<const Texture>& texture,
+                      const Colour4f& colour, bool isAlphaBlendingEnabled) {
+    if (!_vertices.empty() && (_material.getTexture() != texture || _material.isAlphaBlendingEnabled() != isAlphaBlendingEnabled)) {
+        flush();
+    }
+    if (_vertices.size() >= CAPACITY * 4) {
+        flush();
+    }
+    if (_vertices.empty()) {
+        _material.setTexture(texture);
+        _material.setAlphaBlendingEnabled(isAlphaBlendingEnabled);
+    }
+    const float r = colour.get_r(), g = colour.get_g(), b = colour.get_b(), a = colour.get_a();
+    // left/bottom
+    _vertices.push_back({ target.get_min().x(), target.get_max().y(), 0.0f, r, g, b, a, source.get_min().x(), source.get_max().y() });
+    // right/bottom
+    _vertices.push_back({ target.get_max().x(), target.get_max().y(), 0.0f, r, g, b, a, source.get_max().x(), source.get_max().y() });
+    // right/top
+    _vertices.push_back({ target.get_max().x(), target.get_min().y(), 0.0f, r, g, b, a, source.get_max().x(), source.get_min().y() });
+    // left/top
+    _vertices.push_back({ target.get_min().x(), target.get_min().y(), 0.0f, r, g, b, a, source.get_min().x(), source.get_min().y() });
+    _lastColour = colour;
+}
+
+void SpriteBatch::flush() {
+    // Applying the material and rendering calls back into this function.
+    if (_isFlushing || _vertices.empty()) {
+        return;
+    }
+    _isFlushing = true;
+    try {
+        auto& renderer = Renderer::get();
+        _material.apply();
+        {
+            idlib::vertex_buffer_scoped_lock vblck(*_vertexBuffer);
+            std::copy(_vertices.begin(), _vertices.end(), vblck.get<Vertex>());
+        }
+        renderer.render(*_vertexBuffer, _vertexDescriptor, idlib::primitive_type::quadriliterals, 0, _vertices.size());
+        // The current colour is undefined after rendering with colour arrays.
+        // Leave the colour of the last quad as the state, as the material of an unbatched quad would have done.
+        renderer.setColour(_lastColour);
+    } catch (...) {
+        _vertices.clear();
+        _isFlushing = false;
+        throw;
+    }
+    _currentFrame.drawCalls++;
+    _currentFrame.quads += _vertices.size() / 4;
+    _vertices.clear();
+    _material.setTexture(nullptr);
+    _isFlushing = false;
+}
+
+void SpriteBatch::endFrame() {
+    flush();
+    _lastFrame = _currentFrame;
+    _currentFrame = Statistics{ 0, 0 };
+}
+
+} // namespace GUI
+} // namespace Ego
@@ -0,0 +1,94 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/GUI/SpriteBatch.hpp
+/// @brief Collects the 2D quads of the GUI and the HUD and renders them in as few draw calls as possible.
+
+#pragma once
+
+#include "egolib/game/GUI/Material.hpp"
+
+namespace Ego {
+namespace GUI {
+
+/// @brief Collects textured and coloured 2D quads into a large streaming vertex buffer.
+/// Consecutive quads with the same texture and the same alpha blending state are rendered in one draw call.
+/// The renderer flushes the batch before any other state change or draw call such that the drawing order is preserved.
+class SpriteBatch : public Ego::PendingGeometry, private idlib::non_copyable {
+public:
+    /// @brief Statistics of a frame.
+    struct Statistics {
+        size_t drawCalls;   ///< Number of draw calls issued by the batch
+        size_t quads;       ///< Number of quads rendered by the batch
+    };
+
+    SpriteBatch();
+
+    virtual ~SpriteBatch();
+
+    /// @brief Add a quad.
+    /// @param target the target rectangle in screen coordinates
+    /// @param source the source rectangle in texture coordinates
+    /// @param texture a pointer to the texture if any, a null pointer otherwise
+    /// @param colour the colour of the quad
+    /// @param isAlphaBlendingEnabled if alpha blending is enabled
+    /// @remark The pending quads are flushed first if the texture or the alpha blending state differ from theirs.
+    void add(const Rectangle2f& target, const Rectangle2f& source, const std::shared_ptr<const Texture>& texture,
+             const Colour4f& colour, bool isAlphaBlendingEnabled);
+
+    /** @copydoc Ego::PendingGeometry::flush */
+    void flush() override;
+
+    /// @brief Flush the pending quads and start a new frame.
+    void endFrame();
+
+    /// @brief Get the statistics of the last frame.
+    const Statistics& getStatistics() const { return _lastFrame; }
+
+private:
+    struct Vertex {
+        float x, y, z;
+        float r, g, b, a;
+        float s, t;
+    };
+
+    /// @brief The maximum number of quads in the vertex buffer.
+    static constexpr size_t CAPACITY = 1024;
+
+    /// @brief The material of the pending quads. Its colour is white, the quads are coloured by their vertices.
+    Material _material;
+
+    /// @brief The vertices of the pending quads.
+    std::vector<Vertex> _vertices;
+
+    /// @brief The colour of the last pending quad.
+    Colour4f _lastColour;
+
+    /// @brief If the batch is currently flushing.
+    bool _isFlushing;
+
+    idlib::vertex_descriptor _vertexDescriptor;
+    std::shared_ptr<idlib::vertex_buffer> _vertexBuffer;
+
+    Statistics _currentFrame;
+    Statistics _lastFrame;
+};
+
+} // namespace GUI
+} // namespace Ego
@@ -25,6 +25,7 @@
 #include "egolib/game/GUI/UIManager.hpp"
 #include "egolib/game/graphic.h"
 #include "egolib/game/GUI/Material.hpp"
+#include "egolib/game/GUI/SpriteBatch.hpp"
 #include "egolib/Graphics/VertexFormat.hpp"
 #include "egolib/game/game.h" //TODO: Remove only for DisplayMessagePrintf
 
@@ -37,7 +38,8 @@ UIManager::UIManager() :
     _bitmapFontTexture(TextureManager::get().getTexture("mp_data/font_new_shadow")),
     _vertexDescriptor(descriptor_factory<idlib::vertex_format::P2F>()()),
     _textureQuadVertexDescriptor(descriptor_factory<idlib::vertex_format::P2FT2F>()()),
-    _textureQuadVertexBuffer(idlib::video_buffer_manager::get().create_vertex_buffer(4, _textureQuadVertexDescriptor.get_size())) {
+    _textureQuadVertexBuffer(idlib::video_buffer_manager::get().create_vertex_buffer(4, _textureQuadVertexDescriptor.get_size())),
+    _spriteBatch(std::make_unique<SpriteBatch>()) {
     //Load fonts from true-type files
     _fonts[FONT_DEFAULT] = FontManager::get().loadFont("mp_data/Bo_Chen.ttf", 24);
     _fonts[FONT_FLOATING_TEXT] = FontManager::get().loadFont("mp_data/FrostysWinterland.ttf", 24);
@@ -55,9 +57,14 @@ UIManager::UIManager() :
     }
 #endif
     _vertexBuffer = idlib::video_buffer_manager::get().create_vertex_buffer(4, _vertexDescriptor.get_size());
+    Renderer::get().setPendingGeometry(_spriteBatch.get());
 }
 
 UIManager::~UIManager() {
+    if (Renderer::get().getPendingGeometry() == _spriteBatch.get()) {
+        Renderer::get().setPendingGeometry(nullptr);
+    }
+    _spriteBatch = nullptr;
     _vertexBuffer = nullptr;
     // free fonts before font manager
     for (std::shared_ptr<Font> &font : _fonts) {
@@ -74,6 +81,9 @@ void UIManager::beginRenderUI() {
 
     auto& renderer = Renderer::get();
 
+    // Quads batched outside of beginRenderUI/endRenderUI must not be affected by the pushed state.
+    _spriteBatch->flush();
+
     // do not use the ATTRIB_PUSH macro, since the glPopAttrib() is in a different function
     GL_DEBUG(glPushAttrib)(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_VIEWPORT_BIT);
 
@@ -112,11 +122,18 @@ void UIManager::endRenderUI() {
         return;
     }
 
+    // Render the pending quads before the state they were batched under is popped.
+    _spriteBatch->flush();
+
     // Re-enable any states disabled by gui_beginFrame
     // do not use the ATTRIB_POP macro, since the glPushAttrib() is in a different function
     GL_DEBUG(glPopAttrib)();
 }
 
+void UIManager::endFrame() {
+    _spriteBatch->endFrame();
+}
+
 int UIManager::getScreenWidth() const {
     return GraphicsSystem::get().window->size().x();
 }
@@ -253,12 +270,11 @@ void UIManager::drawBitmapGlyph(int fonttype, const Vector2f& position, const fl
     tx_rect.xmax -= BORDER;
     tx_rect.ymax -= BORDER;
 
-    drawQuad2D(sc_rect, tx_rect, std::make_shared<Material>(_bitmapFontTexture, Colour4f(Colour3f::white(), alpha), true));
+    drawQuad2D(sc_rect, tx_rect, _bitmapFontTexture, Colour4f(Colour3f::white(), alpha));
 }
 
 void UIManager::drawQuad2D(const Rectangle2f& scr_rect, const Rectangle2f& tx_rect, const std::shared_ptr<const Material>& material) {
-    material->apply();
-    drawQuad2d(scr_rect, tx_rect);
+    _spriteBatch->add(scr_rect, tx_rect, material->getTexture(), material->getColour(), material->isAlphaBlendingEnabled());
 }
 
 void UIManager::drawQuad2D(const Rectangle2f& scr_rect, const ego_frect_t& tx_rect, const std::shared_ptr<const Material>& material) {
@@ -267,10 +283,18 @@ void UIManager::drawQuad2D(const Rectangle2f& scr_rect, const ego_frect_t& tx_re
     drawQuad2D(scr_rect, tx_rect_2, material);
 }
 
+void UIManager::drawQuad2D(const Rectangle2f& scr_rect, const Rectangle2f& tx_rect, const std::shared_ptr<const Texture>& texture, const Colour4f& tint) {
+    _spriteBatch->add(scr_rect, tx_rect, texture, tint, true);
+}
+
+void UIManager::drawQuad2D(const Rectangle2f& scr_rect, const ego_frect_t& tx_rect, const std::shared_ptr<const Texture>& texture, const Colour4f& tint) {
+    auto tx_rect_2 = Rectangle2f(Point2f(tx_rect.xmin, tx_rect.ymin),
+                                 Point2f(tx_rect.xmax, tx_rect.ymax));
+    drawQuad2D(scr_rect, tx_rect_2, texture, tint);
+}
+
 void UIManager::fillRectangle(const Rectangle2f& rectangle, const bool useAlpha, const Colour4f& tint) {
-    auto material = std::make_shared<Material>(nullptr, tint, useAlpha);
-    material->apply();
-    drawQuad2d(rectangle);
+    _spriteBatch->add(rectangle, Rectangle2f(Point2f(0.0f, 0.0f), Point2f(1.0f, 1.0f)), nullptr, tint, useAlpha);
 }
 
 void UIManager::drawQuad2d(const Rectangle2f& target, const Rectangle2f& source) {
@@ -30,6 +30,7 @@ namespace Ego {
 class Font; 
 namespace GUI {
 class Material;
+class SpriteBatch;
 }
 }
 
@@ -89,6 +90,18 @@ public:
      */
     void endRenderUI();
 
+    /**
+     * @brief
+     *  Render the quads still pending at the end of a frame and start new frame statistics.
+     */
+    void endFrame();
+
+    /**
+     * @return
+     *  The batch collecting the 2D quads of the GUI and the HUD
+     */
+    const SpriteBatch& getSpriteBatch() const { return *_spriteBatch; }
+
     /**
      * @brief
      *  Convinience function to draw a 2D image
@@ -142,6 +155,16 @@ public:
     void drawQuad2D(const Rectangle2f& scr_rect, const Rectangle2f& tx_rect, const std::shared_ptr<const Material>& material);
     void drawQuad2D(const Rectangle2f& scr_rect, const ego_frect_t& tx_rect, const std::shared_ptr<const Material>& material);
 
+    /**
+     * @brief Render a 2D quad with alpha blending.
+     * @param scr_rect the target rectangle (screen coordinates)
+     * @param tx_rect the source rectangle (texture coordinates)
+     * @param texture a pointer to the texture if any, a null pointer otherwise
+     * @param tint the colour of the quad
+     */
+    void drawQuad2D(const Rectangle2f& scr_rect, const Rectangle2f& tx_rect, const std::shared_ptr<const Texture>& texture, const Colour4f& tint = Colour4f::white());
+    void drawQuad2D(const Rectangle2f& scr_rect, const ego_frect_t& tx_rect, const std::shared_ptr<const Texture>& texture, const Colour4f& tint = Colour4f::white());
+
     /// Draw a 2D quad.
     /// @param target the target rectangle in screen coordinates
     /// @param source the source rectangle in texture coordinates
@@ -170,6 +193,9 @@ private:
     /// @brief Vertex descriptor & vertex buffer to render textured quadriliterals.
     idlib::vertex_descriptor _textureQuadVertexDescriptor;
     std::shared_ptr<idlib::vertex_buffer> _textureQuadVertexBuffer;
+
+    /// @brief The batch collecting the quads drawn with a material.
+    std::unique_ptr<SpriteBatch> _spriteBatch;
 };
 
 } // namespace GUI
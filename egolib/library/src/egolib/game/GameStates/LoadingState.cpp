@@ -37,10 +37,12 @@
 #include "egolib/game/game.h"
 #include "egolib/game/link.h"
 #include "egolib/game/Module/Module.hpp"
+#include "egolib/game/Logic/Replay.hpp"
 #include "egolib/game/Graphics/TextureAtlasManager.hpp"
 
 LoadingState::LoadingState(std::shared_ptr<ModuleProfile> module, const std::list<std::string> &playersToLoad) :
     _loadingThread(),
+    _replayReady(false),
     _loadingLabel(nullptr),
     _loadModule(module),
     _playersToLoad(playersToLoad),
@@ -102,7 +104,20 @@ void LoadingState::setProgressText(const std::string &loadingText, const uint8_t
 
 void LoadingState::update()
 {
-    
+    if (_replayReady) {
+        _replayReady = false;
+        startPlaying();
+    }
+}
+
+void LoadingState::startPlaying()
+{
+    //Have to do this function in the OpenGL context thread or else it will fail
+    Ego::Graphics::TextureAtlasManager::get().loadTileSet();
+
+    //Hush gong
+    AudioSystem::get().fadeAllSounds();
+    _gameEngine->setGameState(std::make_shared<PlayingState>());
 }
 
 void LoadingState::drawContainer(Ego::GUI::DrawingContext& drawingContext)
@@ -169,6 +184,9 @@ void LoadingState::loadModuleData()
         //Make sure all data is cleared first
         game_quit_module();
 
+        //Count the file system lookups of this module load
+        vfs_resetStatistics();
+
         setProgressText("Calculating some math...", 10);
         GFX::get().getBillboardSystem().reset();
 
@@ -206,6 +224,24 @@ void LoadingState::loadModuleData()
         }
         _currentModule->setImportPlayers(_playersToLoad);
 
+        // record the player input of this module if requested
+        const std::string& replayFile = egoboo_config_t::get().debug_replay_record.getValue();
+        if (!Ego::ReplaySystem::get().isPlaying() && !replayFile.empty()) {
+            Ego::ReplayHeader header;
+            header.seed = _currentModule->getSeed();
+            header.module = _loadModule->getPath();
+            header.players = _playersToLoad;
+            try {
+                Ego::ReplaySystem::get().startRecording(replayFile, header);
+            } catch (const idlib::exception& ex) {
+                Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to record replay: ", ex.to_string(), Log::EndOfEntry);
+            }
+        }
+
+        const vfs_statistics_t vfsStatistics = vfs_getStatistics();
+        Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "module loaded with ", vfsStatistics.physfsCalls,
+                                         " PhysFS calls, ", vfsStatistics.indexHits, " lookups answered by the vfs index", Log::EndOfEntry);
+
         setProgressText("Almost done...", 90);
 
         // set up the cameras *after* game_begin_module() or the player devices will not be initialized
@@ -227,21 +263,17 @@ void LoadingState::loadModuleData()
         //2 second delay to let music finish, this prevents a frame lag on module startup
         std::this_thread::sleep_for(std::chrono::seconds(2));
 
-        //Add the start button once we are finished loading
-        auto startButton = std::make_shared<Ego::GUI::Button>("Press Space to begin", SDLK_SPACE);
-        startButton->setSize({ 400, 30 });
-        startButton->setPosition({ SCREEN_WIDTH / 2 - startButton->getWidth() / 2, SCREEN_HEIGHT - 50 });
-        _connections.push_back(startButton->Clicked.subscribe(
-            []{
-
-                //Have to do this function in the OpenGL context thread or else it will fail
-                Ego::Graphics::TextureAtlasManager::get().loadTileSet();
-
-                //Hush gong
-                AudioSystem::get().fadeAllSounds();
-                _gameEngine->setGameState(std::make_shared<PlayingState>());
-            }));
-        addComponent(startButton);
+        //A replay starts right away, it must not wait for input
+        if (Ego::ReplaySystem::get().isPlaying()) {
+            _replayReady = true;
+        } else {
+            //Add the start button once we are finished loading
+            auto startButton = std::make_shared<Ego::GUI::Button>("Press Space to begin", SDLK_SPACE);
+            startButton->setSize({ 400, 30 });
+            startButton->setPosition({ SCREEN_WIDTH / 2 - startButton->getWidth() / 2, SCREEN_HEIGHT - 50 });
+            _connections.push_back(startButton->Clicked.subscribe([]{ startPlaying(); }));
+            addComponent(startButton);
+        }
 
         //Hide the progress bar
         _progressBar->setVisible(false);
@@ -77,8 +77,15 @@ protected:
 
     void setProgressText(const std::string &loadingText, const uint8_t progress);
 
+    /**
+     * @brief
+     *    Switch to the playing state. Must be called from the main thread.
+     */
+    static void startPlaying();
+
 private:
     std::thread _loadingThread;
+    std::atomic_bool _replayReady;                  //A replay finished loading and starts with the next update
     std::vector<idlib::connection> _connections;
     std::shared_ptr<Ego::GUI::Label> _loadingLabel;
     const std::shared_ptr<ModuleProfile> _loadModule;
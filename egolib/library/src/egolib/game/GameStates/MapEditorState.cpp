@@ -104,6 +104,7 @@ void MapEditorState::update()
 
 void MapEditorState::drawContainer(Ego::GUI::DrawingContext& drawingContext)
 {
+    gfx_system_make_renderLists();
     CameraSystem::get().renderAll(gfx_system_render_world);
     draw_hud();
 
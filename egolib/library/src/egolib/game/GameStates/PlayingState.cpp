@@ -135,6 +135,7 @@ void PlayingState::update()
 
 void PlayingState::drawContainer(Ego::GUI::DrawingContext& drawingContext)
 {
+    gfx_system_make_renderLists();
     CameraSystem::get().renderAll(gfx_system_render_world);
     draw_hud();
 }
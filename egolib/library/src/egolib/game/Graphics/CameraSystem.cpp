@@ -30,7 +30,8 @@
 CameraSystem::CameraSystem() :
 	_cameraList(),
     _mainCamera(nullptr),
-    _cameraOptions()
+    _cameraOptions(),
+    _workers()
 {
 	//Add 1 camera by default
 	_cameraList.push_back(std::make_shared<Camera>(_cameraOptions));
@@ -105,7 +106,7 @@ egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, st
         _mainCamera = camera;
 
 	    // has this camera already rendered this frame?
-        if ( camera->getLastFrame() >= 0 && static_cast<uint32_t>(camera->getLastFrame()) >= _gameEngine->getNumberOfFramesRendered()) {
+        if (hasRenderedThisFrame(*camera)) {
             continue;
         }
 
@@ -128,6 +129,59 @@ egolib_rv CameraSystem::renderAll(std::function<void(std::shared_ptr<Camera>, st
     return rv_success;
 }
 
+bool CameraSystem::hasRenderedThisFrame(const Camera& camera) const
+{
+    return camera.getLastFrame() >= 0 && static_cast<uint32_t>(camera.getLastFrame()) >= _gameEngine->getNumberOfFramesRendered();
+}
+
+void CameraSystem::buildAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> buildFunction)
+{
+    std::vector<std::shared_ptr<Camera>> cameras;
+    for (const auto& camera : _cameraList) {
+        if (!hasRenderedThisFrame(*camera)) {
+            cameras.push_back(camera);
+        }
+    }
+
+    // A single camera is not worth a context switch.
+    if (cameras.size() < 2) {
+        for (const auto& camera : cameras) {
+            buildFunction(camera, camera->getTileList(), camera->getEntityList());
+        }
+        return;
+    }
+
+    if (!_workers) {
+        _workers = std::make_unique<ThreadPool>(MAX_CAMERAS - 1);
+    }
+
+    // The main thread builds the lists of the first camera while the workers build the others.
+    std::vector<std::future<void>> results;
+    for (size_t i = 1; i < cameras.size(); ++i) {
+        const auto camera = cameras[i];
+        results.push_back(_workers->submit([&buildFunction, camera]() {
+            buildFunction(camera, camera->getTileList(), camera->getEntityList());
+        }));
+    }
+    std::exception_ptr error = nullptr;
+    try {
+        buildFunction(cameras[0], cameras[0]->getTileList(), cameras[0]->getEntityList());
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // Wait for all workers before propagating an exception, they reference buildFunction.
+    for (auto& result : results) {
+        try {
+            result.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
 size_t CameraSystem::getCameraIndex(ObjectRef targetRef) const {
     if (ObjectRef::Invalid == targetRef) {
         return 0;
@@ -22,6 +22,7 @@
 
 #include "egolib/game/egoboo.h"
 #include "egolib/game/Graphics/Camera.hpp"
+#include "egolib/Core/ThreadPool.hpp"
 
 // Forward declaration.
 class ego_mesh_t;
@@ -53,6 +54,19 @@ public:
 
 	egolib_rv renderAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> renderFunction);
 
+	/**
+	 * @brief
+	 *  Build the render lists of all cameras which have not rendered this frame yet.
+	 *  If there is more than one such camera, the lists are built concurrently on worker threads.
+	 * @param buildFunction
+	 *  the function building the render lists of a camera.
+	 *  It must not issue graphics commands, must not depend on the main camera,
+	 *  and must not modify state shared between cameras.
+	 * @remark
+	 *  Returns after all render lists are built. Exceptions raised by @a buildFunction are propagated.
+	 */
+	void buildAll(std::function<void(std::shared_ptr<Camera>, std::shared_ptr<Ego::Graphics::TileList>, std::shared_ptr<Ego::Graphics::EntityList>)> buildFunction);
+
 	/**
 	 * @brief
 	 *  Get the first camera tracking a target.
@@ -106,8 +120,15 @@ private:
      */
     void autoSetTargets();
 
+    /**
+     * @brief Get if a camera has already rendered the current frame.
+     */
+    bool hasRenderedThisFrame(const Camera& camera) const;
+
 private:
 	std::vector<std::shared_ptr<Camera>> _cameraList;
 	std::shared_ptr<Camera> _mainCamera;
 	CameraOptions _cameraOptions;
+	/// The worker threads building the render lists, created when first needed.
+	std::unique_ptr<ThreadPool> _workers;
 };
@@ -7,30 +7,34 @@ namespace Ego {
 namespace Graphics {
 
 EntityList::EntityList()
-    : list(), set() {}
+    : list(), reflectedList(), sorted(), scratch(), set() {}
 
-void EntityList::clear() {
-    if (list.empty()) {
-        return;
-    }
+uint32_t EntityList::getMaterial(const Object& object) {
+    return uint32_t(object.getProfileID().get());
+}
+
+uint32_t EntityList::getMaterial(const Ego::Particle& particle) {
+    return 0x80000000 | ((particle.type & 0x3) << 29) | uint32_t(particle.getProfileID());
+}
 
+void EntityList::clear() {
     set.clear();
-    auto& objectHandler = _currentModule->getObjectHandler();
-    auto& particleHandler = ParticleHandler::get();
-    for (auto& entry : list) {
-        if (ParticleRef::Invalid == entry.iprt && ObjectRef::Invalid != entry.iobj) {
-            auto obj = objectHandler.get(entry.iobj);
-            if (nullptr != obj) {
-            }
-        } else if (ObjectRef::Invalid == entry.iobj && entry.iprt != ParticleRef::Invalid) {
-            auto prt = particleHandler[entry.iprt];
-            if (nullptr != prt) {
-            }
-        } else {
-            continue;
-        }
-    }
     list.clear();
+    reflectedList.clear();
+    sorted.clear();
+}
+
+void EntityList::add(::Camera& camera, ObjectRef iobj, ParticleRef iprt, const Vector3f& position, const Vector3f& reflectedPosition, uint32_t material) {
+    const Vector3f vcam = mat_getCamForward(camera.getViewMatrix());
+
+    Element element(iobj, iprt);
+    element.dist = dot(position - camera.getPosition(), vcam);
+    element.key = makeKey(element.dist, material);
+    list.push_back(element);
+
+    element.dist = dot(reflectedPosition - camera.getPosition(), vcam);
+    element.key = makeKey(element.dist, material);
+    reflectedList.push_back(element);
 }
 
 size_t EntityList::add(::Camera& camera, Object& object) {
@@ -41,7 +45,9 @@ size_t EntityList::add(::Camera& camera, Object& object) {
     }
 
     // Add the object.
-    list.emplace_back(object.getObjRef(), ParticleRef::Invalid);
+    Vector3f reflectedPosition = object.getPosition();
+    reflectedPosition[kZ] = 2.0f * object.getFloorElevation() - reflectedPosition[kZ];
+    add(camera, object.getObjRef(), ParticleRef::Invalid, object.getPosition(), reflectedPosition, getMaterial(object));
     set.emplace((void *)(&object));
     count++;
 
@@ -61,18 +67,30 @@ size_t EntityList::add(::Camera& camera, Object& object) {
 size_t EntityList::add(::Camera& camera, Ego::Particle& particle) {
     size_t count = 0;
     if (!test(camera, particle)) {
-        particle.inst.indolist = false;
         return count;
     }
-    particle.inst.indolist = true;
 
-    list.emplace_back(ObjectRef::Invalid, particle.getParticleID());
+    Vector3f reflectedPosition = particle.getPosition();
+    reflectedPosition[kZ] = 2.0f * particle.enviro.floor_level - reflectedPosition[kZ];
+    add(camera, ObjectRef::Invalid, particle.getParticleID(), particle.getPosition(), reflectedPosition, getMaterial(particle));
     set.emplace((void *)(&particle));
     count++;
 
     return count;
 }
 
+void EntityList::markParticles() {
+    auto& particleHandler = ParticleHandler::get();
+    for (const auto& entry : list) {
+        if (ParticleRef::Invalid != entry.iprt) {
+            auto particle = particleHandler[entry.iprt];
+            if (nullptr != particle) {
+                particle->inst.indolist = true;
+            }
+        }
+    }
+}
+
 void EntityList::sort(Camera& cam, const bool do_reflect) {
     /// @author ZZ
     /// @details This function orders the entity list based on distance from camera,
@@ -80,52 +98,17 @@ void EntityList::sort(Camera& cam, const bool do_reflect) {
     ///    Order from closest to farthest
     assert(list.size() <= CAPACITY);
 
-    Vector3f vcam = mat_getCamForward(cam.getViewMatrix());
-
-    // Figure the distance of each.
-    size_t count = 0;
-    for (size_t i = 0; i < list.size(); ++i) {
-        Vector3f vtmp;
-
-        if (ParticleRef::Invalid == list[i].iprt && ObjectRef::Invalid != list[i].iobj) {
-            Vector3f pos_tmp;
-
-            ObjectRef iobj = list[i].iobj;
-
-            if (do_reflect) {
-                pos_tmp = mat_getTranslate(_currentModule->getObjectHandler().get(iobj)->inst.getReflectionMatrix());
-            } else {
-                pos_tmp = mat_getTranslate(_currentModule->getObjectHandler().get(iobj)->inst.getMatrix());
-            }
-
-            vtmp = pos_tmp - cam.getPosition();
-        } else if (ObjectRef::Invalid == list[i].iobj && list[i].iprt != ParticleRef::Invalid) {
-            ParticleRef iprt = list[i].iprt;
-
-            if (do_reflect) {
-                vtmp = ParticleHandler::get()[iprt]->inst.pos - cam.getPosition();
-            } else {
-                vtmp = ParticleHandler::get()[iprt]->inst.ref_pos - cam.getPosition();
-            }
-        } else {
-            continue;
-        }
-
-        // If theangle between this vector and the camera vector is greater than 90 degrees,
-        // then set the distance to positive infinity.
-        float dist = dot(vtmp, vcam);
-        if (dist > 0) {
-            list[count].iobj = list[i].iobj;
-            list[count].iprt = list[i].iprt;
-            list[count].dist = dist;
-            count++;
+    // Keep the entities in front of the camera.
+    // If the angle between the view vector and the camera vector is greater than 90 degrees,
+    // then the entity is behind the camera.
+    sorted.clear();
+    for (const auto& element : (do_reflect ? reflectedList : list)) {
+        if (element.dist > 0) {
+            sorted.push_back(element);
         }
     }
 
-    // use qsort to sort the list in-place
-    if (count > 1) {
-        std::sort(list.begin(), list.end(), Compare());
-    }
+    radix_sort(sorted, scratch, [](const Element& element) { return element.key; });
 }
 
 bool EntityList::test(::Camera& camera, const Object& object) {
@@ -26,6 +26,7 @@
 #include "egolib/game/egoboo.h"
 #include "egolib/game/mesh.h"
 #include "egolib/game/Graphics/CameraSystem.hpp"
+#include "egolib/Core/RadixSort.hpp"
 
 namespace Ego {
 namespace Graphics {
@@ -34,6 +35,7 @@ namespace Graphics {
  *  List of object  and particle entities to be draw by a renderer.
  *
  *  Entities in this are sorted based on their position from the camera before drawing.
+ *  The sort keys are computed when the entities are added, such that sorting is a radix sort of integers.
  */
 struct EntityList {
     /**
@@ -47,27 +49,80 @@ struct EntityList {
      */
     struct Element {
         Element()
-            : iobj(ObjectRef::Invalid), iprt(ParticleRef::Invalid), dist(0.0f) {}
+            : iobj(ObjectRef::Invalid), iprt(ParticleRef::Invalid), dist(0.0f), key(0) {}
         Element(const Element& other)
-            : iobj(other.iobj), iprt(other.iprt), dist(other.dist) {}
+            : iobj(other.iobj), iprt(other.iprt), dist(other.dist), key(other.key) {}
         Element(ObjectRef iobj, ParticleRef iprt)
-            : iobj(iobj), iprt(iprt), dist(0.0f) {}
+            : iobj(iobj), iprt(iprt), dist(0.0f), key(0) {}
+        Element& operator=(const Element& other) {
+            iobj = other.iobj;
+            iprt = other.iprt;
+            dist = other.dist;
+            key = other.key;
+            return *this;
+        }
 
         ObjectRef iobj;
         ParticleRef iprt;
+        /// The distance of the entity along the view direction of the camera.
         float dist;
+        /// The sort key: the distance in the upper 32 bits, the material in the lower 32 bits.
+        uint64_t key;
     };
     struct Compare {
         bool operator()(const Element& x, const Element& y) const {
-            return x.dist < y.dist;
+            return x.key < y.key;
         }
     };
+    /**
+     * @brief
+     *  Pack a sort key.
+     * @param dist the distance of the entity along the view direction of the camera
+     * @param material the material of the entity
+     * @return the sort key
+     * @remark
+     *  Entities are ordered by their distance. Entities at the same distance are grouped
+     *  by their material such that entities with the same textures are drawn one after another.
+     */
+    static uint64_t makeKey(float dist, uint32_t material) {
+        return (uint64_t(radix_key(dist)) << 32) | material;
+    }
+    /**
+     * @brief
+     *  Get the material of an object entity.
+     * @remark
+     *  The most significant bit is @a 0 for objects, the remaining bits are the profile.
+     */
+    static uint32_t getMaterial(const Object& object);
+    /**
+     * @brief
+     *  Get the material of a particle entity.
+     * @remark
+     *  The most significant bit is @a 1 for particles, the next two bits are the
+     *  transparency mode and the remaining bits are the profile.
+     */
+    static uint32_t getMaterial(const Ego::Particle& particle);
+
 private:
-    /** An array of the entities in this entity list. */
+    /**
+     * An array of the entities in this entity list.
+     * The distances and keys are the ones for unreflected rendering.
+     */
     std::vector<Element> list;
+    /** The entities of list with their distances and keys for reflected rendering. */
+    std::vector<Element> reflectedList;
+    /** The entities in front of the camera, sorted by the last call to sort(). */
+    std::vector<Element> sorted;
+    /** A scratch buffer for the radix sort. */
+    std::vector<Element> scratch;
     /** For checking in amortized constant time if an object is already in this entity list. */
     std::unordered_set<void *> set;
 
+    /**
+     * @brief Add an entity with its distances from the camera.
+     */
+    void add(::Camera& camera, ObjectRef iobj, ParticleRef iprt, const Vector3f& position, const Vector3f& reflectedPosition, uint32_t material);
+
 private:
     /**
      * @brief Test if the specified object entity is eligible for addition.
@@ -85,26 +140,49 @@ private:
 public:
     EntityList();
 
+    /**
+     * @brief Get an entity in front of the camera.
+     * @param index the index of the entity in the order established by the last call to sort()
+     */
     const Element& get(size_t index) const {
-        if (index >= list.size()) {
+        if (index >= sorted.size()) {
             throw std::out_of_range("index out of range");
         }
-        return list[index];
+        return sorted[index];
     }
 
     Element& get(size_t index) {
-        if (index >= list.size()) {
+        if (index >= sorted.size()) {
             throw std::out_of_range("index out of range");
         }
-        return list[index];
+        return sorted[index];
     }
 
+    /**
+     * @brief Get the number of entities in front of the camera.
+     * @remark Only valid after sort() was called.
+     */
     size_t getSize() const {
-        return list.size();
+        return sorted.size();
+    }
+
+    /**
+     * @brief Get all entities in this entity list, in the order they were added.
+     */
+    const std::vector<Element>& getAll() const {
+        return list;
     }
 
     /** @brief Clear this entity list. */
     void clear();
+
+    /**
+     * @brief Sort the entities in front of the camera by their keys.
+     * @param reflect if @a true the entities are sorted for reflected rendering,
+     * otherwise for unreflected rendering
+     * @remark The keys are computed when the entities are added,
+     * sorting does not access the object and particle handlers.
+     */
     void sort(Camera& camera, const bool reflect);
 
     /**
@@ -121,11 +199,19 @@ public:
      * @brief Add a particle entity if it is eligible for addition.
      * @param obj the particle entity to add
      * @return the total number of entities added
+     * @remark Does not modify the particle, such that the lists of several cameras can be built concurrently.
+     * Use markParticles() to update the "in do list" flag of the particles.
      * @remark A (legacy) occlusion test is performed. If the particle is occluded,
      * then particle.getInstance().isOccluded() is set to @a true, otherwise it is
      * set to @a false.
      */
     size_t add(::Camera& camera, Ego::Particle& particle);
+
+    /**
+     * @brief Set the "in do list" flag of all particles in this entity list.
+     * @remark Must be called on the main thread.
+     */
+    void markParticles();
 };
 
 } // namespace Graphics
@@ -171,7 +171,7 @@ gfx_rv ObjectGraphics::needs_update(int vmin, int vmax, bool *verts_match, bool
     return (!(*verts_match) || !( *frames_match )) ? gfx_success : gfx_fail;
 }
 
-void ObjectGraphics::interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip )
+void ObjectGraphics::interpolateVerticesRaw(std::vector<GLvertex> &dst_ary, const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip )
 {
     /// raw indicates no bounds checking, so be careful
 
@@ -179,7 +179,7 @@ void ObjectGraphics::interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_a
     {
         for (size_t i = vmin; i <= vmax; i++)
         {
-            GLvertex* dst = &_vertexList[i];
+            GLvertex* dst = &dst_ary[i];
             const MD2_Vertex &srcLast = lst_ary[i];
 
 			dst->pos[XX] = srcLast.pos[kX];
@@ -199,7 +199,7 @@ void ObjectGraphics::interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_a
     {
         for (size_t i = vmin; i <= vmax; i++ )
         {
-            GLvertex* dst = &_vertexList[i];
+            GLvertex* dst = &dst_ary[i];
             const MD2_Vertex &srcNext = nxt_ary[i];
 
 			dst->pos[XX] = srcNext.pos[kX];
@@ -221,7 +221,7 @@ void ObjectGraphics::interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_a
 
         for (size_t i = vmin; i <= vmax; i++)
         {
-            GLvertex* dst = &_vertexList[i];
+            GLvertex* dst = &dst_ary[i];
             const MD2_Vertex &srcLast = lst_ary[i];
             const MD2_Vertex &srcNext = nxt_ary[i];
 
@@ -243,6 +243,67 @@ void ObjectGraphics::interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_a
     }
 }
 
+void ObjectGraphics::interpolateVerticesRaw(std::vector<GLvertex> &dst_ary, const MD2_Frame &lst, const MD2_Frame &nxt, int vmin, int vmax, float flip)
+{
+    if (!lst.isPacked())
+    {
+        interpolateVerticesRaw(dst_ary, lst.vertexList, nxt.vertexList, vmin, vmax, flip);
+        return;
+    }
+
+    const auto& lst_ary = lst.packedVertexList;
+    const auto& nxt_ary = nxt.packedVertexList;
+
+    if ( 0.0f == flip || 1.0f == flip )
+    {
+        const MD2_Frame &src = ( 0.0f == flip ) ? lst : nxt;
+        for (size_t i = vmin; i <= vmax; i++)
+        {
+            GLvertex* dst = &dst_ary[i];
+            const MD2_PackedVertex &srcVertex = src.packedVertexList[i];
+
+            const Ego::Vector3f pos = src.decodePosition(srcVertex);
+            dst->pos[XX] = pos[kX];
+            dst->pos[YY] = pos[kY];
+            dst->pos[ZZ] = pos[kZ];
+            dst->pos[WW] = 1.0f;
+
+            const Ego::Vector3f nrm = MD2_Frame::decodeNormal(srcVertex);
+            dst->nrm[XX] = nrm[kX];
+            dst->nrm[YY] = nrm[kY];
+            dst->nrm[ZZ] = nrm[kZ];
+
+            dst->env[XX] = indextoenvirox[srcVertex.normal];
+            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
+        }
+    }
+    else
+    {
+        for (size_t i = vmin; i <= vmax; i++)
+        {
+            GLvertex* dst = &dst_ary[i];
+            const MD2_PackedVertex &srcLast = lst_ary[i];
+            const MD2_PackedVertex &srcNext = nxt_ary[i];
+
+            const Ego::Vector3f posLast = lst.decodePosition(srcLast),
+                                posNext = nxt.decodePosition(srcNext);
+            dst->pos[XX] = posLast[kX] + ( posNext[kX] - posLast[kX] ) * flip;
+            dst->pos[YY] = posLast[kY] + ( posNext[kY] - posLast[kY] ) * flip;
+            dst->pos[ZZ] = posLast[kZ] + ( posNext[kZ] - posLast[kZ] ) * flip;
+            dst->pos[WW] = 1.0f;
+
+            const Ego::Vector3f nrmLast = MD2_Frame::decodeNormal(srcLast),
+                                nrmNext = MD2_Frame::decodeNormal(srcNext);
+            dst->nrm[XX] = nrmLast[kX] + ( nrmNext[kX] - nrmLast[kX] ) * flip;
+            dst->nrm[YY] = nrmLast[kY] + ( nrmNext[kY] - nrmLast[kY] ) * flip;
+            dst->nrm[ZZ] = nrmLast[kZ] + ( nrmNext[kZ] - nrmLast[kZ] ) * flip;
+
+            dst->env[XX] = indextoenvirox[srcLast.normal] + ( indextoenvirox[srcNext.normal] - indextoenvirox[srcLast.normal] ) * flip;
+            dst->env[YY] = 0.5f * ( 1.0f + dst->nrm[ZZ] );
+        }
+    }
+}
+
 gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
 {
     bool vertices_match, frames_match;
@@ -257,7 +318,7 @@ gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
     // make sure we have valid data
     if (_vertexList.size() != pmd2->getVertexCount())
     {
-        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "character instance vertex data does not match its md2", Log::EndOfEntry);
+        EGOLIB_LOG_RATE_LIMITED(Log::Level::Warning, 10, "character instance vertex data does not match its md2");
         return gfx_error;
     }
 
@@ -324,8 +385,8 @@ gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
     const auto& frameList = pmd2->getFrames();
     if ( _targetFrameIndex >= frameList.size() || _sourceFrameIndex >= frameList.size() )
     {
-		Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "character instance frame is outside "
-                                         "the range of its MD2", Log::EndOfEntry);
+		EGOLIB_LOG_RATE_LIMITED(Log::Level::Warning, 10, "character instance frame is outside "
+                                "the range of its MD2");
         return gfx_error;
     }
 
@@ -342,13 +403,13 @@ gfx_rv ObjectGraphics::updateVertices(int vmin, int vmax, bool force)
     // interpolate the 1st dirty region
     if ( vdirty1_min >= 0 && vdirty1_max >= 0 )
     {
-		interpolateVerticesRaw(lastFrame.vertexList, nextFrame.vertexList, vdirty1_min, vdirty1_max, loc_flip);
+		interpolateVerticesRaw(_vertexList, lastFrame, nextFrame, vdirty1_min, vdirty1_max, loc_flip);
     }
 
     // interpolate the 2nd dirty region
     if ( vdirty2_min >= 0 && vdirty2_max >= 0 )
     {
-		interpolateVerticesRaw(lastFrame.vertexList, nextFrame.vertexList, vdirty2_min, vdirty2_max, loc_flip);
+		interpolateVerticesRaw(_vertexList, lastFrame, nextFrame, vdirty2_min, vdirty2_max, loc_flip);
     }
 
     // update the saved parameters
@@ -848,7 +909,7 @@ void ObjectGraphics::updateAnimation()
 
         if ( _animationProgressInteger > 4 )
         {
-            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "invalid ilip", Log::EndOfEntry);
+            EGOLIB_LOG_RATE_LIMITED(Log::Level::Warning, 10, "invalid ilip");
             _animationProgressInteger = 0;
             break;
         }
@@ -879,7 +940,7 @@ void ObjectGraphics::updateAnimation()
 
             if ( _animationProgressInteger > 4 )
             {
-                Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "invalid ilip", Log::EndOfEntry);
+                EGOLIB_LOG_RATE_LIMITED(Log::Level::Warning, 10, "invalid ilip");
                 _animationProgressInteger = 0;
             }
         }
@@ -952,7 +1013,7 @@ bool ObjectGraphics::handleAnimationFX() const
     //Do footfall sound effect
     if (egoboo_config_t::get().sound_footfallEffects_enable.getValue() && HAS_SOME_BITS(framefx, MADFX_FOOTFALL))
     {
-        AudioSystem::get().playSound(_object.getPosition(), _object.getProfile()->getFootFallSound());
+        AudioSystem::get().playSound(_object.getPosition(), _object.getProfile()->getFootFallSound(), Ego::Audio::VoicePriority::Ambient);
     }
 
     return true;
@@ -250,6 +250,20 @@ public:
     **/
     oct_bb_t getBoundingBox() const;
 
+    /**
+    * @brief
+    *   Interpolate the vertices vmin to vmax (inclusive) between two frames of a model.
+    *   Raw indicates no bounds checking, so be careful.
+    **/
+    static void interpolateVerticesRaw(std::vector<GLvertex> &dst_ary, const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip);
+
+    /**
+    * @brief
+    *   Interpolate the vertices vmin to vmax (inclusive) between two frames of a model.
+    *   Packed frames are decoded on the fly. Both frames must be packed or unpacked.
+    **/
+    static void interpolateVerticesRaw(std::vector<GLvertex> &dst_ary, const MD2_Frame &lst, const MD2_Frame &nxt, int vmin, int vmax, float flip);
+
 private:
 
     /// Set the model descriptor.
@@ -287,8 +301,6 @@ private:
     **/
 	void clearCache();
 
-	void interpolateVerticesRaw(const std::vector<MD2_Vertex> &lst_ary, const std::vector<MD2_Vertex> &nxt_ary, int vmin, int vmax, float flip);
-
     /**
     * @brief
     *   try to set the model used by the character instance.
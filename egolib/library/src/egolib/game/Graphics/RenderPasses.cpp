@@ -36,6 +36,7 @@
 #include "egolib/game/egoboo.h"
 #include "egolib/game/mesh.h"
 #include "egolib/game/Graphics/CameraSystem.hpp"
+#include "egolib/Core/FrameArena.hpp"
 #include "egolib/FileFormats/Globals.hpp"
 #include "egolib/game/Module/Module.hpp"
 #include "egolib/Entities/_Include.hpp"
@@ -103,7 +104,7 @@ void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tile
 	}
 
 	// insert the rlst values into lst_vals
-	std::vector<ElementV2> lst_vals(tiles.size());
+	Ego::FrameVector<ElementV2> lst_vals(tiles.size(), Ego::FrameAllocator<ElementV2>(Ego::FrameArena::getRenderArena()));
 	for (size_t i = 0; i < tiles.size(); ++i)
 	{
         uint32_t textureIndex;
@@ -138,7 +139,7 @@ void TileListV2::render(ego_mesh_t& mesh, const std::vector<ClippingEntry>& tile
 		gfx_rv render_rv = render_fan(mesh, tmp_itile);
 		if (egoboo_config_t::get().debug_developerMode_enable.getValue() && gfx_error == render_rv)
 		{
-			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "error rendering tile ", tmp_itile.i(), Log::EndOfEntry);
+			EGOLIB_LOG_RATE_LIMITED(Log::Level::Warning, 10, "error rendering tile ", tmp_itile.i());
 		}
 	}
 
@@ -26,6 +26,7 @@
 #include "egolib/game/egoboo.h"
 #include "egolib/game/mesh.h"
 #include "egolib/game/Graphics/CameraSystem.hpp"
+#include "egolib/game/Graphics/TileQuadTree.hpp"
 
 namespace Ego {
 namespace Graphics {
@@ -105,16 +106,30 @@ struct TileList
 	/// @brief Insert a tile into this render list.
 	/// @param the index of the tile to insert
 	/// @param camera the camera
+	/// @remark Does not modify the mesh, such that the lists of several cameras can be built concurrently.
+	///         Tiles which were not in the list in the last frame are remembered and their lighting is
+	///         invalidated by invalidateNewTiles().
 	gfx_rv add(const Index1D& index, ::Camera& camera);
 
+	/// @brief Force a lighting update of the tiles which were added to this list but were not in it last frame.
+	/// @remark Modifies the mesh, must be called on the main thread.
+	void invalidateNewTiles();
+
 	/// @brief check wheter a tile was rendered this render frame.
 	/// @param index the index number of the tile
 	/// @return true if the specified tile is currently in the render list for this render frame
 	bool inRenderList(const Index1D& index) const;
 
+	/// @brief Get the per-camera state of the tile culling.
+	/// @return the tile culling cache
+	TileQuadTree::Cache& getCullingCache() { return _cullingCache; }
+	const TileQuadTree::Cache& getCullingCache() const { return _cullingCache; }
+
 private:
 	std::bitset<MAP_TILE_MAX> _renderTiles;		//index of all tiles to be rendered
 	std::bitset<MAP_TILE_MAX> _lastRenderTiles; //index of all tiles that were rendered last frame
+	std::vector<Index1D> _newTiles;             //tiles added which were not rendered last frame
+	TileQuadTree::Cache _cullingCache;          //visible tiles of the last culling pass of the camera
 };
 
 }
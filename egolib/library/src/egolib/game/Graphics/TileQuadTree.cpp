@@ -0,0 +1,197 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/TileQuadTree.cpp
+/// @brief A min/max-height quadtree over the tiles of a mesh for view frustum culling
+
+#include "egolib/game/Graphics/TileQuadTree.hpp"
+#include "egolib/game/mesh.h"
+
+namespace Ego {
+namespace Graphics {
+
+TileQuadTree::Cache::Cache() :
+    _treeID(0),
+    _planes(),
+    _minimumTop(0.0f),
+    _rejectingPlanes(),
+    _visibleTiles(),
+    _visibleBounds(),
+    _statistics{ 0, 0, 0, false }
+{}
+
+void TileQuadTree::Cache::invalidate()
+{
+    _treeID = 0;
+}
+
+TileQuadTree::TileQuadTree(const ego_mesh_t& mesh) :
+    _id(0),
+    _nodes(),
+    _tileCountX(mesh._info.getTileCountX())
+{
+    static uint32_t nextID = 1;
+    _id = nextID++;
+    const size_t tileCountY = mesh._info.getTileCountY();
+    if (0 == _tileCountX || 0 == tileCountY) {
+        return;
+    }
+    // A full quadtree has less than 4/3 nodes per tile.
+    _nodes.reserve(mesh._info.getTileCount() * 4 / 3 + 1);
+    build(mesh, 0, 0, static_cast<uint16_t>(_tileCountX), static_cast<uint16_t>(tileCountY));
+}
+
+uint32_t TileQuadTree::build(const ego_mesh_t& mesh, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    const uint32_t nodeIndex = static_cast<uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+    uint32_t children[4] = { NO_NODE, NO_NODE, NO_NODE, NO_NODE };
+    AxisAlignedBox3f bounds;
+
+    if (x1 - x0 == 1 && y1 - y0 == 1) {
+        // A leaf: the bounds of the tile.
+        bounds = mesh._tmem.get(Index2D(x0, y0))._oct.toAxisAlignedBox();
+    } else {
+        // Split into up to four children. Splitting a side of length one yields one child along that side.
+        const uint16_t xm = (x1 - x0 > 1) ? (x0 + (x1 - x0) / 2) : x1;
+        const uint16_t ym = (y1 - y0 > 1) ? (y0 + (y1 - y0) / 2) : y1;
+        const uint16_t xs[3] = { x0, xm, x1 }, ys[3] = { y0, ym, y1 };
+        size_t childCount = 0;
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 2; ++i) {
+                if (xs[i] == xs[i + 1] || ys[j] == ys[j + 1]) continue;
+                const uint32_t child = build(mesh, xs[i], ys[j], xs[i + 1], ys[j + 1]);
+                const Node& childNode = _nodes[child];
+                const AxisAlignedBox3f childBounds(childNode.mins, childNode.maxs);
+                if (0 == childCount) {
+                    bounds = childBounds;
+                } else {
+                    bounds.join(childBounds);
+                }
+                children[childCount++] = child;
+            }
+        }
+    }
+
+    // Do not hold a reference into _nodes across the recursion, it might be reallocated.
+    Node& node = _nodes[nodeIndex];
+    node.mins = bounds.get_min();
+    node.maxs = bounds.get_max();
+    node.x0 = x0; node.y0 = y0; node.x1 = x1; node.y1 = y1;
+    std::copy(std::begin(children), std::end(children), std::begin(node.children));
+    return nodeIndex;
+}
+
+bool TileQuadTree::cull(const Frustum& frustum, float minimumTop, Cache& cache) const
+{
+    // Get the frustum planes. Only the side planes are used for culling.
+    std::array<float, Frustum::Planes::COUNT * 4> planes;
+    for (size_t i = 0; i < Frustum::Planes::COUNT; ++i) {
+        planes[i * 4 + 0] = frustum._planes[i].get_normal()[kX];
+        planes[i * 4 + 1] = frustum._planes[i].get_normal()[kY];
+        planes[i * 4 + 2] = frustum._planes[i].get_normal()[kZ];
+        planes[i * 4 + 3] = frustum._planes[i].get_distance();
+    }
+
+    // Nothing changed since the last traversal? Reuse its results.
+    if (cache._treeID == _id && cache._planes == planes && cache._minimumTop == minimumTop) {
+        cache._statistics.testedNodes = 0;
+        cache._statistics.reused = true;
+        return false;
+    }
+
+    if (cache._treeID != _id) {
+        cache._rejectingPlanes.assign(_nodes.size(), NO_PLANE);
+        cache._treeID = _id;
+    }
+    cache._planes = planes;
+    cache._minimumTop = minimumTop;
+    cache._visibleTiles.clear();
+    cache._statistics = Cache::Statistics{ 0, 0, 0, false };
+
+    if (!_nodes.empty()) {
+        uint32_t planeMask = 0;
+        for (uint32_t i = Frustum::Planes::SIDES_BEGIN; i <= Frustum::Planes::SIDES_END; ++i) {
+            planeMask |= 1 << i;
+        }
+        visit(0, frustum, planeMask, minimumTop, cache);
+    }
+    cache._statistics.visibleTiles = cache._visibleTiles.size();
+    return true;
+}
+
+void TileQuadTree::visit(uint32_t nodeIndex, const Frustum& frustum, uint32_t planeMask, float minimumTop, Cache& cache) const
+{
+    const Node& node = _nodes[nodeIndex];
+    const Point3f maxs(node.maxs.x(), node.maxs.y(), std::max(node.maxs.z(), minimumTop));
+    cache._statistics.testedNodes++;
+
+    // Test the plane which rejected this node the last time first, it is likely to reject it again.
+    uint8_t& rejectingPlane = cache._rejectingPlanes[nodeIndex];
+    if (NO_PLANE != rejectingPlane && (planeMask & (1 << rejectingPlane))) {
+        if (Math::Relation::outside == plane_intersects_aab_max(frustum._planes[rejectingPlane], node.mins, maxs)) {
+            return;
+        }
+    }
+
+    for (uint32_t i = Frustum::Planes::SIDES_BEGIN; i <= Frustum::Planes::SIDES_END; ++i) {
+        if (0 == (planeMask & (1 << i))) {
+            continue;
+        }
+        if (i != rejectingPlane && Math::Relation::outside == plane_intersects_aab_max(frustum._planes[i], node.mins, maxs)) {
+            rejectingPlane = static_cast<uint8_t>(i);
+            return;
+        }
+        // If the box is completely in front of the plane, so are the boxes of the children.
+        if (Math::Relation::outside != plane_intersects_aab_min(frustum._planes[i], node.mins, maxs)) {
+            planeMask &= ~(1 << i);
+        }
+    }
+    rejectingPlane = NO_PLANE;
+
+    // Completely inside or a leaf: all tiles are visible.
+    if (0 == planeMask || NO_NODE == node.children[0]) {
+        cache._statistics.visibleNodes++;
+        addTiles(node, minimumTop, cache);
+        return;
+    }
+    for (uint32_t child : node.children) {
+        if (NO_NODE != child) {
+            visit(child, frustum, planeMask, minimumTop, cache);
+        }
+    }
+}
+
+void TileQuadTree::addTiles(const Node& node, float minimumTop, Cache& cache) const
+{
+    const AxisAlignedBox3f bounds(node.mins, Point3f(node.maxs.x(), node.maxs.y(), std::max(node.maxs.z(), minimumTop)));
+    if (cache._visibleTiles.empty()) {
+        cache._visibleBounds = bounds;
+    } else {
+        cache._visibleBounds.join(bounds);
+    }
+    for (size_t y = node.y0; y < node.y1; ++y) {
+        for (size_t x = node.x0; x < node.x1; ++x) {
+            cache._visibleTiles.emplace_back(x + y * _tileCountX);
+        }
+    }
+}
+
+} // namespace Graphics
+} // namespace Ego
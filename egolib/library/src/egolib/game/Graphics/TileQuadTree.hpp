@@ -0,0 +1,140 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/TileQuadTree.hpp
+/// @brief A min/max-height quadtree over the tiles of a mesh for view frustum culling
+
+#pragma once
+
+#include "egolib/frustum.h"
+#include "egolib/Mesh/Info.hpp"
+
+class ego_mesh_t;
+
+namespace Ego {
+namespace Graphics {
+
+/**
+ * @brief
+ *  A quadtree over the tiles of a mesh. Each node stores the bounding box of its tiles
+ *  including the minimum and maximum height of the tiles. The tree is built once when the mesh is loaded
+ *  and traversed against the view frustum of a camera to determine the visible tiles.
+ */
+struct TileQuadTree
+{
+public:
+    /**
+     * @brief
+     *  Per-camera traversal state. The results of the previous traversal are kept to speed up the next one.
+     */
+    struct Cache
+    {
+        /// The statistics of the last traversal.
+        struct Statistics
+        {
+            size_t testedNodes;   ///< Number of nodes tested against the frustum
+            size_t visibleNodes;  ///< Number of nodes found to be visible (completely inside or visible leaves)
+            size_t visibleTiles;  ///< Number of visible tiles
+            bool reused;          ///< Were the results of the previous traversal reused?
+        };
+
+        Cache();
+
+        /// Invalidate the cache. The next traversal will not reuse any results.
+        void invalidate();
+
+        const Statistics& getStatistics() const { return _statistics; }
+
+        /// @brief Get the tiles visible in the last traversal.
+        const std::vector<Index1D>& getVisibleTiles() const { return _visibleTiles; }
+
+        /// @brief Get the bounds of the tiles visible in the last traversal.
+        const AxisAlignedBox3f& getVisibleBounds() const { return _visibleBounds; }
+
+    private:
+        friend struct TileQuadTree;
+        /// The ID of the tree the cache was filled for or 0.
+        uint32_t _treeID;
+        /// The planes of the frustum of the last traversal.
+        std::array<float, Frustum::Planes::COUNT * 4> _planes;
+        /// The minimum top height of the last traversal.
+        float _minimumTop;
+        /// For each node the index of the plane which rejected it in the last traversal (or NO_PLANE).
+        std::vector<uint8_t> _rejectingPlanes;
+        std::vector<Index1D> _visibleTiles;
+        AxisAlignedBox3f _visibleBounds;
+        Statistics _statistics;
+    };
+
+    /**
+     * @brief
+     *  Build the quadtree for the specified mesh.
+     * @param mesh
+     *  the mesh. The bounding boxes of its tiles must be computed.
+     */
+    TileQuadTree(const ego_mesh_t& mesh);
+
+    /**
+     * @brief
+     *  Determine the tiles visible in the specified frustum.
+     * @param frustum
+     *  the view frustum
+     * @param minimumTop
+     *  the tops of all bounding boxes are raised to at least this height (e.g. to the water surface level)
+     * @param cache
+     *  the per-camera cache. Receives the visible tiles.
+     * @return
+     *  @a true if the tree was traversed, @a false if the frustum did not change and the
+     *  visible tiles of the previous traversal were reused
+     */
+    bool cull(const Frustum& frustum, float minimumTop, Cache& cache) const;
+
+    /// @brief Get the number of nodes of this tree.
+    size_t getNodeCount() const { return _nodes.size(); }
+
+private:
+    static constexpr uint8_t NO_PLANE = 0xff;
+    static constexpr uint32_t NO_NODE = 0xffffffff;
+
+    struct Node
+    {
+        Point3f mins, maxs;          ///< The bounding box of the tiles of this node.
+        uint16_t x0, y0, x1, y1;     ///< The tiles of this node, [x0,x1) x [y0,y1).
+        uint32_t children[4];        ///< The child nodes or NO_NODE.
+    };
+
+    /// @brief Build the node for the specified tiles.
+    /// @return the index of the node
+    uint32_t build(const ego_mesh_t& mesh, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+
+    /// @brief Visit a node.
+    /// @param planeMask the planes the node is not known to be completely in front of
+    void visit(uint32_t nodeIndex, const Frustum& frustum, uint32_t planeMask, float minimumTop, Cache& cache) const;
+
+    /// @brief Add all tiles of a node to the visible tiles.
+    void addTiles(const Node& node, float minimumTop, Cache& cache) const;
+
+    /// A unique ID of this tree such that caches can detect a tree was replaced.
+    uint32_t _id;
+    std::vector<Node> _nodes;
+    size_t _tileCountX;
+};
+
+} // namespace Graphics
+} // namespace Ego
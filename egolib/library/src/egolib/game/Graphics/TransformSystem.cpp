@@ -0,0 +1,237 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/TransformSystem.cpp
+/// @brief Updates the matrices of all objects, holders before the objects they hold.
+
+#include "egolib/game/Graphics/TransformSystem.hpp"
+#include "egolib/game/CharacterMatrix.h"
+#include "egolib/game/Module/Module.hpp"
+#include "egolib/Entities/_Include.hpp"
+
+namespace Ego {
+namespace Graphics {
+
+/// Depth of a node which was not visited yet.
+static constexpr size_t UNVISITED = std::numeric_limits<size_t>::max();
+/// Depth of a node whose depth is being computed.
+static constexpr size_t VISITING = UNVISITED - 1;
+/// Depth of a node which must be updated on the main thread with the recursive update.
+static constexpr size_t SERIAL = UNVISITED - 2;
+
+/// Levels with fewer objects are not worth a context switch.
+static constexpr size_t MIN_PARALLEL_OBJECTS = 64;
+
+TransformSystem::TransformSystem() :
+    _nodes(),
+    _index(),
+    _levels(),
+    _serial(),
+    _matrixUpdates(0),
+    _error(false),
+    _current(),
+    _statistics(),
+    _workers()
+{}
+
+TransformSystem::~TransformSystem()
+{}
+
+size_t TransformSystem::getDepth(size_t index)
+{
+    if (VISITING == _nodes[index].depth) {
+        // A cycle of overlays, the recursive update can deal with that.
+        return SERIAL;
+    }
+    if (UNVISITED != _nodes[index].depth) {
+        return _nodes[index].depth;
+    }
+    _nodes[index].depth = VISITING;
+
+    Object& object = *_nodes[index].object;
+    size_t depth = 0;
+    auto dependsOn = [this, &depth](ObjectRef parent) {
+        const auto it = _index.find(parent);
+        if (it == _index.end()) {
+            // The parent is not part of this update.
+            depth = SERIAL;
+            return;
+        }
+        const size_t parentDepth = getDepth(it->second);
+        if (SERIAL == parentDepth || SERIAL == depth) {
+            depth = SERIAL;
+        } else {
+            depth = std::max(depth, parentDepth + 1);
+        }
+    };
+
+    // Held items depend on their holder, see chr_update_matrix().
+    const std::shared_ptr<Object>& holder = object.getHolder();
+    if (holder) {
+        dependsOn(holder->getObjRef());
+    }
+
+    // Overlays depend on their target, see chr_get_matrix_cache().
+    const ObjectRef target = object.ai.getTarget();
+    if (object.is_overlay && target != object.getObjRef() && _currentModule->getObjectHandler().exists(target)) {
+        dependsOn(target);
+    }
+
+    _nodes[index].depth = depth;
+    return depth;
+}
+
+void TransformSystem::updateObject(Object& object, bool recursive)
+{
+    // make sure that the vertices are interpolated
+    if (gfx_error == object.inst.updateVertices(-1, -1, true)) {
+        _error = true;
+        return;
+    }
+
+    // the instance has changed, refresh the matrix and the collision bound
+    const egolib_rv result = chr_update_matrix(&object, false, recursive);
+    if (rv_success == result) {
+        _matrixUpdates++;
+    }
+    if (rv_error != result) {
+        object.getObjectPhysics().updateCollisionSize(false);
+    }
+}
+
+void TransformSystem::updateRange(const size_t *begin, const size_t *end)
+{
+    for (const size_t *it = begin; it != end; ++it) {
+        updateObject(*_nodes[*it].object, false);
+    }
+}
+
+void TransformSystem::updateLevel(std::vector<size_t>& level)
+{
+    if (level.size() < MIN_PARALLEL_OBJECTS) {
+        updateRange(level.data(), level.data() + level.size());
+        return;
+    }
+
+    if (!_workers) {
+        const size_t cores = std::thread::hardware_concurrency();
+        _workers = std::make_unique<ThreadPool>(cores > 1 ? cores - 1 : 1);
+    }
+
+    // One range per thread.
+    const size_t rangeSize = (level.size() + _workers->getThreadCount()) / (_workers->getThreadCount() + 1);
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (size_t begin = 0; begin < level.size(); begin += rangeSize) {
+        ranges.emplace_back(begin, std::min(begin + rangeSize, level.size()));
+    }
+
+    // The main thread updates the first range while the workers update the others.
+    const size_t *data = level.data();
+    std::vector<std::future<void>> results;
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        const auto range = ranges[i];
+        results.push_back(_workers->submit([this, data, range]() {
+            updateRange(data + range.first, data + range.second);
+        }));
+    }
+    std::exception_ptr error = nullptr;
+    try {
+        updateRange(data + ranges[0].first, data + ranges[0].second);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // Wait for all workers before propagating an exception, they reference the level.
+    for (auto& result : results) {
+        try {
+            result.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+gfx_rv TransformSystem::update(const std::vector<std::shared_ptr<Object>>& objects)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    _matrixUpdates = 0;
+    _error = false;
+
+    // Build the hierarchy.
+    _nodes.clear();
+    _index.clear();
+    for (const auto& object : objects) {
+        _index[object->getObjRef()] = _nodes.size();
+        _nodes.push_back(Node{ object.get(), UNVISITED });
+    }
+    for (auto& level : _levels) {
+        level.clear();
+    }
+    _serial.clear();
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        const size_t depth = getDepth(i);
+        if (SERIAL == depth) {
+            _serial.push_back(i);
+            continue;
+        }
+        if (depth >= _levels.size()) {
+            _levels.resize(depth + 1);
+        }
+        _levels[depth].push_back(i);
+    }
+
+    // Update the hierarchy from the top to the bottom. Only the first level runs in parallel:
+    // the objects of the deeper levels are held items and overlays, their update moves them
+    // with Object::setPosition() which tests the mesh and writes the grip vertices of the holder.
+    size_t levels = 0;
+    for (size_t depth = 0; depth < _levels.size(); ++depth) {
+        std::vector<size_t>& level = _levels[depth];
+        if (level.empty()) continue;
+        if (0 == depth) {
+            updateLevel(level);
+        } else {
+            updateRange(level.data(), level.data() + level.size());
+        }
+        levels++;
+    }
+
+    // Whatever is left uses the recursive update on the main thread.
+    for (size_t index : _serial) {
+        updateObject(*_nodes[index].object, true);
+    }
+
+    const std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+    _current.objects += _nodes.size();
+    _current.matrixUpdates += _matrixUpdates;
+    _current.levels = std::max(_current.levels, levels);
+    _current.milliseconds += duration.count();
+
+    return _error ? gfx_error : gfx_success;
+}
+
+void TransformSystem::endFrame()
+{
+    _statistics = _current;
+    _current = Statistics();
+}
+
+} // namespace Graphics
+} // namespace Ego
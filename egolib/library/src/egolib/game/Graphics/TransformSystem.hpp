@@ -0,0 +1,121 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Graphics/TransformSystem.hpp
+/// @brief Updates the matrices of all objects, holders before the objects they hold.
+
+#pragma once
+
+#include "egolib/game/egoboo.h"
+#include "egolib/Core/ThreadPool.hpp"
+
+// Forward declaration.
+class Object;
+
+namespace Ego {
+namespace Graphics {
+
+/**
+ * @brief
+ *  Updates the vertices, the matrices and the collision sizes of objects.
+ *  The objects are sorted into a hierarchy: a holder comes before the objects it holds
+ *  (a mount before its rider) and the target of an overlay before the overlay. The objects
+ *  of one depth only depend on objects of lower depths.
+ * @remark
+ *  Only the objects of depth 0 are updated in parallel. Updating a held object or an overlay
+ *  moves it with Object::setPosition(), which runs the wall tests, and writes the grip vertices
+ *  of its holder, hence the deeper depths are updated on the main thread.
+ */
+class TransformSystem
+{
+public:
+    /**
+     * @brief
+     *  Statistics of a frame.
+     */
+    struct Statistics
+    {
+        size_t objects;        ///< Number of object updates
+        size_t matrixUpdates;  ///< Number of rebuilt matrices
+        size_t levels;         ///< Number of depths of the deepest hierarchy
+        float milliseconds;    ///< Time spent updating
+    };
+
+    TransformSystem();
+    virtual ~TransformSystem();
+
+    /**
+     * @brief
+     *  Update the vertices, the matrices and the collision sizes of objects.
+     * @param objects
+     *  the objects. The holders and overlay targets of these objects should be in the list as well,
+     *  objects whose holder or target is missing are updated on the main thread after all others.
+     * @return
+     *  gfx_error if the vertices of at least one object could not be updated, gfx_success otherwise
+     */
+    gfx_rv update(const std::vector<std::shared_ptr<Object>>& objects);
+
+    /**
+     * @brief
+     *  Finish the statistics of the current frame.
+     */
+    void endFrame();
+
+    /**
+     * @return
+     *  the statistics of the last frame
+     */
+    const Statistics& getStatistics() const { return _statistics; }
+
+private:
+    struct Node
+    {
+        Object *object;
+        size_t depth;
+    };
+
+    /// @brief Compute the depth of a node, SERIAL if the node can not be updated in parallel.
+    size_t getDepth(size_t index);
+
+    /// @brief Update a range of nodes of a level on the calling thread.
+    void updateRange(const size_t *begin, const size_t *end);
+
+    /// @brief Update a single object.
+    /// @param recursive if @a false, the holder and the target of the object must be up to date.
+    void updateObject(Object& object, bool recursive);
+
+    /// @brief Update a level of objects which do not move, in parallel if it is large enough.
+    void updateLevel(std::vector<size_t>& level);
+
+    std::vector<Node> _nodes;
+    std::unordered_map<ObjectRef, size_t> _index;
+    std::vector<std::vector<size_t>> _levels;
+    std::vector<size_t> _serial;
+
+    std::atomic<size_t> _matrixUpdates;
+    std::atomic<bool> _error;
+
+    Statistics _current;
+    Statistics _statistics;
+
+    std::unique_ptr<ThreadPool> _workers;
+};
+
+} // namespace Graphics
+} // namespace Ego
@@ -0,0 +1,215 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Logic/DormancySystem.cpp
+/// @brief Sleeping of idle objects far from all players.
+
+#include "egolib/game/Logic/DormancySystem.hpp"
+#include "egolib/Entities/_Include.hpp"
+#include "egolib/game/Logic/Player.hpp"
+#include "egolib/game/Module/Module.hpp"
+#include "egolib/game/game.h" //for update_wld
+#include "egolib/Core/FrameArena.hpp"
+
+namespace Ego {
+
+namespace {
+
+/// An object has to be idle for this many updates before it falls asleep.
+constexpr uint16_t IDLE_UPDATES_BEFORE_SLEEP = ONESECOND;
+
+/// Objects slower than this are at rest.
+constexpr float REST_SPEED = 0.1f;
+
+/// Players wake objects a bit closer than objects fall asleep, so that nothing flickers at the border.
+constexpr float WAKE_DISTANCE_FACTOR = 0.75f;
+
+/// @return true if a regeneration rate still changes a value which is constrained to [min, max]
+bool isRegenerating(float value, float rate, float min, float max)
+{
+    return (rate > 0.0f && value < max) || (rate < 0.0f && value > min);
+}
+
+} // namespace
+
+DormancySystem::DormancySystem() :
+    _dormantObjects(),
+    _statistics()
+{}
+
+bool DormancySystem::isIdle(const Object& object)
+{
+    // Opted out by the profile, players and objects which follow others stay awake. Hidden objects are
+    // not in the spatial index, players could not wake them.
+    if (!object.getProfile()->canBecomeDormant() || object.isPlayer() || object.isHidden() ||
+        object.isBeingHeld() || object.isInsideInventory() || object.onwhichplatform_ref != ObjectRef::Invalid) {
+        return false;
+    }
+
+    // A mount moves as its rider (held in the left grip) wants.
+    if (object.isMount() && object.getLeftHandItem()) {
+        return false;
+    }
+
+    // Anything pending for the A.I.?
+    if (object.ai.alert != ALERT_NONE || object.ai.changed || object.ai.poof_time >= 0) {
+        return false;
+    }
+
+    // Enchantments expire, timers count down, life and mana regenerate.
+    if (!object._activeEnchants.empty()) {
+        return false;
+    }
+    if (object.reload_timer > 0 || object.damage_timer > 0 || object.jump_timer > 0 || object.careful_timer > 0 ||
+        object.dismount_timer > 0 || object.grog_timer > 0 || object.daze_timer > 0 || object._stealthTimer > 0 ||
+        object.fat_goto_time > 0) {
+        return false;
+    }
+    if (object.isAlive() &&
+        (isRegenerating(object._currentLife, object.getAttribute(Attribute::LIFE_REGEN), 0.01f, object.getAttribute(Attribute::MAX_LIFE)) ||
+         isRegenerating(object._currentMana, object.getAttribute(Attribute::MANA_REGEN), 0.0f, object.getAttribute(Attribute::MAX_MANA)))) {
+        return false;
+    }
+
+    // At rest on the ground, not about to move and not in the middle of an action.
+    if (!object.getObjectPhysics().isTouchingGround() ||
+        idlib::squared_euclidean_norm(object.getVelocity()) > REST_SPEED * REST_SPEED ||
+        idlib::squared_euclidean_norm(object.getObjectPhysics().getDesiredVelocity()) > 0.0f ||
+        object._inputLatchesPressed.any() || !object.inst.canBeInterrupted()) {
+        return false;
+    }
+
+    return true;
+}
+
+void DormancySystem::sleep(Object& object)
+{
+    object._dormant = true;
+    // Wake up when IfTimeOut becomes true.
+    object._wakeTime = object.ai.timer >= update_wld ? object.ai.timer + 1 : 0;
+    _dormantObjects.push_back(object.getObjRef());
+}
+
+void DormancySystem::wake(Object& object)
+{
+    object._dormant = false;
+    object._idleUpdates = 0;
+    _statistics.wokenUp++;
+}
+
+void DormancySystem::wakeAll()
+{
+    ObjectHandler& objects = _currentModule->getObjectHandler();
+    for (ObjectRef ref : _dormantObjects) {
+        const std::shared_ptr<Object>& object = objects[ref];
+        if (object && object->_dormant) {
+            wake(*object);
+        }
+    }
+    _dormantObjects.clear();
+}
+
+void DormancySystem::rebuild()
+{
+    _dormantObjects.clear();
+    for (const std::shared_ptr<Object>& object : _currentModule->getObjectHandler().iterator()) {
+        if (!object->isTerminated() && object->_dormant) {
+            _dormantObjects.push_back(object->getObjRef());
+        }
+    }
+}
+
+void DormancySystem::update()
+{
+    _statistics.wokenUp = 0;
+    ObjectHandler& objects = _currentModule->getObjectHandler();
+
+    if (!egoboo_config_t::get().game_dormancy_enable.getValue()) {
+        wakeAll();
+        _statistics.active = objects.getObjectCount();
+        _statistics.dormant = 0;
+        return;
+    }
+
+    const float sleepDistance = egoboo_config_t::get().game_dormancy_distance.getValue() * Info<float>::Grid::Size();
+    const float wakeDistance = sleepDistance * WAKE_DISTANCE_FACTOR;
+
+    // Players wake everything around them.
+    FrameArena& arena = FrameArena::getUpdateArena();
+    FrameVector<Vector2f> playerPositions{FrameAllocator<Vector2f>(arena)};
+    FrameVector<std::shared_ptr<Object>> nearbyObjects{FrameAllocator<std::shared_ptr<Object>>(arena)};
+    for (const std::shared_ptr<Player>& player : _currentModule->getPlayerList()) {
+        const std::shared_ptr<Object> playerObject = player->getObject();
+        if (!playerObject || playerObject->isTerminated()) {
+            continue;
+        }
+        const Vector2f position(playerObject->getPosX(), playerObject->getPosY());
+        playerPositions.push_back(position);
+        nearbyObjects.clear();
+        objects.findObjects(AxisAlignedBox2f(Point2f(position.x() - wakeDistance, position.y() - wakeDistance),
+                                             Point2f(position.x() + wakeDistance, position.y() + wakeDistance)), nearbyObjects);
+        for (const std::shared_ptr<Object>& object : nearbyObjects) {
+            if (object->_dormant) {
+                wake(*object);
+            }
+        }
+    }
+
+    // Dormant objects wake up if anything changed them or their A.I. timer expires.
+    for (size_t i = 0; i < _dormantObjects.size();) {
+        const std::shared_ptr<Object>& object = objects[_dormantObjects[i]];
+        if (object && !object->isTerminated() && object->_dormant) {
+            if (!isIdle(*object) || (0 != object->_wakeTime && update_wld >= object->_wakeTime)) {
+                wake(*object);
+            } else {
+                ++i;
+                continue;
+            }
+        }
+        _dormantObjects[i] = _dormantObjects.back();
+        _dormantObjects.pop_back();
+    }
+
+    // Objects which stayed idle long enough while far from all players fall asleep.
+    const auto isFarFromPlayers = [&playerPositions, sleepDistance](const Object& object) {
+        const Vector2f position(object.getPosX(), object.getPosY());
+        for (const Vector2f& playerPosition : playerPositions) {
+            if (idlib::squared_euclidean_norm(position - playerPosition) < sleepDistance * sleepDistance) {
+                return false;
+            }
+        }
+        return true;
+    };
+    _statistics.active = 0;
+    for (const std::shared_ptr<Object>& object : objects.iterator()) {
+        if (object->isTerminated() || object->_dormant) {
+            continue;
+        }
+        if (!isIdle(*object) || !isFarFromPlayers(*object)) {
+            object->_idleUpdates = 0;
+        } else if (++object->_idleUpdates >= IDLE_UPDATES_BEFORE_SLEEP) {
+            sleep(*object);
+            continue;
+        }
+        _statistics.active++;
+    }
+    _statistics.dormant = _dormantObjects.size();
+}
+
+} // namespace Ego
@@ -0,0 +1,86 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Logic/DormancySystem.hpp
+/// @brief Sleeping of idle objects far from all players.
+
+#pragma once
+
+#include "idlib/idlib.hpp"
+#include "egolib/typedef.h"
+
+// Forward declarations.
+class Object;
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  Puts objects to sleep which are at rest, far from all players and have nothing scheduled:
+ *  no pending alerts, running timers, enchantments, regeneration or poof time. Dormant objects
+ *  are skipped by the A.I., object update, movement and collision loops.
+ *  They wake up when a player comes near, when an alert is raised against them, when they are
+ *  damaged, moved, grabbed or enchanted and when their A.I. timer expires.
+ */
+class DormancySystem : private idlib::non_copyable
+{
+public:
+    struct Statistics
+    {
+        Statistics() : active(0), dormant(0), wokenUp(0) {}
+
+        size_t active;  ///< The number of objects updated in the last update
+        size_t dormant; ///< The number of objects skipped in the last update
+        size_t wokenUp; ///< The number of objects woken up in the last update
+    };
+
+    DormancySystem();
+
+    /**
+     * @brief
+     *  Wake the dormant objects which need it and put the idle ones to sleep.
+     *  Called once per update before the A.I. runs and after the spatial index was rebuilt.
+     */
+    void update();
+
+    /// @brief Wake all dormant objects.
+    void wakeAll();
+
+    /// @brief Rebuild the list of dormant objects from the objects, e.g. after a snapshot was restored.
+    void rebuild();
+
+    const Statistics& getStatistics() const { return _statistics; }
+
+    /**
+     * @return
+     *  true if nothing but its distance to the players keeps an object from sleeping,
+     *  i.e. it is at rest and has nothing pending which needs an update
+     */
+    static bool isIdle(const Object& object);
+
+private:
+    void sleep(Object& object);
+    void wake(Object& object);
+
+    std::vector<ObjectRef> _dormantObjects;
+    Statistics _statistics;
+};
+
+} // namespace Ego
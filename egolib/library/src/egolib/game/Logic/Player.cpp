@@ -64,8 +64,37 @@ Ego::QuestLog& Player::getQuestLog()
     return _questLog;
 }
 
-void Player::updateLatches()
+PlayerInput Player::readInput() const
 {
+    using InputButton = Ego::Input::InputDevice::InputButton;
+    PlayerInput input;
+
+    // find the camera that is following this character
+    std::shared_ptr<Object> object = getObject();
+    const std::shared_ptr<Camera> pcam = object ? CameraSystem::get().getCamera(object->getObjRef()) : nullptr;
+    if (!pcam) {
+        input.setFlag(PlayerInput::NoCamera, true);
+        return input;
+    }
+    input.facing = pcam->getOrientation().facing_z;
+    input.movement = getInputDevice().getInputMovement();
+    for (size_t button = 0; button < static_cast<size_t>(InputButton::COUNT); ++button) {
+        input.setButtonPressed(static_cast<InputButton>(button), getInputDevice().isButtonPressed(static_cast<InputButton>(button)));
+    }
+    input.setFlag(PlayerInput::MouseDevice, getInputDevice().getDeviceType() == Ego::Input::InputDevice::InputDeviceType::MOUSE);
+
+    // fast camera turn if it is enabled and there is only 1 local player
+    bool fast_camera_turn = ( 1 == local_stats.player_count ) && ( CameraTurnMode::Good == pcam->getTurnMode() );
+    if (fast_camera_turn) {
+        input.setButtonPressed(InputButton::CAMERA_CONTROL, false);
+    }
+    return input;
+}
+
+void Player::updateLatches(const PlayerInput& input)
+{
+    using InputButton = Ego::Input::InputDevice::InputButton;
+
     //Ensure this player is controlling a valid object
     std::shared_ptr<Object> object = getObject();
     if(!object || object->isTerminated()) {
@@ -73,27 +102,23 @@ void Player::updateLatches()
     }
     object->resetInputCommands();
 
-    // find the camera that is following this character
-    const auto &pcam = CameraSystem::get().getCamera(object->getObjRef());
-    if (!pcam) {
+    // no camera is following this character
+    if (input.hasFlag(PlayerInput::NoCamera)) {
         return;
     }
 
-    // fast camera turn if it is enabled and there is only 1 local player
-    bool fast_camera_turn = ( 1 == local_stats.player_count ) && ( CameraTurnMode::Good == pcam->getTurnMode() );
-
     // Clear the player's latch buffers
     Vector2f movementInput = idlib::zero<Vector2f>();
     Vector2f joy_pos = idlib::zero<Vector2f>();
 
     // generate the transforms relative to the camera
     // this needs to be changed for multicamera
-    float fsin = std::sin(pcam->getOrientation().facing_z);
-    float fcos = std::cos(pcam->getOrientation().facing_z);
+    float fsin = std::sin(input.facing);
+    float fcos = std::cos(input.facing);
 
-    if(fast_camera_turn || !getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::CAMERA_CONTROL))
+    if(!input.isButtonPressed(InputButton::CAMERA_CONTROL))
     {
-        joy_pos = getInputDevice().getInputMovement();
+        joy_pos = input.movement;
 
         //Rotate movement input from body frame to earth frame
         movementInput.x() = ( joy_pos[XX] * fcos + joy_pos[YY] * fsin );
@@ -104,11 +129,11 @@ void Player::updateLatches()
     if (!_inventoryMode)
     {
         // Now update movement and input
-        object->setLatchButton(LATCHBUTTON_JUMP, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::JUMP));
-        object->setLatchButton(LATCHBUTTON_LEFT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_LEFT));
-        object->setLatchButton(LATCHBUTTON_RIGHT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_RIGHT));
-        object->setLatchButton(LATCHBUTTON_ALTLEFT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_LEFT));
-        object->setLatchButton(LATCHBUTTON_ALTRIGHT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_RIGHT));
+        object->setLatchButton(LATCHBUTTON_JUMP, input.isButtonPressed(InputButton::JUMP));
+        object->setLatchButton(LATCHBUTTON_LEFT, input.isButtonPressed(InputButton::USE_LEFT));
+        object->setLatchButton(LATCHBUTTON_RIGHT, input.isButtonPressed(InputButton::USE_RIGHT));
+        object->setLatchButton(LATCHBUTTON_ALTLEFT, input.isButtonPressed(InputButton::GRAB_LEFT));
+        object->setLatchButton(LATCHBUTTON_ALTRIGHT, input.isButtonPressed(InputButton::GRAB_RIGHT));
         object->getObjectPhysics().setDesiredVelocity(movementInput);
     }
 
@@ -118,7 +143,7 @@ void Player::updateLatches()
         int new_selected = _inventorySlot;
 
         //ZF> dirty hack here... mouse seems to be inverted in inventory mode?
-        if (getInputDevice().getDeviceType() == Ego::Input::InputDevice::InputDeviceType::MOUSE)
+        if (input.hasFlag(PlayerInput::MouseDevice))
         {
             joy_pos[XX] = -joy_pos[XX];
             joy_pos[YY] = -joy_pos[YY];
@@ -149,7 +174,7 @@ void Player::updateLatches()
         if ( object->inst.canBeInterrupted() && 0 == object->reload_timer )
         {
             //handle LEFT hand control
-            if (getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_LEFT) || getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_LEFT))
+            if (input.isButtonPressed(InputButton::USE_LEFT) || input.isButtonPressed(InputButton::GRAB_LEFT))
             {
                 //put it away and swap with any existing item
                 Inventory::swap_item(object->getObjRef(), _inventorySlot, SLOT_LEFT, false);
@@ -160,7 +185,7 @@ void Player::updateLatches()
             }
 
             //handle RIGHT hand control
-            if (getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_RIGHT) || getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_RIGHT))
+            if (input.isButtonPressed(InputButton::USE_RIGHT) || input.isButtonPressed(InputButton::GRAB_RIGHT))
             {
                 // put it away and swap with any existing item
                 Inventory::swap_item(object->getObjRef(), _inventorySlot, SLOT_RIGHT, false);
@@ -173,7 +198,7 @@ void Player::updateLatches()
     }
 
     //enable inventory mode?
-    if ( update_wld > _inventoryCooldown && getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::INVENTORY) )
+    if ( update_wld > _inventoryCooldown && input.isButtonPressed(InputButton::INVENTORY) )
     {
         for(uint8_t ipla = 0; ipla < _currentModule->getPlayerList().size(); ++ipla) {
             if(_currentModule->getPlayer(ipla).get() == this) {
@@ -185,7 +210,7 @@ void Player::updateLatches()
     }
 
     //Enter or exit stealth mode?
-    if(getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::STEALTH) && update_wld > _inventoryCooldown) {
+    if(input.isButtonPressed(InputButton::STEALTH) && update_wld > _inventoryCooldown) {
         if(!object->isStealthed()) {
             object->activateStealth();
         }
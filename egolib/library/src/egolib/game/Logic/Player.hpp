@@ -26,6 +26,7 @@
 #include "egolib/IDSZ.hpp"
 #include "egolib/InputControl/InputDevice.hpp"
 #include "egolib/game/Logic/QuestLog.hpp"
+#include "egolib/game/Logic/Replay.hpp"
 
 //Forward declarations
 class Object;
@@ -61,9 +62,17 @@ public:
 
     /**
     * @brief
-    *   Polls the input device and sets movement and action latches accordingly
+    *   Polls the input device and the camera following the player object
+    * @return
+    *   the input of this Player in the current update
+    **/
+    PlayerInput readInput() const;
+
+    /**
+    * @brief
+    *   Sets movement and action latches according to the input (live or replayed)
     **/
-    void updateLatches();
+    void updateLatches(const PlayerInput& input);
 
     /**
     * @brief
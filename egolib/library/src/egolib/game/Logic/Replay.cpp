@@ -0,0 +1,436 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Logic/Replay.cpp
+/// @brief Recording and replaying of player input for repeatable benchmarks and regression runs.
+
+#include "egolib/game/Logic/Replay.hpp"
+#include "egolib/Entities/_Include.hpp"
+#include "egolib/game/Module/Module.hpp"
+
+namespace Ego {
+
+namespace {
+
+const char MAGIC[8] = { 'E', 'G', 'O', 'R', 'E', 'P', 'L', 'Y' };
+
+void putUint8(std::vector<char>& buffer, uint8_t value)
+{
+    buffer.push_back(static_cast<char>(value));
+}
+
+void putUint16(std::vector<char>& buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<char>(value & 0xff));
+    buffer.push_back(static_cast<char>(value >> 8));
+}
+
+void putUint32(std::vector<char>& buffer, uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+void putUint64(std::vector<char>& buffer, uint64_t value)
+{
+    putUint32(buffer, uint32_t(value));
+    putUint32(buffer, uint32_t(value >> 32));
+}
+
+void putFloat(std::vector<char>& buffer, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putUint32(buffer, bits);
+}
+
+void putString(std::vector<char>& buffer, const std::string& value)
+{
+    if (value.size() > std::numeric_limits<uint16_t>::max())
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "string too long for a replay");
+    }
+    putUint16(buffer, uint16_t(value.size()));
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+/// Read exactly @a size bytes or fail.
+void getBytes(std::istream& stream, char *bytes, size_t size)
+{
+    if (!stream.read(bytes, size))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "truncated replay");
+    }
+}
+
+uint8_t getUint8(std::istream& stream)
+{
+    char byte;
+    getBytes(stream, &byte, 1);
+    return uint8_t(byte);
+}
+
+uint16_t getUint16(std::istream& stream)
+{
+    unsigned char bytes[2];
+    getBytes(stream, reinterpret_cast<char *>(bytes), 2);
+    return uint16_t(bytes[0] | bytes[1] << 8);
+}
+
+uint32_t getUint32(std::istream& stream)
+{
+    unsigned char bytes[4];
+    getBytes(stream, reinterpret_cast<char *>(bytes), 4);
+    return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+}
+
+uint64_t getUint64(std::istream& stream)
+{
+    const uint64_t low = getUint32(stream);
+    return low | uint64_t(getUint32(stream)) << 32;
+}
+
+float getFloat(std::istream& stream)
+{
+    const uint32_t bits = getUint32(stream);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string getString(std::istream& stream)
+{
+    std::string value(getUint16(stream), '\0');
+    if (!value.empty())
+    {
+        getBytes(stream, &value[0], value.size());
+    }
+    return value;
+}
+
+/// FNV-1a over the bytes of a value.
+template <typename T>
+void hashValue(uint64_t& hash, const T& value)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+void hashVector(uint64_t& hash, const Vector3f& value)
+{
+    hashValue(hash, value.x());
+    hashValue(hash, value.y());
+    hashValue(hash, value.z());
+}
+
+} // namespace
+
+PlayerInput::PlayerInput() :
+    movement(idlib::zero<Vector2f>()),
+    buttons(0),
+    facing(0.0f)
+{}
+
+bool PlayerInput::isButtonPressed(const Input::InputDevice::InputButton button) const
+{
+    return 0 != (buttons & (1u << static_cast<uint32_t>(button)));
+}
+
+void PlayerInput::setButtonPressed(const Input::InputDevice::InputButton button, bool pressed)
+{
+    const uint32_t bit = 1u << static_cast<uint32_t>(button);
+    buttons = pressed ? (buttons | bit) : (buttons & ~bit);
+}
+
+void PlayerInput::setFlag(Flags flag, bool set)
+{
+    buttons = set ? (buttons | flag) : (buttons & ~uint32_t(flag));
+}
+
+ReplayHeader::ReplayHeader() :
+    seed(0),
+    module(),
+    players()
+{}
+
+ReplayTick::ReplayTick() :
+    tick(0),
+    inputs(),
+    checksum(0)
+{}
+
+ReplayWriter::ReplayWriter(std::ostream& stream, const ReplayHeader& header) :
+    _stream(stream)
+{
+    if (header.players.size() > std::numeric_limits<uint8_t>::max())
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "too many players for a replay");
+    }
+    std::vector<char> buffer(std::begin(MAGIC), std::end(MAGIC));
+    putUint32(buffer, VERSION);
+    putUint32(buffer, header.seed);
+    putString(buffer, header.module);
+    putUint8(buffer, uint8_t(header.players.size()));
+    for (const auto& player : header.players)
+    {
+        putString(buffer, player);
+    }
+    if (!_stream.write(buffer.data(), buffer.size()))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to write replay header");
+    }
+}
+
+void ReplayWriter::write(const ReplayTick& tick)
+{
+    if (tick.inputs.size() > std::numeric_limits<uint8_t>::max())
+    {
+        throw idlib::invalid_argument_error(__FILE__, __LINE__, "too many player inputs in a replay tick");
+    }
+    std::vector<char> buffer;
+    putUint32(buffer, tick.tick);
+    putUint8(buffer, uint8_t(tick.inputs.size()));
+    for (const auto& input : tick.inputs)
+    {
+        putUint8(buffer, input.first);
+        putUint32(buffer, input.second.buttons);
+        putFloat(buffer, input.second.movement.x());
+        putFloat(buffer, input.second.movement.y());
+        putFloat(buffer, input.second.facing);
+    }
+    putUint64(buffer, tick.checksum);
+    if (!_stream.write(buffer.data(), buffer.size()))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to write replay tick");
+    }
+}
+
+ReplayReader::ReplayReader(std::istream& stream) :
+    _stream(stream),
+    _header()
+{
+    char magic[sizeof(MAGIC)];
+    if (!_stream.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(MAGIC)))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "not a replay");
+    }
+    const uint32_t version = getUint32(_stream);
+    if (ReplayWriter::VERSION != version)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unsupported replay version " + std::to_string(version));
+    }
+    _header.seed = getUint32(_stream);
+    _header.module = getString(_stream);
+    const uint8_t playerCount = getUint8(_stream);
+    for (uint8_t i = 0; i < playerCount; ++i)
+    {
+        _header.players.push_back(getString(_stream));
+    }
+}
+
+bool ReplayReader::read(ReplayTick& tick)
+{
+    // A clean end of the replay is only allowed between two records.
+    if (std::char_traits<char>::eof() == _stream.peek())
+    {
+        return false;
+    }
+    tick.tick = getUint32(_stream);
+    tick.inputs.resize(getUint8(_stream));
+    for (auto& input : tick.inputs)
+    {
+        input.first = getUint8(_stream);
+        input.second.buttons = getUint32(_stream);
+        input.second.movement.x() = getFloat(_stream);
+        input.second.movement.y() = getFloat(_stream);
+        input.second.facing = getFloat(_stream);
+    }
+    tick.checksum = getUint64(_stream);
+    return true;
+}
+
+ReplaySystem::ReplaySystem() :
+    _pathname(),
+    _file(),
+    _writer(),
+    _reader(),
+    _header(),
+    _current(),
+    _finished(false),
+    _tickCount(0),
+    _divergedTicks(0),
+    _firstDivergedTick(0),
+    _startTime()
+{}
+
+ReplaySystem::~ReplaySystem()
+{
+    stop();
+}
+
+void ReplaySystem::startRecording(const std::string& pathname, const ReplayHeader& header)
+{
+    stop();
+    _file = std::make_unique<std::fstream>(pathname, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!*_file)
+    {
+        _file = nullptr;
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to open replay `" + pathname + "` for writing");
+    }
+    _writer = std::make_unique<ReplayWriter>(*_file, header);
+    _pathname = pathname;
+    _header = header;
+    _current = ReplayTick();
+    _finished = false;
+    _tickCount = 0;
+    _startTime = std::chrono::steady_clock::now();
+}
+
+const ReplayHeader& ReplaySystem::startPlayback(const std::string& pathname)
+{
+    stop();
+    _file = std::make_unique<std::fstream>(pathname, std::ios::in | std::ios::binary);
+    if (!*_file)
+    {
+        _file = nullptr;
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to open replay `" + pathname + "` for reading");
+    }
+    try
+    {
+        _reader = std::make_unique<ReplayReader>(*_file);
+        _header = _reader->getHeader();
+        _finished = !_reader->read(_current);
+    }
+    catch (...)
+    {
+        _reader = nullptr;
+        _file = nullptr;
+        throw;
+    }
+    _pathname = pathname;
+    _tickCount = 0;
+    _divergedTicks = 0;
+    _startTime = std::chrono::steady_clock::now();
+    return _header;
+}
+
+void ReplaySystem::stop()
+{
+    if (!_file)
+    {
+        return;
+    }
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _startTime).count();
+    if (isRecording())
+    {
+        Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "recorded ", _tickCount, " updates into replay `",
+                                         _pathname, "`", Log::EndOfEntry);
+    }
+    else if (0 == _divergedTicks)
+    {
+        Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "replayed ", _tickCount, " updates of `", _pathname,
+                                         "` in ", milliseconds, " ms", Log::EndOfEntry);
+    }
+    else
+    {
+        Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "replayed ", _tickCount, " updates of `", _pathname,
+                                         "` in ", milliseconds, " ms, ", _divergedTicks, " updates diverged, the first one was update ",
+                                         _firstDivergedTick, Log::EndOfEntry);
+    }
+    _writer = nullptr;
+    _reader = nullptr;
+    _file = nullptr;
+}
+
+bool ReplaySystem::getPlayerInput(uint8_t player, PlayerInput& input) const
+{
+    for (const auto& recorded : _current.inputs)
+    {
+        if (recorded.first == player)
+        {
+            input = recorded.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReplaySystem::recordPlayerInput(uint8_t player, const PlayerInput& input)
+{
+    _current.inputs.emplace_back(player, input);
+}
+
+void ReplaySystem::endTick(uint32_t tick)
+{
+    if (isRecording())
+    {
+        _current.tick = tick;
+        _current.checksum = computeWorldChecksum();
+        _writer->write(_current);
+        _current.inputs.clear();
+        _tickCount++;
+    }
+    else if (isPlaying() && !_finished)
+    {
+        const uint64_t checksum = computeWorldChecksum();
+        if (_current.tick != tick || _current.checksum != checksum)
+        {
+            if (0 == _divergedTicks)
+            {
+                _firstDivergedTick = tick;
+                Log::get() << Log::Entry::create(Log::Level::Error, __FILE__, __LINE__, "replay `", _pathname, "` diverged in update ",
+                                                 tick, Log::EndOfEntry);
+            }
+            _divergedTicks++;
+        }
+        _tickCount++;
+        _finished = !_reader->read(_current);
+        if (_finished)
+        {
+            _current = ReplayTick();
+        }
+    }
+}
+
+uint64_t ReplaySystem::computeWorldChecksum()
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const std::shared_ptr<Object>& object : _currentModule->getObjectHandler().iterator())
+    {
+        hashValue(hash, object->getObjRef().get());
+        hashVector(hash, object->getPosition());
+        hashVector(hash, object->getVelocity());
+        hashValue(hash, object->getLife());
+    }
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+    {
+        hashValue(hash, particle->getParticleID().get());
+        hashVector(hash, particle->getPosition());
+        hashVector(hash, particle->getVelocity());
+    }
+    return hash;
+}
+
+} // namespace Ego
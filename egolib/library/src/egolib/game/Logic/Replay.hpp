@@ -0,0 +1,229 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Logic/Replay.hpp
+/// @brief Recording and replaying of player input for repeatable benchmarks and regression runs.
+
+#pragma once
+
+#include "idlib/idlib.hpp"
+#include "egolib/InputControl/InputDevice.hpp"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  The input of a player in one update as read from its input device.
+ *  This is all Player::updateLatches needs, so a recorded PlayerInput
+ *  drives the player object exactly like the live device did.
+ */
+struct PlayerInput
+{
+    /// Bits 0 to InputButton::COUNT-1 are the pressed input buttons, the higher bits are these flags.
+    enum Flags : uint32_t
+    {
+        Respawn = 1u << 24,     ///< The respawn key was pressed
+        MouseDevice = 1u << 25, ///< The input device is a mouse
+        NoCamera = 1u << 26,    ///< No camera is following the player object
+    };
+
+    PlayerInput();
+
+    bool isButtonPressed(const Input::InputDevice::InputButton button) const;
+
+    void setButtonPressed(const Input::InputDevice::InputButton button, bool pressed);
+
+    bool hasFlag(Flags flag) const { return 0 != (buttons & flag); }
+
+    void setFlag(Flags flag, bool set);
+
+    /// The movement of the input device in the body frame.
+    Vector2f movement;
+    /// The pressed buttons and flags.
+    uint32_t buttons;
+    /// The facing of the camera following the player object.
+    float facing;
+};
+
+/**
+ * @brief
+ *  The header of a replay: everything needed to start the same module in the same state.
+ */
+struct ReplayHeader
+{
+    ReplayHeader();
+
+    /// The seed of the random number generators.
+    uint32_t seed;
+    /// The path of the module.
+    std::string module;
+    /// The imported players.
+    std::list<std::string> players;
+};
+
+/**
+ * @brief
+ *  The record of one update.
+ */
+struct ReplayTick
+{
+    ReplayTick();
+
+    /// The value of update_wld of the update.
+    uint32_t tick;
+    /// The input of the players (index into the player list and input) read in this update.
+    std::vector<std::pair<uint8_t, PlayerInput>> inputs;
+    /// The world checksum after the update.
+    uint64_t checksum;
+};
+
+/**
+ * @brief
+ *  Writes a replay to a binary stream. All values are stored little endian.
+ * @remark
+ *  The file starts with the magic "EGOREPLY", the version, the seed, the module path and
+ *  the imported players. It is followed by one record per update until the end of the file.
+ */
+class ReplayWriter : private idlib::non_copyable
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Construct a replay writer and write the header.
+     * @throw idlib::runtime_error if writing fails
+     */
+    ReplayWriter(std::ostream& stream, const ReplayHeader& header);
+
+    /**
+     * @brief Append the record of an update.
+     * @throw idlib::runtime_error if writing fails
+     */
+    void write(const ReplayTick& tick);
+
+private:
+    std::ostream& _stream;
+};
+
+/**
+ * @brief
+ *  Reads a replay written by ReplayWriter.
+ */
+class ReplayReader : private idlib::non_copyable
+{
+public:
+    /**
+     * @brief Construct a replay reader and read the header.
+     * @throw idlib::runtime_error if the stream is not a replay of a supported version
+     */
+    ReplayReader(std::istream& stream);
+
+    const ReplayHeader& getHeader() const { return _header; }
+
+    /**
+     * @brief Read the record of the next update.
+     * @return @a true if a record was read, @a false at the end of the replay
+     * @throw idlib::runtime_error if the record is truncated
+     */
+    bool read(ReplayTick& tick);
+
+private:
+    std::istream& _stream;
+    ReplayHeader _header;
+};
+
+/**
+ * @brief
+ *  Records the player input of a module into a replay or feeds a replay back into the game.
+ *  A checksum of the world is stored with every update, the replay compares it against the
+ *  checksum of the running game and reports the first update where they diverge.
+ */
+class ReplaySystem : public idlib::singleton<ReplaySystem>
+{
+protected:
+    friend idlib::default_new_functor<ReplaySystem>;
+    friend idlib::default_delete_functor<ReplaySystem>;
+    ReplaySystem();
+    virtual ~ReplaySystem();
+
+public:
+    /**
+     * @brief Start recording into a file. Any running recording or replay is stopped.
+     * @throw idlib::runtime_error if the file can not be opened
+     */
+    void startRecording(const std::string& pathname, const ReplayHeader& header);
+
+    /**
+     * @brief Start replaying a file. Any running recording or replay is stopped.
+     * @return the header of the replay
+     * @throw idlib::runtime_error if the file can not be opened or is not a replay
+     */
+    const ReplayHeader& startPlayback(const std::string& pathname);
+
+    /// @brief Stop recording or replaying and log a summary.
+    void stop();
+
+    bool isRecording() const { return nullptr != _writer; }
+
+    bool isPlaying() const { return nullptr != _reader; }
+
+    /// @return @a true if a replay was played to its end
+    bool isFinished() const { return _finished; }
+
+    /// @return the header of the running recording or replay
+    const ReplayHeader& getHeader() const { return _header; }
+
+    /**
+     * @brief Get the recorded input of a player for the current update.
+     * @return @a true if input was recorded for this player, @a false otherwise
+     */
+    bool getPlayerInput(uint8_t player, PlayerInput& input) const;
+
+    /// @brief Record the input of a player for the current update.
+    void recordPlayerInput(uint8_t player, const PlayerInput& input);
+
+    /**
+     * @brief
+     *  Finish an update: store the world checksum when recording, compare it when replaying.
+     */
+    void endTick(uint32_t tick);
+
+    /**
+     * @return
+     *  a checksum of the simulation state (object and particle positions, velocities and life)
+     */
+    static uint64_t computeWorldChecksum();
+
+private:
+    std::string _pathname;
+    std::unique_ptr<std::fstream> _file;
+    std::unique_ptr<ReplayWriter> _writer;
+    std::unique_ptr<ReplayReader> _reader;
+    ReplayHeader _header;
+    /// The update being recorded or replayed.
+    ReplayTick _current;
+    bool _finished;
+    size_t _tickCount;
+    size_t _divergedTicks;
+    uint32_t _firstDivergedTick;
+    std::chrono::steady_clock::time_point _startTime;
+};
+
+} // namespace Ego
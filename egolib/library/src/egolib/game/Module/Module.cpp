@@ -65,7 +65,9 @@ GameModule::GameModule(const std::shared_ptr<ModuleProfile> &profile, const uint
     _pitsClock(PIT_CLOCK_RATE),
     _pitsKill(false),
     _pitsTeleport(false),
-    _pitsTeleportPos()
+    _pitsTeleportPos(),
+    _snapshotRing(),
+    _dormancy()
 {
     Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "loading module ", "`", profile->getPath(), "`", Log::EndOfEntry);
 
@@ -78,6 +80,12 @@ GameModule::GameModule(const std::shared_ptr<ModuleProfile> &profile, const uint
     srand( _seed );
     Random::setSeed(_seed);
 
+    //Keep snapshots of the last seconds to jump back to
+    const int snapshotSeconds = egoboo_config_t::get().debug_snapshot_ringLength.getValue();
+    if (snapshotSeconds > 0) {
+        _snapshotRing = std::make_unique<Ego::SnapshotRing>(snapshotSeconds);
+    }
+
     //Initialize all teams
     for(int i = 0; i < Team::TEAM_MAX; ++i) {
         _teamList.push_back(Team(i));
@@ -498,7 +506,7 @@ std::shared_ptr<Object> GameModule::spawnObject(const Ego::Vector3f& pos, Object
     ai_state_t::spawn( pchr->ai, pchr->getObjRef(), pchr->getProfileID().get(), getTeamList()[team].getMorale() );
 
     // Team stuff
-    pchr->team     = team;
+    pchr->assignTeam(team);
     pchr->team_base = team;
     if ( !pchr->isInvincible() )  getTeamList()[team].increaseMorale();
 
@@ -561,7 +569,7 @@ std::shared_ptr<Object> GameModule::spawnObject(const Ego::Vector3f& pos, Object
     for ( uint8_t tnc = 0; tnc < ppro->getAttachedParticleAmount(); tnc++ )
     {
         ParticleHandler::get().spawnParticle( pchr->getPosition(), pchr->ori.facing_z, ppro->getSlotNumber(), ppro->getAttachedParticleProfile(),
-                                              pchr->getObjRef(), GRIP_LAST + tnc, pchr->team, pchr->getObjRef(), ParticleRef::Invalid, tnc);
+                                              pchr->getObjRef(), GRIP_LAST + tnc, pchr->getTeamID(), pchr->getObjRef(), ParticleRef::Invalid, tnc);
     }
 
     // is the object part of a shop's inventory?
@@ -621,8 +629,8 @@ void GameModule::updateAllObjects()
 {
    for(const std::shared_ptr<Object> &object : getObjectHandler().iterator())
     {
-        //Skip terminated objects
-        if(object->isTerminated()) {
+        //Skip terminated and sleeping objects
+        if(object->isTerminated() || object->isDormant()) {
             continue;
         }
 
@@ -1200,6 +1208,7 @@ void GameModule::update()
     //---- Run AI (but not on first update frame) ~10% CPU
     if(update_wld > 0)
     {
+        _dormancy.update();                             //skip idle objects far from all players
         MainLoop::let_all_characters_think();           //sets the non-player latches
         MainLoop::readPlayerInput();                    //sets latches generated by players
     }
@@ -1220,6 +1229,14 @@ void GameModule::update()
     //Camera movement
     CameraSystem::get().updateAll(_mesh.get());
 
+    //Record or verify the update for replays
+    Ego::ReplaySystem::get().endTick(update_wld);
+
     //Increment update frame counter
     update_wld++;
+
+    //Take a snapshot every second
+    if (_snapshotRing && 0 == update_wld % ONESECOND) {
+        _snapshotRing->push();
+    }
 }
@@ -27,6 +27,8 @@
 #include "egolib/game/Module/Water.hpp"
 #include "egolib/game/Module/module_spawn.h"
 #include "egolib/game/Module/damagetile_instance.h"
+#include "egolib/game/Module/WorldSnapshot.hpp"
+#include "egolib/game/Logic/DormancySystem.hpp"
 
 //@todo This is an ugly hack to work around cyclic dependency and private header guards
 #ifndef GAME_ENTITIES_PRIVATE
@@ -147,6 +149,15 @@ public:
 
     const std::list<std::string>& getImportPlayers() const {return _playerNameList;}
 
+    /// @return the seed the random number generators were initialized with
+    uint32_t getSeed() const {return _seed;}
+
+    /// @return the snapshots of the last seconds, @a nullptr if they are not taken
+    Ego::SnapshotRing *getSnapshotRing() const {return _snapshotRing.get();}
+
+    /// @return the system which lets idle objects far from all players sleep
+    Ego::DormancySystem& getDormancySystem() {return _dormancy;}
+
     /**
     * @brief
     *   Get list of all teams in this Module. Teams determine who like each other and who don't
@@ -313,6 +324,12 @@ private:
     bool _pitsKill;              ///< Do they kill?
     bool _pitsTeleport;          ///< Do they teleport?
     Ego::Vector3f _pitsTeleportPos;   ///< If they teleport, then where to?
+
+    /// The snapshots of the last seconds, @a nullptr if disabled.
+    std::unique_ptr<Ego::SnapshotRing> _snapshotRing;
+
+    /// The sleeping idle objects.
+    Ego::DormancySystem _dormancy;
 };
 
 /// @todo Remove this global.
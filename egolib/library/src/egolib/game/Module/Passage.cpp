@@ -83,27 +83,19 @@ bool Passage::close()
     {
         std::vector<std::shared_ptr<Object>> crushedCharacters;
 
-        // Make sure it isn't blocked
-        for(const std::shared_ptr<Object> &object : _module.getObjectHandler().iterator())
+        // Make sure it isn't blocked. Scenery can neither be crushed nor prevents doors from closing.
+        for(const std::shared_ptr<Object> &object : getOccupants(false))
         {
-            //Scenery can neither be crushed nor prevents doors from closing
-            if(object->isScenery()) {
-                continue;
-            }
-
             if (object->canCollide())
             {
-                if (objectIsInPassage(object))
+                if (!object->canbecrushed || (object->isAlive() && object->getProfile()->canOpenStuff()))
+                {
+                    // Someone is blocking who can open stuff, stop here
+                    return false;
+                }
+                else
                 {
-                    if (!object->canbecrushed || (object->isAlive() && object->getProfile()->canOpenStuff()))
-                    {
-                        // Someone is blocking who can open stuff, stop here
-                        return false;
-                    }
-                    else
-                    {
-                        crushedCharacters.push_back(object);
-                    }
+                    crushedCharacters.push_back(object);
                 }
             }
         }
@@ -128,51 +120,58 @@ bool Passage::objectIsInPassage(const std::shared_ptr<Object> &object) const
     return idlib::is_intersecting(_area, object->getAxisAlignedBox2D());
 }
 
+std::vector<std::shared_ptr<Object>> Passage::getOccupants(bool includeSceneryObjects) const
+{
+    std::vector<std::shared_ptr<Object>> occupants;
+    _module.getObjectHandler().findObjects(_area, occupants, includeSceneryObjects);
+
+    // Drop terminated objects and restore spawn order, so that the "first object found"
+    // is the same one a scan over all objects would find.
+    occupants.erase(std::remove_if(occupants.begin(), occupants.end(),
+                                   [](const std::shared_ptr<Object>& object) { return object->isTerminated(); }),
+                    occupants.end());
+    std::sort(occupants.begin(), occupants.end(),
+              [](const std::shared_ptr<Object>& a, const std::shared_ptr<Object>& b) { return a->getObjRef() < b->getObjRef(); });
+    return occupants;
+}
+
 ObjectRef Passage::whoIsBlockingPassage( ObjectRef objRef, const IDSZ2& idsz, const BIT_FIELD targeting_bits, const IDSZ2& require_item ) const
 {
     // Skip if the one who is looking doesn't exist
     if ( !_module.getObjectHandler().exists(objRef) ) return ObjectRef::Invalid;
     Object *psrc = _module.getObjectHandler().get(objRef);
 
-    // Look at each character
-    for(const std::shared_ptr<Object> &pchr : _module.getObjectHandler().iterator())
+    // Look at each character inside the passage area.
+    // Scenery objects are only of interest if we allow items.
+    for(const std::shared_ptr<Object> &pchr : getOccupants(HAS_SOME_BITS(targeting_bits, TARGET_ITEMS)))
     {
-        if(pchr->isTerminated()) {
-            continue;
-        }
-
         // dont do scenery objects unless we allow items
         if (!HAS_SOME_BITS(targeting_bits, TARGET_ITEMS) && pchr->isScenery()) continue;
 
         //Check if the object has the requirements
         if ( !chr_check_target( psrc, pchr, idsz, targeting_bits ) ) continue;
 
-        //Now check if it actually is inside the passage area
-        if (objectIsInPassage(pchr))
+        // Found a live one, do we need to check for required items as well?
+        if ( IDSZ2::None == require_item )
         {
+            return pchr->getObjRef();
+        }
 
-            // Found a live one, do we need to check for required items as well?
-            if ( IDSZ2::None == require_item )
-            {
+        // It needs to have a specific item as well
+        else
+        {
+            // I: Check hands
+            if(pchr->isWieldingItemIDSZ(require_item)) {
                 return pchr->getObjRef();
             }
-
-            // It needs to have a specific item as well
-            else
+            
+            // II: Check the pack
+            for(const std::shared_ptr<Object> pitem : pchr->getInventory().iterate())
             {
-                // I: Check hands
-                if(pchr->isWieldingItemIDSZ(require_item)) {
-                    return pchr->getObjRef();
-                }
-                
-                // II: Check the pack
-                for(const std::shared_ptr<Object> pitem : pchr->getInventory().iterate())
+                if ( pitem->getProfile()->hasTypeIDSZ(require_item) )
                 {
-                    if ( pitem->getProfile()->hasTypeIDSZ(require_item) )
-                    {
-                        // It has the required item in inventory...
-                        return pchr->getObjRef();
-                    }
+                    // It has the required item in inventory...
+                    return pchr->getObjRef();
                 }
             }
         }
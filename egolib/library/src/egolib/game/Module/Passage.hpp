@@ -29,6 +29,7 @@
 //Forward declarations
 class Object;
 class GameModule;
+namespace Ego { class WorldSnapshot; }
 
 class Passage
 {
@@ -128,6 +129,17 @@ public:
     **/
     const Ego::AxisAlignedBox2f& getAxisAlignedBox2f() const;
 
+private:
+    /**
+    * @brief
+    *	Get all non-terminated objects which intersect with this passage, sorted by object reference.
+    *	Uses the spatial index of the ObjectHandler, so the cost scales with the number of objects
+    *	near the passage instead of with the number of objects in the world.
+    * @param includeSceneryObjects
+    *	if true, scenery objects are included as well
+    **/
+    std::vector<std::shared_ptr<Object>> getOccupants(bool includeSceneryObjects) const;
+
 private:
     GameModule& _module;			   ///< Reference to the module we are inside
 
@@ -139,4 +151,6 @@ private:
     bool _isShop;					   ///< True if this passage is a shop
     ObjectRef _shopOwner;			   ///< object reference of the owner of this shop
     std::vector<Index1D> _passageFans; //List of all tile indexes contained in this passage
+
+    friend class Ego::WorldSnapshot;
 };
@@ -0,0 +1,590 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Module/WorldSnapshot.cpp
+/// @brief Binary snapshots of the simulation state of the running module.
+
+#include "egolib/game/Module/WorldSnapshot.hpp"
+#include "egolib/Core/SnapshotStream.hpp"
+#include "egolib/Entities/_Include.hpp"
+#include "egolib/game/Module/Module.hpp"
+#include "egolib/game/Module/Passage.hpp"
+#include "egolib/game/game.h"
+#include "egolib/game/mesh.h"
+#include "egolib/Math/Random.hpp"
+
+namespace Ego {
+
+namespace {
+
+const uint64_t MAGIC = 0x0050414E534F4745ULL; // "EGOSNAP\0" in little endian byte order
+
+} // namespace
+
+/// The simulation state of an object which is written as one block.
+struct WorldSnapshot::ObjectState
+{
+    size_t ref;
+    REF_T profile;
+    float position[3];
+    float velocity[3];
+    float oldVelocity[3];
+    FACING_T facing[3];
+    float life;
+    float mana;
+    uint16_t money;
+    bool alive;
+    bool stealth;
+    uint32_t experience;
+    uint8_t experienceLevel;
+    uint16_t ammo;
+    TEAM_REF team;
+    SKIN_T skin;
+    size_t holding[SLOT_COUNT];
+    size_t attachedTo;
+    uint8_t inWhichSlot;
+    size_t inWhichInventory;
+    float fat;
+    float fatGoto;
+    int16_t fatGotoTime;
+    uint8_t jumpTimer;
+    uint8_t jumpNumber;
+    bool jumpReady;
+    int16_t grogTimer;
+    int16_t dazeTimer;
+    int16_t boreTimer;
+    uint8_t carefulTimer;
+    uint16_t reloadTimer;
+    uint8_t damageTimer;
+    int dismountTimer;
+    size_t dismountObject;
+    unsigned long latches;
+    // A.I.
+    size_t aiTarget;
+    size_t aiOldTarget;
+    size_t aiBumped;
+    size_t aiLastAttacker;
+    size_t aiOwner;
+    size_t aiChild;
+    size_t aiHitLast;
+    size_t aiLastItemUsed;
+    int32_t aiPoofTime;
+    BIT_FIELD aiAlert;
+    int aiState;
+    int aiContent;
+    int aiPassage;
+    uint32_t aiTimer;
+    int aiX[STOR_COUNT];
+    int aiY[STOR_COUNT];
+    float aiMaxSpeed;
+    int aiBumpLastTime;
+    FACING_T aiDirectionLast;
+    uint32_t aiOrderValue;
+    uint16_t aiOrderCounter;
+    // Dormancy.
+    bool dormant;
+    uint16_t idleUpdates;
+    uint32_t wakeTime;
+};
+
+/// The simulation state of a particle which is written as one block.
+struct WorldSnapshot::ParticleState
+{
+    size_t ref;
+    float position[3];
+    float velocity[3];
+    FACING_T facing;
+    size_t lifetimeRemaining;
+};
+
+void WorldSnapshot::capture(std::vector<char>& buffer)
+{
+    buffer.clear();
+    SnapshotWriter writer(buffer);
+
+    // Header.
+    writer.write(MAGIC);
+    writer.write(uint32_t(VERSION));
+    writer.write(uint32_t(sizeof(ObjectState)));
+    writer.write(uint32_t(sizeof(ParticleState)));
+    writer.writeString(_currentModule->getPath());
+    writer.write(update_wld);
+    writer.write(Random::getState());
+
+    // Objects.
+    ObjectHandler& objects = _currentModule->getObjectHandler();
+    uint32_t objectCount = 0;
+    for (const std::shared_ptr<Object>& object : objects.iterator())
+    {
+        if (!object->isTerminated()) objectCount++;
+    }
+    writer.write(objectCount);
+    for (const std::shared_ptr<Object>& object : objects.iterator())
+    {
+        if (object->isTerminated())
+        {
+            continue;
+        }
+        ObjectState state;
+        std::memset(&state, 0, sizeof(state));
+        state.ref = object->getObjRef().get();
+        state.profile = object->_profileID.get();
+        for (size_t i = 0; i < 3; ++i)
+        {
+            state.position[i] = object->getPosition()[i];
+            state.velocity[i] = object->getVelocity()[i];
+            state.oldVelocity[i] = object->getOldVelocity()[i];
+        }
+        state.facing[0] = FACING_T(object->ori.facing_z);
+        state.facing[1] = FACING_T(object->ori.map_twist_facing_x);
+        state.facing[2] = FACING_T(object->ori.map_twist_facing_y);
+        state.life = object->_currentLife;
+        state.mana = object->_currentMana;
+        state.money = object->_money;
+        state.alive = object->_isAlive;
+        state.stealth = object->_stealth;
+        state.experience = object->experience;
+        state.experienceLevel = object->experiencelevel;
+        state.ammo = object->ammo;
+        state.team = object->getTeamID();
+        state.skin = object->skin;
+        for (size_t i = 0; i < SLOT_COUNT; ++i)
+        {
+            state.holding[i] = object->holdingwhich[i].get();
+        }
+        state.attachedTo = object->attachedto.get();
+        state.inWhichSlot = uint8_t(object->inwhich_slot);
+        state.inWhichInventory = object->inwhich_inventory.get();
+        state.fat = object->fat;
+        state.fatGoto = object->fat_goto;
+        state.fatGotoTime = object->fat_goto_time;
+        state.jumpTimer = object->jump_timer;
+        state.jumpNumber = object->jumpnumber;
+        state.jumpReady = object->jumpready;
+        state.grogTimer = object->grog_timer;
+        state.dazeTimer = object->daze_timer;
+        state.boreTimer = object->bore_timer;
+        state.carefulTimer = object->careful_timer;
+        state.reloadTimer = object->reload_timer;
+        state.damageTimer = object->damage_timer;
+        state.dismountTimer = object->dismount_timer;
+        state.dismountObject = object->dismount_object.get();
+        state.latches = object->_inputLatchesPressed.to_ulong();
+
+        const ai_state_t& ai = object->ai;
+        state.aiTarget = ai.getTarget().get();
+        state.aiOldTarget = ai.getOldTarget().get();
+        state.aiBumped = ai.getBumped().get();
+        state.aiLastAttacker = ai.getLastAttacker().get();
+        state.aiOwner = ai.owner.get();
+        state.aiChild = ai.child.get();
+        state.aiHitLast = ai.hitlast.get();
+        state.aiLastItemUsed = ai.lastitemused.get();
+        state.aiPoofTime = ai.poof_time;
+        state.aiAlert = ai.alert;
+        state.aiState = ai.state;
+        state.aiContent = ai.content;
+        state.aiPassage = ai.passage;
+        state.aiTimer = ai.timer;
+        std::copy(std::begin(ai.x), std::end(ai.x), std::begin(state.aiX));
+        std::copy(std::begin(ai.y), std::end(ai.y), std::begin(state.aiY));
+        state.aiMaxSpeed = ai.maxSpeed;
+        state.aiBumpLastTime = ai.bumplast_time;
+        state.aiDirectionLast = FACING_T(ai.directionlast);
+        state.aiOrderValue = ai.order_value;
+        state.aiOrderCounter = ai.order_counter;
+        state.dormant = object->_dormant;
+        state.idleUpdates = object->_idleUpdates;
+        state.wakeTime = object->_wakeTime;
+
+        writer.write(state);
+        writer.writeString(object->_cold->name);
+
+        // The enchantments are restored in place, only their remaining time is needed.
+        const auto enchantCount = std::distance(object->_activeEnchants.begin(), object->_activeEnchants.end());
+        writer.write(uint32_t(enchantCount));
+        for (const auto& enchant : object->_activeEnchants)
+        {
+            writer.write(enchant->_lifeTime);
+            writer.write(enchant->_spawnParticlesTimer);
+        }
+    }
+
+    // Particles.
+    uint32_t particleCount = 0;
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+    {
+        if (!particle->isTerminated()) particleCount++;
+    }
+    writer.write(particleCount);
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+    {
+        if (particle->isTerminated())
+        {
+            continue;
+        }
+        ParticleState state;
+        std::memset(&state, 0, sizeof(state));
+        state.ref = particle->getParticleID().get();
+        for (size_t i = 0; i < 3; ++i)
+        {
+            state.position[i] = particle->getPosition()[i];
+            state.velocity[i] = particle->getVelocity()[i];
+        }
+        state.facing = FACING_T(particle->facing);
+        state.lifetimeRemaining = particle->lifetime_remaining;
+        writer.write(state);
+    }
+
+    // Mesh FX bits.
+    const tile_mem_t& tiles = _currentModule->getMeshPointer()->_tmem;
+    const size_t tileCount = tiles.getInfo().getTileCount();
+    writer.write(uint32_t(tileCount));
+    for (size_t i = 0; i < tileCount; ++i)
+    {
+        writer.write(tiles.get(Index1D(i)).getFX());
+    }
+
+    // Passages.
+    writer.write(uint32_t(_currentModule->getPassageCount()));
+    for (int i = 0; i < _currentModule->getPassageCount(); ++i)
+    {
+        writer.write(_currentModule->getPassageByID(i)->_open);
+    }
+}
+
+void WorldSnapshot::restore(const std::vector<char>& buffer)
+{
+    SnapshotReader reader(buffer);
+
+    // Header.
+    if (MAGIC != reader.read<uint64_t>() || VERSION != reader.read<uint32_t>() ||
+        sizeof(ObjectState) != reader.read<uint32_t>() || sizeof(ParticleState) != reader.read<uint32_t>())
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "snapshot of an unsupported version");
+    }
+    const std::string module = reader.readString();
+    if (module != _currentModule->getPath())
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "snapshot of module `" + module + "`");
+    }
+    const uint32_t tick = reader.read<uint32_t>();
+    const std::mt19937 random = reader.read<std::mt19937>();
+
+    // Objects. Spawn the missing ones first, then remove the ones which did not exist, then restore the state.
+    const uint32_t objectCount = reader.read<uint32_t>();
+    if (objectCount > buffer.size() / sizeof(ObjectState))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "truncated snapshot");
+    }
+    std::vector<ObjectState> states(objectCount);
+    std::vector<std::string> names(objectCount);
+    std::vector<std::vector<std::pair<int, int>>> enchants(objectCount);
+    for (uint32_t i = 0; i < objectCount; ++i)
+    {
+        states[i] = reader.read<ObjectState>();
+        names[i] = reader.readString();
+        enchants[i].resize(reader.read<uint32_t>());
+        for (auto& enchant : enchants[i])
+        {
+            enchant.first = reader.read<int>();
+            enchant.second = reader.read<int>();
+        }
+    }
+
+    const uint32_t particleCount = reader.read<uint32_t>();
+    if (particleCount > buffer.size() / sizeof(ParticleState))
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "truncated snapshot");
+    }
+    std::vector<ParticleState> particleStates(particleCount);
+    for (auto& state : particleStates)
+    {
+        state = reader.read<ParticleState>();
+    }
+
+    const tile_mem_t& tiles = _currentModule->getMeshPointer()->_tmem;
+    if (tiles.getInfo().getTileCount() != reader.read<uint32_t>())
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "snapshot of a different mesh");
+    }
+    const size_t tileCount = tiles.getInfo().getTileCount();
+    std::vector<GRID_FX_BITS> fx(tileCount);
+    for (auto& bits : fx)
+    {
+        bits = reader.read<GRID_FX_BITS>();
+    }
+
+    if (uint32_t(_currentModule->getPassageCount()) != reader.read<uint32_t>())
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "snapshot with a different number of passages");
+    }
+    std::vector<bool> passages(_currentModule->getPassageCount());
+    for (size_t i = 0; i < passages.size(); ++i)
+    {
+        passages[i] = reader.read<bool>();
+    }
+    if (!reader.isAtEnd())
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "trailing data in snapshot");
+    }
+
+    // The snapshot is valid, nothing below throws.
+    restoreObjects(states, names, enchants);
+    restoreParticles(particleStates);
+    _currentModule->getDormancySystem().rebuild();
+
+    ego_mesh_t& mesh = *_currentModule->getMeshPointer();
+    for (size_t i = 0; i < tileCount; ++i)
+    {
+        if (mesh._tmem.get(Index1D(i)).setFX(fx[i]))
+        {
+            mesh._fxlists.dirty = true;
+        }
+    }
+    for (size_t i = 0; i < passages.size(); ++i)
+    {
+        _currentModule->getPassageByID(int(i))->_open = passages[i];
+    }
+
+    // Last, as spawning objects draws random numbers.
+    Random::setState(random);
+    update_wld = tick;
+}
+
+void WorldSnapshot::restoreObjects(const std::vector<ObjectState>& states, const std::vector<std::string>& names,
+                                   const std::vector<std::vector<std::pair<int, int>>>& enchants)
+{
+    ObjectHandler& objects = _currentModule->getObjectHandler();
+
+    // Remove the objects spawned after the snapshot.
+    std::vector<size_t> refs;
+    refs.reserve(states.size());
+    for (const ObjectState& state : states)
+    {
+        refs.push_back(state.ref);
+    }
+    std::sort(refs.begin(), refs.end());
+    for (const std::shared_ptr<Object>& object : objects.iterator())
+    {
+        if (!object->isTerminated() && !std::binary_search(refs.begin(), refs.end(), object->getObjRef().get()))
+        {
+            object->requestTerminate();
+        }
+    }
+
+    // Spawn the objects removed after the snapshot again under their old reference.
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const ObjectState& state = states[i];
+        const std::shared_ptr<Object>& existing = objects[ObjectRef(state.ref)];
+        if (existing && !existing->isTerminated())
+        {
+            continue;
+        }
+        const Vector3f position(state.position[0], state.position[1], state.position[2]);
+        if (!_currentModule->spawnObject(position, ObjectProfileRef(state.profile), state.team, state.skin,
+                                         Facing(state.facing[0]), names[i], ObjectRef(state.ref)))
+        {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to respawn object ", state.ref,
+                                             " from a snapshot", Log::EndOfEntry);
+        }
+    }
+
+    // Restore the state.
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const ObjectState& state = states[i];
+        const std::shared_ptr<Object>& object = objects[ObjectRef(state.ref)];
+        if (!object || object->isTerminated())
+        {
+            continue;
+        }
+        object->setPosition(Vector3f(state.position[0], state.position[1], state.position[2]));
+        object->setVelocity(Vector3f(state.velocity[0], state.velocity[1], state.velocity[2]));
+        object->setOldVelocity(Vector3f(state.oldVelocity[0], state.oldVelocity[1], state.oldVelocity[2]));
+        object->ori.facing_z = Facing(state.facing[0]);
+        object->ori.map_twist_facing_x = Facing(state.facing[1]);
+        object->ori.map_twist_facing_y = Facing(state.facing[2]);
+        object->_currentLife = state.life;
+        object->_currentMana = state.mana;
+        object->_money = state.money;
+        object->_isAlive = state.alive;
+        object->_stealth = state.stealth;
+        object->experience = state.experience;
+        object->experiencelevel = state.experienceLevel;
+        object->ammo = state.ammo;
+        object->assignTeam(state.team);
+        object->skin = state.skin;
+        for (size_t j = 0; j < SLOT_COUNT; ++j)
+        {
+            object->holdingwhich[j] = ObjectRef(state.holding[j]);
+        }
+        object->attachedto = ObjectRef(state.attachedTo);
+        object->inwhich_slot = static_cast<slot_t>(state.inWhichSlot);
+        object->inwhich_inventory = ObjectRef(state.inWhichInventory);
+        object->fat = state.fat;
+        object->fat_goto = state.fatGoto;
+        object->fat_goto_time = state.fatGotoTime;
+        object->jump_timer = state.jumpTimer;
+        object->jumpnumber = state.jumpNumber;
+        object->jumpready = state.jumpReady;
+        object->grog_timer = state.grogTimer;
+        object->daze_timer = state.dazeTimer;
+        object->bore_timer = state.boreTimer;
+        object->careful_timer = state.carefulTimer;
+        object->reload_timer = state.reloadTimer;
+        object->damage_timer = state.damageTimer;
+        object->dismount_timer = state.dismountTimer;
+        object->dismount_object = ObjectRef(state.dismountObject);
+        object->_inputLatchesPressed = std::bitset<LATCHBUTTON_COUNT>(state.latches);
+
+        ai_state_t& ai = object->ai;
+        ai.setTarget(ObjectRef(state.aiTarget));
+        ai.setOldTarget(ObjectRef(state.aiOldTarget));
+        ai.setBumped(ObjectRef(state.aiBumped));
+        ai.setLastAttacker(ObjectRef(state.aiLastAttacker));
+        ai.owner = ObjectRef(state.aiOwner);
+        ai.child = ObjectRef(state.aiChild);
+        ai.hitlast = ObjectRef(state.aiHitLast);
+        ai.lastitemused = ObjectRef(state.aiLastItemUsed);
+        ai.poof_time = state.aiPoofTime;
+        ai.alert = state.aiAlert;
+        ai.state = state.aiState;
+        ai.content = state.aiContent;
+        ai.passage = state.aiPassage;
+        ai.timer = state.aiTimer;
+        std::copy(std::begin(state.aiX), std::end(state.aiX), std::begin(ai.x));
+        std::copy(std::begin(state.aiY), std::end(state.aiY), std::begin(ai.y));
+        ai.maxSpeed = state.aiMaxSpeed;
+        ai.bumplast_time = state.aiBumpLastTime;
+        ai.directionlast = Facing(state.aiDirectionLast);
+        ai.order_value = state.aiOrderValue;
+        ai.order_counter = state.aiOrderCounter;
+
+        object->_dormant = state.dormant;
+        object->_idleUpdates = state.idleUpdates;
+        object->_wakeTime = state.wakeTime;
+
+        // Enchantments are restored in place if the object still has the same number of them.
+        const auto enchantCount = std::distance(object->_activeEnchants.begin(), object->_activeEnchants.end());
+        if (size_t(enchantCount) == enchants[i].size())
+        {
+            auto enchant = enchants[i].begin();
+            for (const auto& active : object->_activeEnchants)
+            {
+                active->_lifeTime = enchant->first;
+                active->_spawnParticlesTimer = enchant->second;
+                ++enchant;
+            }
+        }
+    }
+}
+
+void WorldSnapshot::restoreParticles(const std::vector<ParticleState>& states)
+{
+    std::vector<size_t> refs;
+    refs.reserve(states.size());
+    for (const ParticleState& state : states)
+    {
+        refs.push_back(state.ref);
+    }
+    std::sort(refs.begin(), refs.end());
+
+    // Particles spawned after the snapshot are removed, the others are restored in place.
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+    {
+        if (particle->isTerminated())
+        {
+            continue;
+        }
+        const auto it = std::lower_bound(refs.begin(), refs.end(), particle->getParticleID().get());
+        if (it == refs.end() || *it != particle->getParticleID().get())
+        {
+            particle->requestTerminate();
+        }
+    }
+    for (const ParticleState& state : states)
+    {
+        const std::shared_ptr<Ego::Particle>& particle = ParticleHandler::get()[ParticleRef(state.ref)];
+        if (!particle || particle->isTerminated())
+        {
+            continue;
+        }
+        particle->setPosition(Vector3f(state.position[0], state.position[1], state.position[2]));
+        particle->setVelocity(Vector3f(state.velocity[0], state.velocity[1], state.velocity[2]));
+        particle->facing = Facing(state.facing);
+        particle->lifetime_remaining = state.lifetimeRemaining;
+    }
+}
+
+bool WorldSnapshot::save(const std::vector<char>& buffer, const std::string& pathname)
+{
+    vfs_FILE *file = vfs_openWrite(pathname);
+    if (!file)
+    {
+        return false;
+    }
+    const bool success = buffer.size() == vfs_write(buffer.data(), 1, buffer.size(), file);
+    vfs_close(file);
+    return success;
+}
+
+bool WorldSnapshot::load(std::vector<char>& buffer, const std::string& pathname)
+{
+    vfs_FILE *file = vfs_openRead(pathname);
+    if (!file)
+    {
+        return false;
+    }
+    const long length = vfs_fileLength(file);
+    buffer.resize(length > 0 ? size_t(length) : 0);
+    const bool success = length > 0 && buffer.size() == vfs_read(buffer.data(), 1, buffer.size(), file);
+    vfs_close(file);
+    return success;
+}
+
+SnapshotRing::SnapshotRing(size_t capacity) :
+    _slots(std::max<size_t>(capacity, 1)),
+    _next(0),
+    _count(0)
+{}
+
+void SnapshotRing::push()
+{
+    WorldSnapshot::capture(_slots[_next]);
+    _next = (_next + 1) % _slots.size();
+    _count = std::min(_count + 1, _slots.size());
+}
+
+bool SnapshotRing::rewind(size_t stepsBack)
+{
+    if (stepsBack >= _count)
+    {
+        return false;
+    }
+    const size_t slot = (_next + _slots.size() - 1 - stepsBack) % _slots.size();
+    WorldSnapshot::restore(_slots[slot]);
+    // The restored snapshot stays the most recent one.
+    _next = (slot + 1) % _slots.size();
+    _count -= stepsBack;
+    return true;
+}
+
+} // namespace Ego
@@ -0,0 +1,115 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Module/WorldSnapshot.hpp
+/// @brief Binary snapshots of the simulation state of the running module.
+
+#pragma once
+
+#include "egolib/egolib.h"
+
+namespace Ego
+{
+
+/**
+ * @brief
+ *  Takes and restores snapshots of the simulation state of the running module:
+ *  the update counter, the random number generator, the objects (with their A.I. state
+ *  and the lifetimes of their enchantments), the particles, the mesh FX bits and the passages.
+ * @remark
+ *  Objects are restored in place. Objects spawned after the snapshot are removed, objects
+ *  removed after the snapshot are spawned again from their profile. Their inventories and
+ *  enchantments are not recreated. Particles removed after the snapshot are not recreated.
+ *  This is exact for jumping back a few seconds, a snapshot is not a save game.
+ */
+class WorldSnapshot
+{
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    /**
+     * @brief Take a snapshot of the running module.
+     * @param buffer the buffer to store the snapshot in. Its previous contents are replaced,
+     *        its capacity is reused.
+     */
+    static void capture(std::vector<char>& buffer);
+
+    /**
+     * @brief Restore a snapshot into the running module.
+     * @throw idlib::runtime_error if the snapshot is of a different version or module or is truncated
+     */
+    static void restore(const std::vector<char>& buffer);
+
+    /**
+     * @brief Write a snapshot to a file in the user directory.
+     * @return @a true on success, @a false otherwise
+     */
+    static bool save(const std::vector<char>& buffer, const std::string& pathname);
+
+    /**
+     * @brief Read a snapshot from a file.
+     * @return @a true on success, @a false otherwise
+     */
+    static bool load(std::vector<char>& buffer, const std::string& pathname);
+
+private:
+    struct ObjectState;
+    struct ParticleState;
+
+    static void restoreObjects(const std::vector<ObjectState>& states, const std::vector<std::string>& names,
+                               const std::vector<std::vector<std::pair<int, int>>>& enchants);
+
+    static void restoreParticles(const std::vector<ParticleState>& states);
+};
+
+/**
+ * @brief
+ *  A ring of the most recent snapshots of the running module.
+ *  The buffers of the snapshots are reused, so after the ring has filled up taking a snapshot does not allocate.
+ */
+class SnapshotRing : private idlib::non_copyable
+{
+public:
+    /// @param capacity the number of snapshots kept
+    SnapshotRing(size_t capacity);
+
+    /// @brief Take a snapshot, replacing the oldest one if the ring is full.
+    void push();
+
+    /**
+     * @brief Restore a snapshot. The snapshots taken after it are dropped.
+     * @param stepsBack @a 0 for the most recent snapshot, @a 1 for the one before it, ...
+     * @return @a true if the snapshot exists and was restored, @a false otherwise
+     * @throw idlib::runtime_error if the snapshot could not be restored
+     */
+    bool rewind(size_t stepsBack);
+
+    /// @return the number of snapshots in the ring
+    size_t size() const { return _count; }
+
+    void clear() { _count = 0; }
+
+private:
+    std::vector<std::vector<char>> _slots;
+    /// The slot the next snapshot is written to.
+    size_t _next;
+    size_t _count;
+};
+
+} // namespace Ego
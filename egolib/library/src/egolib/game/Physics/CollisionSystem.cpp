@@ -19,6 +19,7 @@
 #include "CollisionSystem.hpp"
 #include "egolib/Entities/_Include.hpp"
 #include "egolib/game/game.h" //for update_wld
+#include "egolib/Core/FrameArena.hpp"
 
 #include "particle_collision.h"
 
@@ -56,101 +57,18 @@ void CollisionSystem::update()
     updateObjectCollisions();
     updateParticleCollisions();
 
-    // accumulate the accumulators
-    for(const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
+    // accumulate the accumulators, every object only touches itself and the mesh
     {
-        if(pchr->isTerminated()) {
-            continue;
-        }
-        
-        float tmpx, tmpy;
-        bool position_updated = false;
-        Vector3f max_apos;
-
-		Vector3f tmp_pos = pchr->getPosition();
-
-        // do the "integration" of the accumulated accelerations
-        pchr->setVelocity(pchr->getVelocity() + pchr->phys.avel);
-
-        // get a net displacement vector from aplat and acoll
-        {
-            // create a temporary apos_t
-            apos_t  apos_tmp;
-
-            // copy 1/2 of the data over
-            apos_tmp = pchr->phys.aplat;
-
-            // get the resultant apos_t
-            apos_tmp.join(pchr->phys.acoll);
-
-            // turn this into a vector
-            apos_t::evaluate(apos_tmp, max_apos);
-        }
-
-        // limit the size of the displacement
-        max_apos[kX] = Ego::Math::constrain( max_apos[kX], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
-        max_apos[kY] = Ego::Math::constrain( max_apos[kY], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
-        max_apos[kZ] = Ego::Math::constrain( max_apos[kZ], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
-
-        // do the "integration" on the position
-        if (std::abs(max_apos[kX]) > 0.0f)
-        {
-            tmpx = tmp_pos[kX];
-            tmp_pos[kX] += max_apos[kX];
-            if ( EMPTY_BIT_FIELD != pchr->test_wall( tmp_pos ) )
-            {
-                // restore the old values
-                tmp_pos[kX] = tmpx;
-            }
-            else
-            {
-                //pchr->vel[kX] += pchr->phys.apos_coll[kX] * bump_str;
-                position_updated = true;
-            }
-        }
-
-        if (std::abs(max_apos[kY]) > 0.0f)
-        {
-            tmpy = tmp_pos[kY];
-            tmp_pos[kY] += max_apos[kY];
-            if ( EMPTY_BIT_FIELD != pchr->test_wall( tmp_pos ) )
-            {
-                // restore the old values
-                tmp_pos[kY] = tmpy;
-            }
-            else
-            {
-                //pchr->vel[kY] += pchr->phys.apos_coll[kY] * bump_str;
-                position_updated = true;
+        auto objects = _currentModule->getObjectHandler().iterator();
+        _objects.clear();
+        for(const std::shared_ptr<Object> &object : objects) {
+            if(!object->isTerminated()) {
+                _objects.push_back(object.get());
             }
         }
-
-        if (std::abs(max_apos[kZ]) > 0.0f)
-        {
-            tmp_pos[kZ] += max_apos[kZ];
-            if ( tmp_pos[kZ] < pchr->getObjectPhysics().getGroundElevation() )
-            {
-                // restore the old values
-                tmp_pos[kZ] = pchr->getObjectPhysics().getGroundElevation();
-                if ( pchr->getVelocity().z() < 0 )
-                {
-                    pchr->setVelocity(pchr->getVelocity() +
-                                      Vector3f(0.0f, 0.0f,
-                                               -(1.0f + pchr->getProfile()->getBounciness()) * pchr->getVelocity().z()));
-                }
-                position_updated = true;
-            }
-            else
-            {
-                //pchr->vel[kZ] += pchr->phys.apos_coll[kZ] * bump_str;
-                position_updated = true;
-            }
-        }
-
-        if ( position_updated )
-        {
-            pchr->setPosition(tmp_pos);
-        }
+        _schedule.reset(_objects.size());
+        _schedule.run([this](size_t i) { integrateAccumulators(*_objects[i]); },
+                      egoboo_config_t::get().debug_physics_parallel.getValue());
     }
 
     // accumulate the accumulators
@@ -259,15 +177,151 @@ void CollisionSystem::update()
     }
 }
 
+void CollisionSystem::integrateAccumulators(Object& object)
+{
+    float tmpx, tmpy;
+    bool position_updated = false;
+    Vector3f max_apos;
+
+    Vector3f tmp_pos = object.getPosition();
+
+    // do the "integration" of the accumulated accelerations
+    object.setVelocity(object.getVelocity() + object.phys.avel);
+
+    // get a net displacement vector from aplat and acoll
+    {
+        // create a temporary apos_t
+        apos_t  apos_tmp;
+
+        // copy 1/2 of the data over
+        apos_tmp = object.phys.aplat;
+
+        // get the resultant apos_t
+        apos_tmp.join(object.phys.acoll);
+
+        // turn this into a vector
+        apos_t::evaluate(apos_tmp, max_apos);
+    }
+
+    // limit the size of the displacement
+    max_apos[kX] = Ego::Math::constrain( max_apos[kX], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
+    max_apos[kY] = Ego::Math::constrain( max_apos[kY], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
+    max_apos[kZ] = Ego::Math::constrain( max_apos[kZ], -Info<float>::Grid::Size(), Info<float>::Grid::Size());
+
+    // do the "integration" on the position
+    if (std::abs(max_apos[kX]) > 0.0f)
+    {
+        tmpx = tmp_pos[kX];
+        tmp_pos[kX] += max_apos[kX];
+        if ( EMPTY_BIT_FIELD != object.test_wall( tmp_pos ) )
+        {
+            // restore the old values
+            tmp_pos[kX] = tmpx;
+        }
+        else
+        {
+            //object.vel[kX] += object.phys.apos_coll[kX] * bump_str;
+            position_updated = true;
+        }
+    }
+
+    if (std::abs(max_apos[kY]) > 0.0f)
+    {
+        tmpy = tmp_pos[kY];
+        tmp_pos[kY] += max_apos[kY];
+        if ( EMPTY_BIT_FIELD != object.test_wall( tmp_pos ) )
+        {
+            // restore the old values
+            tmp_pos[kY] = tmpy;
+        }
+        else
+        {
+            //object.vel[kY] += object.phys.apos_coll[kY] * bump_str;
+            position_updated = true;
+        }
+    }
+
+    if (std::abs(max_apos[kZ]) > 0.0f)
+    {
+        tmp_pos[kZ] += max_apos[kZ];
+        if ( tmp_pos[kZ] < object.getObjectPhysics().getGroundElevation() )
+        {
+            // restore the old values
+            tmp_pos[kZ] = object.getObjectPhysics().getGroundElevation();
+            if ( object.getVelocity().z() < 0 )
+            {
+                object.setVelocity(object.getVelocity() +
+                               Vector3f(0.0f, 0.0f,
+                                        -(1.0f + object.getProfile()->getBounciness()) * object.getVelocity().z()));
+            }
+            position_updated = true;
+        }
+        else
+        {
+            //object.vel[kZ] += object.phys.apos_coll[kZ] * bump_str;
+            position_updated = true;
+        }
+    }
+
+    if ( position_updated )
+    {
+        object.setPosition(tmp_pos);
+    }
+}
+
+void CollisionSystem::updateObjectPhysics()
+{
+    auto objects = _currentModule->getObjectHandler().iterator();
+
+    _objects.clear();
+    std::unordered_map<ObjectRef, size_t> index;
+    for(const std::shared_ptr<Object> &object : objects) {
+        if(!object->isTerminated() && !object->isDormant()) {
+            index[object->getObjRef()] = _objects.size();
+            _objects.push_back(object.get());
+        }
+    }
+
+    // Find the objects whose movement reads other objects.
+    _schedule.reset(_objects.size());
+    auto addDependency = [this, &index](size_t i, ObjectRef source) {
+        if(source == ObjectRef::Invalid || source == _objects[i]->getObjRef()) {
+            return;
+        }
+        const auto it = index.find(source);
+        if(it != index.end()) {
+            _schedule.addDependency(i, it->second);
+        } else {
+            _schedule.addDependent(i);
+        }
+    };
+    for(size_t i = 0; i < _objects.size(); ++i) {
+        const Object& object = *_objects[i];
+        addDependency(i, object.inwhich_inventory);     // inventory items follow the carrier
+        addDependency(i, object.attachedto);            // held items follow the holder
+        addDependency(i, object.onwhichplatform_ref);   // riders follow the platform
+        if(TURNMODE_WATCHTARGET == object.turnmode) {
+            addDependency(i, object.ai.getTarget());    // watchers face the target
+        }
+    }
+
+    _schedule.run([this](size_t i) { _objects[i]->getObjectPhysics().updatePhysics(); },
+                  egoboo_config_t::get().debug_physics_parallel.getValue());
+}
+
 void CollisionSystem::updateObjectCollisions()
 {
-    std::unordered_set<std::shared_ptr<Object>> handledObjects;
+    //Transient containers of this update, their memory is reused by the next one
+    Ego::FrameArena& arena = Ego::FrameArena::getUpdateArena();
+    Ego::FrameUnorderedSet<std::shared_ptr<Object>> handledObjects(_currentModule->getObjectHandler().getObjectCount(),
+                                                                    Ego::FrameAllocator<std::shared_ptr<Object>>(arena));
+    Ego::FrameVector<std::shared_ptr<Object>> possibleCollisions{Ego::FrameAllocator<std::shared_ptr<Object>>(arena)};
 
     //Detect character -> character collisions
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator()) {
 
-        //Can we collide?
-        if (!object->canCollide()) {
+        //Can we collide? Sleeping objects are at rest, they are only hit by awake ones
+        if (!object->canCollide() || object->isDormant()) {
             continue;
         }
         handledObjects.insert(object);
@@ -295,7 +349,7 @@ void CollisionSystem::updateObjectCollisions()
         bool canCollideWithScenery = !object->isScenery() || object->canuseplatforms;
 
         // Check collisions to nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
+        possibleCollisions.clear();
         _currentModule->getObjectHandler().findObjects(object->getAxisAlignedBox2D(), possibleCollisions, canCollideWithScenery);
         for (const std::shared_ptr<Object> &other : possibleCollisions)
         {
@@ -320,6 +374,8 @@ void CollisionSystem::updateObjectCollisions()
 
 void CollisionSystem::updateParticleCollisions()
 {
+    Ego::FrameVector<std::shared_ptr<Object>> possibleCollisions{Ego::FrameAllocator<std::shared_ptr<Object>>(Ego::FrameArena::getUpdateArena())};
+
     //Check collisions with particles
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
@@ -339,8 +395,8 @@ void CollisionSystem::updateParticleCollisions()
         const AxisAlignedBox2f aabb2d = AxisAlignedBox2f(Point2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Point2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
 
         //Detect collisions with nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-         _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, true);
+        possibleCollisions.clear();
+        _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, true);
         for (const std::shared_ptr<Object> &object : possibleCollisions)
         {
             //Is it a valid collision?
@@ -20,6 +20,7 @@
 
 #include "idlib/idlib.hpp"
 #include "egolib/egolib.h"
+#include "egolib/game/Physics/IntegrationSchedule.hpp"
 
 //Forward declarations
 namespace Ego { class Particle; }
@@ -46,7 +47,20 @@ public:
 
     void update();
 
+    /**
+    * @brief
+    *   Integrate the movement of all Objects. Free-standing Objects are integrated in parallel,
+    *   held Objects, platform riders and the Objects they follow afterwards in iteration order.
+    **/
+    void updateObjectPhysics();
+
 private:
+    /**
+    * @brief
+    *   Integrate the accumulated accelerations and displacements of an Object
+    **/
+    void integrateAccumulators(Object& object);
+
     /**
     * @brief
     *   Detects if a collision occurs between two Objects
@@ -104,6 +118,9 @@ private:
     friend idlib::default_delete_functor<CollisionSystem>;
     CollisionSystem();
     ~CollisionSystem();
+
+    IntegrationSchedule _schedule;
+    std::vector<Object*> _objects;
 };
 
 } //namespace Physics
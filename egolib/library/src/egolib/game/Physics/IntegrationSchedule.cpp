@@ -0,0 +1,129 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Physics/IntegrationSchedule.cpp
+/// @brief Integrates independent entities in parallel and dependent entities in order.
+
+#include "egolib/game/Physics/IntegrationSchedule.hpp"
+
+namespace Ego {
+namespace Physics {
+
+/// Fewer independent entities are not worth waking up the workers.
+static constexpr size_t MIN_PARALLEL_ENTITIES = 64;
+
+IntegrationSchedule::IntegrationSchedule() :
+    _dependent(),
+    _independent(),
+    _independentCount(0),
+    _workers()
+{}
+
+IntegrationSchedule::~IntegrationSchedule()
+{}
+
+void IntegrationSchedule::reset(size_t count)
+{
+    _dependent.assign(count, false);
+    _independent.clear();
+}
+
+void IntegrationSchedule::addDependent(size_t entity)
+{
+    _dependent[entity] = true;
+}
+
+void IntegrationSchedule::addDependency(size_t entity, size_t source)
+{
+    // The source must not be integrated before entities which precede it in the list,
+    // hence both are integrated in list order.
+    _dependent[entity] = true;
+    _dependent[source] = true;
+}
+
+void IntegrationSchedule::run(const std::function<void(size_t)>& integrate, bool parallel)
+{
+    _independent.clear();
+    if (parallel) {
+        for (size_t i = 0; i < _dependent.size(); ++i) {
+            if (!_dependent[i]) _independent.push_back(i);
+        }
+    }
+    if (_independent.size() < MIN_PARALLEL_ENTITIES) {
+        _independent.clear();
+    }
+    _independentCount = _independent.size();
+
+    if (!_independent.empty()) {
+        runIndependent(integrate);
+    }
+
+    // The dependent entities (all entities if nothing ran in parallel) in list order.
+    const bool all = _independent.empty();
+    for (size_t i = 0; i < _dependent.size(); ++i) {
+        if (all || _dependent[i]) {
+            integrate(i);
+        }
+    }
+}
+
+void IntegrationSchedule::runIndependent(const std::function<void(size_t)>& integrate)
+{
+    if (!_workers) {
+        const size_t cores = std::thread::hardware_concurrency();
+        _workers = std::make_unique<ThreadPool>(cores > 1 ? cores - 1 : 1);
+    }
+
+    // One range per thread, the main thread integrates the first range while the workers integrate the others.
+    const size_t rangeSize = (_independent.size() + _workers->getThreadCount()) / (_workers->getThreadCount() + 1);
+    const size_t *data = _independent.data();
+    const size_t size = _independent.size();
+    auto integrateRange = [&integrate, data](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            integrate(data[i]);
+        }
+    };
+    std::vector<std::future<void>> results;
+    for (size_t begin = rangeSize; begin < size; begin += rangeSize) {
+        const size_t end = std::min(size, begin + rangeSize);
+        results.push_back(_workers->submit([&integrateRange, begin, end]() {
+            integrateRange(begin, end);
+        }));
+    }
+    std::exception_ptr error = nullptr;
+    try {
+        integrateRange(0, std::min(size, rangeSize));
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // Wait for all workers before propagating an exception, they reference the schedule.
+    for (auto& result : results) {
+        try {
+            result.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace Physics
+} // namespace Ego
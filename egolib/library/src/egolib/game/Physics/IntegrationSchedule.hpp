@@ -0,0 +1,93 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egolib/game/Physics/IntegrationSchedule.hpp
+/// @brief Integrates independent entities in parallel and dependent entities in order.
+
+#pragma once
+
+#include "egolib/Core/ThreadPool.hpp"
+
+namespace Ego {
+namespace Physics {
+
+/**
+ * @brief
+ *  Schedules one integration step over a list of entities.
+ *  An entity is dependent if its integration reads another entity (e.g. an item reads its holder,
+ *  a rider reads its platform) or if another entity reads it. All other entities are independent,
+ *  their integration only touches the entity itself and hence they are integrated in parallel.
+ *  The dependent entities are integrated afterwards on the calling thread in list order,
+ *  so the result is the same as integrating all entities in list order.
+ */
+class IntegrationSchedule
+{
+public:
+    IntegrationSchedule();
+    virtual ~IntegrationSchedule();
+
+    /**
+     * @brief
+     *  Start a new schedule.
+     * @param count
+     *  the number of entities. Entities are identified by their index in the list.
+     */
+    void reset(size_t count);
+
+    /**
+     * @brief
+     *  Mark an entity as dependent, e.g. because it reads an entity which is not in the list.
+     */
+    void addDependent(size_t entity);
+
+    /**
+     * @brief
+     *  Record that the integration of an entity reads another entity of the list.
+     */
+    void addDependency(size_t entity, size_t source);
+
+    /**
+     * @brief
+     *  Integrate all entities.
+     * @param integrate
+     *  the integration of an entity. Must be safe to call concurrently for independent entities.
+     * @param parallel
+     *  if @a false, all entities are integrated in list order on the calling thread
+     */
+    void run(const std::function<void(size_t)>& integrate, bool parallel);
+
+    /// @return the number of entities integrated in parallel in the last run
+    size_t getIndependentCount() const { return _independentCount; }
+
+    /// @return @a true if the entity is dependent
+    bool isDependent(size_t entity) const { return _dependent[entity]; }
+
+private:
+    /// @brief Integrate the independent entities in parallel.
+    void runIndependent(const std::function<void(size_t)>& integrate);
+
+    std::vector<bool> _dependent;
+    std::vector<size_t> _independent;
+    size_t _independentCount;
+
+    std::unique_ptr<ThreadPool> _workers;
+};
+
+} // namespace Physics
+} // namespace Ego
@@ -906,7 +906,7 @@ bool ObjectPhysics::attachToObject(const std::shared_ptr<Object> &holder, grip_o
     // Set the team
     if (_object.isItem())
     {
-        _object.team = holder->team;
+        _object.assignTeam(holder->getTeamID());
 
         // Set the alert
         if (_object.isAlive()) {
@@ -923,7 +923,7 @@ bool ObjectPhysics::attachToObject(const std::shared_ptr<Object> &holder, grip_o
 
     if (holder->isMount())
     {
-        holder->team = _object.team;
+        holder->assignTeam(_object.getTeamID());
 
         // Set the alert
         if (!holder->isItem() && holder->isAlive())
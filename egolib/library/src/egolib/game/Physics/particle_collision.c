@@ -507,7 +507,7 @@ bool do_chr_prt_collision_deflect(chr_prt_collision_data_t& pdata)
                 pdata.pprt->phys.avel -= pdata.vdiff * 2.0f;
 
                 // Change the owner of the missile
-                pdata.pprt->team       = pdata.pchr->team;
+                pdata.pprt->team       = pdata.pchr->getTeamID();
                 pdata.pprt->owner_ref  = pdata.pchr->getObjRef();
             }
         }
@@ -577,7 +577,7 @@ bool do_chr_prt_collision_deflect(chr_prt_collision_data_t& pdata)
                     // Attacker broke the block and batters away the shield
                     // Time to raise shield again = 40/50 (0.8 seconds)
                     pdata.pchr->reload_timer += 40;
-                    AudioSystem::get().playSound(pdata.pchr->getPosition(), AudioSystem::get().getGlobalSound(GSND_SHIELDBLOCK));
+                    AudioSystem::get().playSound(pdata.pchr->getPosition(), AudioSystem::get().getGlobalSound(GSND_SHIELDBLOCK), Ego::Audio::VoicePriority::Important);
                 }
             }
         }
@@ -716,7 +716,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
                         pdata.pchr->grog_timer += 2;
 
                         GFX::get().getBillboardSystem().makeBillboard(powner->getObjRef(), "Brutal Strike!", Ego::Colour4f::white(), Ego::Colour4f::red(), 3, Ego::Graphics::Billboard::Flags::All);
-                        AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT));
+                        AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT), Ego::Audio::VoicePriority::Important);
                     }
                 }
 
@@ -800,7 +800,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
                             grimReaperDamage.rand = 0.0f;
                             pdata.pchr->damage(Facing(direction), grimReaperDamage, DAMAGE_EVIL, pdata.pprt->team, _currentModule->getObjectHandler()[pdata.pprt->owner_ref], false, true, false);
                             GFX::get().getBillboardSystem().makeBillboard(powner->getObjRef(), "Grim Reaper!", Ego::Colour4f::white(), Ego::Colour4f::red(), 3, Ego::Graphics::Billboard::Flags::All);
-                            AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT));
+                            AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT), Ego::Audio::VoicePriority::Important);
                         }
                     }
                 }                
@@ -812,7 +812,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
                         //Gain +0.25 damage per Agility
                         modifiedDamage.base += FLOAT_TO_FP8(powner->getAttribute(Ego::Attribute::AGILITY) * 0.25f);
                         GFX::get().getBillboardSystem().makeBillboard(powner->getObjRef(), "Deadly Strike", Ego::Colour4f::white(), Ego::Colour4f::blue(), 3, Ego::Graphics::Billboard::Flags::All);
-                        AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT));
+                        AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT), Ego::Audio::VoicePriority::Important);
                     }
                 }
             }
@@ -847,7 +847,7 @@ bool do_chr_prt_collision_damage( chr_prt_collision_data_t& pdata )
                     modifiedDamage.base += modifiedDamage.rand;
                     modifiedDamage.rand = 0;
                     GFX::get().getBillboardSystem().makeBillboard(powner->getObjRef(), "Critical Hit!", Ego::Colour4f::white(), Ego::Colour4f::red(), 3, Ego::Graphics::Billboard::Flags::All);
-                    AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT));
+                    AudioSystem::get().playSound(powner->getPosition(), AudioSystem::get().getGlobalSound(GSND_CRITICAL_HIT), Ego::Audio::VoicePriority::Important);
                 }
             }
 
@@ -898,19 +898,19 @@ bool do_chr_prt_collision_bump( chr_prt_collision_data_t& pdata )
     }
 
     // does the particle team hate the character's team
-    bool prt_hates_chr = team_hates_team( pdata.pprt->team, pdata.pchr->team );
+    bool prt_hates_chr = team_hates_team( pdata.pprt->team, pdata.pchr->getTeamID() );
 
     // Only bump into hated characters?
     bool valid_onlydamagehate = prt_hates_chr && pdata.pprt->getProfile()->hateonly;
 
     // allow neutral particles to attack anything
     bool prt_attacks_chr = false;
-    if(prt_hates_chr || ((Team::TEAM_NULL != pdata.pchr->team) && (Team::TEAM_NULL == pdata.pprt->team)) ) {
+    if(prt_hates_chr || ((Team::TEAM_NULL != pdata.pchr->getTeamID()) && (Team::TEAM_NULL == pdata.pprt->team)) ) {
         prt_attacks_chr = (maxDamage > 0);
     }
 
     // this is the onlydamagefriendly condition from the particle search code
-    bool valid_onlydamagefriendly = (pdata.ppip->onlydamagefriendly && pdata.pprt->team == pdata.pchr->team)
+    bool valid_onlydamagefriendly = (pdata.ppip->onlydamagefriendly && pdata.pprt->team == pdata.pchr->getTeamID())
 		                         || (!pdata.ppip->onlydamagefriendly && prt_attacks_chr);
 
     // I guess "friendly fire" does not mean "self fire", which is a bit unfortunate.
@@ -1252,7 +1252,7 @@ bool do_chr_prt_collision(const std::shared_ptr<Object> &object, const std::shar
             cn_data.pprt->addCollision(_currentModule->getObjectHandler()[cn_data.pchr->getObjRef()]);
 
             //Play sound effect
-            AudioSystem::get().playSound(cn_data.pchr->getPosition(), AudioSystem::get().getGlobalSound(GSND_DODGE));
+            AudioSystem::get().playSound(cn_data.pchr->getPosition(), AudioSystem::get().getGlobalSound(GSND_DODGE), Ego::Audio::VoicePriority::Important);
 
             // Initialize for the billboard
             GFX::get().getBillboardSystem().makeBillboard( cn_data.pchr->getObjRef(), "Dodged!", Ego::Colour4f::white(), Ego::Colour4f(1.0f, 0.6f, 0.0f, 1.0f), 3, Ego::Graphics::Billboard::Flags::All);
@@ -67,8 +67,8 @@ import_list_t g_importList;
 uint32_t clock_chr_stat   = 0;
 uint32_t update_wld       = 0;
 
-int chr_stoppedby_tests = 0;
-int chr_pressure_tests = 0;
+std::atomic<int> chr_stoppedby_tests(0);
+std::atomic<int> chr_pressure_tests(0);
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -274,14 +274,7 @@ void MainLoop::move_all_objects()
     }
 
     // Move every character
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
-    {
-        if(object->isTerminated()) {
-            continue;
-        }
-        object->getObjectPhysics().updatePhysics();
-        //chr_update_matrix( object.get(), true );
-    }
+    Ego::Physics::CollisionSystem::get().updateObjectPhysics();
 }
 
 void MainLoop::updateLocalStats()
@@ -368,62 +361,49 @@ ObjectRef prt_find_target( const Ego::Vector3f& pos, Facing facing,
     /// @author ZF
     /// @details This is the new improved targeting system for particles. Also includes distance in the Z direction.
 
-    const float max_dist2 = WIDE * WIDE;
-
     std::shared_ptr<ParticleProfile> ppip;
 
-    ObjectRef besttarget = ObjectRef::Invalid;
-    float  longdist2 = max_dist2;
-
     facing = idlib::canonicalize(facing);
 
     if ( !LOADED_PIP( particletype ) ) return ObjectRef::Invalid;
     ppip = ProfileSystem::get().ParticleProfileSystem.get_ptr( particletype );
 
-    for(const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
+    const Team &particleTeam = _currentModule->getTeamList()[team];
+
+    // The nearest object in the facing cone wins
+    std::shared_ptr<Object> besttarget = _currentModule->getObjectHandler().findNearestObjectInCone(pos, facing, ppip->targetangle, WIDE,
+        [&](const std::shared_ptr<Object> &pchr)
     {
-        if ( !pchr->isAlive() || pchr->isitem || _currentModule->getObjectHandler().exists( pchr->inwhich_inventory ) ) continue;
+        if ( pchr->isTerminated() ) return false;
+
+        if ( !pchr->isAlive() || pchr->isitem || _currentModule->getObjectHandler().exists( pchr->inwhich_inventory ) ) return false;
 
         // prefer targeting riders over the mount itself
-        if ( pchr->isMount() && ( _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_LEFT] ) || _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_RIGHT] ) ) ) continue;
+        if ( pchr->isMount() && ( _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_LEFT] ) || _currentModule->getObjectHandler().exists( pchr->holdingwhich[SLOT_RIGHT] ) ) ) return false;
 
         // ignore invictus
-        if ( pchr->invictus ) continue;
+        if ( pchr->invictus ) return false;
 
         // we are going to give the player a break and not target things that
         // can't be damaged, unless the particle is homing. If it homes in,
         // the he damage_timer could drop off en route.
-        if ( !ppip->homing && ( 0 != pchr->damage_timer ) ) continue;
+        if ( !ppip->homing && ( 0 != pchr->damage_timer ) ) return false;
 
         // Don't retarget someone we already had or not supposed to target
-        if ( pchr->getObjRef() == oldtarget || pchr->getObjRef() == donttarget ) continue;
-
-        Team &particleTeam = _currentModule->getTeamList()[team];
+        if ( pchr->getObjRef() == oldtarget || pchr->getObjRef() == donttarget ) return false;
 
         bool target_friend = ppip->onlydamagefriendly && particleTeam == pchr->getTeam();
         bool target_enemy  = !ppip->onlydamagefriendly && particleTeam.hatesTeam(pchr->getTeam() );
 
-        if ( target_friend || target_enemy )
-        {
-            Facing angle = Facing(FACING_T(-facing + vec_to_facing( pchr->getPosX() - pos[kX] , pchr->getPosY() - pos[kY] )));
+        return target_friend || target_enemy;
+    });
 
-            // Only proceed if we are facing the target
-            if ( angle < Facing(ppip->targetangle) || angle > Facing( 0xFFFF - ppip->targetangle ))
-            {
-                float dist2 = idlib::squared_euclidean_norm(pchr->getPosition() - pos);
+    if ( !besttarget ) return ObjectRef::Invalid;
 
-                if ( dist2 < longdist2 && dist2 <= max_dist2 )
-                {
-                    (*targetAngle) = angle;
-                    besttarget = pchr->getObjRef();
-                    longdist2 = dist2;
-                }
-            }
-        }
-    }
+    (*targetAngle) = Facing(FACING_T(-facing + vec_to_facing( besttarget->getPosX() - pos[kX] , besttarget->getPosY() - pos[kY] )));
 
     // All done
-    return besttarget;
+    return besttarget->getObjRef();
 }
 
 //--------------------------------------------------------------------------------------------
@@ -520,83 +500,70 @@ ObjectRef chr_find_target( Object * psrc, float max_dist, const IDSZ2& idsz, con
 
     if (!psrc || psrc->isTerminated()) return ObjectRef::Invalid;
 
-    std::vector<std::shared_ptr<Object>> searchList;
-
-    //Only loop through the players
-    if ( HAS_SOME_BITS( targeting_bits, TARGET_PLAYERS ) || HAS_SOME_BITS( targeting_bits, TARGET_QUEST ) )
-    {
-        for(const std::shared_ptr<Ego::Player> &player : _currentModule->getPlayerList())
-        {
-            const std::shared_ptr<Object> &object = player->getObject();
-            if(player) {
-
-                //Within range?
-                float distance = idlib::euclidean_norm(object->getPosition() - psrc->getPosition());
-                if(max_dist == NEAREST || distance < max_dist) {
-                    searchList.push_back(object);
-                }
-
-            }
-        }
-    }
-
-    //All objects in level
-    else if(max_dist == NEAREST)
-    {
-        searchList = _currentModule->getObjectHandler().getAllObjects();
-    }
-
-    //All objects within range
-    else
-    {
-        searchList = _currentModule->getObjectHandler().findObjects(psrc->getPosX(), psrc->getPosY(), max_dist, true);
-    }
-
-
     // set the line-of-sight source
     los_info.x0         = psrc->getPosX();
     los_info.y0         = psrc->getPosY();
     los_info.z0         = psrc->getPosZ() + psrc->bump.height;
     los_info.stopped_by = psrc->stoppedby;
 
-    ObjectRef best_target = ObjectRef::Invalid;
-    float best_dist2  = (max_dist == NEAREST) ? std::numeric_limits<float>::max() : max_dist*max_dist + 1.0f;
-    for(const std::shared_ptr<Object> &ptst : searchList)
+    auto isValidTarget = [&](const std::shared_ptr<Object> &ptst)
     {
-        if(ptst->isTerminated()) continue;
+        if(ptst->isTerminated()) return false;
 
         //Skip held items
-        if(ptst->isBeingHeld()) continue;
+        if(ptst->isBeingHeld()) return false;
 
-        if (!chr_check_target(psrc, ptst, idsz, targeting_bits)) continue;
+        if (!chr_check_target(psrc, ptst, idsz, targeting_bits)) return false;
 
-		float dist2 = idlib::squared_euclidean_norm(psrc->getPosition() - ptst->getPosition());
-        if (dist2 < best_dist2)
+        //Invictus chars do not need a line of sight
+        if ( !psrc->isInvincible() )
         {
-            //Invictus chars do not need a line of sight
-            if ( !psrc->isInvincible() )
-            {
-                // set the line-of-sight source
-                los_info.x1 = ptst->getPosition()[kX];
-                los_info.y1 = ptst->getPosition()[kY];
-                los_info.z1 = ptst->getPosition()[kZ] + std::max( 1.0f, ptst->bump.height );
+            // set the line-of-sight source
+            los_info.x1 = ptst->getPosition()[kX];
+            los_info.y1 = ptst->getPosition()[kY];
+            los_info.z1 = ptst->getPosition()[kZ] + std::max( 1.0f, ptst->bump.height );
 
-                if ( line_of_sight_info_t::blocked( los_info, _currentModule->getMeshPointer() ) ) continue;
-            }
+            if ( line_of_sight_info_t::blocked( los_info, _currentModule->getMeshPointer() ) ) return false;
+        }
 
-            //Set the new best target found
-            best_target = ptst->getObjRef();
-            best_dist2  = dist2;
+        return true;
+    };
+
+    //Only loop through the players
+    if ( HAS_SOME_BITS( targeting_bits, TARGET_PLAYERS ) || HAS_SOME_BITS( targeting_bits, TARGET_QUEST ) )
+    {
+        ObjectRef best_target = ObjectRef::Invalid;
+        float best_dist2  = (max_dist == NEAREST) ? std::numeric_limits<float>::max() : max_dist*max_dist + 1.0f;
+        for(const std::shared_ptr<Ego::Player> &player : _currentModule->getPlayerList())
+        {
+            if(!player) continue;
+            const std::shared_ptr<Object> &ptst = player->getObject();
+
+            float dist2 = idlib::squared_euclidean_norm(psrc->getPosition() - ptst->getPosition());
+            if (dist2 < best_dist2 && isValidTarget(ptst))
+            {
+                //Set the new best target found
+                best_target = ptst->getObjRef();
+                best_dist2  = dist2;
+            }
         }
+        return best_target;
     }
 
-    return best_target;
+    //The nearest valid object, candidates are checked closest first
+    const float searchDistance = (max_dist == NEAREST) ? std::numeric_limits<float>::infinity() : max_dist;
+    std::shared_ptr<Object> best_target = _currentModule->getObjectHandler().findNearestObject(psrc->getPosition(), searchDistance, isValidTarget);
+
+    return best_target ? best_target->getObjRef() : ObjectRef::Invalid;
 }
 
 //--------------------------------------------------------------------------------------------
 void MainLoop::readPlayerInput()
 {
-    for(const std::shared_ptr<Ego::Player>& player : _currentModule->getPlayerList()) {
+    Ego::ReplaySystem& replay = Ego::ReplaySystem::get();
+    const auto& players = _currentModule->getPlayerList();
+    for(size_t ipla = 0; ipla < players.size(); ++ipla) {
+        const std::shared_ptr<Ego::Player>& player = players[ipla];
 
         //Only valid players
         const std::shared_ptr<Object> &pchr = player->getObject();
@@ -604,12 +571,25 @@ void MainLoop::readPlayerInput()
             continue;
         }
 
-        //Read input from the device controlling the player into object latches
-        player->updateLatches();
+        //Read input from the device controlling the player (or from the replay) into object latches
+        Ego::PlayerInput input;
+        if(replay.isPlaying()) {
+            if(!replay.getPlayerInput(uint8_t(ipla), input)) {
+                continue;
+            }
+        }
+        else {
+            input = player->readInput();
+            input.setFlag(Ego::PlayerInput::Respawn, Ego::Input::InputSystem::get().isKeyDown(SDLK_SPACE));
+            if(replay.isRecording()) {
+                replay.recordPlayerInput(uint8_t(ipla), input);
+            }
+        }
+        player->updateLatches(input);
 
         //Press space to respawn!
         bool respawnRequested = false;
-        if (Ego::Input::InputSystem::get().isKeyDown(SDLK_SPACE)
+        if (input.hasFlag(Ego::PlayerInput::Respawn)
             && (local_stats.allpladead || _currentModule->canRespawnAnyTime())
             && _currentModule->isRespawnValid()
             && egoboo_config_t::get().game_difficulty.getValue() < Ego::GameDifficulty::Hard)
@@ -623,7 +603,7 @@ void MainLoop::readPlayerInput()
             if (!pchr->isAlive() && 0 == local_stats.revivetimer)
             {
                 pchr->respawn();
-                _currentModule->getTeamList()[pchr->team].setLeader(pchr);
+                _currentModule->getTeamList()[pchr->getTeamID()].setLeader(pchr);
                 SET_BIT(pchr->ai.alert, ALERTIF_CLEANEDUP);
 
                 // cost some experience for doing this...  never lose a level
@@ -940,6 +920,11 @@ void game_quit_module()
     /// @author BB
     /// @details all of the de-initialization code after the module actually ends
 
+    // a recording ends with its module
+    if (Ego::ReplaySystem::get().isRecording()) {
+        Ego::ReplaySystem::get().stop();
+    }
+
     // stop the module
     _currentModule.reset(nullptr);
 
@@ -964,8 +949,9 @@ bool game_begin_module(const std::shared_ptr<ModuleProfile> &module)
     /// @author BB
     /// @details all of the initialization code before the module actually starts
 
-    // start the module
-    _currentModule = std::make_unique<GameModule>(module, time(NULL));
+    // start the module, a replay must start with the seed it was recorded with
+    const uint32_t seed = Ego::ReplaySystem::get().isPlaying() ? Ego::ReplaySystem::get().getHeader().seed : uint32_t(time(NULL));
+    _currentModule = std::make_unique<GameModule>(module, seed);
 
     //After loading, spawn all the data and initialize everything (spawn.txt)
     //Due to dependency on the global _currentModule, we cannot do this in the constructor above
@@ -1007,7 +993,7 @@ void MainLoop::let_all_characters_think()
     /// @details This function funst the ai scripts for all eligible objects
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
     {
-        if(object->isTerminated()) {
+        if(object->isTerminated() || object->isDormant()) {
             continue;
         }
 
@@ -48,11 +48,14 @@
 #include "egolib/game/mesh.h"
 #include "egolib/game/Graphics/DefaultMd2ModelRenderer.hpp"
 #include "egolib/game/Graphics/BillboardSystem.hpp"
+#include "egolib/game/Graphics/TransformSystem.hpp"
 #include "egolib/game/Graphics/CameraSystem.hpp"
+#include "egolib/Core/AllocationCounter.hpp"
 #include "egolib/Entities/_Include.hpp"
 #include "egolib/game/Graphics/TextureAtlasManager.hpp"
 #include "egolib/game/Module/Passage.hpp"
 #include "egolib/game/GUI/Material.hpp"
+#include "egolib/game/GUI/SpriteBatch.hpp"
 
 //--------------------------------------------------------------------------------------------
 
@@ -73,8 +76,7 @@ Clock<ClockPolicy::NonRecursive> sortDoListReflected_timer("render.sortDoListRef
 Clock<ClockPolicy::NonRecursive>  render_scene_init_timer("render.scene.init", 512);
 Clock<ClockPolicy::NonRecursive>  render_scene_mesh_timer("render.scene.mesh", 512);
 
-Clock<ClockPolicy::NonRecursive>  gfx_make_tileList_timer("gfx.make.tileList", 512);
-Clock<ClockPolicy::NonRecursive>  gfx_make_entityList_timer("gfx.make.entityList", 512);
+Clock<ClockPolicy::NonRecursive>  gfx_make_renderLists_timer("gfx.make.renderLists", 512);
 Clock<ClockPolicy::NonRecursive>  do_grid_lighting_timer("do.grid.lighting", 512);
 Clock<ClockPolicy::NonRecursive>  light_fans_timer("light.fans", 512);
 
@@ -94,8 +96,7 @@ void reinitClocks() {
 	render_scene_init_timer.reinit();
 	render_scene_mesh_timer.reinit();
 
-	gfx_make_tileList_timer.reinit();
-	gfx_make_entityList_timer.reinit();
+	gfx_make_renderLists_timer.reinit();
 	do_grid_lighting_timer.reinit();
 	light_fans_timer.reinit();
 	GFX::get().update_object_instances_timer.reinit();
@@ -116,6 +117,20 @@ void reinitClocks() {
 static gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam);
 static gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el);
 
+/**
+ * @brief
+ *  The world state the render lists of all cameras are built from.
+ *  Captured on the main thread once per frame. The simulation does not run while
+ *  the render lists are built, so the lists of several cameras can be built concurrently.
+ */
+struct RenderListSnapshot
+{
+    std::shared_ptr<ego_mesh_t> mesh;
+    float waterLevel;
+    /// The particles. Iterating the particle handler is not thread-safe.
+    std::vector<std::shared_ptr<Ego::Particle>> particles;
+};
+
 /**
  * @brief
  *  Find characters that need to be drawn and put them in the list.
@@ -124,8 +139,8 @@ static gfx_rv render_scene(Camera& cam, Ego::Graphics::TileList& tl, Ego::Graphi
  * @param camera
  *	the camera
  */
-static gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& camera);
-static gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& camera);
+static gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& camera, const RenderListSnapshot& snapshot);
+static gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& camera, const RenderListSnapshot& snapshot);
 static gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& camera);
 
 static float draw_fps(float y);
@@ -297,7 +312,7 @@ void draw_blip(float sizeFactor, uint8_t color, float x, float y)
         height = sizeFactor * (bliprect[color]._bottom - bliprect[color]._top);
 
         auto sc_rect = Ego::Rectangle2f(Ego::Point2f(x - (width / 2), y - (height / 2)), Ego::Point2f(x + (width / 2), y + (height / 2)));
-        _gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<Ego::GUI::Material>(ptex, Ego::Colour4f::white(), true));
+        _gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, ptex);
     }
 }
 
@@ -339,7 +354,7 @@ float draw_icon_texture(const std::shared_ptr<const Ego::Texture>& ptex, float x
     }
 
     auto sc_rect = Ego::Rectangle2f(Ego::Point2f(x, y), Ego::Point2f(x + width, y + height));
-    _gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, std::make_shared<const Ego::GUI::Material>(ptex, Ego::Colour4f::white(), true));
+    _gameEngine->getUIManager()->drawQuad2D(sc_rect, tx_rect, ptex);
 
     if (NOSPARKLE != sparkle_color)
     {
@@ -403,6 +418,31 @@ float draw_fps(float y)
         if (egoboo_config_t::get().debug_developerMode_enable.getValue())
         {
 			/** @todo This should be made available through the GUI. Too much information just to print out things on screen. */
+            const auto& statistics = _gameEngine->getUIManager()->getSpriteBatch().getStatistics();
+            os.str(std::string());
+            os << "~~UI " << statistics.drawCalls << " draw calls, " << statistics.quads << " quads";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0.0f, 1.0f);
+
+            const auto& transforms = GFX::get().getTransformSystem().getStatistics();
+            os.str(std::string());
+            os << "~~MAT " << transforms.matrixUpdates << "/" << transforms.objects << " updates, "
+               << transforms.levels << " levels, " << std::setprecision(3) << transforms.milliseconds << " ms";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0.0f, 1.0f);
+
+            const auto& updateTimes = _gameEngine->getUpdateTimes();
+            os.str(std::string());
+            os << "~~UPD p50 " << updateTimes.getPercentile(0.5) << " us, p99 " << updateTimes.getPercentile(0.99)
+               << " us, max " << updateTimes.getMax() << " us";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0.0f, 1.0f);
+
+            os.str(std::string());
+            os << "~~MEM arena " << Ego::FrameArena::getUpdateArena().getHighWaterMark() / 1024 << "/"
+               << Ego::FrameArena::getRenderArena().getHighWaterMark() / 1024 << " KiB";
+            if (Ego::AllocationCounter::isAvailable())
+            {
+                os << ", " << _gameEngine->getUpdateAllocations() << "/" << _gameEngine->getRenderAllocations() << " allocs";
+            }
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0.0f, 1.0f);
         }
     }
 
@@ -507,11 +547,24 @@ float draw_debug(float y)
         os.str(std::string()); os << "~~FREECHR: " << OBJECTS_MAX - _currentModule->getObjectHandler().getObjectCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
 
+        const auto& dormancy = _currentModule->getDormancySystem().getStatistics();
+        os.str(std::string()); os << "~~ACTIVE:  " << dormancy.active << " active, " << dormancy.dormant << " dormant, "
+                                  << dormancy.wokenUp << " woken";
+        y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
+
         os.str(std::string()); os << "~~EXPORT:  " << (_currentModule->isExportValid() ? "TRUE" : "FALSE");
         y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
 
         os.str(std::string()); os << "~~PASS:    " << _currentModule->getPassageCount();
         y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
+
+        for (const auto& camera : CameraSystem::get().getCameraList())
+        {
+            const auto& statistics = camera->getTileList()->getCullingCache().getStatistics();
+            os.str(std::string()); os << "~~TILES:   " << statistics.visibleTiles << " visible, "
+                                      << statistics.visibleNodes << "/" << statistics.testedNodes << " nodes visible/tested";
+            y = _gameEngine->getUIManager()->drawBitmapFontString(Ego::Vector2f(0, y), os.str(), 0, 1.0f);
+        }
     }
 
     if (Ego::Input::InputSystem::get().isKeyDown(SDLK_F7))
@@ -671,19 +724,47 @@ void draw_mouse_cursor()
 //--------------------------------------------------------------------------------------------
 // render_scene FUNCTIONS
 //--------------------------------------------------------------------------------------------
-gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam)
+void gfx_system_make_renderLists()
 {
-    // assume the best;
-    gfx_rv retval = gfx_success;
+    ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_renderLists_timer);
+
+    RenderListSnapshot snapshot;
+    snapshot.mesh = _currentModule->getMeshPointer();
+    if (!snapshot.mesh)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "no mesh");
+    }
+    // Water is drawn above the tiles, so the tiles are culled as if they were raised to the water level.
+    snapshot.waterLevel = _currentModule->getWater().get_level();
+    for (const std::shared_ptr<Ego::Particle>& particle : ParticleHandler::get().iterator())
+    {
+        particle->inst.indolist = false;
+        snapshot.particles.push_back(particle);
+    }
 
+    // Build the lists of all cameras. This does not modify any state shared by the cameras.
+    CameraSystem::get().buildAll([&snapshot](std::shared_ptr<Camera> camera, std::shared_ptr<Ego::Graphics::TileList> tl, std::shared_ptr<Ego::Graphics::EntityList> el)
     {
-		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_tileList_timer);
         // Which tiles can be displayed
-        if (gfx_error == gfx_make_tileList(tl, cam))
+        if (gfx_error == gfx_make_tileList(*tl, *camera, snapshot))
         {
-            retval = gfx_error;
+            throw idlib::runtime_error(__FILE__, __LINE__, "unable to make tile list");
         }
+        // determine which objects are visible
+        gfx_make_entityList(*el, *camera, snapshot);
+    });
+
+    // Apply the side effects of the lists to the shared state.
+    for (const auto& camera : CameraSystem::get().getCameraList())
+    {
+        camera->getEntityList()->markParticles();
     }
+}
+
+gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList& el, dynalist_t& dyl, Camera& cam)
+{
+    // assume the best;
+    gfx_rv retval = gfx_success;
 
     auto mesh = tl.getMesh();
     if (!mesh)
@@ -691,14 +772,9 @@ gfx_rv render_scene_init(Ego::Graphics::TileList& tl, Ego::Graphics::EntityList&
 		throw idlib::runtime_error(__FILE__, __LINE__, "tile list is not attached to a mesh");
     }
 
-    {
-		ClockScope<ClockPolicy::NonRecursive> scope(gfx_make_entityList_timer);
-        // determine which objects are visible
-        if (gfx_error == gfx_make_entityList(el, cam))
-        {
-            retval = gfx_error;
-        }
-    }
+    // The tile list was built by gfx_system_make_renderLists().
+    // Force a lighting update of the tiles which just became visible.
+    tl.invalidateNewTiles();
 
     // put off sorting the entity list until later
     // because it has to be sorted differently for reflected and non-reflected objects
@@ -1152,6 +1228,8 @@ void gfx_do_clear_screen()
 void gfx_do_flip_pages()
 {
     Ego::Core::Console::get().draw();
+    _gameEngine->getUIManager()->endFrame();
+    GFX::get().getTransformSystem().endFrame();
     SDL_GL_SwapWindow(Ego::GraphicsSystem::get().window->get());
 }
 
@@ -1877,47 +1955,27 @@ gfx_rv GridIllumination::do_grid_lighting(Ego::Graphics::TileList& tl, dynalist_
     return gfx_success;
 }
 //--------------------------------------------------------------------------------------------
-gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
+gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam, const RenderListSnapshot& snapshot)
 {
-	// @a true if clipping is enabled, @a false otherwise.
-	static const bool clippingEnabled = true;
-
-    // Because the main loop of the program will always flip the
-    // page before rendering the 1st frame of the actual game,
-    // _gameEngine->getNumberOfFramesRendered() will always start at 1
-    if (1 != (_gameEngine->getNumberOfFramesRendered() & 3))
+    const auto& mesh = snapshot.mesh;
+    if (!mesh || !mesh->_tileTree)
     {
-        return gfx_success;
+        return gfx_error;
     }
 
     // reset the renderlist
     tl.reset();
 
-    // get the tiles in the center of the view (TODO: calculate actual tile view from camera frustrum)
-	int startX, startY, endX, endY;
-	if (clippingEnabled)
-	{
-		static const float offset = 10;
-		float centerX = cam.getTrackPosition()[kX] / Info<float>::Grid::Size();
-		float centerY = cam.getTrackPosition()[kY] / Info<float>::Grid::Size();
-		startX = Ego::Math::constrain<int>(centerX - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		startY = Ego::Math::constrain<int>(centerY - offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-		endX = Ego::Math::constrain<int>(centerX + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountX());
-		endY = Ego::Math::constrain<int>(centerY + offset, 0, _currentModule->getMeshPointer()->_info.getTileCountY());
-	}
-	else
-	{
-		startX = 0;
-		startY = 0;
-		endX = _currentModule->getMeshPointer()->_info.getTileCountX();
-		endY = _currentModule->getMeshPointer()->_info.getTileCountY();
-	}
-    for(size_t x = startX; x < endX; ++x) {
-        for(size_t y = startY; y < endY; ++y) {
-            if (gfx_error == tl.add(x + y * _currentModule->getMeshPointer()->_info.getTileCountX(), cam))
-            {
-                return gfx_error;
-            }        
+    // Which tiles are in the view frustum? Water is drawn above the tiles, so raise the tiles to the water level.
+    // If the camera did not move, the tiles of the last frame are reused.
+    auto& cache = tl.getCullingCache();
+    mesh->_tileTree->cull(cam.getFrustum(), snapshot.waterLevel, cache);
+
+    for (const Index1D& index : cache.getVisibleTiles())
+    {
+        if (gfx_error == tl.add(index, cam))
+        {
+            return gfx_error;
         }
     }
 
@@ -1925,24 +1983,29 @@ gfx_rv gfx_make_tileList(Ego::Graphics::TileList& tl, Camera& cam)
 }
 
 //--------------------------------------------------------------------------------------------
-gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& cam)
+gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& cam, const RenderListSnapshot& snapshot)
 {
     // Remove all entities from the entity list.
     el.clear();
 
-    // collide the characters with the frustum
-    std::vector<std::shared_ptr<Object>> visibleObjects = 
-        _currentModule->getObjectHandler().findObjects(
-            cam.getCenter()[kX], 
-            cam.getCenter()[kY], 
-			Info<float>::Grid::Size() * 10,  //@todo: use camera view size here instead
-            true);
+    // collide the characters with the frustum: the candidates are the objects above the visible tiles
+    // (plus a margin of two tiles for objects standing at the edge), the entity list tests them against the frustum
+    const auto& tileCache = cam.getTileList()->getCullingCache();
+    std::vector<std::shared_ptr<Object>> visibleObjects;
+    if (!tileCache.getVisibleTiles().empty())
+    {
+        const auto& bounds = tileCache.getVisibleBounds();
+        const float margin = Info<float>::Grid::Size() * 2;
+        const Ego::AxisAlignedBox2f area(Ego::Point2f(bounds.get_min().x() - margin, bounds.get_min().y() - margin),
+                                         Ego::Point2f(bounds.get_max().x() + margin, bounds.get_max().y() + margin));
+        _currentModule->getObjectHandler().findObjects(area, visibleObjects, true);
+    }
 
     for(const std::shared_ptr<Object> object : visibleObjects) {
         el.add(cam, *object.get());
     }
 
-    for(const std::shared_ptr<Ego::Particle> particle : ParticleHandler::get().iterator()) {
+    for(const std::shared_ptr<Ego::Particle>& particle : snapshot.particles) {
         el.add(cam, *particle.get());
     }
 
@@ -2007,7 +2070,7 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
 {
     gfx_rv retval;
 
-    if (el.getSize() >= Ego::Graphics::EntityList::CAPACITY)
+    if (el.getAll().size() >= Ego::Graphics::EntityList::CAPACITY)
     {
         Log::Entry e(Log::Level::Error, __FILE__, __LINE__);
         e << "invalid entity list size" << Log::EndOfEntry;
@@ -2016,11 +2079,12 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
     }
 
     retval = gfx_success;
-    for (size_t i = 0, n = el.getSize(); i < n; ++i)
+    // The entity list is not sorted yet.
+    for (const auto& element : el.getAll())
     {
         float tmp_seekurse_level;
 
-        ObjectRef iobj = el.get(i).iobj;
+        ObjectRef iobj = element.iobj;
 
         const std::shared_ptr<Object> &object = _currentModule->getObjectHandler()[iobj];
         if (!object) continue;
@@ -2053,11 +2117,8 @@ gfx_rv gfx_update_flashing(Ego::Graphics::EntityList& el)
 //--------------------------------------------------------------------------------------------
 gfx_rv GFX::update_object_instances(Camera& cam)
 {
-    gfx_rv retval;
-
-    // assume the best
-    retval = gfx_success;
-
+    std::vector<std::shared_ptr<Object>> objects;
+    auto mesh = _currentModule->getMeshPointer();
     for (const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
     {
         //Dont do terminated characters
@@ -2066,19 +2127,16 @@ gfx_rv GFX::update_object_instances(Camera& cam)
         }
 
         //Skip objects outside the map
-		auto mesh = _currentModule->getMeshPointer();
         if (!mesh->grid_is_valid(pchr->getTile())) continue;
 
-        // make sure that the vertices are interpolated
-        if(pchr->inst.updateVertices(-1, -1, true) == gfx_error) {
-            retval = gfx_error;
-        }
+        objects.push_back(pchr);
+    }
 
-        // the instance has changed, refresh the collision bound
-        else {
-            pchr->getObjectPhysics().updateCollisionSize(true);            
-        }
+    // interpolate the vertices and refresh the matrices and collision bounds, holders before held items
+    gfx_rv retval = getTransformSystem().update(objects);
 
+    for (const std::shared_ptr<Object> &pchr : objects)
+    {
         // do the basic lighting
         pchr->inst.updateLighting();
     }
@@ -2187,7 +2245,8 @@ gfx_rv GFX::update_particle_instances(Camera& camera)
 GameAppImpl::GameAppImpl() :
     dynalist(),
     billboardSystem(std::make_unique<Ego::Graphics::BillboardSystem>()),
-    md2ModelRenderer(std::make_unique<Ego::Graphics::DefaultMd2ModelRenderer>())
+    md2ModelRenderer(std::make_unique<Ego::Graphics::DefaultMd2ModelRenderer>()),
+    transformSystem(std::make_unique<Ego::Graphics::TransformSystem>())
 {
     // Initialize the texture atlas manager.
     try
@@ -2220,3 +2279,8 @@ Ego::Graphics::Md2ModelRenderer& GameAppImpl::getMd2ModelRenderer() const
 {
     return *md2ModelRenderer;
 }
+
+Ego::Graphics::TransformSystem& GameAppImpl::getTransformSystem() const
+{
+    return *transformSystem;
+}
@@ -33,6 +33,7 @@ namespace Ego {
 namespace Graphics {
 class BillboardSystem;
 class Md2ModelRenderer;
+class TransformSystem;
 struct RenderPass;
 struct TileList;
 struct EntityList;
@@ -142,12 +143,14 @@ private:
     dynalist_t dynalist;
     std::unique_ptr<Ego::Graphics::BillboardSystem> billboardSystem;
     std::unique_ptr<Ego::Graphics::Md2ModelRenderer> md2ModelRenderer;
+    std::unique_ptr<Ego::Graphics::TransformSystem> transformSystem;
 public:
     GameAppImpl();
     ~GameAppImpl();
     dynalist_t& getDynalist();
     Ego::Graphics::BillboardSystem& getBillboardSystem() const;
     Ego::Graphics::Md2ModelRenderer& getMd2ModelRenderer() const;
+    Ego::Graphics::TransformSystem& getTransformSystem() const;
 };
 
 template <typename T>
@@ -174,6 +177,10 @@ public:
     {
         return impl->getMd2ModelRenderer();
     }
+    Ego::Graphics::TransformSystem& getTransformSystem() const
+    {
+        return impl->getTransformSystem();
+    }
 };
 
 struct GFX : public GameApp<GFX>
@@ -277,6 +284,10 @@ void gfx_system_init_all_graphics();
 void gfx_system_release_all_graphics();
 void gfx_system_load_assets();
 
+/// Build the tile and entity lists of all cameras (concurrently if there are several cameras).
+/// Must be called before CameraSystem::renderAll(gfx_system_render_world).
+void gfx_system_make_renderLists();
+
 // the render engine callback
 void gfx_system_render_world(const std::shared_ptr<Camera> camera, std::shared_ptr<Ego::Graphics::TileList> tl, std::shared_ptr<Ego::Graphics::EntityList> el);
 
@@ -26,6 +26,7 @@
 #include "egolib/game/physics.h"
 #include "egolib/game/Physics/PhysicalConstants.hpp"
 #include "egolib/game/graphic.h"
+#include "egolib/game/Graphics/TileQuadTree.hpp"
 #include "egolib/FileFormats/Globals.hpp"
 #include "egolib/game/game.h"
 #include "egolib/game/Module/Module.hpp"
@@ -39,7 +40,7 @@ const std::shared_ptr<ego_tile_info_t> ego_tile_info_t::NULL_TILE = nullptr;
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
-MeshStats g_meshStats;
+thread_local MeshStats g_meshStats;
 
 static void warnNumberOfVertices(const char *file, int line, size_t numberOfVertices)
 {
@@ -1272,7 +1273,7 @@ BIT_FIELD ego_mesh_t::hit_wall(const Ego::Vector3f& pos, const float radius, con
 }
 
 ego_mesh_t::ego_mesh_t(const Ego::MeshInfo& mesh_info)
-	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info) {
+	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info), _tileTree() {
 }
 
 ego_mesh_t::~ego_mesh_t() {
@@ -1352,6 +1353,9 @@ void ego_mesh_t::finalize()
 	make_bbox();
 	make_texture();
 
+	// build the culling quadtree from the tile bounding boxes
+	_tileTree = std::make_unique<Ego::Graphics::TileQuadTree>(*this);
+
 	// create some lists to make searching the mesh tiles easier
 	_fxlists.synch(_tmem, true);
 }
@@ -33,6 +33,9 @@ namespace Ego {
 namespace OpenGL {
 struct Texture;
 } // namespace OpenGL
+namespace Graphics {
+struct TileQuadTree;
+} // namespace Graphics
 } // namespace Ego
 
 //--------------------------------------------------------------------------------------------
@@ -387,6 +390,8 @@ public:
     Ego::MeshInfo _info;
     tile_mem_t _tmem;
     mpdfx_lists_t _fxlists;
+    /// The quadtree used for culling the tiles against the view frustum, built by finalize().
+    std::unique_ptr<Ego::Graphics::TileQuadTree> _tileTree;
 
     Ego::Vector3f get_diff(const Ego::Vector3f& pos, float radius, float center_pressure, const BIT_FIELD bits);
     float get_pressure(const Ego::Vector3f& pos, float radius, const BIT_FIELD bits) const;
@@ -516,7 +521,8 @@ struct MeshStats {
 };
 
 // Those are statistics. Move into per-mesh statistics.
-extern MeshStats g_meshStats;
+// Per thread as objects test against the mesh concurrently.
+extern thread_local MeshStats g_meshStats;
 
 //--------------------------------------------------------------------------------------------
 
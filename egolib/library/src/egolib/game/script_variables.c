@@ -468,7 +468,7 @@ int32_t load_VARTARGETMAXLIFE(script_state_t& scriptState, ai_state_t& aiState,
 
 int32_t load_VARTARGETTEAM(script_state_t& scriptState, ai_state_t& aiState, Object *pobject, Object *ptarget, Object *powner, Object *pleader)
 {
-    return (nullptr == ptarget) ? 0 : ptarget->team;
+    return (nullptr == ptarget) ? 0 : ptarget->getTeamID();
 }
 
 int32_t load_VARTARGETARMOR(script_state_t& scriptState, ai_state_t& aiState, Object *pobject, Object *ptarget, Object *powner, Object *pleader)
@@ -22,6 +22,12 @@
 /// @details
 
 #include <physfs.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "egolib/vfs.h"
 
@@ -32,6 +38,7 @@
 #include "egolib/endian.h"
 #include "egolib/fileutil.h"
 #include "egolib/Core/StringUtilities.hpp"
+#include "egolib/VFS/PackArchive.hpp"
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
@@ -87,14 +94,23 @@ typedef enum vfs_file_type
     VFS_FILE_TYPE_UNKNOWN = 0,
     VFS_FILE_TYPE_CSTDIO,
     VFS_FILE_TYPE_PHYSFS,
+    VFS_FILE_TYPE_MEMORY,
 } vfs_file_type;
 
+/// A file of a pack archive. It is read into memory when it is opened.
+struct vfs_memory_file_t
+{
+    std::vector<char> data;
+    size_t position;
+};
+
 /// An anonymized pointer type
 typedef union vfs_fileptr_t
 {
     void *u;
     FILE *c;
     PHYSFS_File *p;
+    vfs_memory_file_t *m;
 } vfs_file_ptr_t;
 
 /// A container holding either a FILE * or a PHYSFS_File *, and translated error states
@@ -140,6 +156,57 @@ static std::vector<vfs_path_data_t> _vfs_mount_infos;
 static bool _vfs_atexit_registered = false;
 static bool _vfs_initialized = false;
 
+/// What is known about a normalised VFS path. Filled lazily, one PhysFS call per property.
+struct vfs_index_entry_t
+{
+    bool exists;
+    /// -1 if not known yet, 0 if a file, 1 if a directory.
+    int isDirectory;
+    bool hasRealDirectory;
+    /// The search path entry the path resolves to, the pack file if the path is in a pack file.
+    std::string realDirectory;
+    /// The pack file and the entry if the path is a file in a pack file.
+    std::shared_ptr<Ego::PackArchive> archive;
+    const Ego::PackArchive::Entry *packEntry;
+};
+
+/// An entry of the search path: a directory searched by PhysFS or a pack file mounted instead of a directory.
+struct vfs_search_path_entry_t
+{
+    /// The mount point, without leading slashes.
+    std::string mount;
+    /// The directory mounted in PhysFS or the directory the pack file replaces.
+    std::string directory;
+    /// The pack file, @a nullptr if PhysFS searches the directory.
+    std::shared_ptr<Ego::PackArchive> archive;
+};
+
+/// Where a path was found in the search path.
+struct vfs_real_directory_t
+{
+    bool found;
+    /// Is the path in a pack file? The directory is the pack file then, which can not be opened as a directory.
+    bool packed;
+    std::string directory;
+};
+
+/// The extension of pack files. A pack file <c>objects.egopak</c> is mounted instead of the directory <c>objects</c>.
+static const std::string VFS_PACK_EXTENSION = ".egopak";
+
+/// The index of lookups in the search path. Profile loading probes the same paths (and every
+/// image extension for every texture) over and over, each probe walking all search path entries.
+/// The index is cleared if the search path changes or if something is written through the vfs.
+static std::mutex _vfs_index_mutex;
+static std::unordered_map<std::string, vfs_index_entry_t> _vfs_index;
+static std::atomic<size_t> _vfs_physfs_calls(0);
+static std::atomic<size_t> _vfs_index_hits(0);
+/// The entries mounted by vfs_add_mount_point() in the order PhysFS searches them, guarded by the index mutex.
+/// Loose directories and pack files share this order, whatever is mounted first overrides the rest.
+/// The base search paths are mounted at the root and never contain a mount point, they are not listed.
+static std::vector<vfs_search_path_entry_t> _vfs_search_path;
+/// Incremented whenever a mount point is added or removed.
+static std::atomic<uint32_t> _vfs_mount_generation(0);
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -155,6 +222,16 @@ static int _vfs_mount_info_matches(const Ego::VfsPath& mountPoint, const std::st
 static bool _vfs_mount_info_remove(int cnt);
 static int _vfs_mount_info_search(const std::string& pathname);
 
+static vfs_index_entry_t& _vfs_index_lookup(const std::string& pathname);
+static bool _vfs_index_exists(const std::string& pathname);
+static bool _vfs_index_isDirectory(const std::string& pathname);
+static vfs_real_directory_t _vfs_index_getRealDirectory(const std::string& pathname);
+
+static bool _vfs_search_path_getName(const vfs_search_path_entry_t& searchPathEntry, const std::string& pathname, std::string& name);
+static bool _vfs_pack_find(const std::string& pathname, vfs_index_entry_t& entry);
+static vfs_FILE *_vfs_pack_openRead(const Ego::PackArchive& archive, const Ego::PackArchive::Entry& entry);
+static size_t _vfs_memory_read(vfs_FILE& file, void *buffer, size_t size);
+
 
 static int fake_physfs_vprintf(PHYSFS_File *file, const char *format, va_list args);
 
@@ -273,7 +350,23 @@ vfs_FILE *vfs_openRead(const std::string& pathname)
     if (!validate(pathname,temporary)) {
         return nullptr;
     }
+    // Do not bother PhysFS if the file is known not to exist.
+    std::shared_ptr<Ego::PackArchive> archive;
+    const Ego::PackArchive::Entry *packEntry = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_vfs_index_mutex);
+        const vfs_index_entry_t& entry = _vfs_index_lookup(temporary);
+        if (!entry.exists) {
+            return nullptr;
+        }
+        archive = entry.archive;
+        packEntry = entry.packEntry;
+    }
+    if (packEntry) {
+        return _vfs_pack_openRead(*archive, *packEntry);
+    }
 
+    _vfs_physfs_calls++;
     PHYSFS_File *ftmp = PHYSFS_openRead(temporary.c_str());
     if (!ftmp)
     {
@@ -315,6 +408,7 @@ vfs_FILE *vfs_openWrite(const std::string& pathname)
 
     // Open the PhysFS file.
     PHYSFS_File *ftmp = PHYSFS_openWrite(temporary.c_str());
+    vfs_invalidateIndex();
     if (!ftmp)
     {
     #if defined(_DEBUG) && defined(_VFS_DEBUG)
@@ -348,6 +442,7 @@ vfs_FILE *vfs_openAppend(const std::string& pathname)
     }
 
     PHYSFS_File *ftmp = PHYSFS_openAppend(temporary.c_str());
+    vfs_invalidateIndex();
     if (!ftmp)
     {
     #if defined(_DEBUG) && defined(_VFS_DEBUG)
@@ -427,12 +522,23 @@ std::pair<bool, std::string> vfs_resolveReadFilename( const std::string& filenam
     filename_specific = vfs_convert_fname(Ego::VfsPath(filename_specific)).string();
 
     // If the specified filename denotes an existing file or directory, then this file or directory must have a containing directory.
-    const char *prefix = PHYSFS_getRealDir(filename_specific.c_str());
-    if (nullptr == prefix) {
+    const vfs_real_directory_t realDirectory = _vfs_index_getRealDirectory(filename_specific);
+    if (!realDirectory.found) {
         return std::make_pair(false, filename);
     }
+    const std::string& prefix = realDirectory.directory;
+    if (realDirectory.packed) {
+        // A packed file or directory resolves to the pack file followed by its name in the pack file.
+        // Only the vfs can open it.
+        auto suffix = vfs_mount_info_strip_path(filename_specific.c_str());
+        if (suffix.first) {
+            return std::make_pair(true, (Ego::VfsPath(prefix) + Ego::VfsPath(suffix.second)).string(Ego::VfsPath::Kind::System));
+        } else {
+            return std::make_pair(true, prefix);
+        }
+    }
     // The specified filename denotes an existing file or directory.
-    if (PHYSFS_isDirectory(filename_specific.c_str())) {
+    if (_vfs_index_isDirectory(filename_specific)) {
         // If it denotes a directory then it must be splittable into a prefix and a suffix.
         auto suffix = vfs_mount_info_strip_path(filename_specific.c_str());
         if (suffix.first) {
@@ -553,6 +659,11 @@ int vfs_close(vfs_FILE *file)
         retval = PHYSFS_close(file->ptr.p);
 		delete file;
     }
+    else if (VFS_FILE_TYPE_MEMORY == file->type)
+    {
+        delete file->ptr.m;
+        delete file;
+    }
     else
     {
         // corrupted data?
@@ -609,6 +720,10 @@ int vfs_eof( vfs_FILE * pfile )
     {
         retval = PHYSFS_eof( pfile->ptr.p );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == pfile->type )
+    {
+        retval = pfile->ptr.m->position >= pfile->ptr.m->data.size();
+    }
 
     if ( 0 != retval )
     {
@@ -637,6 +752,10 @@ int vfs_error( vfs_FILE * pfile )
         retval = VFS_FILE_FLAG_ERROR == (pfile->flags & VFS_FILE_FLAG_ERROR);
         //retval = ( NULL != PHYSFS_getLastError() );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == pfile->type )
+    {
+        retval = VFS_FILE_FLAG_ERROR == (pfile->flags & VFS_FILE_FLAG_ERROR);
+    }
 
     return retval;
 }
@@ -659,6 +778,10 @@ long vfs_tell( vfs_FILE * pfile )
     {
         retval = PHYSFS_tell( pfile->ptr.p );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == pfile->type )
+    {
+        retval = static_cast<long>( pfile->ptr.m->position );
+    }
 
     return retval;
 }
@@ -690,6 +813,21 @@ int vfs_seek( vfs_FILE * pfile, long offset )
         if (retval == 0) pfile->flags &= ~VFS_FILE_FLAG_ERROR;
         else             pfile->flags |= VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_MEMORY == pfile->type )
+    {
+        // reset the flags
+        pfile->flags &= ~(VFS_FILE_FLAG_EOF | VFS_FILE_FLAG_ERROR);
+
+        if ( offset >= 0 && static_cast<size_t>( offset ) <= pfile->ptr.m->data.size() )
+        {
+            pfile->ptr.m->position = static_cast<size_t>( offset );
+        }
+        else
+        {
+            pfile->flags |= VFS_FILE_FLAG_ERROR;
+            retval = -1;
+        }
+    }
 
     if ( 0 != offset )
     {
@@ -725,6 +863,10 @@ long vfs_fileLength( vfs_FILE * pfile )
     {
         retval = PHYSFS_fileLength( pfile->ptr.p );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == pfile->type )
+    {
+        retval = static_cast<long>( pfile->ptr.m->data.size() );
+    }
 
     return retval;
 }
@@ -734,7 +876,9 @@ long vfs_fileLength( vfs_FILE * pfile )
 bool vfs_mkdir(const std::string& pathname) {
     BAIL_IF_NOT_INIT();
     std::string temporary = Ego::VfsPath(pathname).string();
-    if (!PHYSFS_mkdir(temporary.c_str())) {
+    int result = PHYSFS_mkdir(temporary.c_str());
+    vfs_invalidateIndex();
+    if (!result) {
         Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "PHYSF_mkdir(", pathname, ") failed: ", vfs_getError());
         return false;
     }
@@ -747,7 +891,9 @@ bool vfs_delete_file(const std::string& pathname)
 
     std::string temporary = Ego::VfsPath(pathname).string();
 
-    if (!PHYSFS_delete(temporary.c_str())) {
+    int result = PHYSFS_delete(temporary.c_str());
+    vfs_invalidateIndex();
+    if (!result) {
         Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "PHYSF_delete(", pathname, ") failed: ", vfs_getError(), Log::EndOfEntry);
         return false;
     }
@@ -756,14 +902,43 @@ bool vfs_delete_file(const std::string& pathname)
 
 bool vfs_exists(const std::string& pathname) {
     BAIL_IF_NOT_INIT();
-    std::string temporary = Ego::VfsPath(pathname).string();
-    return (0 != PHYSFS_exists(temporary.c_str()));
+    return _vfs_index_exists(Ego::VfsPath(pathname).string());
 }
 
 bool vfs_isDirectory(const std::string& pathname) {
+    BAIL_IF_NOT_INIT();
+    return _vfs_index_isDirectory(Ego::VfsPath(pathname).string());
+}
+
+bool vfs_getFileStamp(const std::string& pathname, int64_t& modificationTime, int64_t& size) {
     BAIL_IF_NOT_INIT();
     std::string temporary = Ego::VfsPath(pathname).string();
-    return 0 != PHYSFS_isDirectory(temporary.c_str());
+    {
+        std::lock_guard<std::mutex> lock(_vfs_index_mutex);
+        const vfs_index_entry_t& entry = _vfs_index_lookup(temporary);
+        if (!entry.exists) {
+            return false;
+        }
+        // A packed file changes if the pack file is written again.
+        if (entry.packEntry) {
+            modificationTime = entry.archive->getStamp();
+            size = int64_t(entry.packEntry->size);
+            return true;
+        }
+    }
+    _vfs_physfs_calls += 2;
+    modificationTime = PHYSFS_getLastModTime(temporary.c_str());
+    if (-1 == modificationTime) {
+        return false;
+    }
+    // Opening the file does not read it.
+    PHYSFS_File *file = PHYSFS_openRead(temporary.c_str());
+    if (!file) {
+        return false;
+    }
+    size = PHYSFS_fileLength(file);
+    PHYSFS_close(file);
+    return -1 != size;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -792,6 +967,11 @@ size_t vfs_read( void * buffer, size_t size, size_t count, vfs_FILE * pfile )
 
         if ( !error ) read_length = retval;
     }
+    else if ( VFS_FILE_TYPE_MEMORY == pfile->type )
+    {
+        pfile->flags &= ~VFS_FILE_FLAG_ERROR;
+        read_length = 0 == size ? 0 : _vfs_memory_read( *pfile, buffer, size * count ) / size;
+    }
 
     if ( error ) _vfs_translate_error( pfile );
 
@@ -843,6 +1023,12 @@ int vfs_read_Sint8( vfs_FILE& file, int8_t * val )
         
         error = ( 1 != retval );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        retval = ( sizeof( int8_t ) == _vfs_memory_read( file, val, sizeof( int8_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_read(file.ptr.p, val, 1, sizeof(int8_t));
@@ -873,6 +1059,12 @@ int vfs_read_Uint8( vfs_FILE& file, uint8_t * val )
         
         error = ( 1 != retval );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        retval = ( sizeof( uint8_t ) == _vfs_memory_read( file, val, sizeof( uint8_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_read(file.ptr.p, val, 1, sizeof(int8_t));
@@ -906,6 +1098,15 @@ int vfs_read_Sint16( vfs_FILE& file, int16_t * val )
 
         *val = Endian_FileToHost( itmp );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        int16_t itmp;
+        retval = ( sizeof( int16_t ) == _vfs_memory_read( file, &itmp, sizeof( int16_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+
+        *val = Endian_FileToHost( itmp );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_readSLE16( file.ptr.p, val );
@@ -939,6 +1140,15 @@ int vfs_read_Uint16( vfs_FILE& file, uint16_t * val )
 
         *val = Endian_FileToHost( itmp );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        uint16_t itmp;
+        retval = ( sizeof( uint16_t ) == _vfs_memory_read( file, &itmp, sizeof( uint16_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+
+        *val = Endian_FileToHost( itmp );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_readULE16( file.ptr.p, val );
@@ -972,6 +1182,15 @@ int vfs_read_Sint32( vfs_FILE& file, int32_t * val )
 
         *val = Endian_FileToHost( itmp );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        int32_t itmp;
+        retval = ( sizeof( int32_t ) == _vfs_memory_read( file, &itmp, sizeof( int32_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+
+        *val = Endian_FileToHost( itmp );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_readSLE32( file.ptr.p, val );
@@ -1005,6 +1224,15 @@ int vfs_read_Uint32( vfs_FILE& file, uint32_t * val )
 
         *val = Endian_FileToHost( itmp );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        uint32_t itmp;
+        retval = ( sizeof( uint32_t ) == _vfs_memory_read( file, &itmp, sizeof( uint32_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+
+        *val = Endian_FileToHost( itmp );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_readULE32( file.ptr.p, val );
@@ -1038,6 +1266,15 @@ int vfs_read_Sint64( vfs_FILE& file, int64_t * val )
 
         *val = Endian_FileToHost( itmp );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        int64_t itmp;
+        retval = ( sizeof( int64_t ) == _vfs_memory_read( file, &itmp, sizeof( int64_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+
+        *val = Endian_FileToHost( itmp );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_readSLE64( file.ptr.p, (PHYSFS_sint64*)val );
@@ -1071,6 +1308,15 @@ int vfs_read_Uint64( vfs_FILE& file, uint64_t * val )
 
         *val = Endian_FileToHost( itmp );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        uint64_t itmp;
+        retval = ( sizeof( uint64_t ) == _vfs_memory_read( file, &itmp, sizeof( uint64_t ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+
+        *val = Endian_FileToHost( itmp );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         retval = PHYSFS_readULE64( file.ptr.p, (PHYSFS_uint64 *)val );
@@ -1104,6 +1350,15 @@ int vfs_read_float( vfs_FILE& file, float * val )
 
         *val = Endian_FileToHost( ftmp );
     }
+    else if ( VFS_FILE_TYPE_MEMORY == file.type )
+    {
+        float itmp;
+        retval = ( sizeof( float ) == _vfs_memory_read( file, &itmp, sizeof( float ) ) ) ? 1 : 0;
+
+        error = ( 1 != retval );
+
+        *val = Endian_FileToHost( itmp );
+    }
     else if ( VFS_FILE_TYPE_PHYSFS == file.type )
     {
         union { float f; uint32_t i; } convert;
@@ -1455,6 +1710,7 @@ int vfs_printf( vfs_FILE * pfile, const char *format, ... )
 
 std::vector<std::string> SearchContext::enumerateFiles(const Ego::VfsPath& pathname) {
     std::vector<std::string> result;
+    _vfs_physfs_calls++;
     char **fileList = PHYSFS_enumerateFiles(pathname.string().c_str());
     if (!fileList) {
         throw std::runtime_error("unable to enumerate files");
@@ -1468,6 +1724,19 @@ std::vector<std::string> SearchContext::enumerateFiles(const Ego::VfsPath& pathn
         }
     }
     PHYSFS_freeList(fileList);
+    // Add the contents of the directory in pack files.
+    std::lock_guard<std::mutex> lock(_vfs_index_mutex);
+    for (const auto& searchPathEntry : _vfs_search_path) {
+        std::string name;
+        if (!searchPathEntry.archive || !_vfs_search_path_getName(searchPathEntry, pathname.string(), name)) {
+            continue;
+        }
+        for (const auto& child : searchPathEntry.archive->enumerate(name)) {
+            if (std::find(result.begin(), result.end(), child) == result.end()) {
+                result.push_back(child);
+            }
+        }
+    }
     return result;
 }
 
@@ -1628,6 +1897,7 @@ int vfs_removeDirectoryAndContents(const char * dirname) {
     if (!fs_fileIsDirectory(resolvedWriteFilename.second.c_str())) return VFS_FALSE;
 
     fs_removeDirectoryAndContents(resolvedWriteFilename.second.c_str());
+    vfs_invalidateIndex();
 
     return VFS_TRUE;
 }
@@ -1720,6 +1990,21 @@ int vfs_ungetc( int c, vfs_FILE * pfile )
         if (!seeked) pfile->flags |= VFS_FILE_FLAG_ERROR;
         else         pfile->flags &= ~VFS_FILE_FLAG_ERROR;
     }
+    else if ( VFS_FILE_TYPE_MEMORY == pfile->type )
+    {
+        // fake it
+        if ( pfile->ptr.m->position > 0 )
+        {
+            pfile->ptr.m->position--;
+            pfile->flags &= ~(VFS_FILE_FLAG_EOF | VFS_FILE_FLAG_ERROR);
+            retval = c;
+        }
+        else
+        {
+            pfile->flags |= VFS_FILE_FLAG_ERROR;
+            retval = EOF;
+        }
+    }
 
     return retval;
 }
@@ -1765,6 +2050,18 @@ int vfs_getc(vfs_FILE *file)
             retval = cTmp;
         }
     }
+    else if (VFS_FILE_TYPE_MEMORY == file->type)
+    {
+        unsigned char cTmp;
+        if (1 == _vfs_memory_read(*file, &cTmp, 1))
+        {
+            retval = cTmp;
+        }
+        else
+        {
+            retval = EOF;
+        }
+    }
 
     return retval;
 }
@@ -1869,6 +2166,13 @@ void _vfs_translate_error(vfs_FILE *file)
             SET_BIT(file->flags, VFS_FILE_FLAG_EOF);
         }
     }
+    else if (VFS_FILE_TYPE_MEMORY == file->type)
+    {
+        if (file->ptr.m->position >= file->ptr.m->data.size())
+        {
+            SET_BIT(file->flags, VFS_FILE_FLAG_EOF);
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1949,6 +2253,31 @@ int vfs_add_mount_point( const std::string& rootPath, const Ego::FsPath& relativ
 
     if ( _vfs_mount_info_add( mountPoint, rootPath, relativePath.string() ) )
     {
+        _vfs_mount_generation++;
+
+        // Prefer a pack file of the directory, fall back to the directory.
+        const std::string packFilename = loc_dirname.string() + VFS_PACK_EXTENSION;
+        if ( fs_fileExists( packFilename ) )
+        {
+            try
+            {
+                vfs_search_path_entry_t pack;
+                pack.mount = Ego::left_trim<char>(mountPoint.string(), [](const char& chr) { return chr == NET_SLASH_CHR || chr == WIN32_SLASH_CHR; });
+                pack.directory = loc_dirname.string();
+                pack.archive = std::make_shared<Ego::PackArchive>( packFilename );
+                Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "mounted pack file ", "`", packFilename, "`",
+                                                 " (", pack.archive->getEntries().size(), " files) at ", "`", mountPoint.string(), "`", Log::EndOfEntry);
+                std::lock_guard<std::mutex> lock( _vfs_index_mutex );
+                _vfs_search_path.insert( append ? _vfs_search_path.end() : _vfs_search_path.begin(), pack );
+                _vfs_index.clear();
+                return 1;
+            }
+            catch ( const idlib::exception& ex )
+            {
+                Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to mount pack file ", "`", packFilename, "`",
+                                                 ": ", ex.to_string(), Log::EndOfEntry);
+            }
+        }
         retval = PHYSFS_mount( loc_dirname.string().c_str(), mountPoint.string().c_str(), append );
         if ( 0 == retval )
         {
@@ -1957,11 +2286,26 @@ int vfs_add_mount_point( const std::string& rootPath, const Ego::FsPath& relativ
             int i = _vfs_mount_info_matches( mountPoint, loc_dirname.string() );
             _vfs_mount_info_remove( i );
         }
+        else
+        {
+            vfs_search_path_entry_t directory;
+            directory.mount = Ego::left_trim<char>(mountPoint.string(), [](const char& chr) { return chr == NET_SLASH_CHR || chr == WIN32_SLASH_CHR; });
+            directory.directory = loc_dirname.string();
+            std::lock_guard<std::mutex> lock( _vfs_index_mutex );
+            _vfs_search_path.insert( append ? _vfs_search_path.end() : _vfs_search_path.begin(), directory );
+        }
+        vfs_invalidateIndex();
     }
 
     return retval;
 }
 
+//--------------------------------------------------------------------------------------------
+uint32_t vfs_getMountGeneration()
+{
+    return _vfs_mount_generation;
+}
+
 //--------------------------------------------------------------------------------------------
 int vfs_remove_mount_point( const Ego::VfsPath& mountPoint )
 {
@@ -1979,17 +2323,29 @@ int vfs_remove_mount_point( const Ego::VfsPath& mountPoint )
     // does it exist in the list?
     if ( cnt < 0 ) return false;
 
+    _vfs_mount_generation++;
+
     while ( cnt >= 0 )
     {
         // we have to use the path name to remove the search path, not the mount point name
         PHYSFS_removeFromSearchPath( _vfs_mount_infos[cnt].full_path.c_str() );
 
+        // remove the directory or the pack file mounted instead of it from the search path
+        {
+            std::lock_guard<std::mutex> lock( _vfs_index_mutex );
+            const std::string& directory = _vfs_mount_infos[cnt].full_path;
+            _vfs_search_path.erase( std::remove_if( _vfs_search_path.begin(), _vfs_search_path.end(),
+                                                    [&directory]( const vfs_search_path_entry_t& entry ) { return entry.directory == directory; } ),
+                                    _vfs_search_path.end() );
+        }
+
         // remove the mount info from this index
         // PF> we remove it even if PHYSFS_removeFromSearchPath() fails or else we might get an infinite loop
         _vfs_mount_info_remove( cnt );
 
         cnt = _vfs_mount_info_matches( mountPoint );
     }
+    vfs_invalidateIndex();
 
     return retval;
 }
@@ -2175,6 +2531,170 @@ void vfs_set_base_search_paths( void )
     
     // Put config path on search path...
     PHYSFS_addToSearchPath(fs_getConfigDirectory().c_str(), 1);
+
+    vfs_invalidateIndex();
+}
+
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
+vfs_index_entry_t& _vfs_index_lookup(const std::string& pathname)
+{
+    // The caller holds the index lock.
+    auto it = _vfs_index.find(pathname);
+    if (it != _vfs_index.end()) {
+        _vfs_index_hits++;
+        return it->second;
+    }
+    vfs_index_entry_t entry;
+    entry.packEntry = nullptr;
+    if (_vfs_pack_find(pathname, entry)) {
+        return _vfs_index.emplace(pathname, entry).first->second;
+    }
+    _vfs_physfs_calls++;
+    entry.exists = (0 != PHYSFS_exists(pathname.c_str()));
+    // Nothing more to learn about a path which does not exist.
+    entry.isDirectory = entry.exists ? -1 : 0;
+    entry.hasRealDirectory = !entry.exists;
+    return _vfs_index.emplace(pathname, entry).first->second;
+}
+
+bool _vfs_index_exists(const std::string& pathname)
+{
+    std::lock_guard<std::mutex> lock(_vfs_index_mutex);
+    return _vfs_index_lookup(pathname).exists;
+}
+
+bool _vfs_index_isDirectory(const std::string& pathname)
+{
+    std::lock_guard<std::mutex> lock(_vfs_index_mutex);
+    vfs_index_entry_t& entry = _vfs_index_lookup(pathname);
+    if (-1 == entry.isDirectory) {
+        _vfs_physfs_calls++;
+        entry.isDirectory = (0 != PHYSFS_isDirectory(pathname.c_str())) ? 1 : 0;
+    }
+    return 1 == entry.isDirectory;
+}
+
+vfs_real_directory_t _vfs_index_getRealDirectory(const std::string& pathname)
+{
+    std::lock_guard<std::mutex> lock(_vfs_index_mutex);
+    vfs_index_entry_t& entry = _vfs_index_lookup(pathname);
+    if (!entry.hasRealDirectory) {
+        _vfs_physfs_calls++;
+        const char *realDirectory = PHYSFS_getRealDir(pathname.c_str());
+        if (realDirectory) {
+            entry.realDirectory = realDirectory;
+        }
+        entry.hasRealDirectory = true;
+    }
+    vfs_real_directory_t result;
+    result.found = !entry.realDirectory.empty();
+    result.packed = nullptr != entry.archive;
+    result.directory = entry.realDirectory;
+    return result;
+}
+
+bool _vfs_search_path_getName(const vfs_search_path_entry_t& searchPathEntry, const std::string& pathname, std::string& name)
+{
+    const std::string path = Ego::left_trim<char>(pathname, [](const char& chr) { return chr == NET_SLASH_CHR || chr == WIN32_SLASH_CHR; });
+    if (path == searchPathEntry.mount) {
+        name = std::string();
+        return true;
+    } else if (idlib::is_prefix(path, searchPathEntry.mount + NET_SLASH_STR)) {
+        name = path.substr(searchPathEntry.mount.size() + 1);
+        return true;
+    }
+    return false;
+}
+
+bool _vfs_pack_find(const std::string& pathname, vfs_index_entry_t& entry)
+{
+    // The caller holds the index lock.
+    // The first pack file containing the path.
+    auto pack = _vfs_search_path.cend();
+    const Ego::PackArchive::Entry *packEntry = nullptr;
+    for (auto it = _vfs_search_path.cbegin(); it != _vfs_search_path.cend(); ++it) {
+        std::string name;
+        if (!it->archive || !_vfs_search_path_getName(*it, pathname, name)) {
+            continue;
+        }
+        packEntry = it->archive->find(name);
+        if (packEntry || it->archive->isDirectory(name)) {
+            pack = it;
+            break;
+        }
+    }
+    if (pack == _vfs_search_path.cend()) {
+        return false;
+    }
+    // A loose directory mounted before the pack file overrides it, leave the path to PhysFS then.
+    for (auto it = _vfs_search_path.cbegin(); it != pack; ++it) {
+        std::string name;
+        if (it->archive || !_vfs_search_path_getName(*it, pathname, name)) {
+            continue;
+        }
+        if (fs_fileExists(it->directory + SLASH_STR + str_convert_slash_sys(name))) {
+            return false;
+        }
+    }
+    entry.exists = true;
+    entry.isDirectory = packEntry ? 0 : 1;
+    entry.hasRealDirectory = true;
+    entry.realDirectory = pack->directory + VFS_PACK_EXTENSION;
+    entry.archive = pack->archive;
+    entry.packEntry = packEntry;
+    return true;
+}
+
+vfs_FILE *_vfs_pack_openRead(const Ego::PackArchive& archive, const Ego::PackArchive::Entry& entry)
+{
+    std::unique_ptr<vfs_memory_file_t> memory(new vfs_memory_file_t());
+    try {
+        memory->data = archive.read(entry);
+    } catch (const idlib::exception& ex) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, ex.to_string(), Log::EndOfEntry);
+        return nullptr;
+    }
+    memory->position = 0;
+    vfs_FILE *vfs_file = new vfs_FILE();
+    vfs_file->flags = VFS_FILE_FLAG_READING;
+    vfs_file->type = VFS_FILE_TYPE_MEMORY;
+    vfs_file->ptr.m = memory.release();
+    return vfs_file;
+}
+
+size_t _vfs_memory_read(vfs_FILE& file, void *buffer, size_t size)
+{
+    vfs_memory_file_t& memory = *file.ptr.m;
+    const size_t count = std::min(size, memory.data.size() - memory.position);
+    if (count > 0) {
+        std::memcpy(buffer, memory.data.data() + memory.position, count);
+        memory.position += count;
+    }
+    if (count < size) {
+        file.flags |= VFS_FILE_FLAG_EOF;
+    }
+    return count;
+}
+
+void vfs_invalidateIndex()
+{
+    std::lock_guard<std::mutex> lock(_vfs_index_mutex);
+    _vfs_index.clear();
+}
+
+vfs_statistics_t vfs_getStatistics()
+{
+    vfs_statistics_t statistics;
+    statistics.physfsCalls = _vfs_physfs_calls;
+    statistics.indexHits = _vfs_index_hits;
+    return statistics;
+}
+
+void vfs_resetStatistics()
+{
+    _vfs_physfs_calls = 0;
+    _vfs_index_hits = 0;
 }
 
 //--------------------------------------------------------------------------------------------
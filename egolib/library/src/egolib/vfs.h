@@ -302,6 +302,15 @@ bool vfs_delete_file(const std::string& pathname);
 bool vfs_exists(const std::string& pathname);
 /** @return @a true if the pathname refers to an existing directory file, @a false otherwise */
 bool vfs_isDirectory(const std::string& pathname);
+/**
+ * @brief Get the modification time and the size of a file.
+ * @param pathname the pathname of the file
+ * @param [out] modificationTime the modification time, in seconds since the epoch
+ * @param [out] size the size, in Bytes
+ * @return @a true on success, @a false otherwise
+ * @remark Cheaper than reading the file, use this to check if the file has changed.
+ */
+bool vfs_getFileStamp(const std::string& pathname, int64_t& modificationTime, int64_t& size);
 
 // binary reading and writing
 size_t vfs_read(void *buffer, size_t size, size_t count, vfs_FILE *file);
@@ -361,6 +370,8 @@ int    vfs_removeDirectoryAndContents(const char * dirname);
 // @remark Resolution follows the same rules as if the file was opened for reading.
 // @return <c>(true,resolvedFilename)</c> on success, <c>(false,filename)</c> on failure
 // where <c>resolvedFilename</c> is the resolved filename in system-specific notation.
+// A file in a pack file resolves to the pack file followed by the name of the file in the pack file,
+// e.g. <c>data/basicdat.egopak/globalparticles/spark.txt</c>, which only the vfs can open.
 std::pair<bool, std::string> vfs_resolveReadFilename(const std::string& filename);
 // @brief Resolve the specified filename.
 // @param filename the filename
@@ -384,6 +395,9 @@ int vfs_add_mount_point(const std::string& rootPath, const Ego::FsPath& relative
 /// @brief Remove every search path related to the given mount point
 /// @param mountPoint the mount point in vfs-specific notation e.g. <c>mp_modules</c>
 int vfs_remove_mount_point(const Ego::VfsPath& mountPoint);
+/// @brief Get a number which changes whenever a mount point is added or removed.
+/// @remark After a change, a vfs pathname might refer to another file, e.g. <c>mp_objects</c> of another module.
+uint32_t vfs_getMountGeneration();
 
 Ego::VfsPath vfs_convert_fname(const Ego::VfsPath& path);
 Ego::VfsPath vfs_convert_fname(const std::string& pathString);
@@ -392,7 +406,21 @@ void vfs_set_base_search_paths();
 std::pair<bool, std::string> vfs_mount_info_strip_path(const std::string& some_path);
 
 void vfs_listSearchPaths();
-    
+
+/// @brief Counters of the lookups in the search path.
+struct vfs_statistics_t
+{
+    size_t physfsCalls; ///< Number of PhysFS lookups and opens for reading
+    size_t indexHits;   ///< Number of lookups answered by the index without PhysFS
+};
+/// @brief Get the counters since the last call to vfs_resetStatistics().
+vfs_statistics_t vfs_getStatistics();
+void vfs_resetStatistics();
+/// @brief Forget what is known about existing files and directories.
+/// @remark The vfs does this itself if the search path changes or something is written through it.
+/// Call this after files in the search path were changed bypassing the vfs.
+void vfs_invalidateIndex();
+
 /// @brief Read the contents of a file.
 /// @param pathname the pathname of the file
 /// @param receive function invoked if bytes are received
@@ -0,0 +1,80 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/Image/SDL_Image_Extensions.h"
+
+namespace Ego { namespace Test { namespace Downsample {
+
+static std::shared_ptr<SDL_Surface> aSurface(int width, int height, const pixel_descriptor& pfd) {
+	return std::shared_ptr<SDL_Surface>(SDL_CreateRGBSurface(SDL_SWSURFACE, width, height, pfd.get_color_depth().depth(),
+	                                                         pfd.get_red().get_mask(), pfd.get_green().get_mask(),
+	                                                         pfd.get_blue().get_mask(), pfd.get_alpha().get_mask()),
+	                                    [](SDL_Surface *surface) { SDL_FreeSurface(surface); });
+}
+
+static void setPixel(SDL_Surface *surface, int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	uint32_t pixel = SDL_MapRGBA(surface->format, r, g, b, a);
+	std::memcpy(static_cast<uint8_t *>(surface->pixels) + y * surface->pitch + x * surface->format->BytesPerPixel, &pixel, surface->format->BytesPerPixel);
+}
+
+static Colour4b getPixel(SDL_Surface *surface, int x, int y) {
+	uint32_t pixel = 0;
+	std::memcpy(&pixel, static_cast<uint8_t *>(surface->pixels) + y * surface->pitch + x * surface->format->BytesPerPixel, surface->format->BytesPerPixel);
+	uint8_t r, g, b, a;
+	SDL_GetRGBA(pixel, surface->format, &r, &g, &b, &a);
+	return Colour4b(r, g, b, a);
+}
+
+TEST(downsample, halves_the_dimensions) {
+	auto surface = aSurface(8, 1, pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>());
+	auto level = downsample(surface);
+	ASSERT_EQ(4, level->w);
+	ASSERT_EQ(1, level->h);
+	level = downsample(aSurface(1, 1, pixel_descriptor::get<idlib::pixel_format::R8G8B8>()));
+	ASSERT_EQ(1, level->w);
+	ASSERT_EQ(1, level->h);
+}
+
+TEST(downsample, averages_opaque_pixels) {
+	auto surface = aSurface(2, 2, pixel_descriptor::get<idlib::pixel_format::R8G8B8>());
+	setPixel(surface.get(), 0, 0, 0, 0, 0, 255);
+	setPixel(surface.get(), 1, 0, 100, 0, 0, 255);
+	setPixel(surface.get(), 0, 1, 200, 40, 0, 255);
+	setPixel(surface.get(), 1, 1, 100, 0, 255, 255);
+	auto colour = getPixel(downsample(surface).get(), 0, 0);
+	ASSERT_EQ(100, colour.get_red());
+	ASSERT_EQ(10, colour.get_green());
+	ASSERT_EQ(64, colour.get_blue());
+}
+
+TEST(downsample, transparent_pixels_do_not_bleed) {
+	auto surface = aSurface(2, 2, pixel_descriptor::get<idlib::pixel_format::R8G8B8A8>());
+	// One opaque red pixel surrounded by transparent green pixels.
+	setPixel(surface.get(), 0, 0, 255, 0, 0, 255);
+	setPixel(surface.get(), 1, 0, 0, 255, 0, 0);
+	setPixel(surface.get(), 0, 1, 0, 255, 0, 0);
+	setPixel(surface.get(), 1, 1, 0, 255, 0, 0);
+	auto colour = getPixel(downsample(surface).get(), 0, 0);
+	ASSERT_EQ(255, colour.get_red());
+	ASSERT_EQ(0, colour.get_green());
+	ASSERT_EQ(64, colour.get_alpha());
+}
+
+} } } // namespace Ego::Test::Downsample
@@ -0,0 +1,77 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "gtest/gtest.h"
+#include "egolib/Core/FrameArena.hpp"
+
+namespace Ego { namespace Test { namespace FrameArena {
+
+TEST(frame_arena, allocations_are_aligned_and_disjoint) {
+	Ego::FrameArena arena(64);
+	char *previous = nullptr;
+	for (size_t i = 0; i < 100; ++i) {
+		char *pointer = static_cast<char *>(arena.allocate(24, 16));
+		ASSERT_EQ(0, reinterpret_cast<uintptr_t>(pointer) % 16);
+		std::fill(pointer, pointer + 24, char(i));
+		if (previous) {
+			ASSERT_EQ(char(i - 1), previous[23]);
+		}
+		previous = pointer;
+	}
+	ASSERT_EQ(2400, arena.getUsed());
+}
+
+TEST(frame_arena, reset_reuses_the_memory) {
+	Ego::FrameArena arena(64);
+	Ego::FrameVector<int> first{Ego::FrameAllocator<int>(arena)};
+	for (int i = 0; i < 1000; ++i) {
+		first.push_back(i);
+	}
+	ASSERT_EQ(999, first.back());
+	first = Ego::FrameVector<int>(Ego::FrameAllocator<int>(arena));
+	arena.reset();
+
+	// The chunks were merged, the same frame fits without growing.
+	const size_t capacity = arena.getCapacity();
+	const void *begin = arena.allocate(1, 1);
+	arena.reset();
+	ASSERT_EQ(begin, arena.allocate(1, 1));
+	Ego::FrameVector<int> second{Ego::FrameAllocator<int>(arena)};
+	for (int i = 0; i < 1000; ++i) {
+		second.push_back(i);
+	}
+	ASSERT_EQ(capacity, arena.getCapacity());
+}
+
+TEST(frame_arena, disabled_arena_uses_the_heap) {
+	Ego::FrameArena arena(64);
+	arena.setEnabled(false);
+	ASSERT_TRUE(arena.isEnabled());
+	arena.reset();
+	ASSERT_FALSE(arena.isEnabled());
+	Ego::FrameUnorderedSet<int> set(0, Ego::FrameAllocator<int>(arena));
+	for (int i = 0; i < 100; ++i) {
+		set.insert(i);
+	}
+	ASSERT_EQ(100, set.size());
+	ASSERT_EQ(0, arena.getCapacity());
+}
+
+} } } // namespace Ego::Test::FrameArena
@@ -0,0 +1,106 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/game/Physics/IntegrationSchedule.hpp"
+
+namespace Ego { namespace Test { namespace IntegrationSchedule {
+
+using Physics::IntegrationSchedule;
+
+/// A body moves on its own or follows a leader, like an item follows its holder.
+struct Body {
+	float position;
+	float velocity;
+	size_t leader;
+};
+
+static const size_t NO_LEADER = std::numeric_limits<size_t>::max();
+
+static std::vector<Body> aWorld(size_t count) {
+	std::vector<Body> bodies;
+	for (size_t i = 0; i < count; ++i) {
+		bodies.push_back(Body{ float(i), 0.25f + float(i % 7) * 0.125f, NO_LEADER });
+	}
+	// Followers of leaders before and after them in the list, and a chain.
+	bodies[3].leader = 10;
+	bodies[10].leader = 2;
+	bodies[50].leader = 3;
+	bodies[200].leader = 199;
+	return bodies;
+}
+
+static void integrate(std::vector<Body>& bodies, size_t i) {
+	Body& body = bodies[i];
+	if (NO_LEADER != body.leader) {
+		body.position = bodies[body.leader].position + 1.0f;
+	} else {
+		body.velocity = body.velocity * 0.99f - body.position * 0.001f;
+		body.position += body.velocity;
+	}
+}
+
+static uint64_t checksum(const std::vector<Body>& bodies) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (const Body& body : bodies) {
+		uint32_t bits;
+		std::memcpy(&bits, &body.position, sizeof(bits));
+		hash = (hash ^ bits) * 1099511628211ULL;
+		std::memcpy(&bits, &body.velocity, sizeof(bits));
+		hash = (hash ^ bits) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+static uint64_t simulate(size_t count, bool parallel, size_t& independentCount) {
+	std::vector<Body> bodies = aWorld(count);
+	IntegrationSchedule schedule;
+	for (int step = 0; step < 100; ++step) {
+		schedule.reset(bodies.size());
+		for (size_t i = 0; i < bodies.size(); ++i) {
+			if (NO_LEADER != bodies[i].leader) {
+				schedule.addDependency(i, bodies[i].leader);
+			}
+		}
+		schedule.run([&bodies](size_t i) { integrate(bodies, i); }, parallel);
+	}
+	independentCount = schedule.getIndependentCount();
+	return checksum(bodies);
+}
+
+TEST(integration_schedule, leaders_and_followers_are_dependent) {
+	IntegrationSchedule schedule;
+	schedule.reset(4);
+	schedule.addDependency(2, 0);
+	schedule.addDependent(3);
+	ASSERT_TRUE(schedule.isDependent(0));
+	ASSERT_FALSE(schedule.isDependent(1));
+	ASSERT_TRUE(schedule.isDependent(2));
+	ASSERT_TRUE(schedule.isDependent(3));
+}
+
+TEST(integration_schedule, parallel_integration_matches_serial_integration) {
+	size_t serialCount, parallelCount;
+	ASSERT_EQ(simulate(1000, false, serialCount), simulate(1000, true, parallelCount));
+	ASSERT_EQ(0, serialCount);
+	// All but the six leaders and followers.
+	ASSERT_EQ(994, parallelCount);
+}
+
+} } } // namespace Ego::Test::IntegrationSchedule
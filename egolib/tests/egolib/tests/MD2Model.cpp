@@ -0,0 +1,81 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+#include "gtest/gtest.h"
+#include "egolib/Graphics/MD2Model.hpp"
+#include <random>
+
+namespace Ego { namespace Test { namespace MD2Model {
+
+/// A frame like the loader produces it: positions on the 8 bit grid of the file, scaled like
+/// the model descriptor does, and every id normal including the "equal light" normal.
+static MD2_Frame aFrame(uint32_t seed) {
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> coordinate(0, 255);
+	MD2_Frame frame;
+	frame.vertexList.resize(4 * ::MD2Model::normalCount);
+	for (size_t i = 0; i < frame.vertexList.size(); ++i) {
+		MD2_Vertex& vertex = frame.vertexList[i];
+		vertex.pos = Vector3f(coordinate(generator) * 0.13f - 16.0f, coordinate(generator) * 0.21f - 4.0f, coordinate(generator) * 0.4f) * 3.5f;
+		vertex.normal = i % ::MD2Model::normalCount;
+		vertex.nrm = Vector3f(::MD2Model::getMD2Normal(vertex.normal, 0), ::MD2Model::getMD2Normal(vertex.normal, 1), ::MD2Model::getMD2Normal(vertex.normal, 2));
+	}
+	return frame;
+}
+
+TEST(md2_model, packed_frames_decode_within_tolerance) {
+	const MD2_Frame original = aFrame(47);
+	MD2_Frame packed = original;
+	packed.pack();
+	ASSERT_TRUE(packed.isPacked());
+	ASSERT_TRUE(packed.vertexList.empty());
+	ASSERT_LT(packed.getVertexMemory(), original.getVertexMemory() / 2);
+
+	float maxPositionError = 0.0f, maxNormalError = 0.0f;
+	for (size_t i = 0; i < original.vertexList.size(); ++i) {
+		const MD2_Vertex& vertex = original.vertexList[i];
+		const MD2_PackedVertex& packedVertex = packed.packedVertexList[i];
+		ASSERT_EQ(vertex.normal, packedVertex.normal);
+		const Vector3f position = packed.decodePosition(packedVertex);
+		const Vector3f normal = MD2_Frame::decodeNormal(packedVertex);
+		for (size_t j = 0; j < 3; ++j) {
+			maxPositionError = std::max(maxPositionError, std::abs(position[j] - vertex.pos[j]));
+			maxNormalError = std::max(maxNormalError, std::abs(normal[j] - vertex.nrm[j]));
+		}
+	}
+	// Less than a thousandth of a unit (a tile is 128 units) and a normal off by less than a hundredth of a degree.
+	ASSERT_LT(maxPositionError, 0.001f);
+	ASSERT_LT(maxNormalError, 0.0001f);
+}
+
+TEST(md2_model, unpacking_restores_the_float_frame) {
+	const MD2_Frame original = aFrame(48);
+	MD2_Frame frame = original;
+	frame.pack();
+	frame.unpack();
+	ASSERT_FALSE(frame.isPacked());
+	ASSERT_EQ(original.vertexList.size(), frame.vertexList.size());
+	for (size_t i = 0; i < original.vertexList.size(); ++i) {
+		ASSERT_EQ(original.vertexList[i].normal, frame.vertexList[i].normal);
+		ASSERT_LT(std::abs(original.vertexList[i].pos[kZ] - frame.vertexList[i].pos[kZ]), 0.001f);
+	}
+}
+
+} } } // namespace Ego::Test::MD2Model
@@ -0,0 +1,89 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/VFS/PackWriter.hpp"
+#include <cstdio>
+
+namespace Ego { namespace Test { namespace PackArchive {
+
+static std::string aName(size_t i) {
+    return "object" + std::to_string(i / 5) + ".obj/file" + std::to_string(i % 5) + ".txt";
+}
+
+static std::vector<char> someContents(size_t i) {
+    std::string contents(i % 3 == 0 ? 5000 : 10, char('a' + i % 26));
+    return std::vector<char>(contents.begin(), contents.end());
+}
+
+TEST(pack_archive, every_file_is_found_and_read_back) {
+    const std::string filename = "pack_archive_test.egopak";
+    for (size_t count : { 0u, 1u, 2u, 7u, 1000u }) {
+        PackWriter writer;
+        for (size_t i = 0; i < count; ++i) {
+            writer.add(aName(i), someContents(i));
+        }
+        writer.write(filename, 42);
+
+        Ego::PackArchive archive(filename);
+        ASSERT_EQ(count, archive.getEntries().size());
+        ASSERT_EQ(42, archive.getStamp());
+        for (size_t i = 0; i < count; ++i) {
+            const auto *entry = archive.find(aName(i));
+            ASSERT_NE(nullptr, entry);
+            ASSERT_EQ(0u, entry->offset % Ego::PackArchive::ALIGNMENT);
+            ASSERT_EQ(someContents(i), archive.read(*entry));
+        }
+        ASSERT_EQ(nullptr, archive.find("object0.obj/missing.txt"));
+        ASSERT_EQ(nullptr, archive.find("object0.obj"));
+        ASSERT_TRUE(archive.isDirectory(""));
+        if (count > 0) {
+            ASSERT_TRUE(archive.isDirectory("object0.obj"));
+            ASSERT_FALSE(archive.isDirectory(aName(0)));
+            ASSERT_EQ((count + 4) / 5, archive.enumerate("").size());
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+TEST(pack_archive, the_directory_is_a_perfect_hash) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 5000; ++i) {
+        names.push_back(aName(i));
+    }
+    std::vector<uint32_t> displacements, slots;
+    PackWriter::buildDirectory(names, displacements, slots);
+    std::vector<bool> taken(names.size(), false);
+    for (size_t i = 0; i < names.size(); ++i) {
+        ASSERT_LT(slots[i], names.size());
+        ASSERT_FALSE(taken[slots[i]]);
+        taken[slots[i]] = true;
+    }
+}
+
+TEST(pack_writer, rejects_invalid_and_duplicate_names) {
+    PackWriter writer;
+    writer.add("a/b.txt", {});
+    ASSERT_THROW(writer.add("a/b.txt", {}), idlib::invalid_argument_error);
+    ASSERT_THROW(writer.add("/a.txt", {}), idlib::invalid_argument_error);
+    ASSERT_THROW(writer.add("a//b.txt", {}), idlib::invalid_argument_error);
+    ASSERT_THROW(writer.add("", {}), idlib::invalid_argument_error);
+}
+
+} } } // namespace Ego::Test::PackArchive
@@ -120,4 +120,101 @@ TEST(quad_tree_testing, test_quad_tree) {
     ASSERT_TRUE(result.empty());
 }
 
+static float aSquaredDistanceFromTheCenter(const Point2f& point, QuadTreeElement& element) {
+    const auto& bounds = element.getAxisAlignedBox2D();
+    const float dx = (bounds.get_min()[kX] + bounds.get_max()[kX]) * 0.5f - point[kX];
+    const float dy = (bounds.get_min()[kY] + bounds.get_max()[kY]) * 0.5f - point[kY];
+    return dx * dx + dy * dy;
+}
+
+TEST(quad_tree_testing, find_nearest_visits_closest_first) {
+    Ego::QuadTree<QuadTreeElement> quadTree;
+    Ego::QuadTree<QuadTreeElement> otherQuadTree;
+    std::vector<std::shared_ptr<QuadTreeElement>> elements;
+
+    //A diagonal line of elements spread over both trees, enough to subdivide
+    quadTree.clear(0, 0, 256, 256);
+    otherQuadTree.clear(0, 0, 256, 256);
+    for (int i = 0; i < 32; ++i) {
+        elements.push_back(std::make_shared<QuadTreeElement>(i * 8.0f, i * 8.0f, 1.0f));
+        (i % 2 ? quadTree : otherQuadTree).insert(elements.back());
+    }
+
+    const Point2f point(98, 98);
+    auto squaredDistance = [&point](QuadTreeElement& element) { return aSquaredDistanceFromTheCenter(point, element); };
+
+    //The three nearest elements, closest first
+    std::vector<std::shared_ptr<QuadTreeElement>> result;
+    size_t tested = 0;
+    auto acceptAll = [&tested](const std::shared_ptr<QuadTreeElement>&) { tested++; return true; };
+    Ego::QuadTree<QuadTreeElement>::findNearest({&quadTree, &otherQuadTree}, point, 1000.0f, 3, squaredDistance, acceptAll, result);
+    ASSERT_EQ(3, result.size());
+    ASSERT_EQ(elements[12], result[0]);
+    ASSERT_EQ(elements[13], result[1]);
+    ASSERT_EQ(elements[11], result[2]);
+    //The search stops as soon as enough elements were accepted
+    ASSERT_EQ(3, tested);
+
+    //Rejected elements are skipped
+    result.clear();
+    auto rejectEven = [&elements](const std::shared_ptr<QuadTreeElement>& element) {
+        return (std::find(elements.begin(), elements.end(), element) - elements.begin()) % 2 == 1;
+    };
+    Ego::QuadTree<QuadTreeElement>::findNearest({&quadTree, &otherQuadTree}, point, 1000.0f, 1, squaredDistance, rejectEven, result);
+    ASSERT_EQ(1, result.size());
+    ASSERT_EQ(elements[13], result[0]);
+
+    //Nothing is found beyond the maximum distance
+    result.clear();
+    quadTree.findNearest(Point2f(500, 0), 100.0f, 1, [](QuadTreeElement& element) { return aSquaredDistanceFromTheCenter(Point2f(500, 0), element); }, acceptAll, result);
+    ASSERT_TRUE(result.empty());
+}
+
+TEST(quad_tree_testing, remove_elements_incrementally) {
+    Ego::QuadTree<QuadTreeElement> quadTree;
+    std::vector<std::shared_ptr<QuadTreeElement>> elements;
+
+    //Enough elements to subdivide, the fat one in the middle spans all quadrants
+    quadTree.clear(0, 0, 256, 256);
+    elements.push_back(std::make_shared<QuadTreeElement>(128, 128, 20));
+    for (int i = 0; i < 16; ++i) {
+        elements.push_back(std::make_shared<QuadTreeElement>(8.0f + i * 15.0f, 8.0f + (i % 4) * 60.0f, 2.0f));
+    }
+    for (const auto& element : elements) {
+        quadTree.insert(element);
+    }
+    ASSERT_TRUE(quadTree.contains(elements[0].get(), elements[0]->getAxisAlignedBox2D()));
+
+    //Remove the fat element and every second small element
+    std::unordered_set<const QuadTreeElement*> expected;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (i % 2 == 0) {
+            ASSERT_TRUE(quadTree.remove(elements[i].get(), elements[i]->getAxisAlignedBox2D()));
+        } else {
+            expected.insert(elements[i].get());
+        }
+    }
+    ASSERT_FALSE(quadTree.remove(elements[0].get(), elements[0]->getAxisAlignedBox2D()));
+    ASSERT_FALSE(quadTree.contains(elements[0].get(), elements[0]->getAxisAlignedBox2D()));
+
+    std::unordered_set<const QuadTreeElement*> contained;
+    quadTree.collect(contained);
+    ASSERT_EQ(expected, contained);
+
+    std::vector<std::shared_ptr<QuadTreeElement>> result;
+    quadTree.find(anAABFromARect(128, 128, 128), result);
+    ASSERT_EQ(expected.size(), result.size());
+
+    //Move an element: remove it at its old bounds, insert it at its new bounds
+    const auto& moved = elements[1];
+    const AxisAlignedBox2f oldBounds = moved->getAxisAlignedBox2D();
+    moved->getAxisAlignedBox2D() = anAABFromARect(200, 200, 2);
+    ASSERT_TRUE(quadTree.remove(moved.get(), oldBounds));
+    quadTree.insert(moved);
+    result.clear();
+    quadTree.find(anAABFromARect(200, 200, 5), result);
+    ASSERT_EQ(1, result.size());
+    ASSERT_EQ(moved, result[0]);
+}
+
 } } } // namespace Ego::Test::QuadTree
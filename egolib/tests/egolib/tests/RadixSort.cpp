@@ -0,0 +1,79 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/Core/RadixSort.hpp"
+#include <random>
+
+namespace Ego { namespace Test { namespace RadixSort {
+
+/// Like an entity list entry: a reference and a key packed from a distance and a material.
+struct Entry {
+	uint16_t ref;
+	uint64_t key;
+};
+
+static uint64_t aKey(float dist, uint32_t material) {
+	return (uint64_t(radix_key(dist)) << 32) | material;
+}
+
+/// 4096 objects and particles at random distances with a few different materials.
+static std::vector<Entry> someMixedEntries() {
+	std::mt19937 generator(4096);
+	std::uniform_real_distribution<float> distance(0.1f, 4096.0f);
+	std::uniform_int_distribution<uint32_t> profile(0, 63);
+	std::vector<Entry> entries(4096);
+	for (size_t i = 0; i < entries.size(); ++i) {
+		uint32_t material = (i % 3 == 0) ? profile(generator) : (0x80000000 | profile(generator));
+		entries[i] = Entry{ uint16_t(i), aKey(distance(generator), material) };
+	}
+	return entries;
+}
+
+TEST(radix_sort, keys_compare_like_floats) {
+	const float values[] = { -1000.0f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 1000.0f };
+	for (size_t i = 1; i < sizeof(values) / sizeof(values[0]); ++i) {
+		ASSERT_LT(radix_key(values[i - 1]), radix_key(values[i]));
+	}
+}
+
+TEST(radix_sort, sorts_like_stable_sort) {
+	auto entries = someMixedEntries();
+	// Some entries with equal keys.
+	for (size_t i = 0; i < entries.size(); i += 7) {
+		entries[i].key = aKey(1.0f, 1);
+	}
+	auto expected = entries;
+	std::stable_sort(expected.begin(), expected.end(), [](const Entry& x, const Entry& y) { return x.key < y.key; });
+	std::vector<Entry> scratch;
+	radix_sort(entries, scratch, [](const Entry& x) { return x.key; });
+	ASSERT_EQ(expected.size(), entries.size());
+	for (size_t i = 0; i < entries.size(); ++i) {
+		ASSERT_EQ(expected[i].ref, entries[i].ref);
+	}
+}
+
+TEST(radix_sort, sorts_4096_mixed_entries) {
+	auto entries = someMixedEntries();
+	std::vector<Entry> scratch;
+	radix_sort(entries, scratch, [](const Entry& x) { return x.key; });
+	ASSERT_TRUE(std::is_sorted(entries.begin(), entries.end(), [](const Entry& x, const Entry& y) { return x.key < y.key; }));
+}
+
+} } } // namespace Ego::Test::RadixSort
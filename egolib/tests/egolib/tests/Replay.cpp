@@ -0,0 +1,89 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/game/Logic/Replay.hpp"
+
+namespace Ego { namespace Test { namespace Replay {
+
+static ReplayTick aTick(uint32_t number, uint64_t checksum) {
+	ReplayTick tick;
+	tick.tick = number;
+	tick.checksum = checksum;
+	PlayerInput input;
+	input.movement = Vector2f(0.5f, -1.0f);
+	input.facing = 1.25f;
+	input.setButtonPressed(Input::InputDevice::InputButton::JUMP, true);
+	input.setFlag(PlayerInput::Respawn, true);
+	tick.inputs.emplace_back(1, input);
+	return tick;
+}
+
+TEST(replay, round_trip) {
+	ReplayHeader header;
+	header.seed = 1234;
+	header.module = "mp_modules/adventurer.mod";
+	header.players = { "mp_players/a.obj", "mp_players/b.obj" };
+
+	std::stringstream stream;
+	ReplayWriter writer(stream, header);
+	writer.write(aTick(1, 42));
+	writer.write(aTick(2, 43));
+
+	ReplayReader reader(stream);
+	ASSERT_EQ(1234, reader.getHeader().seed);
+	ASSERT_EQ(header.module, reader.getHeader().module);
+	ASSERT_EQ(header.players, reader.getHeader().players);
+
+	ReplayTick tick;
+	ASSERT_TRUE(reader.read(tick));
+	ASSERT_EQ(1, tick.tick);
+	ASSERT_EQ(42, tick.checksum);
+	ASSERT_EQ(1, tick.inputs.size());
+	ASSERT_EQ(1, tick.inputs[0].first);
+	const PlayerInput& input = tick.inputs[0].second;
+	ASSERT_EQ(0.5f, input.movement.x());
+	ASSERT_EQ(-1.0f, input.movement.y());
+	ASSERT_EQ(1.25f, input.facing);
+	ASSERT_TRUE(input.isButtonPressed(Input::InputDevice::InputButton::JUMP));
+	ASSERT_FALSE(input.isButtonPressed(Input::InputDevice::InputButton::STEALTH));
+	ASSERT_TRUE(input.hasFlag(PlayerInput::Respawn));
+	ASSERT_FALSE(input.hasFlag(PlayerInput::NoCamera));
+
+	ASSERT_TRUE(reader.read(tick));
+	ASSERT_EQ(2, tick.tick);
+	ASSERT_FALSE(reader.read(tick));
+}
+
+TEST(replay, truncated_replays_are_rejected) {
+	std::stringstream stream;
+	ReplayWriter writer(stream, ReplayHeader());
+	writer.write(aTick(1, 42));
+	const std::string bytes = stream.str();
+
+	std::stringstream truncated(bytes.substr(0, bytes.size() - 3));
+	ReplayReader reader(truncated);
+	ReplayTick tick;
+	ASSERT_THROW(reader.read(tick), idlib::runtime_error);
+
+	std::stringstream garbage("EGOPAK\0\0 not a replay");
+	ASSERT_THROW(ReplayReader{ garbage }, idlib::runtime_error);
+}
+
+} } } // namespace Ego::Test::Replay
@@ -0,0 +1,76 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/Script/RuntimeStatistics.hpp"
+#include <sstream>
+
+namespace Ego { namespace Test { namespace RuntimeStatistics {
+
+using Statistics = Ego::Script::RuntimeStatistics;
+
+TEST(runtime_statistics, times_one_in_n_calls) {
+	Statistics statistics({ "a", "b" });
+	statistics.setSamplingInterval(4);
+	size_t timed = 0;
+	for (size_t i = 0; i < 8; ++i) {
+		if (statistics.onFunctionCalled(1)) timed++;
+	}
+	ASSERT_EQ(2, timed);
+	ASSERT_EQ(8, statistics.getFunctionStatistics(1).calls.load());
+	ASSERT_EQ(0, statistics.getFunctionStatistics(0).calls.load());
+	// Unknown functions are ignored.
+	ASSERT_FALSE(statistics.onFunctionCalled(2));
+}
+
+TEST(runtime_statistics, latency_buckets) {
+	ASSERT_EQ(0, Statistics::getBucket(999));
+	ASSERT_EQ(1, Statistics::getBucket(1000));
+	ASSERT_EQ(1, Statistics::getBucket(1999));
+	ASSERT_EQ(2, Statistics::getBucket(2000));
+	ASSERT_EQ(Statistics::NUMBER_OF_BUCKETS - 1, Statistics::getBucket(std::numeric_limits<uint64_t>::max()));
+
+	Statistics statistics({ "a" });
+	statistics.onFunctionCalled(0);
+	statistics.onFunctionTimed(0, 3000);
+	statistics.onFunctionTimed(0, 1000);
+	ASSERT_EQ(3000, statistics.getFunctionStatistics(0).maxNanoseconds.load());
+	ASSERT_EQ(1, statistics.getFunctionStatistics(0).histogram[1].load());
+	ASSERT_EQ(1, statistics.getFunctionStatistics(0).histogram[2].load());
+}
+
+TEST(runtime_statistics, export_sorts_by_cost) {
+	Statistics statistics({ "cheap", "expensive" });
+	statistics.onFunctionCalled(0);
+	statistics.onFunctionTimed(0, 1000);
+	statistics.onFunctionCalled(1);
+	statistics.onFunctionTimed(1, 50000);
+	std::vector<Statistics::ScriptStatistics> scripts = { { "few.txt", 1, 10 }, { "many.txt", 1, 1000 } };
+
+	std::ostringstream csv;
+	statistics.writeCsv(csv, scripts);
+	ASSERT_LT(csv.str().find("function,expensive"), csv.str().find("function,cheap"));
+	ASSERT_LT(csv.str().find("many.txt"), csv.str().find("few.txt"));
+
+	std::ostringstream json;
+	statistics.writeJson(json, scripts);
+	ASSERT_NE(std::string::npos, json.str().find("\"instructions\": 1000"));
+}
+
+} } } // namespace Ego::Test::RuntimeStatistics
@@ -0,0 +1,76 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/Core/SnapshotStream.hpp"
+
+namespace Ego { namespace Test { namespace SnapshotStream {
+
+struct Record {
+	uint32_t id;
+	float position[3];
+	bool alive;
+};
+
+TEST(snapshot_stream, round_trip) {
+	std::vector<char> buffer;
+	SnapshotWriter writer(buffer);
+	writer.write(uint64_t(42));
+	writer.writeString("mp_modules/adventurer.mod");
+	writer.write(Record{ 7, { 1.0f, 2.0f, 3.0f }, true });
+
+	SnapshotReader reader(buffer);
+	ASSERT_EQ(42, reader.read<uint64_t>());
+	ASSERT_EQ("mp_modules/adventurer.mod", reader.readString());
+	const Record record = reader.read<Record>();
+	ASSERT_EQ(7, record.id);
+	ASSERT_EQ(3.0f, record.position[2]);
+	ASSERT_TRUE(record.alive);
+	ASSERT_TRUE(reader.isAtEnd());
+	ASSERT_THROW(reader.read<char>(), idlib::runtime_error);
+}
+
+TEST(snapshot_stream, reused_buffers_do_not_reallocate) {
+	std::vector<char> buffer;
+	for (size_t i = 0; i < 2; ++i) {
+		buffer.clear();
+		SnapshotWriter writer(buffer);
+		for (uint32_t j = 0; j < 1000; ++j) {
+			writer.write(j);
+		}
+	}
+	const char *data = buffer.data();
+	buffer.clear();
+	SnapshotWriter writer(buffer);
+	for (uint32_t j = 0; j < 1000; ++j) {
+		writer.write(j);
+	}
+	ASSERT_EQ(data, buffer.data());
+}
+
+TEST(snapshot_stream, truncated_strings_are_rejected) {
+	std::vector<char> buffer;
+	SnapshotWriter writer(buffer);
+	writer.writeString("a name");
+	buffer.pop_back();
+	SnapshotReader reader(buffer);
+	ASSERT_THROW(reader.readString(), idlib::runtime_error);
+}
+
+} } } // namespace Ego::Test::SnapshotStream
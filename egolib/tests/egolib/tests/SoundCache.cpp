@@ -0,0 +1,89 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/Audio/SoundCache.hpp"
+
+namespace Ego { namespace Test { namespace SoundCache {
+
+using namespace Ego::Audio;
+
+/// Files in memory. Remounting replaces the files and starts a new generation.
+class FakeSource : public SoundSource {
+public:
+	FakeSource() : generation(0), reads(0) {}
+
+	uint32_t getGeneration() const override { return generation; }
+	bool exists(const std::string& pathname) const override { return files.count(pathname) > 0; }
+	void read(const std::string& pathname, std::function<void(size_t, const char *)> receive) const override {
+		const std::string& contents = files.at(pathname);
+		reads++;
+		receive(contents.size(), contents.data());
+	}
+	SDL_RWops *open(const std::string& pathname) const override { return nullptr; }
+
+	void remount(const std::string& pathname, const std::string& contents) {
+		files.clear();
+		files[pathname] = contents;
+		generation++;
+	}
+
+	std::map<std::string, std::string> files;
+	uint32_t generation;
+	mutable size_t reads;
+};
+
+TEST(sound_cache, loading_a_file_name_twice_shares_the_sound) {
+	auto source = std::make_unique<FakeSource>();
+	FakeSource& files = *source;
+	files.remount("mp_objects/sound0.wav", "RIFF first sound");
+	Audio::SoundCache cache(std::move(source));
+
+	const SoundID first = cache.load("mp_objects/sound0");
+	ASSERT_NE(INVALID_SOUND_ID, first);
+	ASSERT_EQ(first, cache.load("mp_objects/sound0"));
+	ASSERT_EQ(1u, files.reads);
+	ASSERT_EQ(1u, cache.getStatistics().sounds);
+	ASSERT_EQ(1u, cache.getStatistics().sharedLoads);
+	ASSERT_EQ(INVALID_SOUND_ID, cache.load("mp_objects/sound1"));
+}
+
+TEST(sound_cache, remounting_a_mount_point_reloads_its_sounds) {
+	auto source = std::make_unique<FakeSource>();
+	FakeSource& files = *source;
+	files.remount("mp_objects/sound0.wav", "RIFF first sound");
+	Audio::SoundCache cache(std::move(source));
+
+	const SoundID first = cache.load("mp_objects/sound0");
+	ASSERT_NE(INVALID_SOUND_ID, first);
+
+	// Another directory at the same mount point, like the objects of the next module.
+	files.remount("mp_objects/sound0.wav", "RIFF second sound");
+	const SoundID second = cache.load("mp_objects/sound0");
+	ASSERT_NE(INVALID_SOUND_ID, second);
+	ASSERT_NE(first, second);
+	ASSERT_EQ(2u, cache.getStatistics().sounds);
+
+	// The first directory again, its sound is known by its contents.
+	files.remount("mp_objects/sound0.wav", "RIFF first sound");
+	ASSERT_EQ(first, cache.load("mp_objects/sound0"));
+	ASSERT_EQ(2u, cache.getStatistics().sounds);
+}
+
+} } } // namespace Ego::Test::SoundCache
@@ -0,0 +1,109 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "gtest/gtest.h"
+#include "egolib/Audio/VoiceManager.hpp"
+
+namespace Ego { namespace Test { namespace VoiceManager {
+
+using namespace Ego::Audio;
+
+/// A mixer without audio device. One-shot sounds play until they are finished explicitly.
+class FakeBackend : public VoiceBackend {
+public:
+	FakeBackend(int channelCount) : playing(channelCount, INVALID_SOUND_ID), positionUpdates(0) {}
+
+	int getChannelCount() const override { return static_cast<int>(playing.size()); }
+	bool play(int channel, SoundID soundID, bool looped) override { playing[channel] = soundID; return true; }
+	void halt(int channel) override { playing[channel] = INVALID_SOUND_ID; }
+	bool isPlaying(int channel) const override { return playing[channel] != INVALID_SOUND_ID; }
+	void setPosition(int channel, float angle, float distance) override { positionUpdates++; }
+
+	std::vector<SoundID> playing;
+	size_t positionUpdates;
+};
+
+static AudioListener aListenerAtOrigin() {
+	AudioListener listener;
+	listener.positions.push_back(Vector3f(0.0f, 0.0f, 0.0f));
+	return listener;
+}
+
+TEST(voice_manager, culls_inaudible_sounds) {
+	FakeBackend backend(4);
+	Audio::VoiceManager manager(backend);
+	auto listener = aListenerAtOrigin();
+	ASSERT_EQ(INVALID_SOUND_CHANNEL, manager.playOneShot(1, Vector3f(1000.0f, 0.0f, 0.0f), VoicePriority::Normal, listener, 100.0f));
+	ASSERT_NE(INVALID_SOUND_CHANNEL, manager.playOneShot(1, Vector3f(10.0f, 0.0f, 0.0f), VoicePriority::Normal, listener, 100.0f));
+}
+
+TEST(voice_manager, important_sounds_steal_channels) {
+	FakeBackend backend(2);
+	Audio::VoiceManager manager(backend);
+	auto listener = aListenerAtOrigin();
+	ASSERT_NE(INVALID_SOUND_CHANNEL, manager.playOneShot(1, Vector3f(10.0f, 0.0f, 0.0f), VoicePriority::Ambient, listener, 100.0f));
+	ASSERT_NE(INVALID_SOUND_CHANNEL, manager.playOneShot(2, Vector3f(10.0f, 0.0f, 0.0f), VoicePriority::Normal, listener, 100.0f));
+	// All channels are busy with sounds which are at least as important.
+	ASSERT_EQ(INVALID_SOUND_CHANNEL, manager.playOneShot(3, Vector3f(10.0f, 0.0f, 0.0f), VoicePriority::Ambient, listener, 100.0f));
+	// The ambient sound gives way.
+	int channel = manager.playOneShot(4, Vector3f(10.0f, 0.0f, 0.0f), VoicePriority::Important, listener, 100.0f);
+	ASSERT_NE(INVALID_SOUND_CHANNEL, channel);
+	ASSERT_EQ(4, backend.playing[channel]);
+	ASSERT_EQ(std::find(backend.playing.begin(), backend.playing.end(), 1), backend.playing.end());
+}
+
+TEST(voice_manager, only_the_nearest_looping_voices_are_bound) {
+	FakeBackend backend(2);
+	Audio::VoiceManager manager(backend);
+	auto listener = aListenerAtOrigin();
+	auto far = manager.addLoopingVoice(1, Vector3f(90.0f, 0.0f, 0.0f), VoicePriority::Normal);
+	auto near = manager.addLoopingVoice(2, Vector3f(10.0f, 0.0f, 0.0f), VoicePriority::Normal);
+	auto middle = manager.addLoopingVoice(3, Vector3f(50.0f, 0.0f, 0.0f), VoicePriority::Normal);
+	manager.update(listener, 100.0f);
+	ASSERT_EQ(INVALID_SOUND_CHANNEL, manager.getChannel(far));
+	ASSERT_NE(INVALID_SOUND_CHANNEL, manager.getChannel(near));
+	ASSERT_NE(INVALID_SOUND_CHANNEL, manager.getChannel(middle));
+	ASSERT_EQ(3, manager.getStatistics().virtualVoices);
+	ASSERT_EQ(2, manager.getStatistics().boundVoices);
+
+	// The far voice comes closer and takes over the channel of the middle one.
+	manager.setVoicePosition(far, Vector3f(5.0f, 0.0f, 0.0f));
+	manager.update(listener, 100.0f);
+	ASSERT_NE(INVALID_SOUND_CHANNEL, manager.getChannel(far));
+	ASSERT_EQ(INVALID_SOUND_CHANNEL, manager.getChannel(middle));
+
+	// Removing a voice frees its channel for the next update.
+	manager.removeVoice(near);
+	manager.update(listener, 100.0f);
+	ASSERT_NE(INVALID_SOUND_CHANNEL, manager.getChannel(middle));
+}
+
+TEST(voice_manager, positions_are_only_updated_on_change) {
+	FakeBackend backend(4);
+	Audio::VoiceManager manager(backend);
+	auto listener = aListenerAtOrigin();
+	manager.addLoopingVoice(1, Vector3f(10.0f, 0.0f, 0.0f), VoicePriority::Normal);
+	manager.update(listener, 100.0f);
+	size_t updates = backend.positionUpdates;
+	manager.update(listener, 100.0f);
+	manager.update(listener, 100.0f);
+	ASSERT_EQ(updates, backend.positionUpdates);
+}
+
+} } } // namespace Ego::Test::VoiceManager
@@ -0,0 +1,217 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file egopack/Main.cpp
+/// @brief Builds pack files from game data directories.
+
+#include "egolib/VFS/PackWriter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+/// @brief Get the files in a directory and its subdirectories, sorted by name.
+/// @param directory the pathname of the directory
+/// @param prefix the '/'-separated name of the directory relative to the packed directory
+/// @param [out] files receives pairs of names relative to the packed directory and pathnames
+void listFiles(const std::string& directory, const std::string& prefix, std::vector<std::pair<std::string, std::string>>& files)
+{
+    std::vector<std::pair<std::string, bool>> children;
+#if defined(_WIN32)
+    WIN32_FIND_DATA ffd;
+    HANDLE hFind = FindFirstFile((directory + "\\*").c_str(), &ffd);
+    if (INVALID_HANDLE_VALUE == hFind)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to list directory `" + directory + "`");
+    }
+    do
+    {
+        if ('.' == ffd.cFileName[0]) continue;
+        children.emplace_back(ffd.cFileName, 0 != (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY));
+    } while (FindNextFile(hFind, &ffd) != 0);
+    FindClose(hFind);
+    const std::string separator = "\\";
+#else
+    DIR *dir = opendir(directory.c_str());
+    if (!dir)
+    {
+        throw idlib::runtime_error(__FILE__, __LINE__, "unable to list directory `" + directory + "`");
+    }
+    while (dirent *entry = readdir(dir))
+    {
+        if ('.' == entry->d_name[0]) continue;
+        struct stat status;
+        if (0 != stat((directory + "/" + entry->d_name).c_str(), &status)) continue;
+        if (!S_ISDIR(status.st_mode) && !S_ISREG(status.st_mode)) continue;
+        children.emplace_back(entry->d_name, S_ISDIR(status.st_mode));
+    }
+    closedir(dir);
+    const std::string separator = "/";
+#endif
+    std::sort(children.begin(), children.end());
+    for (const auto& child : children)
+    {
+        const std::string name = prefix.empty() ? child.first : prefix + "/" + child.first;
+        const std::string pathname = directory + separator + child.first;
+        if (child.second)
+        {
+            listFiles(pathname, name, files);
+        }
+        else
+        {
+            files.emplace_back(name, pathname);
+        }
+    }
+}
+
+std::string trimSeparators(std::string directory)
+{
+    while (directory.size() > 1 && ('/' == directory.back() || '\\' == directory.back()))
+    {
+        directory.pop_back();
+    }
+    return directory;
+}
+
+void pack(const std::string& directory)
+{
+    std::vector<std::pair<std::string, std::string>> files;
+    listFiles(directory, std::string(), files);
+    Ego::PackWriter writer;
+    for (const auto& file : files)
+    {
+        writer.addFile(file.first, file.second);
+    }
+    const std::string filename = directory + ".egopak";
+    writer.write(filename, int64_t(std::time(nullptr)));
+    std::cout << filename << ": " << writer.getSize() << " files" << std::endl;
+}
+
+/// @brief Read all files of a directory, once file by file and once from its pack file.
+/// @remark The first pass is a cold load only if the file system cache was dropped before.
+void benchmark(const std::string& directory)
+{
+    std::vector<std::pair<std::string, std::string>> files;
+    listFiles(directory, std::string(), files);
+    using Clock = std::chrono::steady_clock;
+    const auto milliseconds = [](Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        size_t looseBytes = 0, packedBytes = 0;
+        auto start = Clock::now();
+        for (const auto& file : files)
+        {
+            std::ifstream input(file.second, std::ios::in | std::ios::binary | std::ios::ate);
+            std::vector<char> contents(size_t(input.tellg()));
+            input.seekg(0);
+            input.read(contents.data(), contents.size());
+            looseBytes += size_t(input.gcount());
+        }
+        const auto loose = Clock::now() - start;
+
+        start = Clock::now();
+        Ego::PackArchive archive(directory + ".egopak");
+        for (const auto& file : files)
+        {
+            const auto *entry = archive.find(file.first);
+            if (!entry)
+            {
+                throw idlib::runtime_error(__FILE__, __LINE__, "`" + file.first + "` is not in the pack file, pack the directory again");
+            }
+            packedBytes += archive.read(*entry).size();
+        }
+        const auto packed = Clock::now() - start;
+
+        std::cout << (0 == pass ? "first pass" : "warm") << ": "
+                  << files.size() << " files, "
+                  << "loose " << milliseconds(loose) << " ms (" << looseBytes << " Bytes), "
+                  << "packed " << milliseconds(packed) << " ms (" << packedBytes << " Bytes)" << std::endl;
+    }
+}
+
+void usage()
+{
+    std::cout << "usage: egopack <directory>..." << std::endl
+              << "         writes <directory>.egopak for each directory, the game mounts it instead of the directory" << std::endl
+              << "       egopack --benchmark <directory>" << std::endl
+              << "         reads all files of the directory file by file and from its pack file, twice" << std::endl
+              << "         (drop the file system cache before for cold numbers in the first pass)" << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief
+ *  The entry point of the program.
+ * @param argc
+ *  the number of command-line arguments (number of elements in the array pointed by @a argv)
+ * @param argv
+ *  the command-line arguments (a static constant array of @a argc pointers to static constant zero-terminated strings)
+ * @return
+ *  EXIT_SUCCESS upon regular termination, EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    if (arguments.empty())
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+    try
+    {
+        if ("--benchmark" == arguments[0])
+        {
+            if (2 != arguments.size())
+            {
+                usage();
+                return EXIT_FAILURE;
+            }
+            benchmark(trimSeparators(arguments[1]));
+        }
+        else
+        {
+            for (const auto& argument : arguments)
+            {
+                pack(trimSeparators(argument));
+            }
+        }
+    }
+    catch (const idlib::exception& ex)
+    {
+        std::cerr << ex.to_string() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}